@@ -752,13 +752,20 @@ input_structs = [
     "ufbx_allocator_opts",
     "ufbx_open_memory_opts",
     "ufbx_load_opts",
+    "ufbx_evaluate_cache_opts",
     "ufbx_evaluate_opts",
     "ufbx_tessellate_curve_opts",
     "ufbx_tessellate_surface_opts",
     "ufbx_subdivide_opts",
+    "ufbx_triangulate_opts",
+    "ufbx_generate_indices_opts",
     "ufbx_geometry_cache_opts",
     "ufbx_geometry_cache_data_opts",
+    "ufbx_geometry_cache_reader_opts",
+    "ufbx_cache_playback_opts",
     "ufbx_anim_opts",
+    "ufbx_anim_cursor_opts",
+    "ufbx_compact_anim_opts",
     "ufbx_prop_override_desc",
     "ufbx_bake_opts",
     "ufbx_thread_opts",
@@ -826,6 +833,8 @@ member_functions = [
     MemberFunction(func="ufbx_tessellate_nurbs_surface", self_type="ufbx_nurbs_surface", member_name="tessellate"),
     MemberFunction(func="ufbx_catch_triangulate_face", self_type="ufbx_mesh"),
     MemberFunction(func="ufbx_triangulate_face", self_type="ufbx_mesh"),
+    MemberFunction(func="ufbx_triangulate_mesh", self_type="ufbx_mesh"),
+    MemberFunction(func="ufbx_triangulate_mesh_part", self_type="ufbx_mesh"),
     MemberFunction(func="ufbx_subdivide_mesh", self_type="ufbx_mesh", member_name="subdivide"),
     MemberFunction(func="ufbx_read_geometry_cache_real", self_type="ufbx_cache_frame", member_name="read_real"),
     MemberFunction(func="ufbx_sample_geometry_cache_real", self_type="ufbx_cache_channel", member_name="sample_real"),
@@ -1042,20 +1051,30 @@ if __name__ == "__main__":
     file.functions["ufbx_load_stdio"].alloc_type = "scene"
     file.functions["ufbx_load_stdio_prefix"].alloc_type = "scene"
     file.functions["ufbx_evaluate_scene"].alloc_type = "scene"
+    file.functions["ufbx_create_evaluate_cache"].alloc_type = "evaluateCache"
     file.functions["ufbx_subdivide_mesh"].alloc_type = "mesh"
     file.functions["ufbx_tessellate_nurbs_curve"].alloc_type = "line"
     file.functions["ufbx_tessellate_nurbs_surface"].alloc_type = "mesh"
     file.functions["ufbx_load_geometry_cache"].alloc_type = "geometryCache"
     file.functions["ufbx_load_geometry_cache_len"].alloc_type = "geometryCache"
+    file.functions["ufbx_create_geometry_cache_reader"].alloc_type = "geometryCacheReader"
+    file.functions["ufbx_create_cache_playback"].alloc_type = "cachePlayback"
     file.functions["ufbx_create_anim"].alloc_type = "anim"
+    file.functions["ufbx_create_anim_cursor"].alloc_type = "animCursor"
     file.functions["ufbx_bake_anim"].alloc_type = "bakedAnim"
+    file.functions["ufbx_compact_baked_anim"].alloc_type = "compactAnim"
 
     file.functions["ufbx_free_scene"].kind = "free"
     file.functions["ufbx_free_mesh"].kind = "free"
     file.functions["ufbx_free_line_curve"].kind = "free"
     file.functions["ufbx_free_geometry_cache"].kind = "free"
+    file.functions["ufbx_free_geometry_cache_reader"].kind = "free"
+    file.functions["ufbx_free_cache_playback"].kind = "free"
+    file.functions["ufbx_free_evaluate_cache"].kind = "free"
     file.functions["ufbx_free_anim"].kind = "free"
+    file.functions["ufbx_free_anim_cursor"].kind = "free"
     file.functions["ufbx_free_baked_anim"].kind = "free"
+    file.functions["ufbx_free_compact_anim"].kind = "free"
 
     file.functions["ufbx_retain_scene"].kind = "retain"
     file.functions["ufbx_retain_mesh"].kind = "retain"
@@ -1063,6 +1082,7 @@ if __name__ == "__main__":
     file.functions["ufbx_retain_geometry_cache"].kind = "retain"
     file.functions["ufbx_retain_anim"].kind = "retain"
     file.functions["ufbx_retain_baked_anim"].kind = "retain"
+    file.functions["ufbx_retain_compact_anim"].kind = "retain"
 
     file.functions["ufbx_triangulate_face"].return_array_scale = 3
     # file.functions["ufbx_ffi_triangulate_face"].return_array_scale = 3
@@ -1070,6 +1090,8 @@ if __name__ == "__main__":
     file.functions["ufbx_sample_geometry_cache_real"].return_array_scale = 1
     file.functions["ufbx_read_geometry_cache_vec3"].return_array_scale = 1
     file.functions["ufbx_sample_geometry_cache_vec3"].return_array_scale = 1
+    file.functions["ufbx_cache_playback_sample_real"].return_array_scale = 1
+    file.functions["ufbx_cache_playback_sample_vec3"].return_array_scale = 1
 
     for func in file.functions.values():
         t = file.types[func.return_type]
@@ -1082,7 +1082,7 @@ async def main():
             "output": "unit_tests" + exe_suffix,
             "defines": { },
         }
-        target_tasks += compile_permutations("unit_tests", runner_config, all_configs, [])
+        target_tasks += compile_permutations("unit_tests", runner_config, all_configs, ["-d", "data"])
 
         runner_config = {
             "sources": ["test/extra/test_math.c"],
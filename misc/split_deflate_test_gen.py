@@ -0,0 +1,26 @@
+import zlib
+import struct
+import argparse
+
+# Generates a zlib compressed float array for testing split DEFLATE decoding
+# in `test/unit_tests.c`. The values must match `split_deflate_value()`.
+
+def generate_values(count):
+    seed = 1
+    values = []
+    for i in range(count):
+        seed = (seed * 1664525 + 1013904223) & 0xffffffff
+        values.append(((i // 16 % 4096) * 256 + (seed >> 24)) / 2048.0)
+    return values
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(usage="split_deflate_test_gen.py dst")
+    parser.add_argument("dst", help="Output filename")
+    parser.add_argument("--count", type=int, default=1<<17, help="Number of values")
+    argv = parser.parse_args()
+
+    values = generate_values(argv.count)
+    data = struct.pack(f"<{len(values)}f", *values)
+
+    with open(argv.dst, "wb") as f:
+        f.write(zlib.compress(data, 6))
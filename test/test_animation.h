@@ -3436,3 +3436,650 @@ UFBXT_FILE_TEST_ALT(bake_search_element, maya_anim_diffuse_curve)
 	ufbx_free_baked_anim(bake);
 }
 #endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_same_evaluated_scene(ufbx_scene *a, ufbx_scene *b)
+{
+	ufbxt_assert(a->elements.count == b->elements.count);
+	for (size_t i = 0; i < a->elements.count; i++) {
+		ufbx_element *ea = a->elements.data[i];
+		ufbx_element *eb = b->elements.data[i];
+		ufbxt_assert(ea->props.defaults == eb->props.defaults);
+		ufbxt_assert(ea->props.props.count == eb->props.props.count);
+		for (size_t j = 0; j < ea->props.props.count; j++) {
+			ufbx_prop *pa = &ea->props.props.data[j];
+			ufbx_prop *pb = &eb->props.props.data[j];
+			ufbxt_assert(pa->name.data == pb->name.data);
+			ufbxt_assert(pa->value_int == pb->value_int);
+			ufbxt_assert(!memcmp(&pa->value_vec4, &pb->value_vec4, sizeof(ufbx_vec4)));
+		}
+	}
+
+	for (size_t i = 0; i < a->nodes.count; i++) {
+		ufbx_node *na = a->nodes.data[i];
+		ufbx_node *nb = b->nodes.data[i];
+		ufbxt_assert(!memcmp(&na->local_transform, &nb->local_transform, sizeof(ufbx_transform)));
+		ufbxt_assert(!memcmp(&na->node_to_world, &nb->node_to_world, sizeof(ufbx_matrix)));
+		ufbxt_assert(!memcmp(&na->geometry_to_world, &nb->geometry_to_world, sizeof(ufbx_matrix)));
+	}
+
+	for (size_t i = 0; i < a->meshes.count; i++) {
+		ufbx_mesh *ma = a->meshes.data[i];
+		ufbx_mesh *mb = b->meshes.data[i];
+		ufbxt_assert(ma->skinned_is_local == mb->skinned_is_local);
+		ufbxt_assert(ma->skinned_position.values.count == mb->skinned_position.values.count);
+		if (mb->skinned_position.values.count > 0) {
+			ufbxt_assert(!memcmp(ma->skinned_position.values.data, mb->skinned_position.values.data,
+				mb->skinned_position.values.count * sizeof(ufbx_vec3)));
+		}
+		ufbxt_assert(ma->skinned_normal.values.count == mb->skinned_normal.values.count);
+		ufbxt_assert(ma->skinned_normal.indices.count == mb->skinned_normal.indices.count);
+		if (mb->skinned_normal.values.count > 0) {
+			ufbxt_assert(!memcmp(ma->skinned_normal.values.data, mb->skinned_normal.values.data,
+				mb->skinned_normal.values.count * sizeof(ufbx_vec3)));
+		}
+		if (mb->skinned_normal.indices.count > 0) {
+			ufbxt_assert(!memcmp(ma->skinned_normal.indices.data, mb->skinned_normal.indices.data,
+				mb->skinned_normal.indices.count * sizeof(uint32_t)));
+		}
+	}
+}
+
+static void ufbxt_check_evaluate_in_place(ufbx_scene *scene, const ufbx_anim *anim, const ufbx_evaluate_opts *opts, const double *times, size_t num_times)
+{
+	ufbx_scene *state = ufbx_evaluate_scene(scene, anim, times[0], opts, NULL);
+	ufbxt_assert(state);
+
+	for (size_t i = 0; i < num_times; i++) {
+		size_t num_allocs = state->metadata.result_allocs;
+
+		ufbx_error error;
+		bool ok = ufbx_evaluate_scene_in_place(state, anim, times[i], opts, &error);
+		if (!ok) ufbxt_log_error(&error);
+		ufbxt_assert(ok);
+		ufbxt_check_scene(state);
+
+		// Evaluating with the same animation should never need more memory
+		ufbxt_assert(state->metadata.result_allocs == num_allocs);
+
+		ufbx_scene *ref = ufbx_evaluate_scene(scene, anim, times[i], opts, NULL);
+		ufbxt_assert(ref);
+		ufbxt_check_same_evaluated_scene(state, ref);
+		ufbx_free_scene(ref);
+	}
+
+	ufbx_free_scene(state);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_in_place, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	static const double times[] = { 1.0/24.0, 5.0/24.0, 14.0/24.0, 20.0/24.0, 24.0/24.0, 0.0 };
+	ufbxt_check_evaluate_in_place(scene, NULL, NULL, times, ufbxt_arraycount(times));
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_in_place_overrides, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	ufbx_node *node = ufbx_find_node(scene, "pCube1");
+	ufbxt_assert(node);
+	uint32_t element_id = node->element.element_id;
+
+	ufbx_prop_override_desc overrides[] = {
+		{ element_id, { "Color", SIZE_MAX }, { (ufbx_real)0.3, (ufbx_real)0.6, (ufbx_real)0.9 } },
+		{ element_id, { "|NewProp", SIZE_MAX }, { 10, 20, 30 }, { "Test", SIZE_MAX }, },
+		{ element_id, { "Lcl Scaling", SIZE_MAX }, { 2.0f, 3.0f, 4.0f } },
+		{ scene->root_node->element.element_id, { "Visibility", SIZE_MAX }, { 0.0f } },
+	};
+
+	ufbx_anim_opts anim_opts = { 0 };
+	anim_opts.prop_overrides.data = overrides;
+	anim_opts.prop_overrides.count = ufbxt_arraycount(overrides);
+
+	ufbx_anim *anim = ufbx_create_anim(scene, &anim_opts, NULL);
+	ufbxt_assert(anim);
+
+	static const double times[] = { 5.0/24.0, 14.0/24.0 };
+	ufbxt_check_evaluate_in_place(scene, anim, NULL, times, ufbxt_arraycount(times));
+
+	// Switching between animations with a different amount of overrides
+	ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 0.0, NULL, NULL);
+	ufbxt_assert(state);
+
+	for (int round = 0; round < 2; round++) {
+		const ufbx_anim *round_anim = round == 0 ? anim : scene->anim;
+		bool ok = ufbx_evaluate_scene_in_place(state, round_anim, 14.0/24.0, NULL, NULL);
+		ufbxt_assert(ok);
+
+		ufbx_scene *ref = ufbx_evaluate_scene(scene, round_anim, 14.0/24.0, NULL, NULL);
+		ufbxt_assert(ref);
+		ufbxt_check_same_evaluated_scene(state, ref);
+		ufbx_free_scene(ref);
+	}
+
+	// Evaluating with an animation from a different scene must fail
+	{
+		ufbx_error error;
+		bool ok = ufbx_evaluate_scene_in_place(state, state->anim, 0.0, NULL, &error);
+		ufbxt_assert(!ok);
+		ufbxt_assert(error.type != UFBX_ERROR_NONE);
+	}
+
+	// Only scenes returned by `ufbx_evaluate_scene()` can be evaluated in place
+	{
+		ufbx_error error;
+		bool ok = ufbx_evaluate_scene_in_place(scene, NULL, 0.0, NULL, &error);
+		ufbxt_assert(!ok);
+		ufbxt_assert(error.type != UFBX_ERROR_NONE);
+	}
+
+	ufbx_free_scene(state);
+	ufbx_free_anim(anim);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_evaluate_curves(ufbxt_diff_error *err, ufbx_scene *scene)
+{
+	size_t num_curves = scene->anim_curves.count + 1;
+	const ufbx_anim_curve **curves = (const ufbx_anim_curve**)calloc(num_curves, sizeof(const ufbx_anim_curve*));
+	ufbx_real *values = (ufbx_real*)calloc(num_curves + 256, sizeof(ufbx_real));
+	double *times = (double*)calloc(256, sizeof(double));
+	ufbxt_assert(curves && values && times);
+
+	// Leave the last curve as NULL to test the default value
+	for (size_t i = 0; i < scene->anim_curves.count; i++) {
+		curves[i] = scene->anim_curves.data[i];
+	}
+
+	for (int frame = -2; frame <= 60; frame++) {
+		double time = frame / 24.0 + 0.01;
+		ufbx_evaluate_curves(curves, values, num_curves, time, 7.0f);
+		for (size_t i = 0; i < num_curves; i++) {
+			ufbxt_assert_close_real(err, values[i], ufbx_evaluate_curve(curves[i], time, 7.0f));
+		}
+	}
+
+	for (size_t i = 0; i < num_curves; i++) {
+		const ufbx_anim_curve *curve = curves[i];
+
+		// Increasing times with a few repeats and a jump backwards in the middle
+		for (size_t j = 0; j < 256; j++) {
+			times[j] = (double)j / 96.0 - 0.5;
+			if (j % 7 == 0 && j > 0) times[j] = times[j - 1];
+		}
+		times[128] = 0.0;
+
+		ufbx_evaluate_curve_times(curve, times, values, 256, 7.0f);
+		for (size_t j = 0; j < 256; j++) {
+			ufbxt_assert_close_real(err, values[j], ufbx_evaluate_curve(curve, times[j], 7.0f));
+		}
+	}
+
+	free(times);
+	free(values);
+	free(curves);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_curves_interpolation_modes, maya_interpolation_modes)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_curves(err, scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_curves_tangent_weight, motionbuilder_tangent_weight)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_curves(err, scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_curves_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_curves(err, scene);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_anim_cursor(ufbxt_diff_error *err, ufbx_scene *scene, const ufbx_anim *anim)
+{
+	ufbx_anim_cursor *cursor = ufbx_create_anim_cursor(scene, anim, NULL, NULL);
+	ufbxt_assert(cursor);
+	if (!anim) anim = scene->anim;
+
+	// Play forwards, seek back to the start and play a second time
+	for (int round = 0; round < 2; round++) {
+		for (int frame = -2; frame <= 60; frame++) {
+			double time = frame / 24.0 + 0.01 * round;
+
+			for (size_t i = 0; i < scene->nodes.count; i++) {
+				ufbx_node *node = scene->nodes.data[i];
+				ufbx_transform ref = ufbx_evaluate_transform(anim, node, time);
+				ufbx_transform tr = ufbx_evaluate_transform(cursor->anim, node, time);
+				ufbxt_assert_close_vec3(err, tr.translation, ref.translation);
+				ufbxt_assert_close_quat(err, tr.rotation, ref.rotation);
+				ufbxt_assert_close_vec3(err, tr.scale, ref.scale);
+			}
+
+			for (size_t i = 0; i < scene->anim_curves.count; i++) {
+				ufbx_anim_curve *curve = scene->anim_curves.data[i];
+				ufbx_real ref = ufbx_evaluate_curve(curve, time, 7.0f);
+				ufbx_real value = ufbx_evaluate_curve_cursor(cursor, curve, time, 7.0f);
+				ufbxt_assert_close_real(err, value, ref);
+			}
+		}
+	}
+
+	if (scene->anim_curves.count > 0) {
+		ufbxt_assert(cursor->num_sequential_lookups > 0);
+		ufbxt_assert(cursor->num_search_lookups > 0);
+		ufbxt_assert(cursor->num_sequential_lookups > cursor->num_search_lookups);
+	}
+
+	// In-place evaluation continues from the cursor as well
+	ufbx_scene *state = ufbx_evaluate_scene(scene, cursor->anim, 0.0, NULL, NULL);
+	ufbxt_assert(state);
+	uint64_t num_lookups = cursor->num_sequential_lookups + cursor->num_search_lookups;
+	for (int frame = 0; frame <= 60; frame += 4) {
+		double time = frame / 24.0;
+		ufbxt_assert(ufbx_evaluate_scene_in_place(state, cursor->anim, time, NULL, NULL));
+		for (size_t i = 0; i < scene->nodes.count; i++) {
+			ufbx_transform ref = ufbx_evaluate_transform(anim, scene->nodes.data[i], time);
+			ufbx_transform tr = state->nodes.data[i]->local_transform;
+			ufbxt_assert_close_vec3(err, tr.translation, ref.translation);
+			ufbxt_assert_close_quat(err, tr.rotation, ref.rotation);
+			ufbxt_assert_close_vec3(err, tr.scale, ref.scale);
+		}
+	}
+	if (scene->anim_curves.count > 0 && anim->layers.count > 0) {
+		ufbxt_assert(cursor->num_sequential_lookups + cursor->num_search_lookups > num_lookups);
+	}
+	ufbx_free_scene(state);
+
+	ufbx_free_anim_cursor(cursor);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(anim_cursor_interpolation_modes, maya_interpolation_modes)
+#if UFBXT_IMPL
+{
+	ufbxt_check_anim_cursor(err, scene, NULL);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(anim_cursor_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_anim_cursor(err, scene, NULL);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(anim_cursor_custom_anim, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	ufbx_prop_override_desc over = { 0 };
+	ufbx_node *node = ufbx_find_node(scene, "pCube1");
+	ufbxt_assert(node);
+	over.element_id = node->element.element_id;
+	over.prop_name.data = "Lcl Translation";
+	over.prop_name.length = SIZE_MAX;
+	over.value.x = 1.0f;
+
+	ufbx_anim_opts opts = { 0 };
+	opts.prop_overrides.data = &over;
+	opts.prop_overrides.count = 1;
+	ufbx_anim *anim = ufbx_create_anim(scene, &opts, NULL);
+	ufbxt_assert(anim);
+
+	ufbxt_check_anim_cursor(err, scene, anim);
+
+	// The cursor keeps the animation alive
+	ufbx_anim_cursor *cursor = ufbx_create_anim_cursor(scene, anim, NULL, NULL);
+	ufbxt_assert(cursor);
+	ufbx_free_anim(anim);
+
+	ufbx_transform tr = ufbx_evaluate_transform(cursor->anim, node, 1.0);
+	ufbxt_assert_close_real(err, tr.translation.x, 1.0f);
+
+	// Evaluating a scene with a cursor must not leak it into the result
+	ufbx_scene *state = ufbx_evaluate_scene(scene, cursor->anim, 1.0, NULL, NULL);
+	ufbxt_assert(state);
+	ufbxt_assert(!state->anim->custom);
+	ufbx_free_scene(state);
+
+	// The cursor owns its animation so these are no-ops
+	ufbx_retain_anim(cursor->anim);
+	ufbx_free_anim(cursor->anim);
+
+	ufbx_free_anim_cursor(cursor);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_compact_anim(ufbxt_diff_error *err, ufbx_scene *scene, double sample_rate)
+{
+	ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, NULL, NULL);
+	ufbxt_assert(bake);
+
+	ufbx_compact_anim_opts opts = { 0 };
+	opts.sample_rate = sample_rate;
+
+	ufbx_error error;
+	ufbx_compact_anim *anim = ufbx_compact_baked_anim(bake, &opts, &error);
+	if (!anim) ufbxt_log_error(&error);
+	ufbxt_assert(anim);
+
+	ufbxt_assert(anim->nodes.count == bake->nodes.count);
+	ufbxt_assert(anim->elements.count == bake->elements.count);
+	ufbxt_assert(anim->time_begin == bake->key_time_min);
+	ufbxt_assert(anim->time_end >= bake->key_time_max - 0.001 / sample_rate);
+
+	size_t baked_size = 0;
+	for (size_t i = 0; i < bake->nodes.count; i++) {
+		ufbx_baked_node *baked_node = &bake->nodes.data[i];
+		ufbx_node *node = scene->nodes.data[baked_node->typed_id];
+		ufbx_compact_node *compact_node = ufbx_find_compact_node(anim, node);
+		ufbxt_assert(compact_node && compact_node->element_id == baked_node->element_id);
+
+		baked_size += baked_node->translation_keys.count * sizeof(ufbx_baked_vec3);
+		baked_size += baked_node->rotation_keys.count * sizeof(ufbx_baked_quat);
+		baked_size += baked_node->scale_keys.count * sizeof(ufbx_baked_vec3);
+
+		if (baked_node->constant_translation) ufbxt_assert(compact_node->translation.num_samples == 1);
+		if (baked_node->constant_rotation) ufbxt_assert(compact_node->rotation.num_samples == 1);
+		if (baked_node->constant_scale) ufbxt_assert(compact_node->scale.num_samples == 1);
+
+		// Values at the sample times only have quantization error
+		for (size_t j = 0; j < anim->num_samples; j++) {
+			double time = anim->time_begin + (double)j / anim->sample_rate;
+			ufbx_transform tr = ufbx_evaluate_compact_node(anim, compact_node, time);
+			ufbx_vec3 ref_t = ufbx_evaluate_baked_vec3(baked_node->translation_keys, time);
+			ufbx_quat ref_r = ufbx_evaluate_baked_quat(baked_node->rotation_keys, time);
+			ufbx_vec3 ref_s = ufbx_evaluate_baked_vec3(baked_node->scale_keys, time);
+
+			ufbx_vec3 step_t = compact_node->translation.scale;
+			ufbxt_assert(fabs(tr.translation.x - ref_t.x) <= step_t.x * 0.51f + 1e-5f);
+			ufbxt_assert(fabs(tr.translation.y - ref_t.y) <= step_t.y * 0.51f + 1e-5f);
+			ufbxt_assert(fabs(tr.translation.z - ref_t.z) <= step_t.z * 0.51f + 1e-5f);
+
+			ufbx_vec3 step_s = compact_node->scale.scale;
+			ufbxt_assert(fabs(tr.scale.x - ref_s.x) <= step_s.x * 0.51f + 1e-5f);
+			ufbxt_assert(fabs(tr.scale.y - ref_s.y) <= step_s.y * 0.51f + 1e-5f);
+			ufbxt_assert(fabs(tr.scale.z - ref_s.z) <= step_s.z * 0.51f + 1e-5f);
+
+			// Smallest three encoding flips the sign to make the largest component positive
+			ref_r = ufbx_quat_normalize(ref_r);
+			ufbxt_assert_close_quat_threshold(err, ufbx_quat_fix_antipodal(tr.rotation, ref_r), ref_r, 1e-4f);
+		}
+	}
+
+	for (size_t i = 0; i < bake->elements.count; i++) {
+		ufbx_baked_element *baked_elem = &bake->elements.data[i];
+		ufbx_compact_element *compact_elem = ufbx_find_compact_element(anim, scene->elements.data[baked_elem->element_id]);
+		ufbxt_assert(compact_elem && compact_elem->props.count == baked_elem->props.count);
+
+		for (size_t j = 0; j < baked_elem->props.count; j++) {
+			ufbx_baked_prop *baked_prop = &baked_elem->props.data[j];
+			ufbx_compact_prop *compact_prop = &compact_elem->props.data[j];
+			ufbxt_assert(!strcmp(compact_prop->name.data, baked_prop->name.data));
+			baked_size += baked_prop->keys.count * sizeof(ufbx_baked_vec3);
+
+			for (size_t k = 0; k < anim->num_samples; k++) {
+				double time = anim->time_begin + (double)k / anim->sample_rate;
+				ufbx_vec3 v = ufbx_evaluate_compact_vec3(anim, &compact_prop->value, time);
+				ufbx_vec3 ref = ufbx_evaluate_baked_vec3(baked_prop->keys, time);
+				ufbx_vec3 step = compact_prop->value.scale;
+				ufbxt_assert(fabs(v.x - ref.x) <= step.x * 0.51f + 1e-5f);
+				ufbxt_assert(fabs(v.y - ref.y) <= step.y * 0.51f + 1e-5f);
+				ufbxt_assert(fabs(v.z - ref.z) <= step.z * 0.51f + 1e-5f);
+			}
+		}
+	}
+
+	ufbxt_logf(".. baked %zu bytes, compact %zu bytes", baked_size, anim->data.count * sizeof(uint16_t));
+
+	// Evaluating outside the range clamps to the first and last samples
+	if (anim->nodes.count > 0) {
+		ufbx_compact_node *node = &anim->nodes.data[0];
+		ufbx_transform a = ufbx_evaluate_compact_node(anim, node, anim->time_begin - 10.0);
+		ufbx_transform b = ufbx_evaluate_compact_node(anim, node, anim->time_begin);
+		ufbxt_assert_close_vec3(err, a.translation, b.translation);
+		a = ufbx_evaluate_compact_node(anim, node, anim->time_end + 10.0);
+		b = ufbx_evaluate_compact_node(anim, node, anim->time_end);
+		ufbxt_assert_close_vec3(err, a.translation, b.translation);
+	}
+
+	// The compact animation does not reference the bake
+	ufbx_free_baked_anim(bake);
+	ufbx_retain_compact_anim(anim);
+	ufbx_free_compact_anim(anim);
+	ufbx_free_compact_anim(anim);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(compact_anim_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compact_anim(err, scene, 30.0);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(compact_anim_pivot_rotate, maya_anim_pivot_rotate)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compact_anim(err, scene, 24.0);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(compact_anim_diffuse_curve, maya_anim_diffuse_curve)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compact_anim(err, scene, 60.0);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(compact_anim_alloc_fail, maya_anim_diffuse_curve)
+#if UFBXT_IMPL
+{
+	ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, NULL, NULL);
+	ufbxt_assert(bake);
+
+	for (size_t max_result = 1; max_result < 10000; max_result++) {
+		ufbx_compact_anim_opts opts = { 0 };
+		opts.result_allocator.huge_threshold = 1;
+		opts.result_allocator.allocation_limit = max_result;
+
+		ufbxt_hintf("Result limit: %zu", max_result);
+
+		ufbx_error error;
+		ufbx_compact_anim *anim = ufbx_compact_baked_anim(bake, &opts, &error);
+		if (anim) {
+			ufbxt_logf(".. Tested up to %zu result allocations", max_result);
+			ufbx_free_compact_anim(anim);
+			break;
+		}
+		ufbxt_assert(error.type == UFBX_ERROR_ALLOCATION_LIMIT);
+	}
+
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+#if UFBXT_IMPL
+static double ufbxt_vec3_dist(ufbx_vec3 a, ufbx_vec3 b)
+{
+	double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+	return sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+// World space position of `node` composed from the baked local transforms of it and its ancestors.
+static ufbx_vec3 ufbxt_baked_world_position(ufbx_baked_anim *bake, ufbx_node *node, double time)
+{
+	ufbx_vec3 pos = { 0 };
+	for (; node && !node->is_root; node = node->parent) {
+		ufbx_transform transform = node->local_transform;
+		ufbx_baked_node *baked = ufbx_find_baked_node(bake, node);
+		if (baked) {
+			transform.translation = ufbx_evaluate_baked_vec3(baked->translation_keys, time);
+			transform.rotation = ufbx_evaluate_baked_quat(baked->rotation_keys, time);
+			transform.scale = ufbx_evaluate_baked_vec3(baked->scale_keys, time);
+		}
+		ufbx_matrix matrix = ufbx_transform_to_matrix(&transform);
+		pos = ufbx_transform_position(&matrix, pos);
+	}
+	return pos;
+}
+
+static size_t ufbxt_check_error_bounded_reduction(ufbxt_diff_error *err, ufbx_scene *scene, bool hierarchy)
+{
+	ufbx_baked_anim *ref = ufbx_bake_anim(scene, NULL, NULL, NULL);
+	ufbxt_assert(ref);
+
+	ufbx_bake_opts opts = { 0 };
+	opts.key_reduction_enabled = true;
+	opts.key_reduction_rotation = true;
+	opts.key_reduction_mode = UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED;
+	opts.key_reduction_translation_tolerance = 0.01;
+	opts.key_reduction_rotation_tolerance = 1.0;
+	opts.key_reduction_scale_tolerance = 0.01;
+	opts.key_reduction_prop_tolerance = 0.001;
+	opts.key_reduction_hierarchy_error = hierarchy;
+
+	ufbx_error error;
+	ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, &opts, &error);
+	if (!bake) ufbxt_log_error(&error);
+	ufbxt_assert(bake);
+	ufbxt_assert(bake->nodes.count == ref->nodes.count);
+	ufbxt_assert(bake->elements.count == ref->elements.count);
+
+	// Rotation tolerance as the chord length between unit quaternions
+	double max_chord = 2.0 * sin(opts.key_reduction_rotation_tolerance * (3.141592653589793 / 180.0) * 0.25);
+
+	size_t num_ref_keys = 0, num_keys = 0;
+	for (size_t i = 0; i < bake->nodes.count; i++) {
+		ufbx_baked_node *ref_node = &ref->nodes.data[i];
+		ufbx_baked_node *node = &bake->nodes.data[i];
+		ufbxt_assert(node->typed_id == ref_node->typed_id);
+
+		ufbxt_assert(node->translation_keys.count <= ref_node->translation_keys.count);
+		ufbxt_assert(node->rotation_keys.count <= ref_node->rotation_keys.count);
+		ufbxt_assert(node->scale_keys.count <= ref_node->scale_keys.count);
+		num_ref_keys += ref_node->translation_keys.count + ref_node->rotation_keys.count + ref_node->scale_keys.count;
+		num_keys += node->translation_keys.count + node->rotation_keys.count + node->scale_keys.count;
+
+		// The error bound holds at every originally sampled key
+		for (size_t j = 0; j < ref_node->translation_keys.count; j++) {
+			ufbx_baked_vec3 key = ref_node->translation_keys.data[j];
+			ufbx_vec3 v = ufbx_evaluate_baked_vec3(node->translation_keys, key.time);
+			ufbxt_assert(ufbxt_vec3_dist(v, key.value) <= opts.key_reduction_translation_tolerance + 1e-6);
+		}
+		for (size_t j = 0; j < ref_node->rotation_keys.count; j++) {
+			ufbx_baked_quat key = ref_node->rotation_keys.data[j];
+			ufbx_quat q = ufbx_quat_fix_antipodal(ufbx_evaluate_baked_quat(node->rotation_keys, key.time), key.value);
+			double dx = q.x - key.value.x, dy = q.y - key.value.y, dz = q.z - key.value.z, dw = q.w - key.value.w;
+			ufbxt_assert(sqrt(dx*dx + dy*dy + dz*dz + dw*dw) <= max_chord + 1e-6);
+		}
+		for (size_t j = 0; j < ref_node->scale_keys.count; j++) {
+			ufbx_baked_vec3 key = ref_node->scale_keys.data[j];
+			ufbx_vec3 v = ufbx_evaluate_baked_vec3(node->scale_keys, key.time);
+			ufbxt_assert(ufbxt_vec3_dist(v, key.value) <= opts.key_reduction_scale_tolerance + 1e-6);
+		}
+	}
+
+	for (size_t i = 0; i < bake->elements.count; i++) {
+		ufbx_baked_element *ref_elem = &ref->elements.data[i];
+		ufbx_baked_element *elem = &bake->elements.data[i];
+		ufbxt_assert(elem->props.count == ref_elem->props.count);
+		for (size_t j = 0; j < elem->props.count; j++) {
+			ufbx_baked_prop *ref_prop = &ref_elem->props.data[j];
+			ufbx_baked_prop *prop = &elem->props.data[j];
+			ufbxt_assert(prop->keys.count <= ref_prop->keys.count);
+			num_ref_keys += ref_prop->keys.count;
+			num_keys += prop->keys.count;
+
+			for (size_t k = 0; k < ref_prop->keys.count; k++) {
+				ufbx_baked_vec3 key = ref_prop->keys.data[k];
+				ufbx_vec3 v = ufbx_evaluate_baked_vec3(prop->keys, key.time);
+				ufbxt_assert(ufbxt_vec3_dist(v, key.value) <= opts.key_reduction_prop_tolerance + 1e-6);
+			}
+		}
+	}
+
+	// With hierarchy error the reduced curves should keep the world positions of all nodes
+	// close to the unreduced ones, not just the local transforms. The bound is approximate
+	// as the reach of each node is measured in the rest pose.
+	if (hierarchy) {
+		double max_error = 0.0;
+		for (size_t i = 0; i < scene->nodes.count; i++) {
+			ufbx_node *node = scene->nodes.data[i];
+			if (node->is_root) continue;
+			for (int frame = 0; frame <= 64; frame++) {
+				double time = ref->playback_time_begin + (ref->playback_time_end - ref->playback_time_begin) * (double)frame / 64.0;
+				ufbx_vec3 ref_pos = ufbxt_baked_world_position(ref, node, time);
+				ufbx_vec3 pos = ufbxt_baked_world_position(bake, node, time);
+				double error = ufbxt_vec3_dist(pos, ref_pos);
+				if (error > max_error) max_error = error;
+			}
+		}
+		ufbxt_logf(".. max world position error %f", max_error);
+		ufbxt_assert(max_error <= 2.0 * opts.key_reduction_translation_tolerance);
+	}
+
+	ufbxt_logf(".. %zu keys reduced to %zu%s", num_ref_keys, num_keys, hierarchy ? " (hierarchy)" : "");
+
+	ufbx_free_baked_anim(bake);
+	ufbx_free_baked_anim(ref);
+
+	return num_keys;
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_error_bounded_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	size_t num_keys = ufbxt_check_error_bounded_reduction(err, scene, false);
+	size_t num_hierarchy_keys = ufbxt_check_error_bounded_reduction(err, scene, true);
+	ufbxt_assert(num_hierarchy_keys > num_keys);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_error_bounded_diffuse_curve, maya_anim_diffuse_curve)
+#if UFBXT_IMPL
+{
+	ufbxt_check_error_bounded_reduction(err, scene, false);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_error_bounded_pivot_rotate, maya_anim_pivot_rotate)
+#if UFBXT_IMPL
+{
+	ufbxt_check_error_bounded_reduction(err, scene, false);
+
+	ufbx_bake_opts opts = { 0 };
+	opts.resample_rate = 24.0;
+	opts.key_reduction_enabled = true;
+	opts.key_reduction_rotation = true;
+	opts.key_reduction_mode = UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED;
+
+	ufbx_error error;
+	ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, &opts, &error);
+	if (!bake) ufbxt_log_error(&error);
+	ufbxt_assert(bake);
+
+	// Constant speed rotation reduces to the end keys, but the arc traced by the
+	// translation needs all the keys with the default tolerance.
+	ufbxt_assert(bake->nodes.count == 1);
+	ufbx_baked_node *node = &bake->nodes.data[0];
+	ufbxt_assert(node->rotation_keys.count == 2);
+	ufbxt_assert(node->translation_keys.count == 7);
+	ufbxt_assert(node->constant_scale);
+	ufbxt_assert(node->scale_keys.count == 2);
+
+	ufbx_free_baked_anim(bake);
+}
+#endif
@@ -166,68 +166,6 @@ UFBXT_TEST(thread_memory)
 }
 #endif
 
-#if UFBXT_IMPL
-typedef struct {
-	bool immediate;
-	bool initialized;
-	bool freed;
-	uint32_t wait_index;
-	uint32_t dispatches;
-} ufbxt_single_thread_pool;
-
-static bool ufbxt_single_thread_pool_init_fn(void *user, ufbx_thread_pool_context ctx, const ufbx_thread_pool_info *info)
-{
-	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
-	pool->initialized = true;
-
-	return true;
-}
-
-static void ufbxt_single_thread_pool_run_fn(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t start_index, uint32_t count)
-{
-	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
-	ufbxt_assert(pool->initialized);
-	pool->dispatches++;
-	if (!pool->immediate) return;
-
-	for (uint32_t i = 0; i < count; i++) {
-		ufbx_thread_pool_run_task(ctx, start_index + i);
-	}
-}
-
-static void ufbxt_single_thread_pool_wait_fn(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t max_index)
-{
-	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
-	ufbxt_assert(pool->initialized);
-
-	if (!pool->immediate) {
-		for (uint32_t i = pool->wait_index; i < max_index; i++) {
-			ufbx_thread_pool_run_task(ctx, i);
-		}
-	}
-
-	pool->wait_index = max_index;
-}
-
-static void ufbxt_single_thread_pool_free_fn(void *user, ufbx_thread_pool_context ctx)
-{
-	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
-	pool->freed = true;
-}
-
-static void ufbxt_single_thread_pool_init(ufbx_thread_pool *dst, ufbxt_single_thread_pool *pool, bool immediate)
-{
-	memset(pool, 0, sizeof(ufbxt_single_thread_pool));
-	pool->immediate = immediate;
-
-	dst->init_fn = ufbxt_single_thread_pool_init_fn;
-	dst->run_fn = ufbxt_single_thread_pool_run_fn;
-	dst->wait_fn = ufbxt_single_thread_pool_wait_fn;
-	dst->free_fn = ufbxt_single_thread_pool_free_fn;
-	dst->user = pool;
-}
-#endif
-
 #if UFBXT_IMPL
 static bool ufbxt_is_big_endian()
 {
@@ -364,6 +302,152 @@ UFBXT_TEST(single_thread_deferred_memory)
 }
 #endif
 
+#if UFBXT_IMPL
+static void ufbxt_check_same_meshes(ufbx_scene *a, ufbx_scene *b)
+{
+	ufbxt_assert(a->meshes.count == b->meshes.count);
+	for (size_t i = 0; i < a->meshes.count; i++) {
+		ufbx_mesh *ma = a->meshes.data[i], *mb = b->meshes.data[i];
+		ufbxt_assert(ma->num_vertices == mb->num_vertices);
+		ufbxt_assert(ma->num_indices == mb->num_indices);
+		ufbxt_assert(!memcmp(ma->vertices.data, mb->vertices.data, ma->num_vertices * sizeof(ufbx_vec3)));
+		ufbxt_assert(!memcmp(ma->vertex_indices.data, mb->vertex_indices.data, ma->num_indices * sizeof(uint32_t)));
+	}
+}
+#endif
+
+UFBXT_TEST(single_thread_indexed_ascii_memory)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_slime" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		if (!strstr(path, "_ascii")) continue;
+
+		size_t size = 0;
+		char *data = (char*)ufbxt_read_file(path, &size);
+		ufbxt_assert(data);
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_memory(data, size, NULL, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		for (int corrupt = 0; corrupt <= 1; corrupt++) {
+			if (corrupt) {
+				// Misreport the size of the first vertex array, should fall back to serial parsing
+				char *count = strstr(data, "Vertices: *");
+				ufbxt_assert(count);
+				count += strlen("Vertices: *");
+				ufbxt_assert(*count >= '1' && *count <= '8');
+				*count += 1;
+			}
+
+			for (int immediate = 0; immediate <= 1; immediate++) {
+				ufbxt_single_thread_pool pool;
+				ufbx_load_opts opts = { 0 };
+				ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate != 0);
+
+				ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+				if (!scene) ufbxt_log_error(&error);
+				ufbxt_assert(scene);
+				ufbxt_assert(pool.initialized && pool.freed);
+				ufbxt_assert(pool.dispatches > 0);
+
+				ufbxt_check_scene(scene);
+				ufbxt_check_same_meshes(scene, ref);
+				ufbx_free_scene(scene);
+			}
+		}
+
+		ufbx_free_scene(ref);
+		free(data);
+	}
+}
+#endif
+
+UFBXT_TEST(single_thread_indexed_ascii_comment)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_slime" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		if (!strstr(path, "_ascii")) continue;
+
+		size_t src_size = 0;
+		char *src = (char*)ufbxt_read_file(path, &src_size);
+		ufbxt_assert(src);
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_memory(src, src_size, NULL, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		// Insert a comment full of commas in the middle of the first vertex array.
+		// The comment is longer than the rest of the file, so at least one index
+		// chunk boundary lands within it regardless of the chunk size.
+		char *values = strstr(src, "Vertices: *");
+		ufbxt_assert(values);
+		values = strstr(values, "a: ");
+		ufbxt_assert(values);
+		char *values_end = strchr(values, '}');
+		ufbxt_assert(values_end);
+		char *split = values + (values_end - values) / 2;
+		while (*split != ',') split++;
+		split++;
+		ufbxt_assert(split < values_end);
+
+		for (int dense = 0; dense <= 1; dense++) {
+			// Optionally append empty nodes to overflow the initial brace buffers
+			const char comment_line[] = " ; comment, with, commas";
+			const char dense_line[] = "E: {}\n";
+			size_t dense_size = dense ? src_size : 0;
+			size_t comment_size = src_size + dense_size + 4096;
+			size_t prefix_size = (size_t)(split - src);
+			size_t size = src_size + comment_size + dense_size + 2;
+			char *data = (char*)malloc(size);
+			ufbxt_assert(data);
+
+			char *dst = data;
+			memcpy(dst, src, prefix_size);
+			dst += prefix_size;
+			*dst++ = '\n';
+			for (size_t i = 0; i < comment_size; i++) {
+				*dst++ = comment_line[i % (sizeof(comment_line) - 1)];
+			}
+			*dst++ = '\n';
+			memcpy(dst, split, src_size - prefix_size);
+			dst += src_size - prefix_size;
+			for (size_t i = 0; i < dense_size; i++) {
+				*dst++ = dense_line[i % (sizeof(dense_line) - 1)];
+			}
+			ufbxt_assert(dst == data + size);
+
+			for (int immediate = 0; immediate <= 1; immediate++) {
+				ufbxt_single_thread_pool pool;
+				ufbx_load_opts opts = { 0 };
+				ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate != 0);
+
+				ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+				if (!scene) ufbxt_log_error(&error);
+				ufbxt_assert(scene);
+				ufbxt_assert(pool.initialized && pool.freed);
+				ufbxt_assert(pool.dispatches > 0);
+
+				ufbxt_check_scene(scene);
+				ufbxt_check_same_meshes(scene, ref);
+				ufbx_free_scene(scene);
+			}
+
+			free(data);
+		}
+
+		ufbx_free_scene(ref);
+		free(src);
+	}
+}
+#endif
+
 UFBXT_TEST(thread_memory_limit)
 #if UFBXT_IMPL
 {
@@ -407,6 +491,95 @@ UFBXT_TEST(thread_memory_limit)
 }
 #endif
 
+#if UFBXT_IMPL
+static void ufbxt_check_same_mesh_topology(ufbx_scene *a, ufbx_scene *b)
+{
+	ufbxt_assert(a->meshes.count == b->meshes.count);
+	for (size_t i = 0; i < a->meshes.count; i++) {
+		ufbx_mesh *ma = a->meshes.data[i], *mb = b->meshes.data[i];
+		ufbxt_assert(ma->num_faces == mb->num_faces);
+		ufbxt_assert(ma->num_triangles == mb->num_triangles);
+		ufbxt_assert(ma->num_empty_faces == mb->num_empty_faces);
+		ufbxt_assert(ma->num_point_faces == mb->num_point_faces);
+		ufbxt_assert(ma->num_line_faces == mb->num_line_faces);
+		ufbxt_assert(ma->max_face_triangles == mb->max_face_triangles);
+		ufbxt_assert(ma->num_indices == mb->num_indices);
+		if (ma->num_faces > 0) {
+			ufbxt_assert(!memcmp(ma->faces.data, mb->faces.data, ma->num_faces * sizeof(ufbx_face)));
+		}
+		if (ma->num_indices > 0) {
+			ufbxt_assert(!memcmp(ma->vertex_indices.data, mb->vertex_indices.data, ma->num_indices * sizeof(uint32_t)));
+		}
+
+		const ufbx_vertex_vec3 *attribs_a[] = { &ma->vertex_normal, &ma->vertex_tangent, &ma->vertex_bitangent };
+		const ufbx_vertex_vec3 *attribs_b[] = { &mb->vertex_normal, &mb->vertex_tangent, &mb->vertex_bitangent };
+		for (size_t j = 0; j < ufbxt_arraycount(attribs_a); j++) {
+			ufbxt_assert(attribs_a[j]->exists == attribs_b[j]->exists);
+			ufbxt_assert(attribs_a[j]->indices.count == attribs_b[j]->indices.count);
+			if (attribs_a[j]->indices.count > 0) {
+				ufbxt_assert(!memcmp(attribs_a[j]->indices.data, attribs_b[j]->indices.data, attribs_a[j]->indices.count * sizeof(uint32_t)));
+			}
+		}
+
+		ufbxt_assert(ma->uv_sets.count == mb->uv_sets.count);
+		for (size_t j = 0; j < ma->uv_sets.count; j++) {
+			const ufbx_vertex_vec2 *uv_a = &ma->uv_sets.data[j].vertex_uv;
+			const ufbx_vertex_vec2 *uv_b = &mb->uv_sets.data[j].vertex_uv;
+			ufbxt_assert(uv_a->indices.count == uv_b->indices.count);
+			if (uv_a->indices.count > 0) {
+				ufbxt_assert(!memcmp(uv_a->indices.data, uv_b->indices.data, uv_a->indices.count * sizeof(uint32_t)));
+			}
+		}
+	}
+}
+#endif
+
+UFBXT_TEST(threaded_index_stats)
+#if UFBXT_IMPL
+{
+	// Index arrays decoded in tasks skip the serial counting in `ufbxi_read_mesh()`,
+	// compare the results to a single threaded load where the counts are computed serially.
+	const char *names[] = {
+		"maya_ngon_maze",
+		"blender_300_ngon_big",
+		"zbrush_polygroup_mess",
+		"blender_293_barbarian",
+		"maya_slime",
+	};
+
+	for (size_t name_ix = 0; name_ix < ufbxt_arraycount(names); name_ix++) {
+		char path[512];
+		ufbxt_file_iterator iter = { names[name_ix] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			size_t size = 0;
+			void *data = ufbxt_read_file(path, &size);
+			ufbxt_assert(data);
+
+			ufbx_error error;
+			ufbx_scene *ref = ufbx_load_memory(data, size, NULL, &error);
+			if (!ref) ufbxt_log_error(&error);
+			ufbxt_assert(ref);
+
+			ufbxt_single_thread_pool pool;
+			ufbx_load_opts opts = { 0 };
+			ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, false);
+
+			ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+			if (!scene) ufbxt_log_error(&error);
+			ufbxt_assert(scene);
+			ufbxt_assert(pool.initialized && pool.freed);
+
+			ufbxt_check_scene(scene);
+			ufbxt_check_same_mesh_topology(scene, ref);
+
+			ufbx_free_scene(scene);
+			ufbx_free_scene(ref);
+			free(data);
+		}
+	}
+}
+#endif
+
 UFBXT_TEST(single_thread_file_not_found)
 #if UFBXT_IMPL
 {
@@ -426,6 +599,606 @@ UFBXT_TEST(single_thread_file_not_found)
 }
 #endif
 
+#if UFBXT_IMPL
+typedef struct {
+	const char *name;
+	size_t num_checked;
+	size_t num_mapped;
+} ufbxt_mapped_file_progress;
+
+// Look for the file being loaded in `/proc/self/maps` during progress reports
+static ufbx_progress_result ufbxt_mapped_file_progress_fn(void *user, const ufbx_progress *progress)
+{
+	(void)progress;
+	ufbxt_mapped_file_progress *p = (ufbxt_mapped_file_progress*)user;
+	FILE *f = fopen("/proc/self/maps", "r");
+	if (!f) return UFBX_PROGRESS_CONTINUE;
+
+	char line[1024];
+	bool mapped = false;
+	while (fgets(line, sizeof(line), f)) {
+		if (strstr(line, p->name)) mapped = true;
+	}
+	fclose(f);
+
+	p->num_checked++;
+	if (mapped) p->num_mapped++;
+	return UFBX_PROGRESS_CONTINUE;
+}
+
+static void ufbxt_do_map_main_file_test(const char *name, bool threaded)
+{
+	char path[512];
+	ufbxt_file_iterator iter = { name };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbxt_single_thread_pool pool;
+		ufbx_load_opts opts = { 0 };
+		if (threaded) {
+			ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, true);
+		}
+
+		const char *file_name = strrchr(path, '/');
+		ufbxt_mapped_file_progress progress = { file_name ? file_name + 1 : path };
+		opts.progress_cb.fn = &ufbxt_mapped_file_progress_fn;
+		opts.progress_cb.user = &progress;
+		opts.progress_interval_hint = 1;
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_file(path, &opts, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+		ufbxt_assert(progress.num_mapped == 0);
+
+		opts.map_main_file = true;
+		ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+		ufbxt_check_scene(scene);
+
+		// Memory mapping is implemented on Linux, check that the file was actually mapped
+		// if we can read `/proc/self/maps`.
+		#if defined(__linux__) && !defined(UFBX_NO_MMAP) && !defined(UFBX_STANDARD_C)
+			if (progress.num_checked > 0) {
+				ufbxt_assert(progress.num_mapped > 0);
+			}
+		#endif
+
+		ufbxt_assert(scene->metadata.file_format == ref->metadata.file_format);
+		ufbxt_assert(scene->elements.count == ref->elements.count);
+		ufbxt_assert(scene->meshes.count == ref->meshes.count);
+		for (size_t i = 0; i < scene->meshes.count; i++) {
+			ufbx_mesh *mesh = scene->meshes.data[i];
+			ufbx_mesh *ref_mesh = ref->meshes.data[i];
+			ufbxt_assert(mesh->num_indices == ref_mesh->num_indices);
+			ufbxt_assert(mesh->num_vertices == ref_mesh->num_vertices);
+			ufbxt_assert(!memcmp(mesh->vertex_indices.data, ref_mesh->vertex_indices.data, mesh->num_indices * sizeof(uint32_t)));
+			ufbxt_assert(!memcmp(mesh->vertices.data, ref_mesh->vertices.data, mesh->num_vertices * sizeof(ufbx_vec3)));
+		}
+
+		ufbx_free_scene(scene);
+		ufbx_free_scene(ref);
+	}
+}
+#endif
+
+UFBXT_TEST(map_main_file)
+#if UFBXT_IMPL
+{
+	ufbxt_do_map_main_file_test("blender_293_barbarian", false);
+	ufbxt_do_map_main_file_test("blender_279_ball", false);
+}
+#endif
+
+UFBXT_TEST(map_main_file_threaded)
+#if UFBXT_IMPL
+{
+	ufbxt_do_map_main_file_test("blender_293_barbarian", true);
+	ufbxt_do_map_main_file_test("blender_279_ball", true);
+}
+#endif
+
+UFBXT_TEST(map_main_file_not_found)
+#if UFBXT_IMPL
+{
+	ufbx_load_opts opts = { 0 };
+	opts.map_main_file = true;
+
+	ufbx_error error;
+	ufbx_scene *scene = ufbx_load_file("<doesnotexist>.fbx", &opts, &error);
+	ufbxt_assert(!scene);
+	ufbxt_assert(error.type == UFBX_ERROR_FILE_NOT_FOUND);
+	ufbxt_assert(strstr(error.info, "<doesnotexist>.fbx"));
+}
+#endif
+
+#if UFBXT_IMPL
+// Corrupt the Adler-32 checksum of the first DEFLATE compressed array of at least
+// `min_encoded_size` bytes in a binary FBX file
+static bool ufbxt_corrupt_deflate_checksum(char *data, size_t size, size_t min_encoded_size)
+{
+	if (size < 32 || memcmp(data, "Kaydara FBX Binary", 18) != 0) return false;
+	for (size_t i = 27; i + 14 < size; i++) {
+		if (!strchr("fdilb", data[i]) || data[i] == '\0') continue;
+		uint32_t encoding = (uint32_t)(uint8_t)data[i + 5] | (uint32_t)(uint8_t)data[i + 6] << 8;
+		uint32_t encoded_size = (uint32_t)(uint8_t)data[i + 9] | (uint32_t)(uint8_t)data[i + 10] << 8 | (uint32_t)(uint8_t)data[i + 11] << 16;
+		if (encoding != 1 || (uint8_t)data[i + 13] != 0x78 || encoded_size < 8 || encoded_size > size - i - 13) continue;
+		if (encoded_size < min_encoded_size) continue;
+		data[i + 13 + encoded_size - 1] ^= 0x1;
+		return true;
+	}
+	return false;
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_do_skip_deflate_checksum_test(const char *name, bool threaded)
+{
+	char path[512];
+	ufbxt_file_iterator iter = { name };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		size_t size;
+		char *data = (char*)ufbxt_read_file(path, &size);
+		ufbxt_assert(data);
+
+		// Small arrays are decoded inline even when threaded, corrupt a large one
+		if (ufbxt_corrupt_deflate_checksum(data, size, threaded ? 0x1000 : 0)) {
+			ufbxt_single_thread_pool pool;
+			ufbx_load_opts opts = { 0 };
+			if (threaded) {
+				ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, false);
+			}
+
+			ufbx_error error;
+			ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+			ufbxt_assert(!scene);
+			ufbxt_assert(error.type == UFBX_ERROR_UNKNOWN);
+
+			opts.skip_deflate_checksum = true;
+			scene = ufbx_load_memory(data, size, &opts, &error);
+			if (!scene) ufbxt_log_error(&error);
+			ufbxt_assert(scene);
+			ufbxt_check_scene(scene);
+			ufbx_free_scene(scene);
+			if (threaded) {
+				ufbxt_assert(pool.initialized && pool.freed);
+				ufbxt_assert(pool.dispatches > 0);
+			}
+		}
+
+		free(data);
+	}
+}
+#endif
+
+UFBXT_TEST(skip_deflate_checksum)
+#if UFBXT_IMPL
+{
+	ufbxt_do_skip_deflate_checksum_test("blender_279_ball", false);
+}
+#endif
+
+UFBXT_TEST(skip_deflate_checksum_threaded)
+#if UFBXT_IMPL
+{
+	ufbxt_do_skip_deflate_checksum_test("blender_293_barbarian", true);
+}
+#endif
+
+#if UFBXT_IMPL
+typedef struct {
+	ufbx_scene *ref;
+	size_t num_meshes;
+	size_t cancel_at;
+} ufbxt_mesh_stream_ctx;
+
+static bool ufbxt_stream_mesh_cb(void *user, ufbx_mesh *mesh)
+{
+	ufbxt_mesh_stream_ctx *ctx = (ufbxt_mesh_stream_ctx*)user;
+	if (++ctx->num_meshes == ctx->cancel_at) return false;
+
+	ufbxt_assert(mesh->element_id < ctx->ref->elements.count);
+	ufbx_mesh *ref_mesh = ufbx_as_mesh(ctx->ref->elements.data[mesh->element_id]);
+	ufbxt_assert(ref_mesh);
+	ufbxt_assert(mesh->num_vertices == ref_mesh->num_vertices);
+	ufbxt_assert(mesh->num_indices == ref_mesh->num_indices);
+	ufbxt_assert(mesh->num_faces == ref_mesh->num_faces);
+	ufbxt_assert(mesh->uv_sets.count == ref_mesh->uv_sets.count);
+	ufbxt_assert(!memcmp(mesh->vertices.data, ref_mesh->vertices.data, mesh->num_vertices * sizeof(ufbx_vec3)));
+	ufbxt_assert(!memcmp(mesh->vertex_indices.data, ref_mesh->vertex_indices.data, mesh->num_indices * sizeof(uint32_t)));
+
+	ufbxt_diff_error err = { 0 };
+	for (size_t i = 0; i < mesh->num_indices; i++) {
+		ufbxt_assert_close_vec3(&err, ufbx_get_vertex_vec3(&mesh->vertex_position, i), ufbx_get_vertex_vec3(&ref_mesh->vertex_position, i));
+		if (mesh->vertex_normal.exists) {
+			ufbxt_assert_close_vec3(&err, ufbx_get_vertex_vec3(&mesh->vertex_normal, i), ufbx_get_vertex_vec3(&ref_mesh->vertex_normal, i));
+		}
+		if (mesh->vertex_uv.exists) {
+			ufbxt_assert_close_vec2(&err, ufbx_get_vertex_vec2(&mesh->vertex_uv, i), ufbx_get_vertex_vec2(&ref_mesh->vertex_uv, i));
+		}
+	}
+
+	return true;
+}
+
+static void ufbxt_do_mesh_stream_test(const char *name, bool threaded)
+{
+	char path[512];
+	ufbxt_file_iterator iter = { name };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		if (!strstr(path, ".fbx")) continue;
+
+		ufbxt_single_thread_pool pool;
+		ufbx_load_opts opts = { 0 };
+		if (threaded) {
+			ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, true);
+		}
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_file(path, &opts, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		ufbxt_mesh_stream_ctx ctx = { ref };
+		opts.mesh_cb.fn = &ufbxt_stream_mesh_cb;
+		opts.mesh_cb.user = &ctx;
+
+		ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+		ufbxt_check_scene(scene);
+
+		ufbxt_assert(ctx.num_meshes == ref->meshes.count);
+		ufbxt_assert(scene->meshes.count == ref->meshes.count);
+		for (size_t i = 0; i < scene->meshes.count; i++) {
+			ufbx_mesh *mesh = scene->meshes.data[i];
+			ufbxt_assert(mesh->num_vertices == 0);
+			ufbxt_assert(mesh->num_indices == 0);
+			ufbxt_assert(mesh->instances.count == ref->meshes.data[i]->instances.count);
+		}
+
+		ufbx_free_scene(scene);
+
+		if (ref->meshes.count > 0) {
+			ufbxt_mesh_stream_ctx cancel_ctx = { ref };
+			cancel_ctx.cancel_at = ref->meshes.count;
+			opts.mesh_cb.user = &cancel_ctx;
+
+			scene = ufbx_load_file(path, &opts, &error);
+			ufbxt_assert(!scene);
+			ufbxt_assert(error.type == UFBX_ERROR_CANCELLED);
+		}
+
+		ufbx_free_scene(ref);
+	}
+}
+#endif
+
+UFBXT_TEST(mesh_stream)
+#if UFBXT_IMPL
+{
+	ufbxt_do_mesh_stream_test("blender_293_barbarian", false);
+	ufbxt_do_mesh_stream_test("maya_cube", false);
+	ufbxt_do_mesh_stream_test("maya_node_attribute_zoo", false);
+}
+#endif
+
+UFBXT_TEST(mesh_stream_threaded)
+#if UFBXT_IMPL
+{
+	ufbxt_do_mesh_stream_test("blender_293_barbarian", true);
+	ufbxt_do_mesh_stream_test("maya_cube", true);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_evaluate_skinning_threaded(ufbx_scene *scene, ufbxt_diff_error *err, double time)
+{
+	ufbx_evaluate_opts ref_opts = { 0 };
+	ref_opts.evaluate_skinning = true;
+	ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, time, &ref_opts, NULL);
+	ufbxt_assert(ref);
+
+	// Compare against skinning each vertex separately
+	for (size_t mesh_ix = 0; mesh_ix < ref->meshes.count; mesh_ix++) {
+		ufbx_mesh *mesh = ref->meshes.data[mesh_ix];
+		if (mesh->skin_deformers.count == 0 || mesh->blend_deformers.count > 0) continue;
+		ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
+		ufbx_matrix *fallback = mesh->instances.count > 0 ? &mesh->instances.data[0]->geometry_to_world : NULL;
+		for (size_t i = 0; i < mesh->num_vertices; i++) {
+			ufbx_matrix mat = ufbx_get_skin_vertex_matrix(skin, i, fallback);
+			ufbx_vec3 pos = ufbx_transform_position(&mat, mesh->vertices.data[i]);
+			ufbxt_assert_close_vec3(err, mesh->skinned_position.values.data[i], pos);
+		}
+	}
+
+	for (int immediate = 0; immediate <= 1; immediate++) {
+		ufbxt_single_thread_pool pool;
+		ufbx_evaluate_opts opts = { 0 };
+		opts.evaluate_skinning = true;
+		ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate != 0);
+
+		ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, time, &opts, NULL);
+		ufbxt_assert(state);
+		ufbxt_assert(pool.initialized && pool.freed);
+
+		ufbxt_assert(state->meshes.count == ref->meshes.count);
+		for (size_t mesh_ix = 0; mesh_ix < ref->meshes.count; mesh_ix++) {
+			ufbx_mesh *ref_mesh = ref->meshes.data[mesh_ix];
+			ufbx_mesh *mesh = state->meshes.data[mesh_ix];
+			ufbxt_assert(mesh->skinned_position.values.count == ref_mesh->skinned_position.values.count);
+			if (ref_mesh->skinned_position.values.count > 0) {
+				ufbxt_assert(!memcmp(mesh->skinned_position.values.data, ref_mesh->skinned_position.values.data,
+					ref_mesh->skinned_position.values.count * sizeof(ufbx_vec3)));
+			}
+			ufbxt_assert(mesh->skinned_normal.values.count == ref_mesh->skinned_normal.values.count);
+			if (ref_mesh->skinned_normal.values.count > 0) {
+				ufbxt_assert(!memcmp(mesh->skinned_normal.values.data, ref_mesh->skinned_normal.values.data,
+					ref_mesh->skinned_normal.values.count * sizeof(ufbx_vec3)));
+			}
+		}
+
+		ufbx_free_scene(state);
+	}
+
+	ufbx_free_scene(ref);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_skinning_threaded, maya_dq_weights)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_skinning_threaded(scene, err, 10.0/24.0);
+	ufbxt_check_evaluate_skinning_threaded(scene, err, 18.0/24.0);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_skinning_threaded_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_skinning_threaded(scene, err, 0.5);
+}
+#endif
+
+#if UFBXT_IMPL
+// Generate an ASCII FBX file with a single mesh of `num_vertices` vertices skinned to two
+// rotated bones, with a mix of linear and dual quaternion weights.
+static char *ufbxt_generate_skinned_fbx(size_t num_vertices, size_t *p_size)
+{
+	size_t cap = num_vertices * 160 + 4096, size = 0;
+	char *data = (char*)malloc(cap);
+	ufbxt_assert(data);
+
+	size_t num_triangles = num_vertices / 3;
+	size_t num_weights1 = 0, num_dq = 0;
+	for (size_t i = 0; i < num_vertices; i++) {
+		if (i % 3 != 0) num_weights1++;
+		if (i % 2 == 0) num_dq++;
+	}
+
+	size += (size_t)sprintf(data + size,
+		"; FBX 7.5.0 project file\n"
+		"FBXHeaderExtension:  {\n\tFBXHeaderVersion: 1003\n\tFBXVersion: 7500\n}\n"
+		"Objects:  {\n"
+		"\tGeometry: 1, \"Geometry::Mesh\", \"Mesh\" {\n"
+		"\t\tVertices: *%zu {\n\t\t\ta: ", num_vertices * 3);
+	for (size_t i = 0; i < num_vertices; i++) {
+		size += (size_t)sprintf(data + size, "%s%d,%d,%d", i > 0 ? "," : "", (int)(i % 37) - 18, (int)(i / 37 % 41) - 20, (int)(i % 13));
+	}
+	size += (size_t)sprintf(data + size, "\n\t\t}\n\t\tPolygonVertexIndex: *%zu {\n\t\t\ta: ", num_triangles * 3);
+	for (size_t i = 0; i < num_triangles; i++) {
+		size += (size_t)sprintf(data + size, "%s%zu,%zu,%d", i > 0 ? "," : "", i * 3, i * 3 + 1, -(int)(i * 3 + 2) - 1);
+	}
+	size += (size_t)sprintf(data + size, "\n\t\t}\n\t}\n"
+		"\tModel: 2, \"Model::Mesh\", \"Mesh\" {\n\t}\n"
+		"\tModel: 3, \"Model::Bone0\", \"LimbNode\" {\n\t\tProperties70:  {\n"
+		"\t\t\tP: \"Lcl Rotation\", \"Lcl Rotation\", \"\", \"A\",30,0,10\n\t\t}\n\t}\n"
+		"\tModel: 4, \"Model::Bone1\", \"LimbNode\" {\n\t\tProperties70:  {\n"
+		"\t\t\tP: \"Lcl Translation\", \"Lcl Translation\", \"\", \"A\",0,5,0\n"
+		"\t\t\tP: \"Lcl Rotation\", \"Lcl Rotation\", \"\", \"A\",0,-160,45\n"
+		"\t\t\tP: \"Lcl Scaling\", \"Lcl Scaling\", \"\", \"A\",1,2,1\n\t\t}\n\t}\n"
+		"\tDeformer: 5, \"Deformer::Skin\", \"Skin\" {\n"
+		"\t\tSkinningType: \"Blend\"\n"
+		"\t\tIndexes: *%zu {\n\t\t\ta: ", num_dq);
+	for (size_t i = 0; i < num_vertices; i += 2) {
+		size += (size_t)sprintf(data + size, "%s%zu", i > 0 ? "," : "", i);
+	}
+	size += (size_t)sprintf(data + size, "\n\t\t}\n\t\tBlendWeights: *%zu {\n\t\t\ta: ", num_dq);
+	for (size_t i = 0; i < num_vertices; i += 2) {
+		size += (size_t)sprintf(data + size, "%s%.2f", i > 0 ? "," : "", (double)(i % 5) * 0.25);
+	}
+	size += (size_t)sprintf(data + size, "\n\t\t}\n\t}\n");
+
+	for (int cluster = 0; cluster < 2; cluster++) {
+		size += (size_t)sprintf(data + size,
+			"\tDeformer: %d, \"SubDeformer::Cluster%d\", \"Cluster\" {\n"
+			"\t\tIndexes: *%zu {\n\t\t\ta: ", 6 + cluster, cluster, cluster == 0 ? num_vertices : num_weights1);
+		bool first = true;
+		for (size_t i = 0; i < num_vertices; i++) {
+			if (cluster == 1 && i % 3 == 0) continue;
+			size += (size_t)sprintf(data + size, "%s%zu", first ? "" : ",", i);
+			first = false;
+		}
+		size += (size_t)sprintf(data + size, "\n\t\t}\n\t\tWeights: *%zu {\n\t\t\ta: ", cluster == 0 ? num_vertices : num_weights1);
+		first = true;
+		for (size_t i = 0; i < num_vertices; i++) {
+			if (cluster == 1 && i % 3 == 0) continue;
+			double weight = (double)(i % 7) / 6.0;
+			size += (size_t)sprintf(data + size, "%s%.3f", first ? "" : ",", cluster == 0 ? weight : 1.0 - weight);
+			first = false;
+		}
+		size += (size_t)sprintf(data + size, "\n\t\t}\n"
+			"\t\tTransform: *16 {\n\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1\n\t\t}\n"
+			"\t\tTransformLink: *16 {\n\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,%d,0,1\n\t\t}\n\t}\n", cluster * 5);
+	}
+
+	size += (size_t)sprintf(data + size, "}\n"
+		"Connections:  {\n"
+		"\tC: \"OO\",2,0\n\tC: \"OO\",1,2\n\tC: \"OO\",3,0\n\tC: \"OO\",4,3\n"
+		"\tC: \"OO\",5,1\n\tC: \"OO\",6,5\n\tC: \"OO\",7,5\n\tC: \"OO\",3,6\n\tC: \"OO\",4,7\n"
+		"}\n");
+	ufbxt_assert(size < cap);
+
+	*p_size = size;
+	return data;
+}
+#endif
+
+UFBXT_TEST(evaluate_skinning_threaded_chunks)
+#if UFBXT_IMPL
+{
+	// Enough vertices to be split into several skinning tasks
+	size_t num_vertices = 3 * 0x4000 + 100;
+	size_t size;
+	char *data = ufbxt_generate_skinned_fbx(num_vertices, &size);
+
+	ufbx_error error;
+	ufbx_scene *scene = ufbx_load_memory(data, size, NULL, &error);
+	if (!scene) ufbxt_log_error(&error);
+	ufbxt_assert(scene);
+	free(data);
+
+	ufbxt_assert(scene->meshes.count == 1);
+	ufbx_mesh *mesh = scene->meshes.data[0];
+	ufbxt_assert(mesh->num_vertices == num_vertices);
+	ufbxt_assert(mesh->skin_deformers.count == 1);
+	ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
+	ufbxt_assert(skin->clusters.count == 2);
+	ufbxt_assert(skin->skinning_method == UFBX_SKINNING_METHOD_BLENDED_DQ_LINEAR);
+	ufbxt_assert(skin->num_dq_weights == (num_vertices + 1) / 2);
+
+	ufbxt_diff_error err = { 0 };
+	ufbxt_check_evaluate_skinning_threaded(scene, &err, 0.0);
+	ufbxt_logf(".. Absolute diff: avg %.3g, max %.3g (%zu tests)", err.sum / (ufbx_real)err.num, err.max, err.num);
+
+	// Make sure the mesh was actually split into tasks
+	ufbxt_single_thread_pool pool;
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, false);
+	ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 0.0, &opts, NULL);
+	ufbxt_assert(state);
+	ufbxt_assert(pool.dispatches > 0);
+	ufbxt_assert(memcmp(state->meshes.data[0]->skinned_position.values.data, mesh->vertices.data, num_vertices * sizeof(ufbx_vec3)) != 0);
+	ufbx_free_scene(state);
+
+	ufbx_free_scene(scene);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_evaluate_cache(ufbx_scene *scene, double time)
+{
+	ufbx_evaluate_opts ref_opts = { 0 };
+	ref_opts.evaluate_skinning = true;
+	ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, time, &ref_opts, NULL);
+	ufbxt_assert(ref);
+
+	ufbx_error error;
+	ufbx_evaluate_cache *cache = ufbx_create_evaluate_cache(scene, NULL, &error);
+	if (!cache) ufbxt_log_error(&error);
+	ufbxt_assert(cache);
+	ufbxt_assert(cache->scene == scene);
+	ufbxt_assert(cache->num_meshes > 0);
+
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	opts.cache = cache;
+
+	for (int round = 0; round < 2; round++) {
+		ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, time, &opts, NULL);
+		ufbxt_assert(state);
+
+		ufbxt_assert(state->meshes.count == ref->meshes.count);
+		for (size_t mesh_ix = 0; mesh_ix < ref->meshes.count; mesh_ix++) {
+			ufbx_mesh *ref_mesh = ref->meshes.data[mesh_ix];
+			ufbx_mesh *mesh = state->meshes.data[mesh_ix];
+			ufbxt_assert(mesh->skinned_normal.values.count == ref_mesh->skinned_normal.values.count);
+			ufbxt_assert(mesh->skinned_normal.indices.count == ref_mesh->skinned_normal.indices.count);
+			if (ref_mesh->skinned_normal.values.count > 0) {
+				ufbxt_assert(!memcmp(mesh->skinned_normal.values.data, ref_mesh->skinned_normal.values.data,
+					ref_mesh->skinned_normal.values.count * sizeof(ufbx_vec3)));
+			}
+			if (ref_mesh->skinned_normal.indices.count > 0) {
+				ufbxt_assert(!memcmp(mesh->skinned_normal.indices.data, ref_mesh->skinned_normal.indices.data,
+					ref_mesh->skinned_normal.indices.count * sizeof(uint32_t)));
+			}
+		}
+
+		ufbx_free_scene(state);
+	}
+
+	ufbx_free_evaluate_cache(cache);
+	ufbx_free_scene(ref);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_cache_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_cache(scene, 0.5);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_cache_dq_weights, maya_dq_weights)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_cache(scene, 10.0/24.0);
+}
+#endif
+
+UFBXT_TEST(evaluate_cache_wrong_scene)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_cube" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_scene *scene = ufbx_load_file(path, NULL, NULL);
+		ufbxt_assert(scene);
+		ufbx_scene *other = ufbx_load_file(path, NULL, NULL);
+		ufbxt_assert(other);
+
+		ufbx_evaluate_cache *cache = ufbx_create_evaluate_cache(scene, NULL, NULL);
+		ufbxt_assert(cache);
+		ufbxt_assert(cache->num_meshes == 0);
+
+		ufbx_evaluate_opts opts = { 0 };
+		opts.evaluate_skinning = true;
+		opts.cache = cache;
+
+		ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 0.0, &opts, NULL);
+		ufbxt_assert(state);
+		ufbx_free_scene(state);
+
+		ufbx_error error;
+		state = ufbx_evaluate_scene(other, NULL, 0.0, &opts, &error);
+		ufbxt_assert(!state);
+		ufbxt_assert(error.type != UFBX_ERROR_NONE);
+
+		ufbx_free_evaluate_cache(cache);
+		ufbx_free_scene(other);
+		ufbx_free_scene(scene);
+	}
+}
+#endif
+
+UFBXT_TEST(cache_playback_threaded)
+#if UFBXT_IMPL
+{
+	for (int immediate = 0; immediate <= 1; immediate++) {
+		for (size_t prefetch_frames = 1; prefetch_frames <= 8; prefetch_frames *= 2) {
+			ufbxt_single_thread_pool pool;
+			ufbx_cache_playback_opts opts = { 0 };
+			opts.prefetch_frames = prefetch_frames;
+			ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate != 0);
+
+			ufbxt_check_cache_playback("caches/sine_mxmd_oversample/cache.xml", &opts);
+			ufbxt_assert(pool.initialized && pool.freed);
+			ufbxt_assert(pool.dispatches > 0);
+		}
+	}
+}
+#endif
+
 UFBXT_TEST(empty_file_memory)
 #if UFBXT_IMPL
 {
@@ -1261,6 +2034,104 @@ UFBXT_TEST(bake_bad_opts)
 }
 #endif
 
+#if UFBXT_IMPL
+static void ufbxt_check_baked_vec3_equal(ufbx_baked_vec3_list a, ufbx_baked_vec3_list b)
+{
+	ufbxt_assert(a.count == b.count);
+	for (size_t i = 0; i < a.count; i++) {
+		ufbxt_assert(a.data[i].time == b.data[i].time);
+		ufbxt_assert(a.data[i].flags == b.data[i].flags);
+		ufbxt_assert(a.data[i].value.x == b.data[i].value.x);
+		ufbxt_assert(a.data[i].value.y == b.data[i].value.y);
+		ufbxt_assert(a.data[i].value.z == b.data[i].value.z);
+	}
+}
+
+static void ufbxt_check_threaded_bake(ufbx_scene *scene, const ufbx_bake_opts *base_opts, bool expect_parallel)
+{
+	ufbx_bake_opts opts = { 0 };
+	if (base_opts) opts = *base_opts;
+
+	ufbx_baked_anim *ref = ufbx_bake_anim(scene, NULL, &opts, NULL);
+	ufbxt_assert(ref);
+
+	for (int immediate = 0; immediate <= 1; immediate++) {
+		ufbxt_single_thread_pool pool;
+		ufbx_bake_opts thread_opts = opts;
+		ufbxt_single_thread_pool_init(&thread_opts.thread_opts.pool, &pool, immediate != 0);
+		thread_opts.thread_opts.num_tasks = 16;
+
+		ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, &thread_opts, NULL);
+		ufbxt_assert(bake);
+		ufbxt_assert(pool.initialized && pool.freed);
+		if (expect_parallel) {
+			ufbxt_assert(pool.dispatches > 0);
+		}
+
+		ufbxt_assert(bake->key_time_min == ref->key_time_min);
+		ufbxt_assert(bake->key_time_max == ref->key_time_max);
+
+		ufbxt_assert(bake->nodes.count == ref->nodes.count);
+		for (size_t i = 0; i < ref->nodes.count; i++) {
+			ufbx_baked_node *a = &bake->nodes.data[i], *b = &ref->nodes.data[i];
+			ufbxt_assert(a->typed_id == b->typed_id);
+			ufbxt_assert(a->constant_translation == b->constant_translation);
+			ufbxt_assert(a->constant_rotation == b->constant_rotation);
+			ufbxt_assert(a->constant_scale == b->constant_scale);
+			ufbxt_check_baked_vec3_equal(a->translation_keys, b->translation_keys);
+			ufbxt_check_baked_vec3_equal(a->scale_keys, b->scale_keys);
+			ufbxt_assert(a->rotation_keys.count == b->rotation_keys.count);
+			for (size_t j = 0; j < a->rotation_keys.count; j++) {
+				ufbx_baked_quat ka = a->rotation_keys.data[j], kb = b->rotation_keys.data[j];
+				ufbxt_assert(ka.time == kb.time && ka.flags == kb.flags);
+				ufbxt_assert(ka.value.x == kb.value.x && ka.value.y == kb.value.y);
+				ufbxt_assert(ka.value.z == kb.value.z && ka.value.w == kb.value.w);
+			}
+		}
+
+		ufbxt_assert(bake->elements.count == ref->elements.count);
+		for (size_t i = 0; i < ref->elements.count; i++) {
+			ufbx_baked_element *a = &bake->elements.data[i], *b = &ref->elements.data[i];
+			ufbxt_assert(a->element_id == b->element_id);
+			ufbxt_assert(a->props.count == b->props.count);
+			for (size_t j = 0; j < a->props.count; j++) {
+				ufbxt_assert(!strcmp(a->props.data[j].name.data, b->props.data[j].name.data));
+				ufbxt_assert(a->props.data[j].constant_value == b->props.data[j].constant_value);
+				ufbxt_check_baked_vec3_equal(a->props.data[j].keys, b->props.data[j].keys);
+			}
+		}
+
+		ufbx_free_baked_anim(bake);
+	}
+
+	ufbx_free_baked_anim(ref);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_thread_pool_barbarian, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbxt_check_threaded_bake(scene, NULL, true);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_thread_pool_props, maya_anim_diffuse_curve)
+#if UFBXT_IMPL
+{
+	ufbx_bake_opts opts = { 0 };
+	opts.bake_transform_props = true;
+	ufbxt_check_threaded_bake(scene, &opts, false);
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT_FLAGS(bake_thread_pool_scale_helpers, motionbuilder_sausage_rrss, ufbxt_scale_helper_opts, UFBXT_FILE_TEST_FLAG_ALLOW_INVALID_UNICODE)
+#if UFBXT_IMPL
+{
+	// Nodes depending on scale helpers are baked serially
+	ufbxt_check_threaded_bake(scene, NULL, false);
+}
+#endif
+
 UFBXT_TEST(tessellate_curve_bad_opts)
 #if UFBXT_IMPL
 {
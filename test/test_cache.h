@@ -100,6 +100,33 @@ UFBXT_FILE_TEST(max_cache_box)
 
 	ufbxt_check_frame(scene, err, false, "max_cache_box_44", NULL, 44.0/30.0);
 	ufbxt_check_frame(scene, err, false, "max_cache_box_48", NULL, 48.0/30.0);
+
+	{
+		ufbx_geometry_cache_reader *reader = ufbx_create_geometry_cache_reader(NULL, NULL);
+		ufbxt_assert(reader);
+
+		ufbx_evaluate_opts opts = { 0 };
+		opts.evaluate_skinning = true;
+		opts.evaluate_caches = true;
+		opts.load_external_files = true;
+		ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, 46.0/30.0, &opts, NULL);
+		ufbxt_assert(ref);
+
+		opts.cache_reader = reader;
+		ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 46.0/30.0, &opts, NULL);
+		ufbxt_assert(state);
+		ufbxt_assert(reader->num_frames_read > 0);
+
+		ufbx_mesh *ref_mesh = ufbx_find_node(ref, "Box001")->mesh;
+		ufbx_mesh *state_mesh = ufbx_find_node(state, "Box001")->mesh;
+		ufbxt_assert(ref_mesh->skinned_is_local && state_mesh->skinned_is_local);
+		ufbxt_assert(ref_mesh->num_vertices == state_mesh->num_vertices);
+		ufbxt_assert(!memcmp(ref_mesh->skinned_position.values.data, state_mesh->skinned_position.values.data, ref_mesh->num_vertices * sizeof(ufbx_vec3)));
+
+		ufbx_free_scene(state);
+		ufbx_free_scene(ref);
+		ufbx_free_geometry_cache_reader(reader);
+	}
 }
 #endif
 
@@ -233,3 +260,210 @@ UFBXT_TEST(cache_skip_read)
 }
 #endif
 
+
+#if UFBXT_IMPL
+// Opens a stream that can't be rewound by ufbx as it's not directly backed by `FILE*`
+static size_t ufbxt_wrapped_read(void *user, void *data, size_t size)
+{
+	ufbx_stream *inner = (ufbx_stream*)user;
+	return inner->read_fn(inner->user, data, size);
+}
+
+static void ufbxt_wrapped_close(void *user)
+{
+	ufbx_stream *inner = (ufbx_stream*)user;
+	if (inner->close_fn) inner->close_fn(inner->user);
+	free(inner);
+}
+
+static bool ufbxt_open_file_wrapped(void *user, ufbx_stream *stream, const char *path, size_t path_len, const ufbx_open_file_info *info)
+{
+	ufbx_stream *inner = (ufbx_stream*)malloc(sizeof(ufbx_stream));
+	ufbxt_assert(inner);
+	if (!ufbx_open_file(inner, path, path_len, NULL, NULL)) {
+		free(inner);
+		return false;
+	}
+	memset(stream, 0, sizeof(ufbx_stream));
+	stream->read_fn = &ufbxt_wrapped_read;
+	stream->close_fn = &ufbxt_wrapped_close;
+	stream->user = inner;
+	return true;
+}
+
+static void ufbxt_check_cache_reader(const char *path, ufbx_open_file_fn *open_fn, size_t max_buffered_file_size)
+{
+	char buf[512];
+	snprintf(buf, sizeof(buf), "%s%s", data_root, path);
+
+	ufbx_geometry_cache *cache = ufbx_load_geometry_cache(buf, NULL, NULL);
+	ufbxt_assert(cache);
+
+	ufbx_geometry_cache_reader_opts reader_opts = { 0 };
+	reader_opts.open_file_cb.fn = open_fn;
+	reader_opts.max_buffered_file_size = max_buffered_file_size;
+
+	ufbx_error error;
+	ufbx_geometry_cache_reader *reader = ufbx_create_geometry_cache_reader(&reader_opts, &error);
+	if (!reader) ufbxt_log_error(&error);
+	ufbxt_assert(reader);
+
+	ufbx_geometry_cache_data_opts ref_opts = { 0 };
+	ufbx_geometry_cache_data_opts data_opts = { 0 };
+	data_opts.reader = reader;
+
+	size_t num_samples = 0;
+	for (size_t i = 0; i < cache->channels.count; i++) {
+		ufbx_cache_channel *channel = &cache->channels.data[i];
+		if (channel->frames.count == 0) continue;
+
+		double begin = channel->frames.data[0].time;
+		double end = channel->frames.data[channel->frames.count - 1].time;
+
+		// Sample forwards and then backwards to test re-opening streams
+		for (int pass = 0; pass < 2; pass++) {
+			for (size_t step = 0; step <= 40; step++) {
+				double t = (double)(pass == 0 ? step : 40 - step) / 40.0;
+				double time = begin + (end - begin) * t;
+
+				ufbx_vec3 ref[1024], pos[1024];
+				size_t num_ref = ufbx_sample_geometry_cache_vec3(channel, time, ref, ufbxt_arraycount(ref), &ref_opts);
+				size_t num_pos = ufbx_sample_geometry_cache_vec3(channel, time, pos, ufbxt_arraycount(pos), &data_opts);
+				ufbxt_assert(num_ref > 0);
+				ufbxt_assert(num_pos == num_ref);
+				ufbxt_assert(!memcmp(pos, ref, num_ref * sizeof(ufbx_vec3)));
+				num_samples++;
+			}
+		}
+	}
+
+	ufbxt_assert(num_samples > 0);
+	ufbxt_assert(reader->num_frames_read >= num_samples);
+	ufbxt_assert(reader->num_files_opened > 0);
+
+	size_t num_files = 0;
+	for (size_t i = 0; i < cache->frames.count; i++) {
+		bool unique = true;
+		for (size_t j = 0; j < i; j++) {
+			if (!strcmp(cache->frames.data[i].filename.data, cache->frames.data[j].filename.data)) {
+				unique = false;
+				break;
+			}
+		}
+		if (unique) num_files++;
+	}
+
+	// Files are never re-opened if all of them fit in the reader as streams backed
+	// by `FILE*` are rewound, other streams need to be re-opened to sample backwards.
+	if (open_fn == &ufbxt_open_file_wrapped) {
+		ufbxt_assert(reader->num_files_opened > num_files);
+	} else if (num_files <= 4) {
+		ufbxt_assert(reader->num_files_opened == num_files);
+	}
+
+	ufbx_free_geometry_cache_reader(reader);
+	ufbx_free_geometry_cache(cache);
+}
+#endif
+
+UFBXT_TEST(cache_reader)
+#if UFBXT_IMPL
+{
+	const char *paths[] = {
+		"caches/sine_mcmf_undersample/cache.xml",
+		"caches/sine_mcsd_oversample/cache.xml",
+		"caches/sine_mxmd_oversample/cache.xml",
+		"caches/sine_mxsf_regular/cache.xml",
+		"max_cache_box_7500_binary_fpc/max_cache_box.pc2",
+	};
+
+	for (size_t i = 0; i < ufbxt_arraycount(paths); i++) {
+		ufbxt_check_cache_reader(paths[i], NULL, 0);
+		ufbxt_check_cache_reader(paths[i], &ufbx_default_open_file, 0);
+		ufbxt_check_cache_reader(paths[i], &ufbx_default_open_file, SIZE_MAX);
+		ufbxt_check_cache_reader(paths[i], &ufbxt_open_file_no_skip, SIZE_MAX);
+		ufbxt_check_cache_reader(paths[i], &ufbxt_open_file_wrapped, SIZE_MAX);
+	}
+}
+#endif
+
+#if UFBXT_IMPL
+static size_t ufbxt_check_cache_playback(const char *path, const ufbx_cache_playback_opts *opts)
+{
+	char buf[512];
+	snprintf(buf, sizeof(buf), "%s%s", data_root, path);
+
+	ufbx_geometry_cache *cache = ufbx_load_geometry_cache(buf, NULL, NULL);
+	ufbxt_assert(cache);
+
+	size_t num_hits = 0;
+	for (size_t i = 0; i < cache->channels.count; i++) {
+		ufbx_cache_channel *channel = &cache->channels.data[i];
+		if (channel->frames.count == 0) continue;
+
+		ufbx_error error;
+		ufbx_cache_playback *playback = ufbx_create_cache_playback(channel, opts, &error);
+		if (!playback) ufbxt_log_error(&error);
+		ufbxt_assert(playback);
+		ufbxt_assert(playback->channel == channel);
+		ufbxt_assert(playback->num_buffered_frames >= 2);
+
+		double begin = channel->frames.data[0].time;
+		double end = channel->frames.data[channel->frames.count - 1].time;
+
+		// Play forwards, backwards and then jump around
+		for (size_t step = 0; step < 120; step++) {
+			double t = 0.0;
+			if (step < 40) {
+				t = (double)step / 39.0;
+			} else if (step < 80) {
+				t = (double)(79 - step) / 39.0;
+			} else {
+				t = (double)((step * 37) % 41) / 40.0;
+			}
+			double time = begin + (end - begin) * (t * 1.2 - 0.1);
+
+			ufbx_geometry_cache_data_opts data_opts = { 0 };
+			if (step % 3 == 1) {
+				data_opts.use_weight = true;
+				data_opts.weight = 0.5f;
+			}
+
+			ufbx_vec3 ref[1024], pos[1024];
+			for (size_t j = 0; j < ufbxt_arraycount(ref); j++) {
+				ref[j].x = pos[j].x = (ufbx_real)j;
+				ref[j].y = pos[j].y = 1.0f;
+				ref[j].z = pos[j].z = 2.0f;
+			}
+			data_opts.additive = step % 5 == 2;
+
+			size_t num_ref = ufbx_sample_geometry_cache_vec3(channel, time, ref, ufbxt_arraycount(ref), &data_opts);
+			size_t num_pos = ufbx_cache_playback_sample_vec3(playback, time, pos, ufbxt_arraycount(pos), &data_opts);
+			ufbxt_assert(num_ref > 0);
+			ufbxt_assert(num_pos == num_ref);
+			ufbxt_assert(!memcmp(pos, ref, sizeof(ref)));
+		}
+
+		ufbxt_assert(playback->num_frame_hits > 0);
+		num_hits += playback->num_frame_hits;
+		ufbx_free_cache_playback(playback);
+	}
+
+	ufbx_free_geometry_cache(cache);
+	return num_hits;
+}
+#endif
+
+UFBXT_TEST(cache_playback)
+#if UFBXT_IMPL
+{
+	ufbxt_check_cache_playback("caches/sine_mcmf_undersample/cache.xml", NULL);
+	ufbxt_check_cache_playback("caches/sine_mxsf_regular/cache.xml", NULL);
+	ufbxt_check_cache_playback("max_cache_box_7500_binary_fpc/max_cache_box.pc2", NULL);
+
+	ufbx_cache_playback_opts opts = { 0 };
+	opts.memory_budget = 1;
+	opts.ignore_transform = true;
+	ufbxt_check_cache_playback("caches/sine_mcsd_oversample/cache.xml", &opts);
+}
+#endif
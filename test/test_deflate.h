@@ -166,6 +166,18 @@ UFBXT_DEFLATE_TEST(deflate_simple_chunks)
 }
 #endif
 
+UFBXT_DEFLATE_TEST(deflate_sync_flush)
+#if UFBXT_IMPL
+{
+	char src[] = "\x78\x9c\xf2\x48\xcd\xc9\xc9\x07\x00\x00\x00\xff\xff\x53\x28\xcf\x2f\xca\x49\x01\x00\x18\xab\x04\x3d";
+	char dst[11];
+	ptrdiff_t res = ufbxt_inflate(dst, sizeof(dst), src, sizeof(src) - 1, opts);
+	ufbxt_hintf("res = %d", (int)res);
+	ufbxt_assert(res == 11);
+	ufbxt_assert(!memcmp(dst, "Hello world", 11));
+}
+#endif
+
 UFBXT_DEFLATE_TEST(deflate_static)
 #if UFBXT_IMPL
 {
@@ -122,6 +122,103 @@ UFBXT_TEST(ignore_embedded)
 }
 #endif
 
+#if UFBXT_IMPL
+static void ufbxt_check_deferred_content(ufbx_blob ref, ufbx_blob content, ufbx_embedded_location location, const char *path, const void *file_data, size_t file_size)
+{
+	if (ref.size == 0) return;
+
+	// Content split into multiple parts in binary files is loaded normally
+	if (content.size > 0) {
+		ufbxt_assert(content.size == ref.size);
+		ufbxt_assert(!memcmp(content.data, ref.data, ref.size));
+		ufbxt_assert(location.encoding == UFBX_EMBEDDED_ENCODING_NONE);
+		return;
+	}
+
+	ufbxt_assert(location.encoding != UFBX_EMBEDDED_ENCODING_NONE);
+	ufbxt_assert(location.size == ref.size);
+
+	char *data = (char*)malloc(ref.size);
+	ufbxt_assert(data);
+
+	memset(data, 0, ref.size);
+	ufbxt_assert(ufbx_read_embedded_file(&location, path, data, ref.size, NULL) == ref.size);
+	ufbxt_assert(!memcmp(data, ref.data, ref.size));
+
+	memset(data, 0, ref.size);
+	ufbxt_assert(ufbx_read_embedded_memory(&location, file_data, file_size, data, ref.size) == ref.size);
+	ufbxt_assert(!memcmp(data, ref.data, ref.size));
+
+	ufbx_stream stream = { 0 };
+	ufbxt_assert(ufbx_open_file(&stream, path, SIZE_MAX, NULL, NULL));
+	memset(data, 0, ref.size);
+	ufbxt_assert(ufbx_read_embedded_stream(&location, &stream, data, ref.size) == ref.size);
+	ufbxt_assert(!memcmp(data, ref.data, ref.size));
+	stream.close_fn(stream.user);
+
+	free(data);
+}
+#endif
+
+UFBXT_TEST(defer_embedded)
+#if UFBXT_IMPL
+{
+	// `marvelous_quad` has ASCII arrays large enough to be parsed from retained buffers
+	const char *files[] = { "maya_textured_cube", "synthetic_texture_split", "marvelous_quad" };
+	for (size_t file_ix = 0; file_ix < ufbxt_arraycount(files); file_ix++) {
+		char path[512];
+		ufbxt_file_iterator iter = { files[file_ix] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			ufbx_scene *ref = ufbx_load_file(path, NULL, NULL);
+			ufbxt_assert(ref);
+
+			size_t file_size = 0;
+			void *file_data = ufbxt_read_file(path, &file_size);
+			ufbxt_assert(file_data);
+
+			// Modes: file, memory, threaded file with small read buffers of varying size
+			for (int mode = 0; mode <= 8; mode++) {
+				ufbx_load_opts opts = { 0 };
+				opts.defer_embedded = true;
+
+				// Threaded ASCII parsing with one object per batch relocates partially
+				// consumed data into the read buffer, which must not affect the offsets.
+				ufbxt_single_thread_pool pool;
+				if (mode >= 2) {
+					ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, false);
+					opts.thread_opts.memory_limit = 1;
+					opts.read_buffer_size = (size_t)64 << mode;
+				}
+
+				ufbx_scene *scene = mode == 1 ? ufbx_load_memory(file_data, file_size, &opts, NULL) : ufbx_load_file(path, &opts, NULL);
+				ufbxt_assert(scene);
+				if (mode >= 2) {
+					ufbxt_assert(pool.initialized && pool.freed);
+				}
+				ufbxt_check_scene(scene);
+
+				ufbxt_assert(scene->videos.count == ref->videos.count);
+				for (size_t i = 0; i < scene->videos.count; i++) {
+					ufbx_video *video = scene->videos.data[i];
+					ufbxt_check_deferred_content(ref->videos.data[i]->content, video->content, video->content_location, path, file_data, file_size);
+				}
+
+				ufbxt_assert(scene->textures.count == ref->textures.count);
+				for (size_t i = 0; i < scene->textures.count; i++) {
+					ufbx_texture *texture = scene->textures.data[i];
+					ufbxt_check_deferred_content(ref->textures.data[i]->content, texture->content, texture->content_location, path, file_data, file_size);
+				}
+
+				ufbx_free_scene(scene);
+			}
+
+			free(file_data);
+			ufbx_free_scene(ref);
+		}
+	}
+}
+#endif
+
 UFBXT_FILE_TEST(maya_shared_textures)
 #if UFBXT_IMPL
 {
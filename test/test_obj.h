@@ -1312,6 +1312,167 @@ UFBXT_TEST(obj_opts_no_extrnal_files_by_filename)
 }
 #endif
 
+#if UFBXT_IMPL
+static char *ufbxt_generate_obj(size_t num_faces, size_t *p_size)
+{
+	size_t cap = num_faces * 256 + 1024, size = 0;
+	char *data = (char*)malloc(cap);
+	ufbxt_assert(data);
+
+	uint32_t seed = 1;
+	size_t num_vertices = 0;
+	for (size_t i = 0; i < num_faces; i++) {
+		ufbxt_assert(cap - size >= 256);
+		char *dst = data + size;
+		int len = 0;
+
+		if (i % 5000 == 0) {
+			len += sprintf(dst + len, "o object%u\n", (unsigned)(i / 5000));
+		}
+		if (i % 700 == 0) {
+			len += sprintf(dst + len, "g group%u\nusemtl material%u\n", (unsigned)(i / 700 % 3), (unsigned)(i / 1100 % 4));
+		}
+		if (i % 900 == 0) {
+			len += sprintf(dst + len, "s %s\n", i % 1800 == 0 ? "off" : "1");
+		}
+
+		for (size_t j = 0; j < 3; j++) {
+			float v[3];
+			for (size_t k = 0; k < 3; k++) {
+				seed = seed * 1103515245u + 12345u;
+				v[k] = (float)(seed >> 8) / (float)(1u << 20) - 8.0f;
+			}
+			if ((num_vertices + j) % 97 == 0) {
+				len += sprintf(dst + len, "v %.6f %.6f %.6f 0.5 0.25 1\n", v[0], v[1], v[2]);
+			} else {
+				len += sprintf(dst + len, "v %.6f %.6f %.6f\n", v[0], v[1], v[2]);
+			}
+			len += sprintf(dst + len, "vt %.4f %.4f\nvn %.3f %.3f %.3f\n", v[0], v[1], v[2], v[1], v[0]);
+		}
+		num_vertices += 3;
+
+		unsigned a = (unsigned)num_vertices - 2, b = a + 1, c = a + 2;
+		switch (i % 7) {
+		case 0: len += sprintf(dst + len, "f -3/-3/-3 -2/-2/-2 -1/-1/-1\n"); break;
+		case 1: len += sprintf(dst + len, "f %u//%u %u//%u %u//%u\n", a, a, b, b, c, c); break;
+		case 2: len += sprintf(dst + len, "f %u/%u %u/%u %u/%u # comment\n", a, a, b, b, c, c); break;
+		case 3: len += sprintf(dst + len, "f %u/%u/%u %u/%u/%u \\\n  %u/%u/%u\n", a, a, a, b, b, b, c, c, c); break;
+		case 4: len += sprintf(dst + len, "l %u %u\n", a, c); break;
+		case 5: len += sprintf(dst + len, "\tf  %u %u %u\r\n", a, b, c); break;
+		default: len += sprintf(dst + len, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c); break;
+		}
+
+		size += (size_t)len;
+	}
+
+	*p_size = size;
+	return data;
+}
+
+static void ufbxt_check_obj_meshes_equal(ufbx_scene *a, ufbx_scene *b)
+{
+	ufbxt_assert(a->meshes.count == b->meshes.count);
+	ufbxt_assert(a->materials.count == b->materials.count);
+	ufbxt_assert(a->metadata.warnings.count == b->metadata.warnings.count);
+	for (size_t i = 0; i < a->meshes.count; i++) {
+		ufbx_mesh *ma = a->meshes.data[i], *mb = b->meshes.data[i];
+		ufbxt_assert(!strcmp(ma->name.data, mb->name.data));
+		ufbxt_assert(ma->num_faces == mb->num_faces);
+		ufbxt_assert(ma->num_indices == mb->num_indices);
+		ufbxt_assert(ma->num_vertices == mb->num_vertices);
+		ufbxt_assert(ma->num_line_faces == mb->num_line_faces);
+		ufbxt_assert(ma->materials.count == mb->materials.count);
+		ufbxt_assert(ma->face_groups.count == mb->face_groups.count);
+		ufbxt_assert(ma->face_smoothing.count == mb->face_smoothing.count);
+		ufbxt_assert(ma->vertex_color.exists == mb->vertex_color.exists);
+		for (size_t j = 0; j < ma->num_faces; j++) {
+			ufbxt_assert(ma->faces.data[j].index_begin == mb->faces.data[j].index_begin);
+			ufbxt_assert(ma->faces.data[j].num_indices == mb->faces.data[j].num_indices);
+			if (ma->face_material.count > 0) ufbxt_assert(ma->face_material.data[j] == mb->face_material.data[j]);
+			if (ma->face_group.count > 0) ufbxt_assert(ma->face_group.data[j] == mb->face_group.data[j]);
+			if (ma->face_smoothing.count > 0) ufbxt_assert(ma->face_smoothing.data[j] == mb->face_smoothing.data[j]);
+		}
+		for (size_t j = 0; j < ma->num_indices; j++) {
+			ufbx_vec3 pa = ufbx_get_vertex_vec3(&ma->vertex_position, j);
+			ufbx_vec3 pb = ufbx_get_vertex_vec3(&mb->vertex_position, j);
+			ufbxt_assert(pa.x == pb.x && pa.y == pb.y && pa.z == pb.z);
+			ufbxt_assert(ma->vertex_position.indices.data[j] == mb->vertex_position.indices.data[j]);
+			if (ma->vertex_uv.exists) {
+				ufbx_vec2 ua = ufbx_get_vertex_vec2(&ma->vertex_uv, j);
+				ufbx_vec2 ub = ufbx_get_vertex_vec2(&mb->vertex_uv, j);
+				ufbxt_assert(ua.x == ub.x && ua.y == ub.y);
+			}
+			if (ma->vertex_normal.exists) {
+				ufbx_vec3 na = ufbx_get_vertex_vec3(&ma->vertex_normal, j);
+				ufbx_vec3 nb = ufbx_get_vertex_vec3(&mb->vertex_normal, j);
+				ufbxt_assert(na.x == nb.x && na.y == nb.y && na.z == nb.z);
+			}
+			if (ma->vertex_color.exists) {
+				ufbx_vec4 ca = ufbx_get_vertex_vec4(&ma->vertex_color, j);
+				ufbx_vec4 cb = ufbx_get_vertex_vec4(&mb->vertex_color, j);
+				ufbxt_assert(ca.x == cb.x && ca.y == cb.y && ca.z == cb.z && ca.w == cb.w);
+			}
+		}
+	}
+}
+
+static size_t ufbxt_obj_memory_read_fn(void *user, void *data, size_t size)
+{
+	ufbx_blob *blob = (ufbx_blob*)user;
+	size_t to_read = size < blob->size ? size : blob->size;
+	to_read = to_read < 12345 ? to_read : 12345;
+	memcpy(data, blob->data, to_read);
+	blob->data = (const char*)blob->data + to_read;
+	blob->size -= to_read;
+	return to_read;
+}
+#endif
+
+UFBXT_TEST(obj_thread_pool)
+#if UFBXT_IMPL
+{
+	size_t size = 0;
+	char *data = ufbxt_generate_obj(40000, &size);
+
+	ufbx_load_opts opts = { 0 };
+	opts.file_format = UFBX_FILE_FORMAT_OBJ;
+
+	ufbx_error error;
+	ufbx_scene *ref = ufbx_load_memory(data, size, &opts, &error);
+	if (!ref) ufbxt_log_error(&error);
+	ufbxt_assert(ref);
+	ufbxt_assert(ref->meshes.count > 1);
+
+	for (int streamed = 0; streamed <= 1; streamed++) {
+		ufbxt_single_thread_pool pool;
+		ufbx_load_opts thread_opts = opts;
+		ufbxt_single_thread_pool_init(&thread_opts.thread_opts.pool, &pool, false);
+
+		ufbx_scene *scene = NULL;
+		if (streamed) {
+			ufbx_blob blob = { data, size };
+			ufbx_stream stream = { 0 };
+			stream.read_fn = &ufbxt_obj_memory_read_fn;
+			stream.user = &blob;
+			thread_opts.read_buffer_size = 4096;
+			scene = ufbx_load_stream(&stream, &thread_opts, &error);
+		} else {
+			scene = ufbx_load_memory(data, size, &thread_opts, &error);
+		}
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+		ufbxt_assert(pool.dispatches > 0);
+
+		ufbxt_check_obj_meshes_equal(scene, ref);
+		ufbx_free_scene(scene);
+		ufbxt_assert(pool.freed);
+	}
+
+	ufbx_free_scene(ref);
+	free(data);
+}
+#endif
+
 #if UFBXT_IMPL
 static void ufbxt_check_only_texture(ufbx_material_map *map, const char *filename)
 {
@@ -1595,3 +1756,71 @@ UFBXT_FILE_TEST_OPTS_ALT_FLAGS(obj_space_manual_convert, blender_279_ball, obj_a
 }
 #endif
 
+UFBXT_TEST(obj_tokenize_whitespace)
+#if UFBXT_IMPL
+{
+	const char obj[] =
+		"# Leading comment line that is long enough to span multiple blocks\n"
+		"o \t  VeryLongObjectNameThatSpansSeveralBlocks#1   \t   # trailing comment\r\n"
+		"v 0.000000000000000000 \t\t\t 0.000000000000000000                   0.0\n"
+		"v\t1.0000000000000000000000000000000000\t0\t0\t# comment after values\r\n"
+		"v 0 \\\n   1.0 0\n"
+		"                                                         f 1 2 3";
+
+	ufbx_scene *scene = ufbx_load_memory(obj, sizeof(obj) - 1, NULL, NULL);
+	ufbxt_assert(scene);
+
+	ufbxt_assert(scene->meshes.count == 1);
+	ufbx_mesh *mesh = scene->meshes.data[0];
+	ufbxt_assert(mesh->instances.count == 1);
+	ufbxt_assert(!strcmp(mesh->instances.data[0]->name.data, "VeryLongObjectNameThatSpansSeveralBlocks#1"));
+	ufbxt_assert(mesh->faces.count == 1);
+	ufbxt_assert(mesh->vertices.count == 3);
+
+	ufbx_vec3 v0 = { 0.0f, 0.0f, 0.0f };
+	ufbx_vec3 v1 = { 1.0f, 0.0f, 0.0f };
+	ufbx_vec3 v2 = { 0.0f, 1.0f, 0.0f };
+
+	ufbxt_diff_error err = { 0 };
+	ufbxt_assert_close_vec3(&err, mesh->vertices.data[0], v0);
+	ufbxt_assert_close_vec3(&err, mesh->vertices.data[1], v1);
+	ufbxt_assert_close_vec3(&err, mesh->vertices.data[2], v2);
+
+	ufbx_free_scene(scene);
+}
+#endif
+
+UFBXT_TEST(obj_approximate_float_parsing)
+#if UFBXT_IMPL
+{
+	const char obj[] =
+		"v 0.1234567890123456789012345 -12345678.123456789012345678 1e-30\n"
+		"v 1.0 -0.0509034991264343 0.12345678901234567\n"
+		"v 0 1 0\n"
+		"f 1 2 3\n";
+
+	ufbx_scene *exact = ufbx_load_memory(obj, sizeof(obj) - 1, NULL, NULL);
+	ufbxt_assert(exact);
+
+	ufbx_load_opts opts = { 0 };
+	opts.approximate_float_parsing = true;
+	ufbx_scene *approx = ufbx_load_memory(obj, sizeof(obj) - 1, &opts, NULL);
+	ufbxt_assert(approx);
+
+	ufbxt_assert(exact->meshes.count == 1 && approx->meshes.count == 1);
+	ufbx_mesh *exact_mesh = exact->meshes.data[0];
+	ufbx_mesh *approx_mesh = approx->meshes.data[0];
+	ufbxt_assert(exact_mesh->vertices.count == 3 && approx_mesh->vertices.count == 3);
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			ufbx_real a = exact_mesh->vertices.data[i].v[j];
+			ufbx_real b = approx_mesh->vertices.data[i].v[j];
+			ufbxt_assert(fabs(a - b) <= fabs(a) * 4e-16);
+		}
+	}
+
+	ufbx_free_scene(approx);
+	ufbx_free_scene(exact);
+}
+#endif
@@ -1149,3 +1149,246 @@ UFBXT_FILE_TEST(maya_instanced_skin)
 }
 #endif
 
+
+UFBXT_FILE_TEST_ALT(evaluate_in_place_skinned, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	static const double times[] = { 0.5, 0.25, 0.75, 0.5 };
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	ufbxt_check_evaluate_in_place(scene, NULL, &opts, times, ufbxt_arraycount(times));
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_in_place_dq_weights, maya_dq_weights)
+#if UFBXT_IMPL
+{
+	static const double times[] = { 10.0/24.0, 18.0/24.0, 0.0 };
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	ufbxt_check_evaluate_in_place(scene, NULL, &opts, times, ufbxt_arraycount(times));
+
+	// Skinning buffers are allocated lazily if the previous evaluation did not skin
+	ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 0.0, NULL, NULL);
+	ufbxt_assert(state);
+	bool ok = ufbx_evaluate_scene_in_place(state, NULL, 10.0/24.0, &opts, NULL);
+	ufbxt_assert(ok);
+
+	ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, 10.0/24.0, &opts, NULL);
+	ufbxt_assert(ref);
+	ufbxt_check_same_evaluated_scene(state, ref);
+	ufbx_free_scene(ref);
+	ufbx_free_scene(state);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_in_place_toggle_skinning, maya_dq_weights)
+#if UFBXT_IMPL
+{
+	ufbx_evaluate_opts skin_opts = { 0 };
+	skin_opts.evaluate_skinning = true;
+
+	ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, 10.0/24.0, &skin_opts, NULL);
+	ufbxt_assert(state);
+
+	// Turning skinning off must reset the meshes to the unskinned vertices
+	bool ok = ufbx_evaluate_scene_in_place(state, NULL, 18.0/24.0, NULL, NULL);
+	ufbxt_assert(ok);
+	{
+		ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, 18.0/24.0, NULL, NULL);
+		ufbxt_assert(ref);
+		ufbxt_check_same_evaluated_scene(state, ref);
+		for (size_t i = 0; i < state->meshes.count; i++) {
+			ufbx_mesh *mesh = state->meshes.data[i];
+			ufbxt_assert(mesh->skinned_is_local == scene->meshes.data[i]->skinned_is_local);
+			ufbxt_assert(mesh->skinned_position.values.data == scene->meshes.data[i]->skinned_position.values.data);
+			ufbxt_assert(mesh->skinned_normal.values.data == scene->meshes.data[i]->skinned_normal.values.data);
+		}
+		ufbx_free_scene(ref);
+	}
+
+	// Skinning buffers of the first evaluation are reused when turned back on
+	size_t num_allocs = state->metadata.result_allocs;
+	for (int i = 0; i < 2; i++) {
+		ok = ufbx_evaluate_scene_in_place(state, NULL, i == 0 ? 0.0 : 18.0/24.0, &skin_opts, NULL);
+		ufbxt_assert(ok);
+		ufbxt_assert(state->metadata.result_allocs == num_allocs);
+
+		ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, i == 0 ? 0.0 : 18.0/24.0, &skin_opts, NULL);
+		ufbxt_assert(ref);
+		ufbxt_check_same_evaluated_scene(state, ref);
+		ufbx_free_scene(ref);
+
+		ok = ufbx_evaluate_scene_in_place(state, NULL, 10.0/24.0, NULL, NULL);
+		ufbxt_assert(ok);
+		ufbxt_assert(state->metadata.result_allocs == num_allocs);
+	}
+
+	ufbx_free_scene(state);
+}
+#endif
+
+#if UFBXT_IMPL
+static bool ufbxt_is_ancestor_node(const ufbx_node *ancestor, const ufbx_node *node)
+{
+	for (; node; node = node->parent) {
+		if (node == ancestor) return true;
+	}
+	return false;
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_partial_skinned, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbx_mesh *mesh = NULL;
+	for (size_t i = 0; i < scene->meshes.count; i++) {
+		if (scene->meshes.data[i]->skin_deformers.count > 0 && scene->meshes.data[i]->instances.count > 0) {
+			mesh = scene->meshes.data[i];
+			break;
+		}
+	}
+	ufbxt_assert(mesh);
+	ufbx_node *root = mesh->instances.data[0];
+	ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
+
+	uint32_t root_ids[] = { root->typed_id };
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	opts.root_node_ids.data = root_ids;
+	opts.root_node_ids.count = ufbxt_arraycount(root_ids);
+
+	ufbx_evaluate_opts ref_opts = { 0 };
+	ref_opts.evaluate_skinning = true;
+
+	double time = 0.5;
+	ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, time, &ref_opts, NULL);
+	ufbxt_assert(ref);
+
+	ufbx_scene *prev = ufbx_evaluate_scene(scene, NULL, 0.0, NULL, NULL);
+	ufbxt_assert(prev);
+
+	for (int in_place = 0; in_place <= 1; in_place++) {
+		ufbx_scene *state = NULL;
+		if (in_place) {
+			state = ufbx_evaluate_scene(scene, NULL, 0.0, NULL, NULL);
+			ufbxt_assert(state);
+			bool ok = ufbx_evaluate_scene_in_place(state, NULL, time, &opts, NULL);
+			ufbxt_assert(ok);
+		} else {
+			state = ufbx_evaluate_scene(scene, NULL, time, &opts, NULL);
+			ufbxt_assert(state);
+		}
+		ufbxt_check_scene(state);
+
+		// The skinned mesh matches full evaluation
+		ufbx_mesh *state_mesh = state->meshes.data[mesh->typed_id];
+		ufbx_mesh *ref_mesh = ref->meshes.data[mesh->typed_id];
+		ufbxt_assert(state_mesh->skinned_position.values.count == ref_mesh->skinned_position.values.count);
+		ufbxt_assert(!memcmp(state_mesh->skinned_position.values.data, ref_mesh->skinned_position.values.data,
+			ref_mesh->skinned_position.values.count * sizeof(ufbx_vec3)));
+		ufbxt_assert(state_mesh->skinned_normal.values.count == ref_mesh->skinned_normal.values.count);
+		ufbxt_assert(!memcmp(state_mesh->skinned_normal.values.data, ref_mesh->skinned_normal.values.data,
+			ref_mesh->skinned_normal.values.count * sizeof(ufbx_vec3)));
+
+		for (size_t i = 0; i < scene->nodes.count; i++) {
+			ufbx_node *node = scene->nodes.data[i];
+			bool evaluated = ufbxt_is_ancestor_node(root, node) || ufbxt_is_ancestor_node(node, root);
+			for (size_t j = 0; j < skin->clusters.count; j++) {
+				ufbx_node *bone = skin->clusters.data[j]->bone_node;
+				if (bone && ufbxt_is_ancestor_node(node, bone)) {
+					evaluated = true;
+				}
+			}
+
+			// Evaluated nodes match full evaluation, others retain their previous values
+			const ufbx_node *expected = evaluated ? ref->nodes.data[i] : in_place ? prev->nodes.data[i] : node;
+			ufbxt_assert(!memcmp(&state->nodes.data[i]->node_to_world, &expected->node_to_world, sizeof(ufbx_matrix)));
+		}
+
+		ufbx_free_scene(state);
+	}
+
+	{
+		uint32_t bad_ids[] = { (uint32_t)scene->nodes.count };
+		ufbx_evaluate_opts bad_opts = { 0 };
+		bad_opts.root_node_ids.data = bad_ids;
+		bad_opts.root_node_ids.count = ufbxt_arraycount(bad_ids);
+
+		ufbx_error error;
+		ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, time, &bad_opts, &error);
+		ufbxt_assert(!state);
+		ufbxt_assert(error.type != UFBX_ERROR_NONE);
+	}
+
+	ufbx_free_scene(prev);
+	ufbx_free_scene(ref);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_partial_bone, blender_293_barbarian)
+#if UFBXT_IMPL
+{
+	ufbx_node *bone = NULL;
+	for (size_t i = 0; i < scene->skin_clusters.count && !bone; i++) {
+		bone = scene->skin_clusters.data[i]->bone_node;
+	}
+	ufbxt_assert(bone);
+
+	// Selecting only a bone must re-skin the meshes deformed by it
+	uint32_t root_ids[] = { bone->typed_id };
+	ufbx_evaluate_opts opts = { 0 };
+	opts.evaluate_skinning = true;
+	opts.root_node_ids.data = root_ids;
+	opts.root_node_ids.count = ufbxt_arraycount(root_ids);
+
+	ufbx_evaluate_opts ref_opts = { 0 };
+	ref_opts.evaluate_skinning = true;
+
+	double time = 0.5;
+	ufbx_scene *ref = ufbx_evaluate_scene(scene, NULL, time, &ref_opts, NULL);
+	ufbxt_assert(ref);
+
+	for (int in_place = 0; in_place <= 1; in_place++) {
+		ufbx_scene *state = NULL;
+		if (in_place) {
+			state = ufbx_evaluate_scene(scene, NULL, 0.0, &ref_opts, NULL);
+			ufbxt_assert(state);
+			bool ok = ufbx_evaluate_scene_in_place(state, NULL, time, &opts, NULL);
+			ufbxt_assert(ok);
+		} else {
+			state = ufbx_evaluate_scene(scene, NULL, time, &opts, NULL);
+			ufbxt_assert(state);
+		}
+		ufbxt_check_scene(state);
+
+		size_t num_deformed = 0;
+		for (size_t i = 0; i < scene->meshes.count; i++) {
+			ufbx_mesh *mesh = scene->meshes.data[i];
+			bool deformed = false;
+			for (size_t j = 0; j < mesh->skin_deformers.count; j++) {
+				ufbx_skin_deformer *skin = mesh->skin_deformers.data[j];
+				for (size_t k = 0; k < skin->clusters.count; k++) {
+					if (skin->clusters.data[k]->bone_node == bone) deformed = true;
+				}
+			}
+			if (!deformed) continue;
+			num_deformed++;
+
+			ufbx_mesh *state_mesh = state->meshes.data[i];
+			ufbx_mesh *ref_mesh = ref->meshes.data[i];
+			ufbxt_assert(state_mesh->skinned_position.values.count == ref_mesh->skinned_position.values.count);
+			ufbxt_assert(!memcmp(state_mesh->skinned_position.values.data, ref_mesh->skinned_position.values.data,
+				ref_mesh->skinned_position.values.count * sizeof(ufbx_vec3)));
+			ufbxt_assert(state_mesh->skinned_normal.values.count == ref_mesh->skinned_normal.values.count);
+			ufbxt_assert(!memcmp(state_mesh->skinned_normal.values.data, ref_mesh->skinned_normal.values.data,
+				ref_mesh->skinned_normal.values.count * sizeof(ufbx_vec3)));
+		}
+		ufbxt_assert(num_deformed > 0);
+
+		ufbx_free_scene(state);
+	}
+
+	ufbx_free_scene(ref);
+}
+#endif
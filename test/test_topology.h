@@ -813,3 +813,75 @@ UFBXT_FILE_TEST_ALT(subsurf_interpolate_ignore, maya_cube)
 }
 #endif
 
+#if UFBXT_IMPL
+static void ufbxt_generate_grid_vertices(ufbxt_vertex_pn *vertices, size_t grid_size)
+{
+	size_t num_vertices = 0;
+	for (size_t y = 0; y < grid_size; y++) {
+		for (size_t x = 0; x < grid_size; x++) {
+			static const size_t corners[6][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+			for (size_t i = 0; i < 6; i++) {
+				ufbxt_vertex_pn *v = &vertices[num_vertices++];
+				v->position.x = (ufbx_real)(x + corners[i][0]);
+				v->position.y = 0.0f;
+				v->position.z = (ufbx_real)(y + corners[i][1]);
+				v->normal.x = 0.0f;
+				v->normal.y = 1.0f;
+				v->normal.z = 0.0f;
+			}
+		}
+	}
+}
+#endif
+
+UFBXT_TEST(generate_indices_threaded)
+#if UFBXT_IMPL
+{
+	size_t grid_size = 128;
+	size_t num_indices = grid_size * grid_size * 6;
+
+	ufbxt_vertex_pn *ref_vertices = (ufbxt_vertex_pn*)calloc(num_indices, sizeof(ufbxt_vertex_pn));
+	ufbxt_vertex_pn *vertices = (ufbxt_vertex_pn*)calloc(num_indices, sizeof(ufbxt_vertex_pn));
+	uint32_t *ref_indices = (uint32_t*)calloc(num_indices, sizeof(uint32_t));
+	uint32_t *indices = (uint32_t*)calloc(num_indices, sizeof(uint32_t));
+	ufbxt_assert(ref_vertices && vertices && ref_indices && indices);
+
+	ufbxt_generate_grid_vertices(ref_vertices, grid_size);
+	ufbx_vertex_stream ref_stream = { ref_vertices, num_indices, sizeof(ufbxt_vertex_pn) };
+	size_t ref_num_vertices = ufbx_generate_indices(&ref_stream, 1, ref_indices, num_indices, NULL, NULL);
+	ufbxt_assert(ref_num_vertices == (grid_size + 1) * (grid_size + 1));
+
+	// A tiny memory limit packs one chunk at a time
+	for (int round = 0; round < 4; round++) {
+		bool immediate = (round & 1) != 0;
+		bool limit_memory = (round & 2) != 0;
+
+		ufbxt_generate_grid_vertices(vertices, grid_size);
+		memset(indices, 0, num_indices * sizeof(uint32_t));
+
+		ufbxt_single_thread_pool pool;
+		ufbx_generate_indices_opts opts = { 0 };
+		ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate);
+		if (limit_memory) {
+			opts.thread_opts.memory_limit = 1;
+		}
+
+		ufbx_error error;
+		ufbx_vertex_stream stream = { vertices, num_indices, sizeof(ufbxt_vertex_pn) };
+		size_t num_vertices = ufbx_generate_indices_ex(&stream, 1, indices, num_indices, &opts, &error);
+		if (error.type != UFBX_ERROR_NONE) ufbxt_log_error(&error);
+		ufbxt_assert(error.type == UFBX_ERROR_NONE);
+		ufbxt_assert(pool.initialized && pool.freed);
+		ufbxt_assert(pool.dispatches >= (limit_memory ? 2u : 1u));
+
+		ufbxt_assert(num_vertices == ref_num_vertices);
+		ufbxt_assert(!memcmp(indices, ref_indices, num_indices * sizeof(uint32_t)));
+		ufbxt_assert(!memcmp(vertices, ref_vertices, num_vertices * sizeof(ufbxt_vertex_pn)));
+	}
+
+	free(indices);
+	free(ref_indices);
+	free(vertices);
+	free(ref_vertices);
+}
+#endif
@@ -370,3 +370,94 @@ UFBXT_FILE_TEST(maya_ngon_l)
 	}
 }
 #endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_triangulate_mesh(ufbx_mesh *mesh, const ufbx_mesh_part *part, bool threaded, bool immediate)
+{
+	ufbxt_single_thread_pool pool;
+	ufbx_triangulate_opts opts = { 0 };
+	if (threaded) {
+		ufbxt_single_thread_pool_init(&opts.thread_opts.pool, &pool, immediate);
+	}
+
+	size_t num_faces = part ? part->num_faces : mesh->num_faces;
+	size_t num_triangles = part ? part->num_triangles : mesh->num_triangles;
+
+	uint32_t *ref = (uint32_t*)malloc((num_triangles * 3 + 1) * sizeof(uint32_t));
+	uint32_t *indices = (uint32_t*)malloc((num_triangles * 3 + 1) * sizeof(uint32_t));
+	uint32_t *face_tris = (uint32_t*)malloc(mesh->max_face_triangles * 3 * sizeof(uint32_t));
+	ufbxt_assert(ref && indices && face_tris);
+
+	size_t num_ref = 0;
+	for (size_t i = 0; i < num_faces; i++) {
+		ufbx_face face = mesh->faces.data[part ? part->face_indices.data[i] : i];
+		uint32_t num_tris = ufbx_triangulate_face(face_tris, mesh->max_face_triangles * 3, mesh, face);
+		memcpy(ref + num_ref * 3, face_tris, num_tris * 3 * sizeof(uint32_t));
+		num_ref += num_tris;
+	}
+	ufbxt_assert(num_ref == num_triangles);
+
+	ufbx_error error;
+	size_t num_tris = part
+		? ufbx_triangulate_mesh_part(indices, num_triangles * 3, mesh, part, &opts, &error)
+		: ufbx_triangulate_mesh(indices, num_triangles * 3, mesh, &opts, &error);
+	if (error.type != UFBX_ERROR_NONE) ufbxt_log_error(&error);
+	ufbxt_assert(error.type == UFBX_ERROR_NONE);
+	ufbxt_assert(num_tris == num_triangles);
+	ufbxt_assert(!memcmp(indices, ref, num_triangles * 3 * sizeof(uint32_t)));
+	if (threaded) {
+		ufbxt_assert(pool.initialized && pool.freed);
+	}
+
+	if (num_triangles > 0) {
+		num_tris = part
+			? ufbx_triangulate_mesh_part(indices, num_triangles * 3 - 1, mesh, part, NULL, &error)
+			: ufbx_triangulate_mesh(indices, num_triangles * 3 - 1, mesh, NULL, &error);
+		ufbxt_assert(num_tris == 0);
+		ufbxt_assert(error.type != UFBX_ERROR_NONE);
+	}
+
+	free(face_tris);
+	free(indices);
+	free(ref);
+}
+
+static void ufbxt_do_triangulate_mesh_test(const char *name, bool threaded, bool immediate)
+{
+	char path[512];
+	ufbxt_file_iterator iter = { name };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_scene *scene = ufbx_load_file(path, NULL, NULL);
+		ufbxt_assert(scene);
+
+		for (size_t i = 0; i < scene->meshes.count; i++) {
+			ufbx_mesh *mesh = scene->meshes.data[i];
+			ufbxt_check_triangulate_mesh(mesh, NULL, threaded, immediate);
+			for (size_t part_ix = 0; part_ix < mesh->material_parts.count; part_ix++) {
+				ufbxt_check_triangulate_mesh(mesh, &mesh->material_parts.data[part_ix], threaded, immediate);
+			}
+		}
+
+		ufbx_free_scene(scene);
+	}
+}
+#endif
+
+UFBXT_TEST(triangulate_mesh)
+#if UFBXT_IMPL
+{
+	ufbxt_do_triangulate_mesh_test("blender_293_barbarian", false, false);
+	ufbxt_do_triangulate_mesh_test("maya_ngon_maze", false, false);
+	ufbxt_do_triangulate_mesh_test("blender_300_ngon_irregular", false, false);
+	ufbxt_do_triangulate_mesh_test("maya_tri_cone", false, false);
+}
+#endif
+
+UFBXT_TEST(triangulate_mesh_threaded)
+#if UFBXT_IMPL
+{
+	ufbxt_do_triangulate_mesh_test("maya_ngon_maze", true, true);
+	ufbxt_do_triangulate_mesh_test("maya_ngon_maze", true, false);
+	ufbxt_do_triangulate_mesh_test("blender_293_barbarian", true, true);
+}
+#endif
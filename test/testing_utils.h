@@ -2098,4 +2098,67 @@ static ufbxt_noinline void *ufbxt_read_file_ex(const char *name, size_t *p_size)
 	}
 }
 
+// Thread pool that runs all tasks on the calling thread, either immediately
+// when dispatched or when waited on.
+typedef struct {
+	bool immediate;
+	bool initialized;
+	bool freed;
+	uint32_t wait_index;
+	uint32_t dispatches;
+} ufbxt_single_thread_pool;
+
+static bool ufbxt_single_thread_pool_init_fn(void *user, ufbx_thread_pool_context ctx, const ufbx_thread_pool_info *info)
+{
+	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
+	pool->initialized = true;
+	pool->wait_index = 0;
+
+	return true;
+}
+
+static void ufbxt_single_thread_pool_run_fn(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t start_index, uint32_t count)
+{
+	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
+	ufbxt_assert(pool->initialized);
+	pool->dispatches++;
+	if (!pool->immediate) return;
+
+	for (uint32_t i = 0; i < count; i++) {
+		ufbx_thread_pool_run_task(ctx, start_index + i);
+	}
+}
+
+static void ufbxt_single_thread_pool_wait_fn(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t max_index)
+{
+	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
+	ufbxt_assert(pool->initialized);
+
+	if (!pool->immediate) {
+		for (uint32_t i = pool->wait_index; i < max_index; i++) {
+			ufbx_thread_pool_run_task(ctx, i);
+		}
+	}
+
+	pool->wait_index = max_index;
+}
+
+static void ufbxt_single_thread_pool_free_fn(void *user, ufbx_thread_pool_context ctx)
+{
+	ufbxt_single_thread_pool *pool = (ufbxt_single_thread_pool*)user;
+	pool->freed = true;
+}
+
+static void ufbxt_single_thread_pool_init(ufbx_thread_pool *dst, ufbxt_single_thread_pool *pool, bool immediate)
+{
+	memset(pool, 0, sizeof(ufbxt_single_thread_pool));
+	pool->immediate = immediate;
+
+	dst->init_fn = ufbxt_single_thread_pool_init_fn;
+	dst->run_fn = ufbxt_single_thread_pool_run_fn;
+	dst->wait_fn = ufbxt_single_thread_pool_wait_fn;
+	dst->free_fn = ufbxt_single_thread_pool_free_fn;
+	dst->user = pool;
+}
+
 #endif
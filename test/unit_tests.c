@@ -14,6 +14,8 @@ void ufbxt_assert_imp(bool cond, const char *message, int line)
 
 #define ufbxt_assert(cond) ufbxt_assert_imp((cond), #cond, __LINE__)
 
+static char data_root[256];
+
 typedef struct  {
 	uint32_t a, b;
 } uint_pair;
@@ -649,11 +651,13 @@ void test_bigint_div()
 void ufbxt_check_float(const char *str)
 {
 	char *end;
+	size_t len = strlen(str) + 1;
 	double ref_d = strtod(str, NULL);
-	double slow_d = ufbxi_parse_double(str, SIZE_MAX, &end, 0);
-	double fast_d = ufbxi_parse_double(str, SIZE_MAX, &end, UFBXI_PARSE_DOUBLE_ALLOW_FAST_PATH);
+	double slow_d = ufbxi_parse_double(str, len, &end, 0);
+	double fast_d = ufbxi_parse_double(str, len, &end, UFBXI_PARSE_DOUBLE_ALLOW_FAST_PATH);
+	double approx_d = ufbxi_parse_double(str, len, &end, UFBXI_PARSE_DOUBLE_ALLOW_FAST_PATH|UFBXI_PARSE_DOUBLE_APPROXIMATE);
 	float ref_f = strtof(str, NULL);
-	float slow_f = (float)ufbxi_parse_double(str, SIZE_MAX, &end, UFBXI_PARSE_DOUBLE_AS_BINARY32);
+	float slow_f = (float)ufbxi_parse_double(str, len, &end, UFBXI_PARSE_DOUBLE_AS_BINARY32);
 
 	if (isfinite(ref_d)) {
 		if (slow_d != ref_d) {
@@ -664,6 +668,10 @@ void ufbxt_check_float(const char *str)
 			fprintf(stderr, "strtod() mismatch (fast): '%s': reference %.20g, ufbxc %.20g\n", str, ref_d, fast_d);
 			ufbxt_assert(0);
 		}
+		if (fabs(approx_d - ref_d) > fabs(ref_d) * 4e-16) {
+			fprintf(stderr, "strtod() mismatch (approximate): '%s': reference %.20g, ufbxc %.20g\n", str, ref_d, approx_d);
+			ufbxt_assert(0);
+		}
 	} else {
 		ufbxt_assert(!isfinite(fast_d));
 		ufbxt_assert(!isfinite(slow_f));
@@ -729,6 +737,17 @@ void test_double_parse()
 	ufbxt_check_float(TEST_ZEROS "." TEST_ZEROS "123" TEST_ZEROS);
 	ufbxt_check_float(TEST_ZEROS "." TEST_ZEROS TEST_ZEROS "123");
 	ufbxt_check_float("241309881603643e20");
+	ufbxt_check_float("-0.0509034991264343");
+	ufbxt_check_float("0.12345678901234567");
+	ufbxt_check_float("12345678.123456789");
+	ufbxt_check_float("9007199254740993");
+	ufbxt_check_float("9007199254740993.0000000001");
+	ufbxt_check_float("1.00000000000000011102230246251565404236316680908203125");
+	ufbxt_check_float("2.2250738585072011e-308");
+	ufbxt_check_float("1.7976931348623157e308");
+	ufbxt_check_float("1.7976931348623159e308");
+	ufbxt_check_float("3.4028235e38");
+	ufbxt_check_float("1.4e-45");
 	ufbxt_check_float(".5.57999999993498");
 	ufbxt_check_float("-71862.4328795732984723456847839347829321867347892347893274982374982349872136217381623872E-273");
 	#if !defined(_MSC_VER)
@@ -871,6 +890,166 @@ void test_sorts()
 	}
 }
 
+static float split_deflate_value(size_t index, uint32_t *p_seed)
+{
+	*p_seed = *p_seed * 1664525u + 1013904223u;
+	return (float)((uint32_t)(index / 16 % 4096) * 256 + (*p_seed >> 24)) * (1.0f / 2048.0f);
+}
+
+void test_split_deflate()
+{
+	// Generated with zlib by `misc/split_deflate_test_gen.py`
+	char path[512];
+	snprintf(path, sizeof(path), "%sdeflate_split_floats.zlib", data_root);
+	FILE *f = fopen(path, "rb");
+	ufbxt_assert(f);
+	static char src[0x80000];
+	size_t src_size = fread(src, 1, sizeof(src), f);
+	fclose(f);
+	ufbxt_assert(src_size > 0 && src_size < sizeof(src));
+
+	size_t num_values = 1 << 17;
+	size_t dst_size = num_values * sizeof(float);
+	char *dst = (char*)malloc(dst_size);
+	ufbxt_assert(dst);
+
+	ufbx_inflate_retain retain;
+	retain.initialized = false;
+	ufbxi_inflate_init_retain(&retain);
+
+	// Decode each chunk independently like the loader tasks do, with the same
+	// amount of markers as `ufbxi_setup_split_deflate()` reserves.
+	enum { num_chunks = 4 };
+	size_t markers_cap = dst_size / num_chunks / 4 + UFBXI_INFLATE_WINDOW_SIZE;
+	ufbxi_inflate_chunk chunks[num_chunks];
+	memset(chunks, 0, sizeof(chunks));
+	size_t chunk_bytes = src_size / num_chunks;
+	size_t num_decoded = 0;
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_inflate_chunk *chunk = &chunks[i];
+		chunk->data = src;
+		chunk->data_size = src_size;
+		chunk->retain = &retain;
+		chunk->begin_bit = (uint64_t)(i * chunk_bytes) * 8;
+		chunk->end_bit = i + 1 < num_chunks ? (uint64_t)((i + 1) * chunk_bytes) * 8 : UINT64_MAX;
+		if (i == 0) {
+			chunk->dst = dst;
+			chunk->dst_size = dst_size;
+		} else {
+			chunk->dst = (char*)malloc(dst_size);
+			chunk->markers = (uint16_t*)malloc(markers_cap * sizeof(uint16_t));
+			ufbxt_assert(chunk->dst && chunk->markers);
+			chunk->dst_size = dst_size;
+			chunk->markers_cap = markers_cap;
+		}
+
+		ufbxi_inflate_decode_chunk(chunk);
+		if (chunk->result == 0) num_decoded++;
+	}
+	ufbxt_assert(num_decoded == num_chunks);
+
+	ptrdiff_t res = ufbxi_inflate_finish_chunks(chunks, num_chunks, dst, dst_size, false);
+	ufbxt_assert(res == (ptrdiff_t)dst_size);
+
+	// Every chunk should line up with the previous one
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxt_assert(chunks[i].used);
+	}
+
+	uint32_t seed = 1;
+	for (size_t i = 0; i < num_values; i++) {
+		float ref = split_deflate_value(i, &seed);
+		float value;
+		memcpy(&value, dst + i * sizeof(float), sizeof(float));
+		ufbxt_assert(value == ref);
+	}
+
+	for (size_t i = 1; i < num_chunks; i++) {
+		free(chunks[i].dst);
+		free(chunks[i].markers);
+	}
+	free(dst);
+}
+
+static uint32_t ref_adler32(const char *data, size_t size)
+{
+	uint32_t a = 1, b = 0;
+	for (size_t i = 0; i < size; i++) {
+		a = (a + (uint8_t)data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	return b << 16 | a;
+}
+
+void test_adler32()
+{
+	static const size_t sizes[] = {
+		0, 1, 15, 16, 17, 31, 32, 33, 63, 255, 256, 257, 1023,
+		5551, 5552, 5553, 5802, 5803, 5804, 11105, 65537, 200001,
+	};
+
+	size_t max_size = 200001 + 64;
+	char *data = (char*)malloc(max_size);
+	ufbxt_assert(data);
+
+	// Saturated bytes stress the overflow limits of the sums, random ones the
+	// per-byte weights of the vectorized paths.
+	for (int pattern = 0; pattern < 2; pattern++) {
+		uint32_t seed = 1;
+		for (size_t i = 0; i < max_size; i++) {
+			data[i] = pattern == 0 ? (char)0xff : (char)(xorshift32(&seed) >> 24);
+		}
+
+		for (size_t si = 0; si < ufbxi_arraycount(sizes); si++) {
+			for (size_t offset = 0; offset < 32; offset++) {
+				size_t size = sizes[si];
+				uint32_t ref = ref_adler32(data + offset, size);
+				ufbxt_assert(ufbxi_adler32(data + offset, size, false) == ref);
+				ufbxt_assert(ufbxi_adler32(data + offset, size, ufbxi_cpu_has_avx2()) == ref);
+			}
+		}
+	}
+
+	free(data);
+}
+
+void test_convert_arrays()
+{
+	enum { max_size = 67 };
+	char src[max_size * 8 + 8];
+	uint32_t seed = 1;
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (char)(xorshift32(&seed) >> 24);
+	}
+
+	// Random bytes may contain NaNs, so floating point results are compared bitwise
+	// against the scalar reads.
+	static double dst_f64[2][max_size];
+	static float dst_f32[2][max_size];
+	for (size_t offset = 0; offset < 8; offset++) {
+		const char *p = src + offset;
+		for (size_t size = 0; size <= max_size; size++) {
+			for (int avx2 = 0; avx2 < 2; avx2++) {
+				bool has_avx2 = avx2 ? ufbxi_cpu_has_avx2() : false;
+				ufbxi_convert_f64_to_f32(dst_f32[avx2], p, size, has_avx2);
+				for (size_t i = 0; i < size; i++) {
+					float ref = (float)ufbxi_read_f64(p + i * 8);
+					ufbxt_assert(memcmp(&dst_f32[avx2][i], &ref, sizeof(float)) == 0 || (ref != ref && dst_f32[avx2][i] != dst_f32[avx2][i]));
+				}
+				ufbxi_convert_f32_to_f64(dst_f64[avx2], p, size, has_avx2);
+				for (size_t i = 0; i < size; i++) {
+					double ref = (double)ufbxi_read_f32(p + i * 4);
+					ufbxt_assert(memcmp(&dst_f64[avx2][i], &ref, sizeof(double)) == 0 || (ref != ref && dst_f64[avx2][i] != dst_f64[avx2][i]));
+				}
+				ufbxi_convert_i32_to_f64(dst_f64[avx2], p, size, has_avx2);
+				for (size_t i = 0; i < size; i++) {
+					ufbxt_assert(dst_f64[avx2][i] == (double)ufbxi_read_i32(p + i * 4));
+				}
+			}
+		}
+	}
+}
+
 #define UFBXT_TEST(name) { #name, &name }
 
 typedef struct {
@@ -889,10 +1068,31 @@ ufbxt_test tests[] = {
 	UFBXT_TEST(test_double_parse_bits),
 	UFBXT_TEST(test_double_parse_decimal),
 	UFBXT_TEST(test_sorts),
+	UFBXT_TEST(test_split_deflate),
+	UFBXT_TEST(test_adler32),
+	UFBXT_TEST(test_convert_arrays),
 };
 
 int main(int argc, char **argv)
 {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-d") || !strcmp(argv[i], "--data")) {
+			if (++i < argc) {
+				size_t len = strlen(argv[i]);
+				if (len + 2 > sizeof(data_root)) {
+					fprintf(stderr, "-d: Data root too long");
+					return 1;
+				}
+				memcpy(data_root, argv[i], len);
+				char end = argv[i][len - 1];
+				if (end != '/' && end != '\\') {
+					data_root[len] = '/';
+					data_root[len + 1] = '\0';
+				}
+			}
+		}
+	}
+
 	size_t num_tests = sizeof(tests) / sizeof(*tests);
 	for (size_t i = 0; i < num_tests; i++) {
 		const ufbxt_test *test = &tests[i];
@@ -1,6 +1,12 @@
 #ifndef UFBX_UFBX_C_INCLUDED
 #define UFBX_UFBX_C_INCLUDED
 
+// Strict ISO C modes (eg. `-std=c99`) hide POSIX declarations such as `mmap()`,
+// request them before any system header is included.
+#if defined(__linux__) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+	#define _POSIX_C_SOURCE 200112l
+#endif
+
 #if defined(UFBX_HEADER_PATH)
 	#include UFBX_HEADER_PATH
 #else
@@ -21,6 +27,7 @@
 //   UFBX_LITTLE_ENDIAN=0/1    Explicitly define little/big endian architecture
 //   UFBX_PATH_SEPARATOR=''    Specify default platform path separator
 //   UFBX_NO_SSE               Do not try to include SSE
+//   UFBX_NO_MMAP              Do not try to memory map files for `ufbx_load_opts.map_main_file`
 
 // Dependencies:
 //   UFBX_NO_MALLOC              Disable default malloc/realloc/free
@@ -57,7 +64,13 @@
 #define UFBXI_MIN_FILE_FORMAT_LOOKAHEAD 32
 #define UFBXI_FACE_GROUP_HASH_BITS 8
 #define UFBXI_MIN_THREADED_DEFLATE_BYTES 256
+#define UFBXI_MIN_SPLIT_DEFLATE_BYTES 0x400000
+#define UFBXI_SPLIT_DEFLATE_CHUNK_BYTES 0x200000
+#define UFBXI_SPLIT_DEFLATE_MAX_CHUNKS 64
 #define UFBXI_MIN_THREADED_ASCII_VALUES 64
+#define UFBXI_ASCII_INDEX_CHUNK_BYTES 0x40000
+#define UFBXI_ASCII_INDEX_MAX_CHUNKS 64
+#define UFBXI_SKINNING_CHUNK_SIZE 0x4000
 #define UFBXI_GEOMETRY_CACHE_BUFFER_SIZE 512
 
 #ifndef UFBXI_MAX_NURBS_ORDER
@@ -444,6 +457,12 @@ extern "C" {
 	#define ufbxi_nounroll
 #endif
 
+#if !defined(UFBX_STANDARD_C) && (defined(__GNUC__) || defined(__clang__))
+	#define ufbxi_prefetch(ptr) __builtin_prefetch(ptr)
+#else
+	#define ufbxi_prefetch(ptr) (void)(ptr)
+#endif
+
 #if defined(__GNUC__) && !defined(__clang__)
 	#define ufbxi_ignore(cond) (void)!(cond)
 #else
@@ -600,6 +619,20 @@ extern "C" {
 	#endif
 #endif
 
+#if !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_MMAP) && !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO) && defined(__linux__) && defined(_POSIX_C_SOURCE)
+	#if _POSIX_C_SOURCE >= 200112l
+		#define UFBXI_HAS_MMAP 1
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <fcntl.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+#if !defined(UFBXI_HAS_MMAP)
+	#define UFBXI_HAS_MMAP 0
+#endif
+
 #if defined(UFBX_USE_SSE) || (!defined(UFBX_STANDARD_C) && !defined(UFBX_NO_SSE) && ((defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)) || ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))))
 	#define UFBXI_HAS_SSE 1
 	#include <xmmintrin.h>
@@ -608,6 +641,18 @@ extern "C" {
 	#define UFBXI_HAS_SSE 0
 #endif
 
+// AVX2 is not part of the x86-64 baseline so it's compiled per function and selected at runtime.
+// `__builtin_cpu_supports()` needs compiler-rt which is not linked by default with clang-cl.
+#if UFBXI_HAS_SSE && !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_AVX2) && !defined(_MSC_VER) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+	#define UFBXI_HAS_AVX2 1
+	#include <immintrin.h>
+	#define ufbxi_target_avx2 __attribute__((target("avx2")))
+	#define ufbxi_cpu_has_avx2() (__builtin_cpu_supports("avx2") != 0)
+#else
+	#define UFBXI_HAS_AVX2 0
+	#define ufbxi_cpu_has_avx2() false
+#endif
+
 // -- Atomic counter
 
 #define UFBXI_THREAD_SAFE 1
@@ -922,6 +967,11 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	}
 #endif
 
+// Count trailing zeros via isolating the lowest set bit, `v` must be non-zero.
+static ufbxi_forceinline ufbxi_unused uint32_t ufbxi_ctz32(uint32_t v) {
+	return 31 - ufbxi_lzcnt32(v & (0u - v));
+}
+
 // -- Bit conversion
 
 #if defined(__cplusplus)
@@ -958,8 +1008,20 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	#undef UFBXI_MIN_THREADED_DEFLATE_BYTES
 	#define UFBXI_MIN_THREADED_DEFLATE_BYTES 2
 
+	#undef UFBXI_MIN_SPLIT_DEFLATE_BYTES
+	#define UFBXI_MIN_SPLIT_DEFLATE_BYTES 0x400
+
+	#undef UFBXI_SPLIT_DEFLATE_CHUNK_BYTES
+	#define UFBXI_SPLIT_DEFLATE_CHUNK_BYTES 0x100
+
 	#undef UFBXI_MIN_THREADED_ASCII_VALUES
 	#define UFBXI_MIN_THREADED_ASCII_VALUES 2
+
+	#undef UFBXI_ASCII_INDEX_CHUNK_BYTES
+	#define UFBXI_ASCII_INDEX_CHUNK_BYTES 0x100
+
+	#undef UFBXI_SKINNING_CHUNK_SIZE
+	#define UFBXI_SKINNING_CHUNK_SIZE 0x40
 #endif
 
 #if defined(UFBX_REGRESSION)
@@ -1313,6 +1375,89 @@ static const double ufbxi_pow10_tab_f64[] = {
 	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
 };
 
+// Normalized 128-bit approximations of `5^q` for `q` in `[UFBXI_POW5_128_MIN, UFBXI_POW5_128_MAX]`.
+// Positive powers are truncated and negative ones are rounded up as required by `ufbxi_parse_double_eisel_lemire()`.
+#define UFBXI_POW5_128_MIN -48
+#define UFBXI_POW5_128_MAX 48
+static const uint64_t ufbxi_pow5_128_tab[] = {
+	UINT64_C(0xbb127c53b17ec159), UINT64_C(0x5560c018580d5d52), UINT64_C(0xe9d71b689dde71af), UINT64_C(0xaab8f01e6e10b4a6),
+	UINT64_C(0x9226712162ab070d), UINT64_C(0xcab3961304ca70e8), UINT64_C(0xb6b00d69bb55c8d1), UINT64_C(0x3d607b97c5fd0d22),
+	UINT64_C(0xe45c10c42a2b3b05), UINT64_C(0x8cb89a7db77c506a), UINT64_C(0x8eb98a7a9a5b04e3), UINT64_C(0x77f3608e92adb242),
+	UINT64_C(0xb267ed1940f1c61c), UINT64_C(0x55f038b237591ed3), UINT64_C(0xdf01e85f912e37a3), UINT64_C(0x6b6c46dec52f6688),
+	UINT64_C(0x8b61313bbabce2c6), UINT64_C(0x2323ac4b3b3da015), UINT64_C(0xae397d8aa96c1b77), UINT64_C(0xabec975e0a0d081a),
+	UINT64_C(0xd9c7dced53c72255), UINT64_C(0x96e7bd358c904a21), UINT64_C(0x881cea14545c7575), UINT64_C(0x7e50d64177da2e54),
+	UINT64_C(0xaa242499697392d2), UINT64_C(0xdde50bd1d5d0b9e9), UINT64_C(0xd4ad2dbfc3d07787), UINT64_C(0x955e4ec64b44e864),
+	UINT64_C(0x84ec3c97da624ab4), UINT64_C(0xbd5af13bef0b113e), UINT64_C(0xa6274bbdd0fadd61), UINT64_C(0xecb1ad8aeacdd58e),
+	UINT64_C(0xcfb11ead453994ba), UINT64_C(0x67de18eda5814af2), UINT64_C(0x81ceb32c4b43fcf4), UINT64_C(0x80eacf948770ced7),
+	UINT64_C(0xa2425ff75e14fc31), UINT64_C(0xa1258379a94d028d), UINT64_C(0xcad2f7f5359a3b3e), UINT64_C(0x096ee45813a04330),
+	UINT64_C(0xfd87b5f28300ca0d), UINT64_C(0x8bca9d6e188853fc), UINT64_C(0x9e74d1b791e07e48), UINT64_C(0x775ea264cf55347e),
+	UINT64_C(0xc612062576589dda), UINT64_C(0x95364afe032a819e), UINT64_C(0xf79687aed3eec551), UINT64_C(0x3a83ddbd83f52205),
+	UINT64_C(0x9abe14cd44753b52), UINT64_C(0xc4926a9672793543), UINT64_C(0xc16d9a0095928a27), UINT64_C(0x75b7053c0f178294),
+	UINT64_C(0xf1c90080baf72cb1), UINT64_C(0x5324c68b12dd6339), UINT64_C(0x971da05074da7bee), UINT64_C(0xd3f6fc16ebca5e04),
+	UINT64_C(0xbce5086492111aea), UINT64_C(0x88f4bb1ca6bcf585), UINT64_C(0xec1e4a7db69561a5), UINT64_C(0x2b31e9e3d06c32e6),
+	UINT64_C(0x9392ee8e921d5d07), UINT64_C(0x3aff322e62439fd0), UINT64_C(0xb877aa3236a4b449), UINT64_C(0x09befeb9fad487c3),
+	UINT64_C(0xe69594bec44de15b), UINT64_C(0x4c2ebe687989a9b4), UINT64_C(0x901d7cf73ab0acd9), UINT64_C(0x0f9d37014bf60a11),
+	UINT64_C(0xb424dc35095cd80f), UINT64_C(0x538484c19ef38c95), UINT64_C(0xe12e13424bb40e13), UINT64_C(0x2865a5f206b06fba),
+	UINT64_C(0x8cbccc096f5088cb), UINT64_C(0xf93f87b7442e45d4), UINT64_C(0xafebff0bcb24aafe), UINT64_C(0xf78f69a51539d749),
+	UINT64_C(0xdbe6fecebdedd5be), UINT64_C(0xb573440e5a884d1c), UINT64_C(0x89705f4136b4a597), UINT64_C(0x31680a88f8953031),
+	UINT64_C(0xabcc77118461cefc), UINT64_C(0xfdc20d2b36ba7c3e), UINT64_C(0xd6bf94d5e57a42bc), UINT64_C(0x3d32907604691b4d),
+	UINT64_C(0x8637bd05af6c69b5), UINT64_C(0xa63f9a49c2c1b110), UINT64_C(0xa7c5ac471b478423), UINT64_C(0x0fcf80dc33721d54),
+	UINT64_C(0xd1b71758e219652b), UINT64_C(0xd3c36113404ea4a9), UINT64_C(0x83126e978d4fdf3b), UINT64_C(0x645a1cac083126ea),
+	UINT64_C(0xa3d70a3d70a3d70a), UINT64_C(0x3d70a3d70a3d70a4), UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccd),
+	UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xa000000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xc800000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xfa00000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x9c40000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xc350000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xf424000000000000), UINT64_C(0x0000000000000000), UINT64_C(0x9896800000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xbebc200000000000), UINT64_C(0x0000000000000000), UINT64_C(0xee6b280000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x9502f90000000000), UINT64_C(0x0000000000000000), UINT64_C(0xba43b74000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xe8d4a51000000000), UINT64_C(0x0000000000000000), UINT64_C(0x9184e72a00000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xb5e620f480000000), UINT64_C(0x0000000000000000), UINT64_C(0xe35fa931a0000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x8e1bc9bf04000000), UINT64_C(0x0000000000000000), UINT64_C(0xb1a2bc2ec5000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xde0b6b3a76400000), UINT64_C(0x0000000000000000), UINT64_C(0x8ac7230489e80000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xad78ebc5ac620000), UINT64_C(0x0000000000000000), UINT64_C(0xd8d726b7177a8000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x878678326eac9000), UINT64_C(0x0000000000000000), UINT64_C(0xa968163f0a57b400), UINT64_C(0x0000000000000000),
+	UINT64_C(0xd3c21bcecceda100), UINT64_C(0x0000000000000000), UINT64_C(0x84595161401484a0), UINT64_C(0x0000000000000000),
+	UINT64_C(0xa56fa5b99019a5c8), UINT64_C(0x0000000000000000), UINT64_C(0xcecb8f27f4200f3a), UINT64_C(0x0000000000000000),
+	UINT64_C(0x813f3978f8940984), UINT64_C(0x4000000000000000), UINT64_C(0xa18f07d736b90be5), UINT64_C(0x5000000000000000),
+	UINT64_C(0xc9f2c9cd04674ede), UINT64_C(0xa400000000000000), UINT64_C(0xfc6f7c4045812296), UINT64_C(0x4d00000000000000),
+	UINT64_C(0x9dc5ada82b70b59d), UINT64_C(0xf020000000000000), UINT64_C(0xc5371912364ce305), UINT64_C(0x6c28000000000000),
+	UINT64_C(0xf684df56c3e01bc6), UINT64_C(0xc732000000000000), UINT64_C(0x9a130b963a6c115c), UINT64_C(0x3c7f400000000000),
+	UINT64_C(0xc097ce7bc90715b3), UINT64_C(0x4b9f100000000000), UINT64_C(0xf0bdc21abb48db20), UINT64_C(0x1e86d40000000000),
+	UINT64_C(0x96769950b50d88f4), UINT64_C(0x1314448000000000), UINT64_C(0xbc143fa4e250eb31), UINT64_C(0x17d955a000000000),
+	UINT64_C(0xeb194f8e1ae525fd), UINT64_C(0x5dcfab0800000000), UINT64_C(0x92efd1b8d0cf37be), UINT64_C(0x5aa1cae500000000),
+	UINT64_C(0xb7abc627050305ad), UINT64_C(0xf14a3d9e40000000), UINT64_C(0xe596b7b0c643c719), UINT64_C(0x6d9ccd05d0000000),
+	UINT64_C(0x8f7e32ce7bea5c6f), UINT64_C(0xe4820023a2000000), UINT64_C(0xb35dbf821ae4f38b), UINT64_C(0xdda2802c8a800000),
+	UINT64_C(0xe0352f62a19e306e), UINT64_C(0xd50b2037ad200000), UINT64_C(0x8c213d9da502de45), UINT64_C(0x4526f422cc340000),
+	UINT64_C(0xaf298d050e4395d6), UINT64_C(0x9670b12b7f410000),
+};
+
+// 64x64 -> 128-bit multiplication, returns the high half and stores the low half in `*p_lo`.
+#if !defined(UFBX_STANDARD_C) && (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 ufbxi_uint128;
+	static ufbxi_forceinline uint64_t ufbxi_mul64_hi(uint64_t a, uint64_t b, uint64_t *p_lo) {
+		ufbxi_uint128 r = (ufbxi_uint128)a * b;
+		*p_lo = (uint64_t)r;
+		return (uint64_t)(r >> 64u);
+	}
+#elif !defined(UFBX_STANDARD_C) && defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
+	ufbxi_extern_c unsigned __int64 _umul128(unsigned __int64 a, unsigned __int64 b, unsigned __int64 *hi);
+	static ufbxi_forceinline uint64_t ufbxi_mul64_hi(uint64_t a, uint64_t b, uint64_t *p_lo) {
+		unsigned __int64 hi;
+		*p_lo = (uint64_t)_umul128((unsigned __int64)a, (unsigned __int64)b, &hi);
+		return (uint64_t)hi;
+	}
+#else
+	static ufbxi_forceinline uint64_t ufbxi_mul64_hi(uint64_t a, uint64_t b, uint64_t *p_lo) {
+		uint64_t a_lo = (uint32_t)a, a_hi = a >> 32u;
+		uint64_t b_lo = (uint32_t)b, b_hi = b >> 32u;
+		uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+		uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+		uint64_t mid = (lo_lo >> 32u) + (uint32_t)hi_lo + lo_hi;
+		*p_lo = (mid << 32u) | (uint32_t)lo_lo;
+		return hi_hi + (hi_lo >> 32u) + (mid >> 32u);
+	}
+#endif
+
 static ufbxi_noinline void ufbxi_bigint_mad(ufbxi_bigint *bigint, ufbxi_bigint_accum multiplicand, ufbxi_bigint_accum addend)
 {
 	ufbxi_dev_assert((multiplicand | addend) >> (UFBXI_BIGINT_ACCUM_BITS - 1) == 0);
@@ -1466,11 +1611,89 @@ typedef enum {
 	UFBXI_PARSE_DOUBLE_ALLOW_FAST_PATH = 0x1,
 	UFBXI_PARSE_DOUBLE_VERIFY_LENGTH = 0x2,
 	UFBXI_PARSE_DOUBLE_AS_BINARY32 = 0x4,
+	UFBXI_PARSE_DOUBLE_APPROXIMATE = 0x8,
 } ufbxi_parse_double_flag;
 
+// Returns true if `v` contains eight ASCII digits.
+static ufbxi_forceinline bool ufbxi_is_8_digits(uint64_t v)
+{
+	uint64_t a = v + UINT64_C(0x4646464646464646);
+	uint64_t b = v - UINT64_C(0x3030303030303030);
+	return ((a | b) & UINT64_C(0x8080808080808080)) == 0;
+}
+
+// Convert eight ASCII digits loaded in little-endian order to an integer.
+static ufbxi_forceinline uint32_t ufbxi_parse_8_digits(uint64_t v)
+{
+	const uint64_t mul_1 = 100 + (UINT64_C(1000000) << 32u);
+	const uint64_t mul_2 = 1 + (UINT64_C(10000) << 32u);
+	v -= UINT64_C(0x3030303030303030);
+	v = (v * 10) + (v >> 8u);
+	v = (((v & UINT64_C(0x000000FF000000FF)) * mul_1) + (((v >> 16u) & UINT64_C(0x000000FF000000FF)) * mul_2)) >> 32u;
+	return (uint32_t)v;
+}
+
+// Eisel-Lemire algorithm: Round `w * 10^q` correctly using a 128-bit approximation of `5^q`, see
+// "Number Parsing at a Gigabyte per Second" and "Fast Number Parsing Without Fallback" by Lemire et al.
+// Returns `false` if the result would be subnormal, infinite or `q` is outside of `ufbxi_pow5_128_tab[]`.
+static ufbxi_noinline bool ufbxi_parse_double_eisel_lemire(uint64_t *p_bits, uint64_t w, int32_t q, uint32_t flags)
+{
+	ufbxi_dev_assert(w != 0);
+	if (q < UFBXI_POW5_128_MIN || q > UFBXI_POW5_128_MAX) return false;
+
+	uint32_t mantissa_bits = 52;
+	int32_t min_exponent = -1023, round_to_even_min = -4, round_to_even_max = 23, infinite_power = 0x7ff;
+	if (flags & UFBXI_PARSE_DOUBLE_AS_BINARY32) {
+		mantissa_bits = 23;
+		min_exponent = -127;
+		round_to_even_min = -17;
+		round_to_even_max = 10;
+		infinite_power = 0xff;
+	}
+
+	uint32_t lz = ufbxi_lzcnt64(w);
+	w <<= lz;
+
+	// The first 64 bits of `5^q` are enough unless the bits below the result mantissa are all ones.
+	const uint64_t *pow5 = ufbxi_pow5_128_tab + (size_t)(q - UFBXI_POW5_128_MIN) * 2;
+	uint64_t lo, hi = ufbxi_mul64_hi(w, pow5[0], &lo);
+	uint64_t precision_mask = UINT64_MAX >> (mantissa_bits + 3);
+	if ((hi & precision_mask) == precision_mask) {
+		uint64_t lo_lo, lo_hi = ufbxi_mul64_hi(w, pow5[1], &lo_lo);
+		lo += lo_hi;
+		if (lo_hi > lo) hi++;
+	}
+
+	// `floor(q * log2(10))` with a positive bias to keep the shift well defined.
+	int32_t pow2_q = (int32_t)(((int64_t)217706 * q + ((int64_t)1 << 40)) >> 16) - (1 << 24);
+
+	uint32_t upper_bit = (uint32_t)(hi >> 63u);
+	uint32_t shift = upper_bit + 64 - mantissa_bits - 3;
+	uint64_t mantissa = hi >> shift;
+	int32_t power2 = pow2_q + 63 + (int32_t)upper_bit - (int32_t)lz - min_exponent;
+	if (power2 <= 0) return false;
+
+	// Exactly halfway between two values is only possible when `5^q` fits in 64 bits, round to even.
+	if (lo <= 1 && q >= round_to_even_min && q <= round_to_even_max && (mantissa & 3) == 1 && (mantissa << shift) == hi) {
+		mantissa &= ~(uint64_t)1;
+	}
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= (UINT64_C(2) << mantissa_bits)) {
+		mantissa = UINT64_C(1) << mantissa_bits;
+		power2++;
+	}
+	mantissa &= ~(UINT64_C(1) << mantissa_bits);
+	if (power2 >= infinite_power) return false;
+
+	*p_bits = mantissa | (uint64_t)power2 << mantissa_bits;
+	return true;
+}
+
 static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_length, char **end, uint32_t flags)
 {
-	const uint32_t max_limbs = 14;
+	uint32_t max_limbs = 14;
 
 	ufbxi_bigint_limb mantissa_limbs[42], divisor_limbs[42], quotient_limbs[42];
 	ufbxi_bigint big_mantissa = ufbxi_bigint_array(mantissa_limbs);
@@ -1490,7 +1713,11 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 			if (big_mantissa.length < max_limbs) {
 				digits = digits * 10 + (uint64_t)(c - '0');
 				num_digits++;
-				if (num_digits >= 18) {
+				if (num_digits >= 18 && (flags & UFBXI_PARSE_DOUBLE_APPROXIMATE) != 0 && big_mantissa.length == 0) {
+					// Approximate: Ignore digits past the first 17 significant ones, `digits` can
+					// hold one more digit than that so the check is deferred until then.
+					if (digits >= UINT64_C(100000000000000000)) max_limbs = 0;
+				} else if (num_digits >= 18) {
 					ufbxi_dev_assert(num_digits < ufbxi_arraycount(ufbxi_pow5_tab));
 					ufbxi_bigint_mad(&big_mantissa, ufbxi_pow5_tab[num_digits] << num_digits, digits);
 					digits = 0;
@@ -1503,6 +1730,16 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 			}
 		} else if (c == '.' && !has_dot) {
 			has_dot = true;
+
+			// Long fractional parts: Consume eight digits at a time as long as they fit in `digits`
+			while (num_digits < 10 && big_mantissa.length < max_limbs && ufbxi_to_size(p - str) + 8 <= max_length) {
+				uint64_t v = ufbxi_read_u64(p);
+				if (!ufbxi_is_8_digits(v)) break;
+				digits = digits * 100000000u + ufbxi_parse_8_digits(v);
+				num_digits += 8;
+				dec_exponent -= 8;
+				p += 8;
+			}
 		} else {
 			break;
 		}
@@ -1549,10 +1786,27 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 	}
 
 	if (big_mantissa.length == 0) {
+		if (digits == 0) return negative ? -0.0 : 0.0;
+
+		// Correctly rounded without arbitrary precision for most values, falls back to the bigint path below.
+		uint64_t bits;
+		if (ufbxi_parse_double_eisel_lemire(&bits, digits, dec_exponent, flags)) {
+			if (flags & UFBXI_PARSE_DOUBLE_AS_BINARY32) {
+				uint32_t bits_lo = (uint32_t)bits | (negative ? 0x80000000u : 0u);
+				float result;
+				ufbxi_bit_cast(float, result, uint32_t, bits_lo);
+				return result;
+			} else {
+				bits |= (uint64_t)(negative ? 1u : 0u) << 63u;
+				double result;
+				ufbxi_bit_cast(double, result, uint64_t, bits);
+				return result;
+			}
+		}
+
 		big_mantissa.limbs[0] = (ufbxi_bigint_limb)digits;
 		big_mantissa.limbs[1] = (ufbxi_bigint_limb)(digits >> 32u);
-		big_mantissa.length = (digits >> 32u) ? 2 : digits ? 1 : 0;
-		if (big_mantissa.length == 0) return negative ? -0.0 : 0.0;
+		big_mantissa.length = (digits >> 32u) ? 2 : 1;
 	} else {
 		ufbxi_dev_assert(num_digits < ufbxi_arraycount(ufbxi_pow5_tab));
 		ufbxi_bigint_mad(&big_mantissa, ufbxi_pow5_tab[num_digits] << num_digits, digits);
@@ -1883,6 +2137,7 @@ typedef struct {
 
 typedef struct {
 	bool initialized;
+	bool has_avx2; // < Cached `ufbxi_cpu_has_avx2()`
 	ufbxi_trees static_trees;
 } ufbxi_inflate_retain_imp;
 
@@ -1895,6 +2150,19 @@ typedef struct {
 	char *out_begin;
 	char *out_ptr;
 	char *out_end;
+
+	// Bit offset of the beginning of `stream` in the whole DEFLATE stream.
+	uint64_t bit_offset;
+
+	// Stop decoding before a dynamic Huffman block that starts at or after `stop_bit`.
+	uint64_t stop_bit;
+
+	// While non-NULL, output values are written to `markers[]` instead of `out_begin[]`,
+	// see `ufbxi_inflate_block_markers()`.
+	uint16_t *markers;
+	size_t markers_cap;
+	size_t marker_end;  // < One past the last value that refers to the unknown window
+	size_t num_markers; // < Number of values written to `markers[]`
 } ufbxi_deflate_context;
 
 static ufbxi_forceinline uint32_t
@@ -2076,6 +2344,10 @@ ufbxi_bit_copy_bytes(void *dst, ufbxi_bit_stream *s, size_t len)
 		s->left -= 8;
 	}
 
+	// Short blocks may be fully contained in the buffered bits, in which case
+	// we must keep the rest of them.
+	if (len == 0) return 1;
+
 	// We need to clear the top bits as there may be data
 	// read ahead past `s->left` in some cases
 	s->bits = 0;
@@ -2530,7 +2802,49 @@ ufbxi_init_dynamic_huff(ufbxi_deflate_context *dc, ufbxi_trees *trees)
 	return 0;
 }
 
-static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size)
+#if UFBXI_HAS_AVX2
+
+// Accumulate Adler-32 sums 32 bytes at a time using AVX2, returns a pointer to the
+// first unprocessed byte. `end - p` must be within the SSE chunk limit (5803).
+static ufbxi_noinline ufbxi_target_avx2 const char *ufbxi_adler32_avx2(const char *p, const char *end, ufbxi_fast_uint *p_a, ufbxi_fast_uint *p_b)
+{
+	size_t chunk_size = ufbxi_to_size(end - p) & ~(size_t)0x1f;
+	if (chunk_size == 0) return p;
+	const char *chunk_end = p + chunk_size;
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i factor_1 = _mm256_set1_epi16(1);
+	const __m256i factors = _mm256_setr_epi8(
+		32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+
+	// `s1_prev` accumulates the value of `s1` before each 32 byte block, which
+	// contributes `32 * s1` to `s2`.
+	__m256i s1 = zero, s2 = zero, s1_prev = zero;
+	while (p != chunk_end) {
+		__m256i d = _mm256_loadu_si256((const __m256i*)p);
+		s1_prev = _mm256_add_epi32(s1_prev, s1);
+		s1 = _mm256_add_epi32(s1, _mm256_sad_epu8(d, zero));
+		s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_maddubs_epi16(d, factors), factor_1));
+		p += 32;
+	}
+	s2 = _mm256_add_epi32(s2, _mm256_slli_epi32(s1_prev, 5));
+
+	__m128i s1_sum = _mm_add_epi32(_mm256_castsi256_si128(s1), _mm256_extracti128_si256(s1, 1));
+	__m128i s2_sum = _mm_add_epi32(_mm256_castsi256_si128(s2), _mm256_extracti128_si256(s2, 1));
+	s1_sum = _mm_add_epi32(s1_sum, _mm_shuffle_epi32(s1_sum, _MM_SHUFFLE(1,0,3,2)));
+	s2_sum = _mm_add_epi32(s2_sum, _mm_shuffle_epi32(s2_sum, _MM_SHUFFLE(2,3,0,1)));
+	s2_sum = _mm_add_epi32(s2_sum, _mm_shuffle_epi32(s2_sum, _MM_SHUFFLE(1,0,3,2)));
+
+	*p_b += chunk_size * *p_a;
+	*p_a += (uint32_t)_mm_cvtsi128_si32(s1_sum);
+	*p_b += (uint32_t)_mm_cvtsi128_si32(s2_sum);
+	return p;
+}
+
+#endif
+
+static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size, bool has_avx2)
 {
 	ufbxi_fast_uint a = 1, b = 0;
 	const char *p = (const char*)data;
@@ -2540,6 +2854,10 @@ static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size)
 	// the size of the type holding the sum.
 	const ufbxi_fast_uint num_before_wrap = sizeof(ufbxi_fast_uint) == 8 ? 380368439u : 5552u;
 
+#if !UFBXI_HAS_AVX2
+	(void)has_avx2;
+#endif
+
 	ufbxi_fast_uint size_left = size;
 	while (size_left > 0) {
 		ufbxi_fast_uint num = size_left <= num_before_wrap ? size_left : num_before_wrap;
@@ -2552,6 +2870,14 @@ static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size)
 			p++;
 		}
 
+#if UFBXI_HAS_AVX2
+		if (has_avx2) {
+			while (ufbxi_to_size(end - p) >= 32) {
+				p = ufbxi_adler32_avx2(p, p + ufbxi_min_sz(ufbxi_to_size(end - p), 5803), &a, &b);
+			}
+		}
+#endif
+
 #if UFBXI_HAS_SSE
 		static const uint16_t factors[2][8] = {
 			{ 16, 15, 14, 13, 12, 11, 10, 9, },
@@ -2960,79 +3286,140 @@ ufbxi_inflate_block_fast(ufbxi_deflate_context *dc, ufbxi_trees *trees)
 	#undef ufbxi_fast_inflate_should_continue
 }
 
-static void ufbxi_inflate_init_retain(ufbx_inflate_retain *retain)
-{
-	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)retain;
-	if (!ret_imp->initialized) {
-		ufbxi_init_static_huff(&ret_imp->static_trees, NULL);
-		ret_imp->initialized = true;
-	}
-}
+#define UFBXI_INFLATE_WINDOW_SIZE 32768
+#define UFBXI_INFLATE_MARKER 0x8000
 
-// TODO: Error codes should have a quick test if the destination buffer overflowed
-// Returns actual number of decompressed bytes or negative error:
-// -1: Bad compression method (ZLIB header)
-// -2: Requires dictionary (ZLIB header)
-// -3: Bad FCHECK (ZLIB header)
-// -4: Bad NLEN (Uncompressed LEN != ~NLEN)
-// -5: Uncompressed source overflow
-// -6: Uncompressed destination overflow
-// -7: Bad block type
-// -8: Truncated checksum (deprecated, reported as -9)
-// -9: Checksum mismatch
-// -10: Literal destination overflow
-// -11: Bad distance code or distance of (30..31)
-// -12: Match out of bounds
-// -13: Bad lit/length code
-// -14: Codelen Huffman Overfull
-// -15: Codelen Huffman Underfull
-// -16 - -21: Litlen Huffman: Overfull / Underfull / Repeat 16/17/18 overflow / Bad length code
-// -22 - -27: Distance Huffman: Overfull / Underfull / Repeat 16/17/18 overflow / Bad length code
-// -28: Cancelled
-// -29: Invalid ufbx_inflate_input.internal_fast_bits value
-ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inflate_input *input, ufbx_inflate_retain *retain)
+// Variant of `ufbxi_inflate_block_slow()` used when decoding starts in the middle of a stream without
+// knowing the preceding 32kB window. Values are written to `dc->markers[]`: Either literal bytes or
+// `UFBXI_INFLATE_MARKER | index` referring to `window[index]` where the window is the 32kB of output
+// preceding `dc->out_begin`. As soon as the last 32kB of output contains no markers all further matches
+// must resolve to known bytes, so we copy the resolved window to `dc->out_begin[]` and switch to bytes.
+// Returns 0 at the end of block, 1 when switched to bytes or negative error (-30 if out of markers).
+static ufbxi_noinline int
+ufbxi_inflate_block_markers(ufbxi_deflate_context *dc, ufbxi_trees *trees)
 {
-	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)retain;
+	uint16_t *markers = dc->markers;
+	size_t pos = ufbxi_to_size(dc->out_ptr - dc->out_begin);
+	size_t out_size = ufbxi_to_size(dc->out_end - dc->out_begin);
+	size_t max_pos = ufbxi_min_sz(out_size, dc->markers_cap);
+	size_t marker_end = dc->marker_end;
 
-	ptrdiff_t err;
-	ufbxi_deflate_context dc;
-	ufbxi_bit_stream_init(&dc.stream, input);
-	dc.out_begin = (char*)dst;
-	dc.out_ptr = (char*)dst;
-	dc.out_end = (char*)dst + dst_size;
-	if (input->internal_fast_bits != 0) {
-		dc.fast_bits = (uint32_t)input->internal_fast_bits;
-		if (dc.fast_bits < 1 || dc.fast_bits == 9 || dc.fast_bits > 10) return -29;
-	} else {
-		// TODO: Profile this
-		dc.fast_bits = input->total_size > 2048 ? 10 : 8;
-	}
+	uint32_t fast_bits = trees->fast_bits;
+	uint32_t fast_mask = (1u << fast_bits) - 1;
 
-	uint64_t bits = dc.stream.bits;
-	size_t left = dc.stream.left;
-	const char *data = dc.stream.chunk_ptr;
+	uint64_t bits = dc->stream.bits;
+	size_t left = dc->stream.left;
+	const char *data = dc->stream.chunk_ptr;
 
-	ufbxi_bit_refill(&bits, &left, &data, &dc.stream);
-	if (dc.stream.cancelled) return -28;
+	int result = 0;
+	for (;;) {
+		if (pos - marker_end >= UFBXI_INFLATE_WINDOW_SIZE) {
+			// No match can reach a marker anymore: Resolve the window to bytes.
+			for (size_t i = pos - UFBXI_INFLATE_WINDOW_SIZE; i < pos; i++) {
+				dc->out_begin[i] = (char)(uint8_t)markers[i];
+			}
+			dc->markers = NULL;
+			result = 1;
+			break;
+		}
 
-	// Zlib header
-	if (!input->no_header) {
-		size_t cmf = (size_t)(bits & 0xff);
-		size_t flg = (size_t)(bits >> 8) & 0xff;
-		bits >>= 16;
-		left -= 16;
+		ufbxi_bit_refill(&bits, &left, &data, &dc->stream);
+		uint64_t sym_bits = bits;
 
-		if ((cmf & 0xf) != 0x8) return -1;
-		if ((flg & 0x20) != 0) return -2;
-		if ((cmf << 8 | flg) % 31u != 0) return -3;
+		ufbxi_huff_sym sym0 = ufbxi_huff_decode_bits(&trees->lit_length, bits, fast_bits, fast_mask);
+		uint32_t sym0_bits = ufbxi_huff_sym_total_bits(sym0);
+
+		bits >>= sym0_bits;
+		left -= sym0_bits;
+		if (sym0 & UFBXI_HUFF_SYM_END) {
+			if (ufbxi_huff_sym_value(sym0) != 0) return -13;
+			break;
+		} else if ((sym0 & UFBXI_HUFF_SYM_MATCH) == 0) {
+			if (pos == max_pos) return max_pos < out_size ? -30 : -10;
+			markers[pos++] = (uint16_t)ufbxi_huff_sym_value(sym0);
+			continue;
+		}
+
+		uint32_t sym0_value = ufbxi_huff_sym_value(sym0);
+		uint32_t len_shift_base = trees->lit_length.extra_shift_base[sym0_value];
+		uint16_t len_mask = trees->lit_length.extra_mask[sym0_value];
+		uint32_t length = (len_shift_base >> 16) + (uint32_t)(ufbxi_wrap_shr64(sym_bits, len_shift_base) & len_mask);
+
+		ufbxi_huff_sym sym1 = ufbxi_huff_decode_bits(&trees->dist, bits, fast_bits, fast_mask);
+		if (sym1 & UFBXI_HUFF_SYM_END) return -11;
+
+		uint32_t sym1_bits = ufbxi_huff_sym_total_bits(sym1);
+
+		bits >>= sym1_bits;
+		left -= sym1_bits;
+
+		uint32_t sym1_value = ufbxi_huff_sym_value(sym1);
+		uint32_t dist_shift_base = trees->dist.extra_shift_base[sym1_value];
+		uint16_t dist_mask = trees->dist.extra_mask[sym1_value];
+		uint32_t distance = (dist_shift_base >> 16) + (uint32_t)(ufbxi_wrap_shr64(sym_bits, dist_shift_base + sym0) & dist_mask);
+
+		if (length > max_pos - pos) return max_pos < out_size ? -30 : -12;
+
+		// Matches reaching past the beginning refer to the unknown window, distances are
+		// at most 32768 so the window index is always valid.
+		size_t end = pos + length;
+		if (distance > pos) {
+			size_t window_end = ufbxi_min_sz(end, distance);
+			size_t index = UFBXI_INFLATE_WINDOW_SIZE + pos - distance;
+			for (; pos < window_end; pos++) {
+				markers[pos] = (uint16_t)(UFBXI_INFLATE_MARKER | index++);
+			}
+			marker_end = pos;
+		}
+		for (; pos < end; pos++) {
+			uint16_t value = markers[pos - distance];
+			markers[pos] = value;
+			marker_end = (value & UFBXI_INFLATE_MARKER) != 0 ? pos + 1 : marker_end;
+		}
 	}
 
+	dc->num_markers = pos;
+	dc->marker_end = marker_end;
+	dc->out_ptr = dc->out_begin + pos;
+	dc->stream.bits = bits;
+	dc->stream.left = left;
+	dc->stream.chunk_ptr = data;
+	return result;
+}
+
+static ufbxi_forceinline uint64_t
+ufbxi_inflate_bit_offset(const ufbxi_deflate_context *dc, const char *data, size_t left)
+{
+	uint64_t num_bytes = (uint64_t)dc->stream.num_read_before_chunk + (uint64_t)(data - dc->stream.chunk_begin);
+	return dc->bit_offset + num_bytes * 8 - left;
+}
+
+// Decode DEFLATE blocks until the end of the final block, see `ufbx_inflate()` for error codes.
+// Returns 0 after the final block, or 1 if stopped due to `dc->stop_bit` (stream points to the block header).
+static ufbxi_noinline ptrdiff_t
+ufbxi_inflate_blocks(ufbxi_deflate_context *dc, ufbxi_inflate_retain_imp *ret_imp, const ufbx_inflate_input *input)
+{
+	ptrdiff_t err;
+
+	uint64_t bits = dc->stream.bits;
+	size_t left = dc->stream.left;
+	const char *data = dc->stream.chunk_ptr;
+
 	for (;;) {
-		ufbxi_bit_refill(&bits, &left, &data, &dc.stream);
-		if (dc.stream.cancelled) return -28;
+		ufbxi_bit_refill(&bits, &left, &data, &dc->stream);
+		if (dc->stream.cancelled) return -28;
 
 		// Block header: [0:1] BFINAL [1:3] BTYPE
 		size_t header = (size_t)bits & 0x7;
+
+		// Split decoding: Stop at the first dynamic block past `stop_bit`
+		if (header >> 1 == 2 && dc->stop_bit != UINT64_MAX && ufbxi_inflate_bit_offset(dc, data, left) >= dc->stop_bit) {
+			dc->stream.bits = bits;
+			dc->stream.left = left;
+			dc->stream.chunk_ptr = data;
+			return 1;
+		}
+
 		bits >>= 3;
 		left -= 3;
 
@@ -3047,24 +3434,34 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 			size_t len = (size_t)(bits & 0xffff);
 			size_t nlen = (size_t)((bits >> 16) & 0xffff);
 			if ((len ^ nlen) != 0xffff) return -4;
-			if (dc.out_end - dc.out_ptr < (ptrdiff_t)len) return -6;
+			if (dc->out_end - dc->out_ptr < (ptrdiff_t)len) return -6;
 			bits >>= 32;
 			left -= 32;
 
-			dc.stream.bits = bits;
-			dc.stream.left = left;
-			dc.stream.chunk_ptr = data;
+			dc->stream.bits = bits;
+			dc->stream.left = left;
+			dc->stream.chunk_ptr = data;
 
 			// Copy `len` bytes of literal data
-			if (!ufbxi_bit_copy_bytes(dc.out_ptr, &dc.stream, len)) return -5;
+			if (!ufbxi_bit_copy_bytes(dc->out_ptr, &dc->stream, len)) return -5;
+
+			// Literal data never refers to the window so it can be widened as-is
+			if (dc->markers) {
+				size_t pos = ufbxi_to_size(dc->out_ptr - dc->out_begin);
+				if (len > dc->markers_cap - pos) return -30;
+				for (size_t i = 0; i < len; i++) {
+					dc->markers[pos + i] = (uint8_t)dc->out_ptr[i];
+				}
+				dc->num_markers = pos + len;
+			}
 
-			dc.out_ptr += len;
+			dc->out_ptr += len;
 
 		} else if (type <= 2) {
 
-			dc.stream.bits = bits;
-			dc.stream.left = left;
-			dc.stream.chunk_ptr = data;
+			dc->stream.bits = bits;
+			dc->stream.left = left;
+			dc->stream.chunk_ptr = data;
 
 			ufbxi_trees tree_data; // ufbxi_uninit
 			ufbxi_trees *trees; // ufbxi_uninit
@@ -3072,30 +3469,39 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 				// Static Huffman: Initialize the trees once and cache them in `retain`.
 				if (!ret_imp->initialized) {
 					ufbxi_init_static_huff(&ret_imp->static_trees, input);
+					ret_imp->has_avx2 = ufbxi_cpu_has_avx2();
 					ret_imp->initialized = true;
 				}
 				trees = &ret_imp->static_trees;
 			} else {
 				// Dynamic Huffman
-				err = ufbxi_init_dynamic_huff(&dc, &tree_data);
+				err = ufbxi_init_dynamic_huff(dc, &tree_data);
 				if (err) return err;
 				trees = &tree_data;
 			}
 
 			for (;;) {
-				bool fast_viable = trees->fast_bits == UFBXI_HUFF_FAST_BITS && dc.out_end - dc.out_ptr >= UFBXI_INFLATE_FAST_MIN_OUT;
+				if (dc->markers) {
+					err = ufbxi_inflate_block_markers(dc, trees);
+					if (err < 0) return err;
+					if (dc->stream.cancelled) return -28;
+					if (err == 0) break;
+					continue;
+				}
+
+				bool fast_viable = trees->fast_bits == UFBXI_HUFF_FAST_BITS && dc->out_end - dc->out_ptr >= UFBXI_INFLATE_FAST_MIN_OUT;
 
 				// `ufbxi_inflate_block_fast()` needs a bit more upfront setup, see asserts on top of the function
-				if (fast_viable && dc.stream.chunk_yield - dc.stream.chunk_ptr >= UFBXI_INFLATE_FAST_MIN_IN) {
-					err = ufbxi_inflate_block_fast(&dc, trees);
+				if (fast_viable && dc->stream.chunk_yield - dc->stream.chunk_ptr >= UFBXI_INFLATE_FAST_MIN_IN) {
+					err = ufbxi_inflate_block_fast(dc, trees);
 				} else {
-					err = ufbxi_inflate_block_slow(&dc, trees, fast_viable ? 32 : SIZE_MAX);
+					err = ufbxi_inflate_block_slow(dc, trees, fast_viable ? 32 : SIZE_MAX);
 				}
 
 				if (err < 0) return err;
 
 				// `ufbxi_inflate_block()` returns normally on cancel so check it here
-				if (dc.stream.cancelled) return -28;
+				if (dc->stream.cancelled) return -28;
 
 				if (err == 0) break;
 			}
@@ -3105,14 +3511,112 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 			return -7;
 		}
 
-		bits = dc.stream.bits;
-		left = dc.stream.left;
-		data = dc.stream.chunk_ptr;
+		bits = dc->stream.bits;
+		left = dc->stream.left;
+		data = dc->stream.chunk_ptr;
 
 		// BFINAL: End of stream
 		if (header & 1) break;
 	}
 
+	dc->stream.bits = bits;
+	dc->stream.left = left;
+	dc->stream.chunk_ptr = data;
+	return 0;
+}
+
+static void ufbxi_inflate_init_retain(ufbx_inflate_retain *retain)
+{
+	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)retain;
+	if (!ret_imp->initialized) {
+		ufbxi_init_static_huff(&ret_imp->static_trees, NULL);
+		ret_imp->has_avx2 = ufbxi_cpu_has_avx2();
+		ret_imp->initialized = true;
+	}
+}
+
+static ufbxi_forceinline ptrdiff_t ufbxi_inflate_check_zlib_header(uint64_t bits)
+{
+	size_t cmf = (size_t)(bits & 0xff);
+	size_t flg = (size_t)(bits >> 8) & 0xff;
+	if ((cmf & 0xf) != 0x8) return -1;
+	if ((flg & 0x20) != 0) return -2;
+	if ((cmf << 8 | flg) % 31u != 0) return -3;
+	return 0;
+}
+
+// TODO: Error codes should have a quick test if the destination buffer overflowed
+// Returns actual number of decompressed bytes or negative error:
+// -1: Bad compression method (ZLIB header)
+// -2: Requires dictionary (ZLIB header)
+// -3: Bad FCHECK (ZLIB header)
+// -4: Bad NLEN (Uncompressed LEN != ~NLEN)
+// -5: Uncompressed source overflow
+// -6: Uncompressed destination overflow
+// -7: Bad block type
+// -8: Truncated checksum (deprecated, reported as -9)
+// -9: Checksum mismatch
+// -10: Literal destination overflow
+// -11: Bad distance code or distance of (30..31)
+// -12: Match out of bounds
+// -13: Bad lit/length code
+// -14: Codelen Huffman Overfull
+// -15: Codelen Huffman Underfull
+// -16 - -21: Litlen Huffman: Overfull / Underfull / Repeat 16/17/18 overflow / Bad length code
+// -22 - -27: Distance Huffman: Overfull / Underfull / Repeat 16/17/18 overflow / Bad length code
+// -28: Cancelled
+// -29: Invalid ufbx_inflate_input.internal_fast_bits value
+// -30: Out of markers (internal, split decoding only)
+ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inflate_input *input, ufbx_inflate_retain *retain)
+{
+	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)retain;
+
+	ptrdiff_t err;
+	ufbxi_deflate_context dc;
+	ufbxi_bit_stream_init(&dc.stream, input);
+	dc.out_begin = (char*)dst;
+	dc.out_ptr = (char*)dst;
+	dc.out_end = (char*)dst + dst_size;
+	dc.bit_offset = 0;
+	dc.stop_bit = UINT64_MAX;
+	dc.markers = NULL;
+	dc.markers_cap = 0;
+	dc.marker_end = 0;
+	dc.num_markers = 0;
+	if (input->internal_fast_bits != 0) {
+		dc.fast_bits = (uint32_t)input->internal_fast_bits;
+		if (dc.fast_bits < 1 || dc.fast_bits == 9 || dc.fast_bits > 10) return -29;
+	} else {
+		// TODO: Profile this
+		dc.fast_bits = input->total_size > 2048 ? 10 : 8;
+	}
+
+	uint64_t bits = dc.stream.bits;
+	size_t left = dc.stream.left;
+	const char *data = dc.stream.chunk_ptr;
+
+	ufbxi_bit_refill(&bits, &left, &data, &dc.stream);
+	if (dc.stream.cancelled) return -28;
+
+	// Zlib header
+	if (!input->no_header) {
+		err = ufbxi_inflate_check_zlib_header(bits);
+		if (err) return err;
+		bits >>= 16;
+		left -= 16;
+	}
+
+	dc.stream.bits = bits;
+	dc.stream.left = left;
+	dc.stream.chunk_ptr = data;
+
+	err = ufbxi_inflate_blocks(&dc, ret_imp, input);
+	if (err < 0) return err;
+
+	bits = dc.stream.bits;
+	left = dc.stream.left;
+	data = dc.stream.chunk_ptr;
+
 	// Check Adler-32
 	{
 		// Round up to the next byte
@@ -3126,7 +3630,8 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 			uint32_t ref = (uint32_t)bits;
 			ref = (ref>>24) | ((ref>>8)&0xff00) | ((ref<<8)&0xff0000) | (ref<<24);
 
-			uint32_t checksum = ufbxi_adler32(dc.out_begin, ufbxi_to_size(dc.out_ptr - dc.out_begin));
+			bool has_avx2 = ret_imp->initialized ? ret_imp->has_avx2 : ufbxi_cpu_has_avx2();
+			uint32_t checksum = ufbxi_adler32(dc.out_begin, ufbxi_to_size(dc.out_ptr - dc.out_begin), has_avx2);
 			if (ref != checksum) {
 				return -9;
 			}
@@ -3136,6 +3641,352 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 	return dc.out_ptr - dc.out_begin;
 }
 
+// -- Split DEFLATE
+//
+// A single large DEFLATE stream can be decoded in parallel by splitting the compressed data at
+// arbitrary bit offsets. Each chunk searches for the first plausible dynamic Huffman block header
+// past its nominal beginning and decodes until the first dynamic block at or past its nominal end.
+// Output that depends on the unknown preceding window is stored as markers until it can be resolved,
+// see `ufbxi_inflate_block_markers()`. `ufbxi_inflate_finish_chunks()` chains the results: A chunk is
+// only used if it starts exactly where the previous one stopped, anything else is decoded serially,
+// so the output is always identical to `ufbx_inflate()`.
+
+#define UFBXI_INFLATE_CHUNK_MAX_ATTEMPTS 16
+
+// zlib blocks are at most ~100kB compressed so search a bit further than that for the first block
+#define UFBXI_INFLATE_CHUNK_MAX_SEARCH_BITS (0x20000*8)
+
+typedef struct {
+	// Compressed zlib stream
+	const void *data;
+	size_t data_size;
+	ufbx_inflate_retain *retain;
+
+	// Nominal range of the chunk in bits, the first chunk must have `begin_bit == 0`.
+	uint64_t begin_bit;
+	uint64_t end_bit;
+
+	// Output buffer, the first chunk should decode directly to the final destination.
+	char *dst;
+	size_t dst_size;
+
+	// Markers for the beginning of non-first chunks.
+	uint16_t *markers;
+	size_t markers_cap;
+
+	// Results, `result` is zero on success or negative error.
+	ptrdiff_t result;
+	uint64_t start_bit;
+	uint64_t stop_bit;
+	size_t out_size;
+	size_t num_markers;
+	bool final;
+
+	// Set by `ufbxi_inflate_finish_chunks()` if the decoded output of the chunk was used.
+	bool used;
+} ufbxi_inflate_chunk;
+
+static ufbxi_noinline void ufbxi_inflate_init_at_bit(ufbxi_deflate_context *dc, const char *data, size_t data_size, uint64_t bit, char *out_begin, char *out_ptr, char *out_end)
+{
+	size_t byte_offset = (size_t)(bit >> 3);
+	ufbx_assert(byte_offset <= data_size);
+
+	ufbx_inflate_input input; // ufbxi_uninit
+	memset(&input, 0, sizeof(input));
+	input.data = data + byte_offset;
+	input.data_size = data_size - byte_offset;
+	input.total_size = data_size - byte_offset;
+	ufbxi_bit_stream_init(&dc->stream, &input);
+
+	dc->fast_bits = UFBXI_HUFF_FAST_BITS;
+	dc->out_begin = out_begin;
+	dc->out_ptr = out_ptr;
+	dc->out_end = out_end;
+	dc->bit_offset = (uint64_t)byte_offset * 8;
+	dc->stop_bit = UINT64_MAX;
+	dc->markers = NULL;
+	dc->markers_cap = 0;
+	dc->marker_end = 0;
+	dc->num_markers = 0;
+
+	uint32_t skip_bits = (uint32_t)(bit & 0x7);
+	ufbxi_bit_refill(&dc->stream.bits, &dc->stream.left, &dc->stream.chunk_ptr, &dc->stream);
+	dc->stream.bits >>= skip_bits;
+	dc->stream.left -= skip_bits;
+}
+
+// Check if `bit` could be the start of a dynamic Huffman block without building the full trees:
+// Valid symbol counts, complete code length code and complete literal/length and distance codes
+// that contain the end-of-block symbol. This rejects practically all false positives.
+static ufbxi_noinline bool ufbxi_inflate_check_block_header(const char *data, size_t data_size, uint64_t bit)
+{
+	uint64_t max_bit = (uint64_t)(data_size - 8) * 8;
+	uint64_t bits = ufbxi_read_u64(data + (size_t)(bit >> 3)) >> (bit & 0x7);
+
+	// BTYPE=2, HLIT <= 29, HDIST <= 29
+	if ((bits & 0x6) != 0x4) return false;
+	if ((bits >> 3 & 0x1f) > 29 || (bits >> 8 & 0x1f) > 29) return false;
+	uint32_t num_lit_lengths = 257 + (uint32_t)(bits >> 3 & 0x1f);
+	uint32_t num_dists = 1 + (uint32_t)(bits >> 8 & 0x1f);
+	uint32_t num_code_lengths = 4 + (uint32_t)(bits >> 13 & 0xf);
+	bit += 17;
+
+	// Up to 19*3 code length bits, the code length code must be complete
+	static const uint8_t kraft_weights[8] = { 0, 64, 32, 16, 8, 4, 2, 1 };
+	bits = ufbxi_read_u64(data + (size_t)(bit >> 3)) >> (bit & 0x7);
+	uint64_t used_bits = bits & (UINT64_MAX >> (64 - num_code_lengths * 3));
+	uint32_t kraft_sum = 0;
+	for (uint32_t i = 0; i < 19; i++) {
+		kraft_sum += kraft_weights[(used_bits >> (i * 3)) & 0x7];
+	}
+	if (kraft_sum != 128) return false;
+
+	uint8_t code_lengths[19]; // ufbxi_uninit
+	memset(code_lengths, 0, sizeof(code_lengths));
+	uint32_t bits_counts[8] = { 0 };
+	for (uint32_t i = 0; i < num_code_lengths; i++) {
+		uint32_t len = (uint32_t)(bits >> (i * 3)) & 0x7;
+		code_lengths[ufbxi_deflate_code_length_permutation[i]] = (uint8_t)len;
+		bits_counts[len]++;
+	}
+	bit += num_code_lengths * 3;
+
+	// Sort the symbols for canonical decoding
+	uint8_t sorted_syms[19]; // ufbxi_uninit
+	uint32_t offsets[8]; // ufbxi_uninit
+	offsets[1] = 0;
+	for (uint32_t len = 1; len < 7; len++) {
+		offsets[len + 1] = offsets[len] + bits_counts[len];
+	}
+	for (uint32_t sym = 0; sym < 19; sym++) {
+		uint32_t len = code_lengths[sym];
+		if (len > 0) sorted_syms[offsets[len]++] = (uint8_t)sym;
+	}
+
+	// Decode the code lengths of both codes and accumulate the Kraft sums.
+	uint32_t num_symbols = num_lit_lengths + num_dists;
+	uint32_t lit_kraft = 0, dist_kraft = 0, num_dist_codes = 0;
+	uint32_t prev = 0;
+	bool has_end_of_block = false;
+	for (uint32_t sym_index = 0; sym_index < num_symbols; ) {
+		if (bit > max_bit) return false;
+		bits = ufbxi_read_u64(data + (size_t)(bit >> 3)) >> (bit & 0x7);
+
+		// Canonical Huffman decoding one bit at a time, see RFC 1951 3.2.2
+		uint32_t code = 0, first = 0, index = 0, inst = UINT32_MAX;
+		for (uint32_t len = 1; len <= 7; len++) {
+			code |= (uint32_t)(bits >> (len - 1)) & 1;
+			uint32_t count = bits_counts[len];
+			if (code - first < count) {
+				inst = sorted_syms[index + code - first];
+				bits >>= len;
+				bit += len;
+				break;
+			}
+			index += count;
+			first = (first + count) << 1;
+			code <<= 1;
+		}
+		if (inst == UINT32_MAX) return false;
+
+		uint32_t len = inst, num = 1;
+		if (inst == 16) {
+			if (sym_index == 0) return false;
+			len = prev;
+			num = 3 + ((uint32_t)bits & 0x3);
+			bit += 2;
+		} else if (inst == 17) {
+			len = 0;
+			num = 3 + ((uint32_t)bits & 0x7);
+			bit += 3;
+		} else if (inst == 18) {
+			len = 0;
+			num = 11 + ((uint32_t)bits & 0x7f);
+			bit += 7;
+		}
+		if (num > num_symbols - sym_index) return false;
+
+		for (uint32_t i = 0; i < num; i++) {
+			uint32_t sym = sym_index + i;
+			if (len == 0) continue;
+			if (sym < num_lit_lengths) {
+				lit_kraft += 1u << (15 - len);
+				if (sym == 256) has_end_of_block = true;
+			} else {
+				dist_kraft += 1u << (15 - len);
+				num_dist_codes++;
+			}
+		}
+		sym_index += num;
+		prev = len;
+	}
+
+	if (!has_end_of_block || lit_kraft != 1u << 15) return false;
+	if (num_dist_codes > 1 && dist_kraft != 1u << 15) return false;
+	return true;
+}
+
+// Find the first bit offset in `[begin, end)` that could start a dynamic Huffman block.
+// Returns `UINT64_MAX` if not found.
+static ufbxi_noinline uint64_t ufbxi_inflate_find_block(const char *data, size_t data_size, uint64_t begin, uint64_t end)
+{
+	if (data_size < 16) return UINT64_MAX;
+	end = ufbxi_min64(end, (uint64_t)(data_size - 16) * 8);
+
+	for (uint64_t bit = begin; bit < end; bit++) {
+		// Quick rejection for BTYPE=2, HLIT <= 29, HDIST <= 29 before the full check
+		uint32_t bits = (uint32_t)(ufbxi_read_u64(data + (size_t)(bit >> 3)) >> (bit & 0x7));
+		if ((bits & 0x6) != 0x4 || (bits & 0xf0) == 0xf0 || (bits & 0x1e00) == 0x1e00) continue;
+		if (ufbxi_inflate_check_block_header(data, data_size, bit)) return bit;
+	}
+
+	return UINT64_MAX;
+}
+
+static ufbxi_noinline void ufbxi_inflate_decode_chunk(ufbxi_inflate_chunk *chunk)
+{
+	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)chunk->retain;
+	ufbx_assert(ret_imp->initialized);
+
+	const char *data = (const char*)chunk->data;
+	size_t data_size = chunk->data_size;
+	char *dst = chunk->dst;
+
+	ufbxi_deflate_context dc; // ufbxi_uninit
+	ptrdiff_t err = -30;
+
+	uint64_t bit = chunk->begin_bit;
+	if (bit == 0) {
+		// First chunk: Regular decoding after the zlib header
+		ufbxi_inflate_init_at_bit(&dc, data, data_size, 0, dst, dst, dst + chunk->dst_size);
+		err = ufbxi_inflate_check_zlib_header(dc.stream.bits);
+		if (!err) {
+			bit = 16;
+			dc.stream.bits >>= 16;
+			dc.stream.left -= 16;
+			dc.stop_bit = chunk->end_bit;
+			err = ufbxi_inflate_blocks(&dc, ret_imp, NULL);
+		}
+	} else {
+		uint64_t search_end = ufbxi_min64(chunk->end_bit, bit + UFBXI_INFLATE_CHUNK_MAX_SEARCH_BITS);
+
+		// Try candidate block starts until one decodes without errors. Most false candidates
+		// are rejected cheaply when building the Huffman trees (errors -14 to -27), so only
+		// count attempts that failed during decoding.
+		size_t num_attempts = 0;
+		while (num_attempts < UFBXI_INFLATE_CHUNK_MAX_ATTEMPTS) {
+			bit = ufbxi_inflate_find_block(data, data_size, bit, search_end);
+			if (bit == UINT64_MAX) break;
+
+			ufbxi_inflate_init_at_bit(&dc, data, data_size, bit, dst, dst, dst + chunk->dst_size);
+			dc.stop_bit = chunk->end_bit;
+			dc.markers = chunk->markers;
+			dc.markers_cap = chunk->markers_cap;
+			err = ufbxi_inflate_blocks(&dc, ret_imp, NULL);
+			if (err >= 0) break;
+
+			// Running out of markers is not a decoding error, later blocks would only
+			// run out as well, so leave the chunk to be decoded serially.
+			if (err == -30) break;
+
+			if (!(err <= -14 && err >= -27)) num_attempts++;
+			bit++;
+		}
+	}
+
+	chunk->result = err < 0 ? err : 0;
+	if (err < 0) return;
+
+	chunk->start_bit = bit;
+	chunk->stop_bit = ufbxi_inflate_bit_offset(&dc, dc.stream.chunk_ptr, dc.stream.left);
+	chunk->out_size = ufbxi_to_size(dc.out_ptr - dc.out_begin);
+	chunk->num_markers = dc.markers ? chunk->out_size : dc.num_markers;
+	chunk->final = err == 0;
+}
+
+// Combine the decoded chunks into `dst`, decoding serially where chunks don't line up.
+// Returns the number of decompressed bytes or negative error, see `ufbx_inflate()`.
+static ufbxi_noinline ptrdiff_t ufbxi_inflate_finish_chunks(ufbxi_inflate_chunk *chunks, size_t num_chunks, void *dst, size_t dst_size, bool no_checksum)
+{
+	ufbx_assert(num_chunks > 0 && chunks[0].begin_bit == 0 && chunks[0].dst == dst);
+	ufbxi_inflate_retain_imp *ret_imp = (ufbxi_inflate_retain_imp*)chunks[0].retain;
+	const char *data = (const char*)chunks[0].data;
+	size_t data_size = chunks[0].data_size;
+	char *out = (char*)dst;
+
+	if (chunks[0].result < 0) return chunks[0].result;
+	chunks[0].used = true;
+
+	size_t pos = chunks[0].out_size;
+	uint64_t bit = chunks[0].stop_bit;
+	bool final = chunks[0].final;
+	size_t next = 1;
+	while (!final) {
+		while (next < num_chunks && (chunks[next].result < 0 || chunks[next].start_bit < bit)) {
+			next++;
+		}
+
+		ufbxi_inflate_chunk *chunk = next < num_chunks ? &chunks[next] : NULL;
+		if (chunk && chunk->start_bit == bit) {
+			if (chunk->out_size > dst_size - pos) return -10;
+
+			// Resolve markers using the preceding output as the window
+			const uint16_t *markers = chunk->markers;
+			char *chunk_out = out + pos;
+			size_t num_markers = chunk->num_markers;
+			if (pos >= UFBXI_INFLATE_WINDOW_SIZE) {
+				// Branchless as every window index is in bounds
+				const char *window = chunk_out - UFBXI_INFLATE_WINDOW_SIZE;
+				for (size_t i = 0; i < num_markers; i++) {
+					uint32_t value = markers[i];
+					char window_byte = window[value & (UFBXI_INFLATE_WINDOW_SIZE - 1)];
+					chunk_out[i] = (value & UFBXI_INFLATE_MARKER) != 0 ? window_byte : (char)(uint8_t)value;
+				}
+			} else {
+				for (size_t i = 0; i < num_markers; i++) {
+					uint32_t value = markers[i];
+					if (value & UFBXI_INFLATE_MARKER) {
+						size_t index = value & ~(uint32_t)UFBXI_INFLATE_MARKER;
+						if (pos + index < UFBXI_INFLATE_WINDOW_SIZE) return -12;
+						chunk_out[i] = out[pos + index - UFBXI_INFLATE_WINDOW_SIZE];
+					} else {
+						chunk_out[i] = (char)(uint8_t)value;
+					}
+				}
+			}
+			memcpy(chunk_out + num_markers, chunk->dst + num_markers, chunk->out_size - num_markers);
+
+			pos += chunk->out_size;
+			bit = chunk->stop_bit;
+			final = chunk->final;
+			chunk->used = true;
+			next++;
+		} else {
+			// Decode serially until we reach the beginning of the next chunk
+			ufbxi_deflate_context dc; // ufbxi_uninit
+			ufbxi_inflate_init_at_bit(&dc, data, data_size, bit, out, out + pos, out + dst_size);
+			if (chunk) dc.stop_bit = chunk->start_bit;
+			ptrdiff_t err = ufbxi_inflate_blocks(&dc, ret_imp, NULL);
+			if (err < 0) return err;
+
+			pos = ufbxi_to_size(dc.out_ptr - dc.out_begin);
+			bit = ufbxi_inflate_bit_offset(&dc, dc.stream.chunk_ptr, dc.stream.left);
+			final = err == 0;
+		}
+	}
+
+	if (no_checksum) return (ptrdiff_t)pos;
+
+	// Check Adler-32, stored after rounding up to the next byte
+	uint64_t checksum_offset = (bit + 7) >> 3;
+	if (checksum_offset + 4 > data_size) return -9;
+	const uint8_t *ref_data = (const uint8_t*)data + (size_t)checksum_offset;
+	uint32_t ref = (uint32_t)ref_data[0] << 24 | (uint32_t)ref_data[1] << 16 | (uint32_t)ref_data[2] << 8 | (uint32_t)ref_data[3];
+	if (ref != ufbxi_adler32(out, pos, ret_imp->has_avx2)) return -9;
+
+	return (ptrdiff_t)pos;
+}
+
 #endif // !defined(ufbx_inflate)
 
 // -- Printf
@@ -3662,8 +4513,13 @@ static ufbxi_noinline void ufbxi_free_ator(ufbxi_allocator *ator)
 #define UFBXI_MESH_IMP_MAGIC 0x48534d55
 #define UFBXI_LINE_CURVE_IMP_MAGIC 0x55434c55
 #define UFBXI_CACHE_IMP_MAGIC 0x48434355
+#define UFBXI_CACHE_READER_IMP_MAGIC 0x52434355
+#define UFBXI_CACHE_PLAYBACK_IMP_MAGIC 0x50434355
+#define UFBXI_EVALUATE_CACHE_IMP_MAGIC 0x43564555
 #define UFBXI_ANIM_IMP_MAGIC 0x494e4155
 #define UFBXI_BAKED_ANIM_IMP_MAGIC 0x4b414255
+#define UFBXI_ANIM_CURSOR_IMP_MAGIC 0x52434155
+#define UFBXI_COMPACT_ANIM_IMP_MAGIC 0x4d434155
 #define UFBXI_REFCOUNT_IMP_MAGIC 0x46455255
 #define UFBXI_BUF_CHUNK_IMP_MAGIC 0x46554255
 
@@ -5710,6 +6566,7 @@ static const ufbx_vec3 ufbxi_one_vec3 = { 1.0f, 1.0f, 1.0f };
 
 #define UFBXI_PI ((ufbx_real)3.14159265358979323846)
 #define UFBXI_DPI (3.14159265358979323846)
+#define UFBXI_SQRT_2 (1.41421356237309504880)
 #define UFBXI_DEG_TO_RAD ((ufbx_real)(UFBXI_PI / 180.0))
 #define UFBXI_RAD_TO_DEG ((ufbx_real)(180.0 / UFBXI_PI))
 #define UFBXI_DEG_TO_RAD_DOUBLE (UFBXI_DPI / 180.0)
@@ -5921,7 +6778,9 @@ ufbxi_noinline static void ufbxi_thread_pool_free(ufbxi_thread_pool *pool)
 		pool->opts.pool.free_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool);
 	}
 
-	ufbxi_free(pool->ator, ufbxi_task_imp, pool->tasks, pool->num_tasks);
+	if (pool->tasks) {
+		ufbxi_free(pool->ator, ufbxi_task_imp, pool->tasks, pool->num_tasks);
+	}
 }
 
 ufbxi_nodiscard ufbxi_noinline static uint32_t ufbxi_thread_pool_available_tasks(ufbxi_thread_pool *pool)
@@ -5995,8 +6854,20 @@ typedef struct {
 	void *data;  // < Pointer to `size` bool/int32_t/int64_t/float/double elements
 	size_t size; // < Number of elements
 	char type;   // < FBX type code: b/i/l/f/d
+
+	// Index statistics gathered by a decoding task, see `UFBXI_ARRAY_FLAG_INDEX`.
+	bool has_index_stats;        // < `index_num_negative` is valid
+	uint32_t index_num_negative; // < Number of negative indices (ends of polygons)
 } ufbxi_value_array;
 
+// Part of embedded content left in the file, see `ufbx_load_opts.defer_embedded`.
+// Stored in arrays of type 'E' in place of 'C' strings.
+typedef struct {
+	uint64_t offset;       // < Byte offset of the data (binary) or the opening quote (ASCII)
+	uint64_t encoded_size; // < Number of bytes in the file
+	size_t size;           // < Size of the decoded content
+} ufbxi_embedded_part;
+
 struct ufbxi_node {
 	const char *name;      // < Name of the node (pooled, compare with == to ufbxi_* strings)
 	uint32_t num_children; // < Number of child nodes
@@ -6034,12 +6905,28 @@ static ufbxi_noinline void ufbxi_retain_ref(ufbxi_refcount *refcount);
 
 #define ufbxi_get_imp(type, ptr) ((type*)((char*)ptr - sizeof(ufbxi_refcount)))
 
+// Skinned views of a mesh that was not skinned in the latest in-place evaluation.
+typedef struct {
+	ufbx_vertex_vec3 skinned_position;
+	ufbx_vertex_vec3 skinned_normal;
+	bool generated_normals;
+	bool valid;
+} ufbxi_saved_skinning;
+
 typedef struct {
 	ufbxi_refcount refcount;
 	ufbx_scene scene;
 	uint32_t magic;
 
 	ufbxi_buf string_buf;
+
+	// Evaluated scenes only: Allocated `ufbx_element.props` buffers per `element_id`,
+	// reused by `ufbx_evaluate_scene_in_place()`
+	ufbx_prop_list *evaluated_props;
+
+	// Evaluated scenes only: Skinning buffers per mesh `typed_id` kept while the mesh
+	// is not skinned, allocated on demand by `ufbx_evaluate_scene_in_place()`
+	ufbxi_saved_skinning *saved_skinning;
 } ufbxi_scene_imp;
 
 ufbx_static_assert(scene_imp_offset, offsetof(ufbxi_scene_imp, scene) == sizeof(ufbxi_refcount));
@@ -6071,6 +6958,7 @@ typedef struct {
 		double f64;
 		int64_t i64;
 		size_t name_len;
+		ufbxi_embedded_part part;
 	} value;
 } ufbxi_ascii_token;
 
@@ -6093,6 +6981,29 @@ typedef struct {
 	ufbxi_ascii_token token;
 } ufbxi_ascii;
 
+// Structural index of an in-memory ASCII file, see `ufbxi_ascii_build_index()`.
+// Offsets are relative to `begin`, comma counts are global prefix sums.
+
+typedef struct {
+	size_t open_offset;
+	size_t close_offset;
+	size_t comma_begin;
+	size_t num_commas;
+} ufbxi_ascii_block;
+
+typedef struct {
+	const char *begin;
+	size_t size;
+
+	size_t num_chunks;
+	size_t *chunk_offsets; // [num_chunks + 1]
+	size_t *chunk_commas;  // [num_chunks + 1]
+	bool *chunk_normal;    // [num_chunks], chunk doesn't start in a string or comment
+
+	ufbxi_ascii_block *blocks;
+	size_t num_blocks;
+} ufbxi_ascii_index;
+
 typedef struct {
 	const char *type;
 	ufbx_string sub_type;
@@ -6196,6 +7107,46 @@ typedef struct {
 	size_t num_left;
 } ufbxi_obj_fast_indices;
 
+// Threaded .obj parsing splits blocks of up to `UFBXI_OBJ_MAX_CHUNKS * UFBXI_OBJ_CHUNK_BYTES`
+// bytes at line boundaries and pre-parses vertex and face lines of each chunk in parallel.
+// Anything the chunk parser does not understand is left for the serial parser.
+#define UFBXI_OBJ_CHUNK_BYTES 0x40000
+#define UFBXI_OBJ_MIN_CHUNK_BYTES 0x4000
+#define UFBXI_OBJ_MAX_CHUNKS 32
+
+// Pre-parsed `ufbxi_obj_line.type` for faces, vertices use `UFBXI_OBJ_ATTRIB_*`.
+#define UFBXI_OBJ_LINE_FACE 0x10
+
+// Raw face index with the sign stored in the top bit, see `ufbxi_obj_push_index()`.
+#define UFBXI_OBJ_RAW_INDEX_NEGATIVE (UINT64_C(1) << 63u)
+
+typedef struct {
+	uint32_t offset;     // < Offset of the line from `ufbxi_obj_chunk.data`
+	uint32_t length;     // < Length of the line including the `\n`
+	uint32_t type;       // < `UFBXI_OBJ_ATTRIB_*` or `UFBXI_OBJ_LINE_FACE`
+	uint32_t num_values; // < Number of vertex values or face corners
+} ufbxi_obj_line;
+
+typedef struct {
+	const char *data;
+	size_t data_size;
+	uint32_t parse_flags;
+
+	// Pre-parsed lines in order, faces store three raw indices per corner.
+	// If any of the arrays runs out of space the rest of the chunk is left unparsed.
+	ufbxi_obj_line *lines;
+	ufbx_real *values;
+	uint64_t *indices;
+	size_t num_lines, lines_cap;
+	size_t num_values, values_cap;
+	size_t num_indices, indices_cap;
+
+	// Consumed by the serial parser
+	size_t line_index;
+	size_t value_index;
+	size_t index_index;
+} ufbxi_obj_chunk;
+
 // Temporary pointer to a `ufbx_anim_stack` by name used to patch start/stop
 // time from "Takes" if necessary.
 typedef struct {
@@ -6206,6 +7157,7 @@ typedef struct {
 typedef struct {
 	ufbx_string absolute_filename;
 	ufbx_blob content;
+	ufbx_embedded_location content_location;
 } ufbxi_file_content;
 
 typedef struct {
@@ -6236,6 +7188,13 @@ typedef struct {
 
 	size_t read_progress;
 
+	// Pre-parsed chunks of the current block, see `ufbxi_obj_parse_block()`
+	ufbxi_buf tmp_chunks;
+	ufbxi_obj_chunk *chunks;
+	size_t num_chunks;
+	size_t chunk_index;
+	uint64_t block_end_offset;
+
 	ufbxi_obj_mesh *mesh;
 
 	uint64_t usemtl_fbx_id;
@@ -6270,6 +7229,8 @@ typedef struct {
 
 } ufbxi_obj_context;
 
+typedef struct ufbxi_deflate_task ufbxi_deflate_task;
+
 typedef struct {
 
 	ufbx_error error;
@@ -6279,6 +7240,7 @@ typedef struct {
 	bool from_ascii;
 	bool local_big_endian;
 	bool file_big_endian;
+	bool has_avx2; // < Cached `ufbxi_cpu_has_avx2()`
 	bool sure_fbx;
 	bool retain_mesh_parts;
 	bool read_legacy_settings;
@@ -6339,10 +7301,12 @@ typedef struct {
 	ufbxi_buf tmp_element_ptrs;
 	ufbxi_buf tmp_typed_element_offsets[UFBX_ELEMENT_TYPE_COUNT];
 	ufbxi_buf tmp_mesh_textures;
+	ufbxi_buf tmp_mesh_geometry;
 	ufbxi_buf tmp_full_weights;
 	ufbxi_buf tmp_dom_nodes;
 	ufbxi_buf tmp_element_id;
 	ufbxi_buf tmp_ascii_spans;
+	ufbxi_buf tmp_ascii_index;
 	ufbxi_buf tmp_thread_parse[UFBX_THREAD_GROUP_COUNT];
 	size_t tmp_element_byte_offset;
 
@@ -6437,9 +7401,18 @@ typedef struct {
 	const char *load_filename;
 	size_t load_filename_len;
 
+	// Memory mapped main file, see `ufbx_load_opts.map_main_file`
+	void *mapped_data;
+	size_t mapped_size;
+
 	bool parse_threaded;
 	ufbxi_thread_pool thread_pool;
 
+	ufbxi_ascii_index ascii_index;
+
+	// Arrays decoded using split DEFLATE that need to be finished when the current batch completes
+	ufbxi_deflate_task *split_deflate_tasks;
+
 	uint8_t *base64_table;
 
 } ufbxi_context;
@@ -6934,6 +7907,15 @@ static ufbxi_noinline bool ufbxi_stdio_open(ufbxi_file_context *fc, ufbx_stream
 	return true;
 }
 
+// Seek a stream back to the start of the file, only possible if the stream uses `FILE*`.
+static ufbxi_noinline bool ufbxi_stdio_rewind(ufbx_stream *stream)
+{
+	if (stream->read_fn != &ufbxi_stdio_read) return false;
+	FILE *file = (FILE*)stream->user;
+	rewind(file);
+	return true;
+}
+
 #elif defined(UFBX_EXTERNAL_STDIO)
 
 static ufbxi_noinline void ufbxi_stdio_init(ufbx_stream *stream, void *file, bool close)
@@ -6975,6 +7957,64 @@ static ufbxi_noinline bool ufbxi_stdio_open(ufbxi_file_context *fc, ufbx_stream
 
 #endif
 
+#if defined(UFBX_NO_STDIO) || defined(UFBX_EXTERNAL_STDIO)
+
+static ufbxi_noinline bool ufbxi_stdio_rewind(ufbx_stream *stream)
+{
+	(void)stream;
+	return false;
+}
+
+#endif
+
+// -- Memory mapped IO
+
+#if UFBXI_HAS_MMAP
+
+static ufbxi_noinline bool ufbxi_map_file(ufbxi_allocator *ator, void **p_data, size_t *p_size, const char *path, size_t path_len, bool null_terminated)
+{
+	char copy_buf[256], *copy = NULL; // ufbxi_uninit
+	if (null_terminated) {
+		copy = (char*)path;
+	} else {
+		if (path_len < ufbxi_arraycount(copy_buf) - 1) {
+			copy = copy_buf;
+		} else {
+			copy = ufbxi_alloc(ator, char, path_len + 1);
+			if (!copy) return false;
+		}
+		memcpy(copy, path, path_len);
+		copy[path_len] = '\0';
+	}
+	int fd = open(copy, O_RDONLY);
+	if (!null_terminated && copy != copy_buf) {
+		ufbxi_free(ator, char, copy, path_len + 1);
+	}
+	if (fd < 0) return false;
+
+	// Empty files cannot be mapped, let the regular path report them
+	void *data = MAP_FAILED;
+	size_t size = 0;
+	struct stat st; // ufbxi_uninit
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+		size = (size_t)st.st_size;
+		data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (data == MAP_FAILED) return false;
+
+	*p_data = data;
+	*p_size = size;
+	return true;
+}
+
+static ufbxi_noinline void ufbxi_unmap_file(void *data, size_t size)
+{
+	munmap(data, size);
+}
+
+#endif
+
 // -- Memory IO
 
 typedef struct {
@@ -7492,6 +8532,7 @@ static ufbxi_noinline size_t ufbxi_array_type_size(char type)
 	case 's': return sizeof(ufbx_string);
 	case 'S': return sizeof(ufbx_string);
 	case 'C': return sizeof(ufbx_string);
+	case 'E': return sizeof(ufbxi_embedded_part);
 	default: return 1;
 	}
 }
@@ -7751,10 +8792,11 @@ typedef enum {
 } ufbxi_parse_state;
 
 typedef enum {
-	UFBXI_ARRAY_FLAG_RESULT       = 0x1, // < Allocate the array from the result buffer
-	UFBXI_ARRAY_FLAG_TMP_BUF      = 0x2, // < Allocate the array from the result buffer
-	UFBXI_ARRAY_FLAG_PAD_BEGIN    = 0x4, // < Pad the begin of the array with 4 zero elements to guard from invalid -1 index accesses
-	UFBXI_ARRAY_FLAG_ACCURATE_F32 = 0x8, // < Must be parsed as bit-accurate 32-bit floats
+	UFBXI_ARRAY_FLAG_RESULT       = 0x1,  // < Allocate the array from the result buffer
+	UFBXI_ARRAY_FLAG_TMP_BUF      = 0x2,  // < Allocate the array from the result buffer
+	UFBXI_ARRAY_FLAG_PAD_BEGIN    = 0x4,  // < Pad the begin of the array with 4 zero elements to guard from invalid -1 index accesses
+	UFBXI_ARRAY_FLAG_ACCURATE_F32 = 0x8,  // < Must be parsed as bit-accurate 32-bit floats
+	UFBXI_ARRAY_FLAG_INDEX        = 0x10, // < Index array, gather `ufbxi_value_array` index statistics if decoded in a task
 } ufbxi_array_flags;
 
 typedef struct {
@@ -7872,7 +8914,7 @@ static ufbxi_noinline ufbxi_parse_state ufbxi_update_parse_state(ufbxi_parse_sta
 	return UFBXI_PARSE_UNKNOWN;
 }
 
-static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, const char *name, ufbxi_array_info *info)
+static bool ufbxi_is_array_node_imp(ufbxi_context *uc, ufbxi_parse_state parent, const char *name, ufbxi_array_info *info)
 {
 	info->flags = 0;
 
@@ -7899,7 +8941,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			return true;
 		} else if (name == ufbxi_PolygonVertexIndex) {
 			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_INDEX;
 			return true;
 		} else if (name == ufbxi_Edges) {
 			info->type = uc->opts.ignore_geometry ? '-' : 'i';
@@ -7992,7 +9034,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_VIDEO:
 		if (name == ufbxi_Content) {
-			info->type = uc->opts.ignore_embedded ? '-' : 'C';
+			info->type = uc->opts.ignore_embedded ? '-' : uc->opts.defer_embedded ? 'E' : 'C';
 			return true;
 		}
 		break;
@@ -8277,7 +9319,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_AUDIO:
 		if (name == ufbxi_Content) {
-			info->type = uc->opts.ignore_embedded ? '-' : 'C';
+			info->type = uc->opts.ignore_embedded ? '-' : uc->opts.defer_embedded ? 'E' : 'C';
 			return true;
 		}
 		break;
@@ -8294,6 +9336,21 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 	return false;
 }
 
+static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, const char *name, ufbxi_array_info *info)
+{
+	if (!ufbxi_is_array_node_imp(uc, parent, name, info)) return false;
+
+	// Mesh geometry is parsed to temporary memory if the meshes are streamed to `ufbx_load_opts.mesh_cb`,
+	// other readers that use arrays in these states must call `ufbxi_retain_streamed_array()`.
+	if (uc->opts.mesh_cb.fn && !uc->opts.retain_dom) {
+		if (parent == UFBXI_PARSE_MODEL || parent == UFBXI_PARSE_GEOMETRY || (parent >= UFBXI_PARSE_LAYER_ELEMENT_NORMAL && parent <= UFBXI_PARSE_LAYER_ELEMENT_OTHER)) {
+			info->flags = (uint8_t)(info->flags & ~(uint32_t)UFBXI_ARRAY_FLAG_RESULT);
+		}
+	}
+
+	return true;
+}
+
 static ufbxi_noinline bool ufbxi_is_raw_string(ufbxi_context *uc, ufbxi_parse_state parent, const char *name, size_t index)
 {
 	(void)index;
@@ -8443,6 +9500,33 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_array(ufbxi_
 	}
 }
 
+// Swap the endianness of an array typed with a lowercase letter in place, does not
+// need a context so it's safe to call from worker threads.
+static ufbxi_noinline void ufbxi_swap_endian_array_in_place(void *data, size_t count, char type)
+{
+	char *d = (char*)data, t;
+	switch (type) {
+	case 'i': case 'f':
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			t = d[0]; d[0] = d[3]; d[3] = t;
+			t = d[1]; d[1] = d[2]; d[2] = t;
+			d += 4;
+		}
+		break;
+	case 'l': case 'd':
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			t = d[0]; d[0] = d[7]; d[7] = t;
+			t = d[1]; d[1] = d[6]; d[6] = t;
+			t = d[2]; d[2] = d[5]; d[5] = t;
+			t = d[3]; d[3] = d[4]; d[4] = t;
+			d += 8;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
 // Swap the endianness of a single value (shallow, swaps string/array header words)
 ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_value(ufbxi_context *uc, const void *src, char type)
 {
@@ -8456,9 +9540,145 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_value(ufbxi_
 	}
 }
 
+// Vectorized conversion loops for the most common array conversions, the scalar
+// tails must match the per-element expressions in `ufbxi_binary_convert_array()`.
+// `src` is always in little endian order and may be unaligned.
+
+#if UFBXI_HAS_AVX2
+
+// AVX2 variants of the floating point conversions, return the number of converted elements.
+// The rest are handled by the SSE2 and scalar loops of the callers.
+
+static ufbxi_noinline ufbxi_target_avx2 size_t ufbxi_convert_f64_to_f32_avx2(float *dst, const char *src, size_t size)
+{
+	size_t i = 0;
+	for (; size - i >= 8; i += 8) {
+		__m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd((const double*)(src + i * 8)));
+		__m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd((const double*)(src + i * 8 + 32)));
+		_mm256_storeu_ps(dst + i, _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+	}
+	return i;
+}
+
+static ufbxi_noinline ufbxi_target_avx2 size_t ufbxi_convert_f32_to_f64_avx2(double *dst, const char *src, size_t size)
+{
+	size_t i = 0;
+	for (; size - i >= 8; i += 8) {
+		__m256 v = _mm256_loadu_ps((const float*)(src + i * 4));
+		_mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+		_mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+	}
+	return i;
+}
+
+static ufbxi_noinline ufbxi_target_avx2 size_t ufbxi_convert_i32_to_f64_avx2(double *dst, const char *src, size_t size)
+{
+	size_t i = 0;
+	for (; size - i >= 8; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+		_mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+		_mm256_storeu_pd(dst + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+	}
+	return i;
+}
+
+#endif
+
+static ufbxi_noinline void ufbxi_convert_f64_to_f32(float *dst, const char *src, size_t size, bool has_avx2)
+{
+	size_t i = 0;
+#if UFBXI_HAS_AVX2
+	if (has_avx2) i = ufbxi_convert_f64_to_f32_avx2(dst, src, size);
+#else
+	(void)has_avx2;
+#endif
+#if UFBXI_HAS_SSE
+	for (; size - i >= 4; i += 4) {
+		__m128 lo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(src + i * 8)));
+		__m128 hi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(src + i * 8 + 16)));
+		_mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+	}
+#endif
+	for (; i < size; i++) {
+		dst[i] = (float)ufbxi_read_f64(src + i * 8);
+	}
+}
+
+static ufbxi_noinline void ufbxi_convert_f32_to_f64(double *dst, const char *src, size_t size, bool has_avx2)
+{
+	size_t i = 0;
+#if UFBXI_HAS_AVX2
+	if (has_avx2) i = ufbxi_convert_f32_to_f64_avx2(dst, src, size);
+#else
+	(void)has_avx2;
+#endif
+#if UFBXI_HAS_SSE
+	for (; size - i >= 4; i += 4) {
+		__m128 v = _mm_loadu_ps((const float*)(src + i * 4));
+		_mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+		_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+#endif
+	for (; i < size; i++) {
+		dst[i] = (double)ufbxi_read_f32(src + i * 4);
+	}
+}
+
+static ufbxi_noinline void ufbxi_convert_i32_to_i64(int64_t *dst, const char *src, size_t size)
+{
+	size_t i = 0;
+#if UFBXI_HAS_SSE
+	for (; size - i >= 4; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		__m128i sign = _mm_srai_epi32(v, 31);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi32(v, sign));
+		_mm_storeu_si128((__m128i*)(dst + i + 2), _mm_unpackhi_epi32(v, sign));
+	}
+#endif
+	for (; i < size; i++) {
+		dst[i] = (int64_t)ufbxi_read_i32(src + i * 4);
+	}
+}
+
+static ufbxi_noinline void ufbxi_convert_i64_to_i32(int32_t *dst, const char *src, size_t size)
+{
+	size_t i = 0;
+#if UFBXI_HAS_SSE
+	for (; size - i >= 4; i += 4) {
+		__m128 lo = _mm_loadu_ps((const float*)(src + i * 8));
+		__m128 hi = _mm_loadu_ps((const float*)(src + i * 8 + 16));
+		_mm_storeu_ps((float*)(dst + i), _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+#endif
+	for (; i < size; i++) {
+		dst[i] = (int32_t)ufbxi_read_i64(src + i * 8);
+	}
+}
+
+static ufbxi_noinline void ufbxi_convert_i32_to_f64(double *dst, const char *src, size_t size, bool has_avx2)
+{
+	size_t i = 0;
+#if UFBXI_HAS_AVX2
+	if (has_avx2) i = ufbxi_convert_i32_to_f64_avx2(dst, src, size);
+#else
+	(void)has_avx2;
+#endif
+#if UFBXI_HAS_SSE
+	for (; size - i >= 4; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		_mm_storeu_pd(dst + i, _mm_cvtepi32_pd(v));
+		_mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v)));
+	}
+#endif
+	for (; i < size; i++) {
+		dst[i] = (double)ufbxi_read_i32(src + i * 4);
+	}
+}
+
 // Read and convert a post-7000 FBX data array into a different format. `src_type` may be equal to `dst_type`
 // if the platform is not binary compatible with the FBX data representation.
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_context *maybe_uc, char src_type, char dst_type, const void *src, void *dst, size_t size)
+// `has_avx2` should be the cached result of `ufbxi_cpu_has_avx2()`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_context *maybe_uc, char src_type, char dst_type, const void *src, void *dst, size_t size, bool has_avx2)
 {
 	// TODO: We might want to use the slow path if the machine float/double doesn't match IEEE 754!
 	// Convert commented out lines under some `#if UFBX_NON_IEE754` define or something.
@@ -8505,7 +9725,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		switch (src_type) {
 		case 'c': ufbxi_convert_loop_slow(int32_t, (int32_t), 1, *val); break;
 		// case 'i': ufbxi_convert_loop_slow(int32_t, (int32_t), 4, ufbxi_read_i32(val)); break;
-		case 'l': ufbxi_convert_loop_slow(int32_t, (int32_t), 8, ufbxi_read_i64(val)); break;
+		case 'l': ufbxi_convert_i64_to_i32((int32_t*)dst, (const char*)src, size); break;
 		case 'f': ufbxi_convert_loop_slow(int32_t, ufbxi_f64_to_i32, 4, ufbxi_read_f32(val)); break;
 		case 'd': ufbxi_convert_loop_slow(int32_t, ufbxi_f64_to_i32, 8, ufbxi_read_f64(val)); break;
 		default: if (maybe_uc) ufbxi_fail_err(&maybe_uc->error, "Bad array source type"); return 0;
@@ -8515,7 +9735,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 	case 'l':
 		switch (src_type) {
 		case 'c': ufbxi_convert_loop_slow(int64_t, (int64_t), 1, *val); break;
-		case 'i': ufbxi_convert_loop_slow(int64_t, (int64_t), 4, ufbxi_read_i32(val)); break;
+		case 'i': ufbxi_convert_i32_to_i64((int64_t*)dst, (const char*)src, size); break;
 		// case 'l': ufbxi_convert_loop_slow(int64_t, (int64_t), 8, ufbxi_read_i64(val)); break;
 		case 'f': ufbxi_convert_loop_slow(int64_t, ufbxi_f64_to_i64, 4, ufbxi_read_f32(val)); break;
 		case 'd': ufbxi_convert_loop_slow(int64_t, ufbxi_f64_to_i64, 8, ufbxi_read_f64(val)); break;
@@ -8529,7 +9749,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		case 'i': ufbxi_convert_loop_slow(float, (float), 4, ufbxi_read_i32(val)); break;
 		case 'l': ufbxi_convert_loop_slow(float, (float), 8, ufbxi_read_i64(val)); break;
 		// case 'f': ufbxi_convert_loop_slow(float, (float), 4, ufbxi_read_f32(val)); break;
-		case 'd': ufbxi_convert_loop_fast(float, (float), 8, ufbxi_read_f64(val)); break;
+		case 'd': ufbxi_convert_f64_to_f32((float*)dst, (const char*)src, size, has_avx2); break;
 		default: if (maybe_uc) ufbxi_fail_err(&maybe_uc->error, "Bad array source type"); return 0;
 		}
 		break;
@@ -8537,9 +9757,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 	case 'd':
 		switch (src_type) {
 		case 'c': ufbxi_convert_loop_slow(double, (double), 1, *val); break;
-		case 'i': ufbxi_convert_loop_slow(double, (double), 4, ufbxi_read_i32(val)); break;
+		case 'i': ufbxi_convert_i32_to_f64((double*)dst, (const char*)src, size, has_avx2); break;
 		case 'l': ufbxi_convert_loop_slow(double, (double), 8, ufbxi_read_i64(val)); break;
-		case 'f': ufbxi_convert_loop_fast(double, (double), 4, ufbxi_read_f32(val)); break;
+		case 'f': ufbxi_convert_f32_to_f64((double*)dst, (const char*)src, size, has_avx2); break;
 		// case 'd': ufbxi_convert_loop_slow(double, (double), 8, ufbxi_read_f64(val)); break;
 		default: if (maybe_uc) ufbxi_fail_err(&maybe_uc->error, "Bad array source type"); return 0;
 		}
@@ -8573,6 +9793,29 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_parse_multivalue_array(uf
 		} \
 	} while (0)
 
+	// Deferred embedded content: Skip the data and only record its location
+	if (dst_type == 'E') {
+		ufbxi_embedded_part *d = (ufbxi_embedded_part*)dst;
+		for (size_t i = 0; i < size; i++) {
+			val = ufbxi_peek_bytes(uc, 13);
+			ufbxi_check(val);
+			char type = *val++;
+			ufbxi_check(type == 'S' || type == 'R');
+			if (file_big_endian) {
+				val = ufbxi_swap_endian_value(uc, val, type);
+				ufbxi_check(val);
+			}
+			size_t len = ufbxi_read_u32(val);
+			ufbxi_consume_bytes(uc, 5);
+			d->offset = ufbxi_get_read_offset(uc);
+			d->encoded_size = len;
+			d->size = len;
+			ufbxi_check(ufbxi_skip_bytes(uc, len));
+			d++;
+		}
+		return 1;
+	}
+
 	// String array special case
 	if (dst_type == 's' || dst_type == 'S' || dst_type == 'C') {
 		bool raw = dst_type == 's';
@@ -8685,23 +9928,56 @@ ufbxi_nodiscard ufbxi_noinline static void *ufbxi_push_array_data(ufbxi_context
 
 ufbxi_noinline static void ufbxi_postprocess_bool_array(char *data, size_t size)
 {
-	ufbxi_for(char, b, (char*)data, size) {
+	size_t i = 0;
+#if UFBXI_HAS_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi8(1);
+	for (; size - i >= 16; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+		_mm_storeu_si128((__m128i*)(data + i), _mm_andnot_si128(_mm_cmpeq_epi8(v, zero), one));
+	}
+#endif
+	ufbxi_for(char, b, data + i, size - i) {
 		*b = (char)(*b != 0);
 	}
 }
 
-typedef struct {
+struct ufbxi_deflate_task {
 	size_t encoded_size;
 	size_t src_elem_size;
 	size_t array_size;
 	char src_type;
 	char dst_type;
 	char arr_type;
+	bool swap_endian;
+	bool no_checksum;
+	bool has_avx2;
 	const void *encoded_data;
 	void *decoded_data;
 	void *dst_data;
 	ufbx_inflate_retain *inflate_retain;
-} ufbxi_deflate_task;
+	ufbxi_value_array *index_stats_arr;
+
+	// Split DEFLATE chunks, see `ufbxi_inflate_chunk`
+#if !defined(ufbx_inflate)
+	ufbxi_inflate_chunk *chunks;
+	size_t num_chunks;
+#endif
+	ufbxi_deflate_task *next_split;
+};
+
+// Gather statistics of an index array so `ufbxi_read_mesh()` can skip counting
+// the faces serially later.
+ufbxi_noinline static void ufbxi_gather_index_stats(ufbxi_value_array *arr, const uint32_t *data, size_t size)
+{
+	size_t num_negative = 0;
+	for (size_t i = 0; i < size; i++) {
+		num_negative += data[i] >> 31u;
+	}
+
+	arr->index_num_negative = (uint32_t)num_negative;
+	arr->has_index_stats = true;
+}
 
 static bool ufbxi_deflate_task_fn(ufbxi_task *task)
 {
@@ -8712,7 +9988,7 @@ static bool ufbxi_deflate_task_fn(ufbxi_task *task)
 	input.data = t->encoded_data;
 	input.data_size = t->encoded_size;
 	input.no_header = false;
-	input.no_checksum = false;
+	input.no_checksum = t->no_checksum;
 	input.internal_fast_bits = 0;
 	input.progress_cb.fn = NULL;
 	input.progress_cb.user = NULL;
@@ -8734,8 +10010,12 @@ static bool ufbxi_deflate_task_fn(ufbxi_task *task)
 		return false;
 	}
 
+	if (t->swap_endian) {
+		ufbxi_swap_endian_array_in_place(t->decoded_data, t->array_size, t->src_type);
+	}
+
 	if (t->decoded_data != t->dst_data) {
-		int ok = ufbxi_binary_convert_array(NULL, t->src_type, t->dst_type, t->decoded_data, t->dst_data, t->array_size);
+		int ok = ufbxi_binary_convert_array(NULL, t->src_type, t->dst_type, t->decoded_data, t->dst_data, t->array_size, t->has_avx2);
 		if (!ok) {
 			task->error = "Failed to convert array";
 			return false;
@@ -8746,9 +10026,113 @@ static bool ufbxi_deflate_task_fn(ufbxi_task *task)
 		ufbxi_postprocess_bool_array((char*)t->dst_data, t->array_size);
 	}
 
+	if (t->index_stats_arr) {
+		ufbxi_gather_index_stats(t->index_stats_arr, (const uint32_t*)t->dst_data, t->array_size);
+	}
+
 	return true;
 }
 
+// Splitting needs the internals of the built-in `ufbx_inflate()`
+#if !defined(ufbx_inflate)
+
+static bool ufbxi_deflate_chunk_task_fn(ufbxi_task *task)
+{
+	ufbxi_inflate_chunk *chunk = (ufbxi_inflate_chunk*)task->data;
+	ufbxi_inflate_decode_chunk(chunk);
+
+	// Failed chunks are decoded serially in `ufbxi_finish_split_deflate()`
+	return true;
+}
+
+// Split a large DEFLATE array into multiple tasks, see `ufbxi_inflate_chunk`.
+// Leaves `*p_split` untouched if there are not enough tasks available.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_setup_split_deflate(ufbxi_context *uc, ufbxi_deflate_task *t, ufbxi_buf *tmp_buf, bool *p_split)
+{
+	size_t num_chunks = t->encoded_size / UFBXI_SPLIT_DEFLATE_CHUNK_BYTES;
+	num_chunks = ufbxi_min_sz(num_chunks, UFBXI_SPLIT_DEFLATE_MAX_CHUNKS);
+	num_chunks = ufbxi_min_sz(num_chunks, ufbxi_thread_pool_available_tasks(&uc->thread_pool));
+	if (num_chunks < 2) return 1;
+
+	ufbxi_inflate_chunk *chunks = ufbxi_push_zero(tmp_buf, ufbxi_inflate_chunk, num_chunks);
+	ufbxi_check(chunks);
+
+	// Chunks other than the first one decode to temporary buffers, reserve some extra
+	// space as the compression ratio varies between chunks. Chunks that run out of space
+	// will be decoded serially. Matches keep copying values from the unknown window for a
+	// while, eg. index arrays need markers for up to ~20% of the chunk, float data for a bit
+	// more than the window.
+	size_t decoded_size = t->src_elem_size * t->array_size;
+	size_t chunk_bytes = t->encoded_size / num_chunks;
+	size_t chunk_decoded_size = decoded_size / num_chunks;
+	size_t chunk_capacity = ufbxi_min_sz(decoded_size, chunk_decoded_size + chunk_decoded_size / 2 + 0x10000);
+	size_t markers_capacity = ufbxi_min_sz(chunk_capacity, chunk_decoded_size / 4 + UFBXI_INFLATE_WINDOW_SIZE);
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_inflate_chunk *chunk = &chunks[i];
+		chunk->data = t->encoded_data;
+		chunk->data_size = t->encoded_size;
+		chunk->retain = t->inflate_retain;
+		chunk->begin_bit = (uint64_t)(i * chunk_bytes) * 8;
+		chunk->end_bit = i + 1 < num_chunks ? (uint64_t)((i + 1) * chunk_bytes) * 8 : UINT64_MAX;
+		chunk->result = -30;
+
+		if (i == 0) {
+			chunk->dst = (char*)t->decoded_data;
+			chunk->dst_size = decoded_size;
+		} else {
+			chunk->dst = ufbxi_push(tmp_buf, char, chunk_capacity);
+			chunk->markers = ufbxi_push(tmp_buf, uint16_t, markers_capacity);
+			ufbxi_check(chunk->dst && chunk->markers);
+			chunk->dst_size = chunk_capacity;
+			chunk->markers_cap = markers_capacity;
+		}
+	}
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_deflate_chunk_task_fn);
+		ufbxi_check(task);
+		task->data = &chunks[i];
+		ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+	}
+
+	t->chunks = chunks;
+	t->num_chunks = num_chunks;
+	t->next_split = uc->split_deflate_tasks;
+	uc->split_deflate_tasks = t;
+
+	*p_split = true;
+	return 1;
+}
+
+// Combine the split DEFLATE chunks, must be called after the tasks have completed.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_finish_split_deflate(ufbxi_context *uc, ufbxi_deflate_task *t)
+{
+	size_t decoded_data_size = t->src_elem_size * t->array_size;
+	ptrdiff_t res = ufbxi_inflate_finish_chunks(t->chunks, t->num_chunks, t->decoded_data, decoded_data_size, t->no_checksum);
+	ufbxi_check_msg(res == (ptrdiff_t)decoded_data_size, "Bad DEFLATE data");
+
+	if (t->swap_endian) {
+		ufbxi_swap_endian_array_in_place(t->decoded_data, t->array_size, t->src_type);
+	}
+
+	if (t->decoded_data != t->dst_data) {
+		ufbxi_check_msg(ufbxi_binary_convert_array(NULL, t->src_type, t->dst_type, t->decoded_data, t->dst_data, t->array_size, t->has_avx2), "Failed to convert array");
+	}
+
+	if (t->arr_type == 'b') {
+		ufbxi_postprocess_bool_array((char*)t->dst_data, t->array_size);
+	}
+
+	if (t->index_stats_arr) {
+		ufbxi_gather_index_stats(t->index_stats_arr, (const uint32_t*)t->dst_data, t->array_size);
+	}
+
+	return 1;
+}
+
+#endif
+
 // Recursion limited by check at the start
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context *uc, uint32_t depth, ufbxi_parse_state parent_state, bool *p_end, ufbxi_buf *tmp_buf, bool recursive)
 	ufbxi_recursive_function(int, ufbxi_binary_parse_node, (uc, depth, parent_state, p_end, tmp_buf, recursive), UFBXI_MAX_NODE_DEPTH + 1,
@@ -8820,6 +10204,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 	ufbxi_array_info arr_info;
 	if (ufbxi_is_array_node(uc, parent_state, name, &arr_info)) {
 
+		// Deferred embedded content must be contiguous, so load split content normally.
+		if (arr_info.type == 'E' && num_values != 1) arr_info.type = 'C';
+
 		// Normalize the array type (eg. 'r' to 'f'/'d' depending on the build)
 		// and get the per-element size of the array.
 		// Boolean arrays 'b' are normalized to 'c' as they are postprocessed
@@ -8832,6 +10219,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 		node->value_type_mask = UFBXI_VALUE_ARRAY;
 		node->array = arr;
 		arr->type = ufbxi_normalize_array_type(arr_info.type, 'b');
+		arr->has_index_stats = false;
 
 		// Peek the first bytes of the array. We can always look at least 13 bytes
 		// ahead safely as valid FBX files must end in a 13/25 byte NULL record.
@@ -8883,7 +10271,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 			}
 
 			// Threading
-			if (uc->parse_threaded && encoding == 1 && encoded_size >= UFBXI_MIN_THREADED_DEFLATE_BYTES && !uc->file_big_endian && !uc->local_big_endian) {
+			if (uc->parse_threaded && encoding == 1 && encoded_size >= UFBXI_MIN_THREADED_DEFLATE_BYTES) {
 				ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_deflate_task_fn);
 				if (task) {
 					ufbxi_deflate_task *t = ufbxi_push_zero(tmp_buf, ufbxi_deflate_task, 1);
@@ -8898,7 +10286,21 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					t->dst_type = dst_type;
 					t->arr_type = arr->type;
 					t->dst_data = arr_data;
+					t->no_checksum = uc->opts.skip_deflate_checksum;
+					t->has_avx2 = uc->has_avx2;
+
+					// Byte swapping is done in place by the task: Arrays of matching types are
+					// swapped to the native byte order, arrays that need to be converted are
+					// swapped to little endian as expected by `ufbxi_binary_convert_array()`.
+					if (src_type == dst_type) {
+						t->swap_endian = uc->file_big_endian != uc->local_big_endian;
+					} else {
+						t->swap_endian = uc->file_big_endian;
+					}
 					t->inflate_retain = uc->inflate_retain;
+					if ((arr_info.flags & UFBXI_ARRAY_FLAG_INDEX) != 0 && dst_type == 'i') {
+						t->index_stats_arr = arr;
+					}
 
 					if (!uc->read_fn) {
 						// From memory, no need to copy
@@ -8917,8 +10319,19 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 						t->decoded_data = arr_data;
 					}
 
-					task->data = t;
-					ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+					// Very large arrays are decoded by multiple tasks, note that this
+					// creates its own tasks and ignores `task`.
+					bool split = false;
+#if !defined(ufbx_inflate)
+					if (encoded_size >= UFBXI_MIN_SPLIT_DEFLATE_BYTES) {
+						ufbxi_check(ufbxi_setup_split_deflate(uc, t, tmp_buf, &split));
+					}
+#endif
+
+					if (!split) {
+						task->data = t;
+						ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+					}
 					deferred = true;
 				}
 			}
@@ -8965,7 +10378,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				input.data = uc->data;
 				input.data_size = uc->data_size;
 				input.no_header = false;
-				input.no_checksum = false;
+				input.no_checksum = uc->opts.skip_deflate_checksum;
 				input.internal_fast_bits = 0;
 
 				if (uc->opts.progress_cb.fn) {
@@ -9007,6 +10420,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					ufbxi_check(ufbxi_resume_progress(uc));
 				}
 
+				// Initialize `retain` up front so CPU features are only checked once
+				ufbxi_inflate_init_retain(uc->inflate_retain);
 				ptrdiff_t res = ufbx_inflate(decoded_data, decoded_data_size, &input, uc->inflate_retain);
 				ufbxi_check_msg(res != -28, "Cancelled");
 				ufbxi_check_msg(res == (ptrdiff_t)decoded_data_size, "Bad DEFLATE data");
@@ -9017,7 +10432,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 
 			// Convert the decoded array if necessary.
 			if (!deferred && decoded_data != arr_data) {
-				ufbxi_check(ufbxi_binary_convert_array(uc, src_type, dst_type, decoded_data, arr_data, size));
+				ufbxi_check(ufbxi_binary_convert_array(uc, src_type, dst_type, decoded_data, arr_data, size, uc->has_avx2));
 			}
 
 			arr->data = arr_data;
@@ -9198,6 +10613,7 @@ static const char ufbxi_binary_magic[] = "Kaydara FBX Binary  \x00\x1a";
 #define UFBXI_ASCII_INT 'I'
 #define UFBXI_ASCII_FLOAT 'F'
 #define UFBXI_ASCII_STRING 'S'
+#define UFBXI_ASCII_DEFERRED_STRING 'D'
 
 static ufbxi_noinline char ufbxi_ascii_refill(ufbxi_context *uc)
 {
@@ -9338,6 +10754,51 @@ static ufbxi_forceinline bool ufbxi_is_space(char c)
 	return v < 32 && ((ufbxi_space_mask >> v) & 0x1) != 0;
 }
 
+// Structural character scanning shared by the ASCII FBX and OBJ tokenizers.
+// `ufbxi_scan_mask16()` classifies 16 bytes at a time into a bitmask of
+// whitespace characters (see `ufbxi_is_space()`) and a bitmask of bytes equal
+// to `special`, bit N corresponding to `p[N]`.
+
+typedef struct {
+	uint32_t space;
+	uint32_t special;
+} ufbxi_scan_mask;
+
+static ufbxi_forceinline ufbxi_scan_mask ufbxi_scan_mask16(const char *p, char special)
+{
+	ufbxi_scan_mask mask;
+#if UFBXI_HAS_SSE
+	const __m128i v = _mm_loadu_si128((const __m128i*)p);
+	const __m128i space = _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+		_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+	mask.space = (uint32_t)_mm_movemask_epi8(space);
+	mask.special = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(special)));
+#else
+	mask.space = 0;
+	mask.special = 0;
+	for (uint32_t i = 0; i < 16; i++) {
+		mask.space |= (ufbxi_is_space(p[i]) ? 1u : 0u) << i;
+		mask.special |= (p[i] == special ? 1u : 0u) << i;
+	}
+#endif
+	return mask;
+}
+
+// Returns a pointer to the first non-whitespace character in `[ptr, end)` or `end`.
+static ufbxi_forceinline const char *ufbxi_scan_skip_space(const char *ptr, const char *end)
+{
+#if UFBXI_HAS_SSE
+	while (ufbxi_to_size(end - ptr) >= 16) {
+		uint32_t non_space = ufbxi_scan_mask16(ptr, '\0').space ^ 0xffff;
+		if (non_space) return ptr + ufbxi_ctz32(non_space);
+		ptr += 16;
+	}
+#endif
+	while (ptr != end && ufbxi_is_space(*ptr)) ptr++;
+	return ptr;
+}
+
 static ufbxi_noinline char ufbxi_ascii_skip_whitespace(ufbxi_context *uc)
 {
 	ufbxi_ascii *ua = &uc->ascii;
@@ -9345,8 +10806,10 @@ static ufbxi_noinline char ufbxi_ascii_skip_whitespace(ufbxi_context *uc)
 	// Ignore whitespace
 	char c = ufbxi_ascii_peek(uc);
 	for (;;) {
+		// Skip buffered whitespace in bulk, `ufbxi_ascii_peek()` handles refilling
 		while (ufbxi_is_space(c)) {
-			c = ufbxi_ascii_next(uc);
+			ua->src = ufbxi_scan_skip_space(ua->src, ua->src_yield);
+			c = ufbxi_ascii_peek(uc);
 		}
 
 		// Line comment
@@ -9719,10 +11182,10 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_int_array(ufbxi_conte
 
 		// Skip '\s*,\s*' between array elements. If we don't find a comma after an element
 		// don't push it as we can't be 100% certain whether it's a part of the array.
-		while (src_scan != end && ufbxi_is_space(*src_scan)) src_scan++;
+		src_scan = ufbxi_scan_skip_space(src_scan, end);
 		if (src_scan == end || *src_scan != ',') break;
 		src_scan++;
-		while (src_scan != end && ufbxi_is_space(*src_scan)) src_scan++;
+		src_scan = ufbxi_scan_skip_space(src_scan, end);
 
 		// Found comma, commit to the position and push the previous value to the array
 		src = src_scan;
@@ -9948,6 +11411,300 @@ ufbxi_noinline static bool ufbxi_ascii_array_task_fn(ufbxi_task *task)
 	return true;
 }
 
+// -- ASCII structural index
+//
+// When the whole ASCII file is in memory we scan it in parallel chunks for braces,
+// commas, strings and comments before parsing `Objects`. This lets us find the
+// extent and value count of every array block without trusting the self-reported
+// `*N` sizes and split large arrays into multiple parse tasks at chunk boundaries.
+
+typedef enum {
+	UFBXI_ASCII_INDEX_STATE_NORMAL,
+	UFBXI_ASCII_INDEX_STATE_STRING,
+	UFBXI_ASCII_INDEX_STATE_COMMENT,
+} ufbxi_ascii_index_state;
+
+typedef struct {
+	size_t offset;
+	size_t num_commas;
+	bool open;
+} ufbxi_ascii_brace;
+
+typedef struct {
+	const char *data;
+	size_t offset;
+	size_t size;
+
+	ufbxi_ascii_index_state start_state;
+	ufbxi_ascii_index_state end_state;
+	size_t num_commas;
+
+	ufbxi_ascii_brace *braces;
+	size_t num_braces;
+	size_t braces_cap;
+	bool failed;
+} ufbxi_ascii_index_chunk;
+
+// Scan a chunk assuming `chunk->start_state`, sets `chunk->failed` if `braces[]` runs out.
+static ufbxi_noinline void ufbxi_ascii_index_scan(ufbxi_ascii_index_chunk *chunk)
+{
+	const char *ptr = chunk->data, *end = ptr + chunk->size;
+	ufbxi_ascii_index_state state = chunk->start_state;
+	size_t num_commas = 0;
+
+	chunk->num_braces = 0;
+	chunk->failed = false;
+	while (ptr != end) {
+		if (state == UFBXI_ASCII_INDEX_STATE_STRING) {
+			const char *quot = (const char*)memchr(ptr, '"', ufbxi_to_size(end - ptr));
+			if (!quot) break;
+			ptr = quot + 1;
+			state = UFBXI_ASCII_INDEX_STATE_NORMAL;
+		} else if (state == UFBXI_ASCII_INDEX_STATE_COMMENT) {
+			const char *line_end = (const char*)memchr(ptr, '\n', ufbxi_to_size(end - ptr));
+			if (!line_end) break;
+			ptr = line_end + 1;
+			state = UFBXI_ASCII_INDEX_STATE_NORMAL;
+		} else {
+			char c = *ptr++;
+			if (c == ',') {
+				num_commas++;
+			} else if (c == '"') {
+				state = UFBXI_ASCII_INDEX_STATE_STRING;
+			} else if (c == ';') {
+				state = UFBXI_ASCII_INDEX_STATE_COMMENT;
+			} else if (c == '{' || c == '}') {
+				if (chunk->num_braces == chunk->braces_cap) {
+					chunk->failed = true;
+					return;
+				}
+				ufbxi_ascii_brace *brace = &chunk->braces[chunk->num_braces++];
+				brace->offset = chunk->offset + ufbxi_to_size(ptr - chunk->data) - 1;
+				brace->num_commas = num_commas;
+				brace->open = c == '{';
+			}
+		}
+	}
+
+	chunk->num_commas = num_commas;
+	chunk->end_state = state;
+}
+
+static bool ufbxi_ascii_index_task_fn(ufbxi_task *task)
+{
+	ufbxi_ascii_index_scan((ufbxi_ascii_index_chunk*)task->data);
+
+	// Chunks that fail or started in the wrong state are re-scanned serially
+	return true;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_build_index(ufbxi_context *uc)
+{
+	ufbxi_ascii *ua = &uc->ascii;
+	ufbxi_ascii_index *ix = &uc->ascii_index;
+	memset(ix, 0, sizeof(ufbxi_ascii_index));
+
+	size_t size = ufbxi_to_size(ua->src_end - ua->src);
+	size_t num_chunks = size / UFBXI_ASCII_INDEX_CHUNK_BYTES;
+	num_chunks = ufbxi_min_sz(num_chunks, UFBXI_ASCII_INDEX_MAX_CHUNKS);
+	num_chunks = ufbxi_min_sz(num_chunks, ufbxi_thread_pool_available_tasks(&uc->thread_pool));
+	if (num_chunks < 2) return 1;
+
+	ix->begin = ua->src;
+	ix->size = size;
+	ix->num_chunks = num_chunks;
+	ix->chunk_offsets = ufbxi_push(&uc->tmp, size_t, num_chunks + 1);
+	ix->chunk_commas = ufbxi_push(&uc->tmp, size_t, num_chunks + 1);
+	ix->chunk_normal = ufbxi_push(&uc->tmp, bool, num_chunks);
+	ufbxi_check(ix->chunk_offsets && ix->chunk_commas && ix->chunk_normal);
+
+	ufbxi_ascii_index_chunk *chunks = ufbxi_push_zero(&uc->tmp_ascii_index, ufbxi_ascii_index_chunk, num_chunks);
+	ufbxi_check(chunks);
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_ascii_index_chunk *chunk = &chunks[i];
+		size_t begin = size / num_chunks * i;
+		size_t end = i + 1 < num_chunks ? size / num_chunks * (i + 1) : size;
+		ix->chunk_offsets[i] = begin;
+
+		// Reserve space for typical node density, denser chunks are re-scanned serially
+		chunk->data = ix->begin + begin;
+		chunk->offset = begin;
+		chunk->size = end - begin;
+		chunk->braces_cap = chunk->size / 64 + 16;
+		chunk->braces = ufbxi_push(&uc->tmp_ascii_index, ufbxi_ascii_brace, chunk->braces_cap);
+		ufbxi_check(chunk->braces);
+	}
+	ix->chunk_offsets[num_chunks] = size;
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_ascii_index_task_fn);
+		ufbxi_check(task);
+		task->data = &chunks[i];
+		ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+	}
+
+	ufbxi_thread_pool_flush_group(&uc->thread_pool);
+	ufbxi_check(ufbxi_thread_pool_wait_all(&uc->thread_pool));
+
+	// Re-scan chunks that ran out of space or started in the middle of a string or comment
+	ufbxi_ascii_index_state state = UFBXI_ASCII_INDEX_STATE_NORMAL;
+	size_t num_commas = 0;
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_ascii_index_chunk *chunk = &chunks[i];
+		if (chunk->failed || chunk->start_state != state) {
+			chunk->start_state = state;
+			ufbxi_ascii_index_scan(chunk);
+
+			// Grow the brace buffer geometrically, so it stays proportional to the
+			// number of braces in the chunk instead of its size in bytes.
+			while (chunk->failed) {
+				chunk->braces_cap = ufbxi_min_sz(chunk->braces_cap * 2, chunk->size);
+				chunk->braces = ufbxi_push(&uc->tmp_ascii_index, ufbxi_ascii_brace, chunk->braces_cap);
+				ufbxi_check(chunk->braces);
+				ufbxi_ascii_index_scan(chunk);
+			}
+		}
+
+		ix->chunk_normal[i] = state == UFBXI_ASCII_INDEX_STATE_NORMAL;
+		ix->chunk_commas[i] = num_commas;
+		num_commas += chunk->num_commas;
+		state = chunk->end_state;
+	}
+	ix->chunk_commas[num_chunks] = num_commas;
+
+	// Match braces using `tmp_stack` and record blocks that don't contain other blocks,
+	// ie. the ones closed right after the matching opening brace.
+	size_t num_open = 0;
+	bool prev_open = false;
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_ascii_index_chunk *chunk = &chunks[i];
+		ufbxi_for(ufbxi_ascii_brace, brace, chunk->braces, chunk->num_braces) {
+			size_t brace_commas = ix->chunk_commas[i] + brace->num_commas;
+			if (brace->open) {
+				ufbxi_ascii_brace *open = ufbxi_push(&uc->tmp_stack, ufbxi_ascii_brace, 1);
+				ufbxi_check(open);
+				*open = *brace;
+				open->num_commas = brace_commas;
+				num_open++;
+			} else if (num_open > 0) {
+				ufbxi_ascii_brace open; // ufbxi_uninit
+				ufbxi_pop(&uc->tmp_stack, ufbxi_ascii_brace, 1, &open);
+				num_open--;
+				if (prev_open) {
+					ufbxi_ascii_block *block = ufbxi_push(&uc->tmp_ascii_index, ufbxi_ascii_block, 1);
+					ufbxi_check(block);
+					block->open_offset = open.offset;
+					block->close_offset = brace->offset;
+					block->comma_begin = open.num_commas;
+					block->num_commas = brace_commas - open.num_commas;
+					ix->num_blocks++;
+				}
+			}
+			prev_open = brace->open;
+		}
+	}
+	ufbxi_pop(&uc->tmp_stack, ufbxi_ascii_brace, num_open, NULL);
+
+	ix->blocks = ufbxi_push_pop(&uc->tmp, &uc->tmp_ascii_index, ufbxi_ascii_block, ix->num_blocks);
+	ufbxi_check(ix->blocks);
+	ufbxi_buf_free(&uc->tmp_ascii_index);
+
+	return 1;
+}
+
+// Find the indexed block containing `ptr`, returns `NULL` if not found.
+static ufbxi_noinline const ufbxi_ascii_block *ufbxi_ascii_find_block(const ufbxi_ascii_index *ix, const char *ptr)
+{
+	size_t offset = (size_t)((uintptr_t)ptr - (uintptr_t)ix->begin);
+	if (ix->num_blocks == 0 || offset >= ix->size) return NULL;
+
+	// Find the last block opened before `offset`
+	size_t lo = 0, hi = ix->num_blocks;
+	while (hi - lo > 1) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (ix->blocks[mid].open_offset < offset) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	const ufbxi_ascii_block *block = &ix->blocks[lo];
+	if (block->open_offset < offset && offset <= block->close_offset) return block;
+	return NULL;
+}
+
+// Parse `arr_size` array values from `src` to the end of `block`, splitting the work into
+// multiple tasks at index chunk boundaries where the element index is known.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_parse_indexed_array(ufbxi_context *uc, const ufbxi_ascii_block *block, const char *src, void *arr_data, char arr_type, size_t arr_size, ufbxi_buf *tmp_buf)
+{
+	const ufbxi_ascii_index *ix = &uc->ascii_index;
+	size_t elem_size = ufbxi_array_type_size(arr_type);
+	size_t src_offset = ufbxi_to_size(src - ix->begin);
+
+	size_t first_chunk = 1, last_chunk = ix->num_chunks;
+	while (first_chunk < last_chunk && ix->chunk_offsets[first_chunk] <= src_offset) first_chunk++;
+	while (last_chunk > first_chunk && ix->chunk_offsets[last_chunk - 1] >= block->close_offset) last_chunk--;
+
+	size_t num_candidates = last_chunk - first_chunk;
+	size_t max_tasks = ufbxi_max_sz(ufbxi_thread_pool_available_tasks(&uc->thread_pool), 1);
+	size_t stride = (num_candidates + max_tasks) / max_tasks;
+
+	// Split points start after a comma, value offsets are relative to `src`
+	const char *split_src[UFBXI_ASCII_INDEX_MAX_CHUNKS + 1]; // ufbxi_uninit
+	size_t split_offset[UFBXI_ASCII_INDEX_MAX_CHUNKS + 1]; // ufbxi_uninit
+	size_t num_splits = 0;
+	split_src[num_splits] = src;
+	split_offset[num_splits] = 0;
+	num_splits++;
+
+	const char *end = ix->begin + block->close_offset + 1;
+	for (size_t i = first_chunk + stride - 1; i < last_chunk; i += stride) {
+		// Chunks starting within a comment or string may contain commas that are not
+		// separators, leave the range to the previous task which parses it serially.
+		if (!ix->chunk_normal[i]) continue;
+
+		const char *ptr = ix->begin + ix->chunk_offsets[i];
+		size_t offset = ix->chunk_commas[i] - block->comma_begin;
+		while (ptr != end && *ptr != ',' && *ptr != '"' && *ptr != ';') ptr++;
+		if (ptr == end || *ptr != ',') continue;
+		if (offset <= split_offset[num_splits - 1] || offset >= arr_size) continue;
+
+		split_src[num_splits] = ptr + 1;
+		split_offset[num_splits] = offset;
+		num_splits++;
+	}
+	split_src[num_splits] = end;
+	split_offset[num_splits] = arr_size;
+
+	for (size_t i = 0; i < num_splits; i++) {
+		ufbxi_ascii_span *span = ufbxi_push(tmp_buf, ufbxi_ascii_span, 1);
+		ufbxi_check(span);
+		span->source = split_src[i];
+		span->length = ufbxi_to_size(split_src[i + 1] - split_src[i]);
+
+		ufbxi_ascii_array_task t; // ufbxi_uninit
+		t.arr_data = (char*)arr_data + split_offset[i] * elem_size;
+		t.arr_type = arr_type;
+		t.arr_size = split_offset[i + 1] - split_offset[i];
+		t.num_spans = 1;
+		t.spans = span;
+		t.offset = 0;
+
+		ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_ascii_array_task_fn);
+		if (task) {
+			task->data = ufbxi_push_copy(tmp_buf, ufbxi_ascii_array_task, 1, &t);
+			ufbxi_check(task->data);
+			ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+		} else {
+			ufbxi_check_msg(ufbxi_ascii_array_task_imp(&t), "Threaded ASCII parse error");
+		}
+	}
+
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_float_array(ufbxi_context *uc, char type, size_t *p_num_read)
 {
 	ufbxi_ascii *ua = &uc->ascii;
@@ -9974,10 +11731,10 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_float_array(ufbxi_con
 
 		// Skip '\s*,\s*' between array elements. If we don't find a comma after an element
 		// don't push it as we can't be 100% certain whether it's a part of the array.
-		while (src_scan != end && ufbxi_is_space(*src_scan)) src_scan++;
+		src_scan = ufbxi_scan_skip_space(src_scan, end);
 		if (src_scan == end || *src_scan != ',') break;
 		src_scan++;
-		while (src_scan != end && ufbxi_is_space(*src_scan)) src_scan++;
+		src_scan = ufbxi_scan_skip_space(src_scan, end);
 
 		// Found comma, commit to the position and push the previous value to the array
 		src = src_scan;
@@ -10013,12 +11770,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_float_array(ufbxi_con
 	return 1;
 }
 
-ufbxi_noinline static int ufbxi_setup_base64(ufbxi_context *uc)
+static ufbxi_noinline void ufbxi_init_base64_table(uint8_t *table)
 {
-	uint8_t *table = ufbxi_push(&uc->tmp, uint8_t, 256);
-	ufbxi_check(table);
-	uc->base64_table = table;
-
 	memset(table, 0x80, 256);
 	ufbxi_nounroll for (char c = 'A'; c <= 'Z'; c++) table[(size_t)c] = (uint8_t)(c - 'A');
 	ufbxi_nounroll for (char c = 'a'; c <= 'z'; c++) table[(size_t)c] = (uint8_t)(26 + (c - 'a'));
@@ -10026,10 +11779,33 @@ ufbxi_noinline static int ufbxi_setup_base64(ufbxi_context *uc)
 	table[(size_t)'+'] = 62;
 	table[(size_t)'/'] = 63;
 	table[(size_t)'='] = 0x40;
+}
+
+ufbxi_noinline static int ufbxi_setup_base64(ufbxi_context *uc)
+{
+	uint8_t *table = ufbxi_push(&uc->tmp, uint8_t, 256);
+	ufbxi_check(table);
+	uc->base64_table = table;
+	ufbxi_init_base64_table(table);
 
 	return 1;
 }
 
+// Number of decoded bytes to drop due to padding, `tail` contains the last four
+// characters of the string. Sets `*p_bad` if the padding is malformed.
+static ufbxi_forceinline size_t ufbxi_base64_padding(const char *tail, bool *p_bad)
+{
+	uint32_t padding = 0;
+	padding |= tail[0] == '=' ? 0x8 : 0x0;
+	padding |= tail[1] == '=' ? 0x4 : 0x0;
+	padding |= tail[2] == '=' ? 0x2 : 0x0;
+	padding |= tail[3] == '=' ? 0x1 : 0x0;
+	if (padding <= 0x1) return padding; // "xxx=" or "xxxx"
+	if (padding == 0x3) return 2;       // "xx=="
+	*p_bad = true;                      // anything else
+	return 0;
+}
+
 ufbxi_noinline static int ufbxi_decode_base64(ufbxi_context *uc, ufbx_string *p_result, const char *src, size_t src_length, bool *p_failed)
 {
 	if (!uc->base64_table) ufbxi_check(ufbxi_setup_base64(uc));
@@ -10053,15 +11829,9 @@ ufbxi_noinline static int ufbxi_decode_base64(ufbxi_context *uc, ufbx_string *p_
 	}
 
 	if (src_length >= 4) {
-		const char *end = src + src_length - 4;
-		uint32_t padding = 0;
-		padding |= end[0] == '=' ? 0x8 : 0x0;
-		padding |= end[1] == '=' ? 0x4 : 0x0;
-		padding |= end[2] == '=' ? 0x2 : 0x0;
-		padding |= end[3] == '=' ? 0x1 : 0x0;
-		if (padding <= 0x1) p -= padding; // "xxx=" or "xxxx"
-		else if (padding == 0x3) p -= 2;  // "xx=="
-		else pad_error |= 0x40;           // anything else
+		bool bad_padding = false;
+		p -= ufbxi_base64_padding(src + src_length - 4, &bad_padding);
+		if (bad_padding) pad_error |= 0x40;
 	}
 
 	if (((error_mask & 0x80) != 0 || (pad_error & 0x40) != 0 || src_length % 4 != 0) && !*p_failed) {
@@ -10073,6 +11843,67 @@ ufbxi_noinline static int ufbxi_decode_base64(ufbxi_context *uc, ufbx_string *p_
 	return 1;
 }
 
+// Skip a string token only recording its location as a deferred embedded content part,
+// see `ufbx_load_opts.defer_embedded`. Results in `UFBXI_ASCII_DEFERRED_STRING` token.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_try_defer_string(ufbxi_context *uc, ufbxi_ascii_token *token)
+{
+	ufbxi_ascii *ua = &uc->ascii;
+
+	char c = ufbxi_ascii_skip_whitespace(uc);
+	token->str_len = 0;
+	if (c != '"') return false;
+
+	// Replace `prev_token` with `token` but swap the buffers so `token` uses
+	// the now-unused string buffer of the old `prev_token`.
+	char *swap_data = ua->prev_token.str_data;
+	size_t swap_cap = ua->prev_token.str_cap;
+	ua->prev_token = ua->token;
+	ua->token.str_data = swap_data;
+	ua->token.str_cap = swap_cap;
+
+	token->type = UFBXI_ASCII_DEFERRED_STRING;
+	ufbxi_embedded_part *part = &token->value.part;
+	part->offset = uc->data_offset + ufbxi_to_size(ua->src - uc->data_begin);
+
+	// Skip opening quote
+	ufbxi_ascii_next(uc);
+
+	// Find the closing quote keeping track of the last characters for base64 padding
+	char tail[4] = { 0 };
+	uint64_t length = 0;
+	for (;;) {
+		size_t buffered = ufbxi_to_size(ua->src_yield - ua->src);
+		if (buffered == 0) {
+			c = ufbxi_ascii_yield(uc);
+			ufbxi_check(c != '\0');
+			continue;
+		}
+
+		const char *begin = ua->src;
+		const char *match = (const char*)memchr(begin, '"', buffered);
+		size_t len = match ? ufbxi_to_size(match - begin) : buffered;
+		for (size_t i = len > 4 ? len - 4 : 0; i < len; i++) {
+			tail[0] = tail[1];
+			tail[1] = tail[2];
+			tail[2] = tail[3];
+			tail[3] = begin[i];
+		}
+		length += len;
+		ua->src = begin + len;
+		if (match) break;
+	}
+
+	// Skip closing quote
+	ufbxi_ascii_next(uc);
+
+	// Malformed content is detected when decoding, see `ufbxi_base64_decoder`
+	bool bad_padding = false;
+	part->encoded_size = length + 2;
+	part->size = (size_t)(length / 4 * 3);
+	if (length >= 4) part->size -= ufbxi_base64_padding(tail, &bad_padding);
+	return true;
+}
+
 // Recursion limited by check at the start
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *uc, uint32_t depth, ufbxi_parse_state parent_state, bool *p_end, ufbxi_buf *tmp_buf, bool recursive)
 	ufbxi_recursive_function(int, ufbxi_ascii_parse_node, (uc, depth, parent_state, p_end, tmp_buf, recursive), UFBXI_MAX_NODE_DEPTH + 1,
@@ -10135,6 +11966,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 		node->value_type_mask = UFBXI_VALUE_ARRAY;
 		node->array = arr;
 		arr->type = (char)arr_type;
+		arr->has_index_stats = false;
 
 		// Parse array values using strtof() if the array destination is 32-bit float
 		// since KeyAttrDataFloat packs integer data (!) into floating point values so we
@@ -10162,10 +11994,15 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	if (ua->token.type == ',') {
 		// HACK: If we are parsing an "array" that should be ignored, ie. `Content` when
 		// `opts.ignore_embedded == true` try to skip the next token string if possible.
+		// Similarly with `opts.defer_embedded == true` record the string location instead.
 		if (arr_type == '-') {
 			if (!ufbxi_ascii_try_ignore_string(uc, &ua->token)) {
 				ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
 			}
+		} else if (arr_type == 'E') {
+			if (!ufbxi_ascii_try_defer_string(uc, &ua->token)) {
+				ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
+			}
 		} else {
 			ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
 		}
@@ -10175,6 +12012,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	ufbxi_value vals[UFBXI_MAX_NON_ARRAY_VALUES];
 
 	uint32_t deferred_size = 0;
+	const ufbxi_ascii_block *deferred_block = NULL;
+	const char *deferred_src = NULL;
 
 	// NOTE: Infinite loop to allow skipping the comma parsing via `continue`.
 	for (;;) {
@@ -10191,7 +12030,19 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 			num_values += (uint32_t)num_read;
 		}
 
-		if (ufbxi_ascii_accept(uc, UFBXI_ASCII_STRING)) {
+		if (ufbxi_ascii_accept(uc, UFBXI_ASCII_DEFERRED_STRING)) {
+			ufbx_assert(arr_type == 'E');
+			ufbxi_embedded_part *v = ufbxi_push_copy(&uc->tmp_stack, ufbxi_embedded_part, 1, &tok->value.part);
+			ufbxi_check(v);
+
+		} else if (ufbxi_ascii_accept(uc, UFBXI_ASCII_STRING)) {
+
+			// Content that could not be deferred (eg. missing leading comma), load it normally
+			if (arr_type == 'E' && num_values == 0) {
+				arr_type = 'C';
+				arr_elem_size = ufbxi_array_type_size('C');
+				node->array->type = 'C';
+			}
 
 			if (arr_type) {
 
@@ -10352,8 +12203,20 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 						&& (arr_type == 'i' || arr_type == 'l' || arr_type == 'f' || arr_type == 'd')) {
 					// Don't bother with small arrays due to fixed overhead
 					if (count >= UFBXI_MIN_THREADED_ASCII_VALUES && count <= UINT32_MAX) {
-						deferred_size = (uint32_t)count - 1;
-						ufbxi_check(ufbxi_ascii_store_array(uc, tmp_buf));
+						const ufbxi_ascii_block *block = ufbxi_ascii_find_block(&uc->ascii_index, ua->src);
+						if (block) {
+							// Indexed arrays whose size doesn't match the comma count are parsed serially.
+							// Skip to the closing brace, forcing `ufbxi_ascii_yield()` on the next read.
+							if (block->num_commas == (uint64_t)count - 1) {
+								deferred_size = (uint32_t)count - 1;
+								deferred_block = block;
+								deferred_src = ua->src;
+								ua->src = ua->src_yield = uc->ascii_index.begin + block->close_offset;
+							}
+						} else {
+							deferred_size = (uint32_t)count - 1;
+							ufbxi_check(ufbxi_ascii_store_array(uc, tmp_buf));
+						}
 					}
 				}
 			}
@@ -10369,7 +12232,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 		// skipped if we enter an array block.
 		num_values++;
 		ufbxi_check(num_values < UINT32_MAX);
-		if (!ufbxi_ascii_accept(uc, ',')) break;
+		if (arr_type == 'E') {
+			if (ua->token.type != ',') break;
+			if (!ufbxi_ascii_try_defer_string(uc, &ua->token)) {
+				ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
+			}
+		} else if (!ufbxi_ascii_accept(uc, ',')) {
+			break;
+		}
 	}
 
 	// Close the ASCII array if we are in one
@@ -10412,7 +12282,10 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 			ufbxi_pop_size(&uc->tmp_stack, 8, 1, NULL, false);
 
 			// Deferred parsing
-			if (deferred_size > 0) {
+			if (deferred_block) {
+				void *deferred_data = (char*)arr_data + num_values * arr_elem_size;
+				ufbxi_check(ufbxi_ascii_parse_indexed_array(uc, deferred_block, deferred_src, deferred_data, (char)arr_type, deferred_size, tmp_buf));
+			} else if (deferred_size > 0) {
 				size_t num_spans = uc->tmp_ascii_spans.num_items;
 				ufbxi_ascii_span *spans = ufbxi_push_pop(tmp_buf, &uc->tmp_ascii_spans, ufbxi_ascii_span, num_spans);
 				ufbxi_check(spans);
@@ -10544,6 +12417,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_retain_dom_node(ufbxi_context *u
 		case 'd': val->type = UFBX_DOM_VALUE_ARRAY_F64; break;
 		case 's': val->type = UFBX_DOM_VALUE_ARRAY_RAW_STRING; break;
 		case 'C': val->type = UFBX_DOM_VALUE_ARRAY_RAW_STRING; break;
+		case 'E': val->type = UFBX_DOM_VALUE_ARRAY_IGNORED; val->value_blob.size = 0; break;
 		case '-': val->type = UFBX_DOM_VALUE_ARRAY_IGNORED; break;
 		default: ufbxi_fail("Bad array type");
 		}
@@ -11526,10 +13400,31 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_maps(ufbxi_context *uc)
 
 // -- Reading the parsed data
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_embedded_blob(ufbxi_context *uc, ufbx_blob *dst_blob, ufbxi_node *node)
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_embedded_blob(ufbxi_context *uc, ufbx_blob *dst_blob, ufbx_embedded_location *dst_location, ufbxi_node *node)
 {
 	if (!node) return 1;
 
+	ufbxi_value_array *part_arr = dst_location ? ufbxi_get_array(node, 'E') : NULL;
+	if (part_arr && part_arr->size > 0) {
+		size_t num_parts = part_arr->size;
+		const ufbxi_embedded_part *parts = (const ufbxi_embedded_part*)part_arr->data;
+		const ufbxi_embedded_part *last = &parts[num_parts - 1];
+
+		size_t size = 0;
+		ufbxi_for(const ufbxi_embedded_part, part, parts, num_parts) {
+			ufbxi_check(SIZE_MAX - size >= part->size);
+			size += part->size;
+		}
+
+		if (size > 0) {
+			dst_location->encoding = uc->from_ascii ? UFBX_EMBEDDED_ENCODING_BASE64 : UFBX_EMBEDDED_ENCODING_RAW;
+			dst_location->offset = parts[0].offset;
+			dst_location->encoded_size = last->offset + last->encoded_size - parts[0].offset;
+			dst_location->size = size;
+		}
+		return 1;
+	}
+
 	ufbxi_value_array *content_arr = ufbxi_get_array(node, 'C');
 	if (content_arr && content_arr->size > 0) {
 		ufbx_string content;
@@ -11621,7 +13516,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_read_property(ufbxi_context *uc,
 	// Very unlikely, seems to only exist in some "non standard" FBX files
 	if (node->num_children > 0) {
 		ufbxi_node *binary = ufbxi_find_child(node, ufbxi_BinaryData);
-		ufbxi_check(ufbxi_read_embedded_blob(uc, &prop->value_blob, binary));
+		ufbxi_check(ufbxi_read_embedded_blob(uc, &prop->value_blob, NULL, binary));
 		flags |= (uint32_t)UFBX_PROP_FLAG_VALUE_BLOB;
 	}
 
@@ -12374,6 +14269,42 @@ static ufbx_real ufbxi_zero_element[8] = { 0 };
 static const uint32_t ufbxi_sentinel_index_zero[1] = { 100000000 };
 static const uint32_t ufbxi_sentinel_index_consecutive[1] = { 123456789 };
 
+ufbxi_forceinline static void ufbxi_patch_index_pointer(ufbxi_context *uc, uint32_t **p_index)
+{
+	if (*p_index == ufbxi_sentinel_index_zero) {
+		*p_index = uc->zero_indices;
+	} else if (*p_index == ufbxi_sentinel_index_consecutive) {
+		*p_index = uc->consecutive_indices;
+	}
+}
+
+static ufbxi_noinline void ufbxi_patch_mesh_index_pointers(ufbxi_context *uc, ufbx_mesh *mesh)
+{
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_position.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_normal.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_color.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_crease.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->face_material.data);
+	ufbxi_patch_index_pointer(uc, &mesh->face_group.data);
+
+	ufbxi_patch_index_pointer(uc, &mesh->skinned_position.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->skinned_normal.indices.data);
+
+	ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+		ufbxi_patch_index_pointer(uc, &set->vertex_uv.indices.data);
+		ufbxi_patch_index_pointer(uc, &set->vertex_bitangent.indices.data);
+		ufbxi_patch_index_pointer(uc, &set->vertex_tangent.indices.data);
+	}
+
+	ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
+		ufbxi_patch_index_pointer(uc, &set->vertex_color.indices.data);
+	}
+
+	if (mesh->face_group_parts.count == 1) {
+		ufbxi_patch_index_pointer(uc, &mesh->face_group_parts.data[0].face_indices.data);
+	}
+}
+
 ufbxi_noinline static int ufbxi_fix_index(ufbxi_context *uc, uint32_t *p_dst, uint32_t index, size_t one_past_max_val)
 {
 	switch (uc->opts.index_error_handling) {
@@ -12718,6 +14649,22 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_blend_offsets(ufbxi_context
 	return 1;
 }
 
+// Copy an array parsed to temporary memory to the result if meshes are streamed, see `ufbxi_is_array_node()`.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_retain_streamed_array(ufbxi_context *uc, ufbxi_value_array *arr)
+{
+	if (!arr || !uc->opts.mesh_cb.fn || uc->opts.retain_dom) return 1;
+
+	// Keep the zero padding of `UFBXI_ARRAY_FLAG_PAD_BEGIN` arrays
+	size_t elem_size = ufbxi_array_type_size(arr->type);
+	char *data = (char*)ufbxi_push_size_zero(&uc->result, elem_size, arr->size + 4);
+	ufbxi_check(data);
+	data += elem_size * 4;
+	memcpy(data, arr->data, elem_size * arr->size);
+	arr->data = data;
+
+	return 1;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_shape(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
 {
 	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
@@ -12736,6 +14683,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_shape(ufbxi_context *uc, uf
 	ufbxi_check(vertices && indices);
 	ufbxi_check(vertices->size % 3 == 0);
 	ufbxi_check(indices->size == vertices->size / 3);
+	ufbxi_check(ufbxi_retain_streamed_array(uc, vertices));
+	ufbxi_check(ufbxi_retain_streamed_array(uc, indices));
 
 	size_t num_offsets = indices->size;
 	uint32_t *vertex_indices = (uint32_t*)indices->data;
@@ -12749,6 +14698,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_shape(ufbxi_context *uc, uf
 	if (node_normals) {
 		ufbxi_value_array *normals = ufbxi_get_array(node_normals, 'r');
 		ufbxi_check(normals && normals->size == vertices->size);
+		ufbxi_check(ufbxi_retain_streamed_array(uc, normals));
 		shape->normal_offsets.data = (ufbx_vec3*)normals->data;
 		shape->normal_offsets.count = num_offsets;
 	}
@@ -12847,13 +14797,16 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_synthetic_blend_shapes(ufbx
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_process_indices(ufbxi_context *uc, ufbx_mesh *mesh, uint32_t *index_data)
+// `num_total_faces` may be precomputed by the caller, pass `SIZE_MAX` if unknown.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_process_indices(ufbxi_context *uc, ufbx_mesh *mesh, uint32_t *index_data, size_t num_total_faces)
 {
 	// Count the number of faces and allocate the index list
 	// Indices less than zero (~actual_index) ends a polygon
-	size_t num_total_faces = 0;
-	ufbxi_for (uint32_t, p_ix, index_data, mesh->num_indices) {
-		num_total_faces += ((int32_t)*p_ix < 0) ? 1u : 0u;
+	if (num_total_faces == SIZE_MAX) {
+		num_total_faces = 0;
+		ufbxi_for (uint32_t, p_ix, index_data, mesh->num_indices) {
+			num_total_faces += ((int32_t)*p_ix < 0) ? 1u : 0u;
+		}
 	}
 	mesh->faces.data = ufbxi_push(&uc->result, ufbx_face, num_total_faces);
 	ufbxi_check(mesh->faces.data);
@@ -12863,11 +14816,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_process_indices(ufbxi_context *u
 	size_t num_bad_faces[3] = { 0 };
 
 	ufbx_face *dst_face = mesh->faces.data;
+	ufbx_face *dst_face_end = dst_face + num_total_faces;
 	uint32_t *p_face_begin = index_data;
 	ufbxi_for (uint32_t, p_ix, index_data, mesh->num_indices) {
 		uint32_t ix = *p_ix;
 		// Un-negate final indices of polygons
 		if ((int32_t)ix < 0) {
+			// The face count may be precomputed, don't trust it to match the indices
+			ufbxi_check_msg(dst_face != dst_face_end, "Bad face count");
 			ix = ~ix;
 			*p_ix =  ix;
 			uint32_t num_indices = (uint32_t)((p_ix - p_face_begin) + 1);
@@ -12887,6 +14843,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_process_indices(ufbxi_context *u
 
 	mesh->vertex_position.indices.data = index_data;
 	mesh->num_faces = ufbxi_to_size(dst_face - mesh->faces.data);
+	ufbxi_check_msg(mesh->num_faces == num_total_faces, "Bad face count");
 	mesh->faces.count = mesh->num_faces;
 	mesh->num_triangles = num_triangles;
 	mesh->max_face_triangles = max_face_triangles;
@@ -13142,25 +15099,11 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_update_face_groups(ufbxi_buf *bu
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh_geometry(ufbxi_context *uc, ufbx_mesh *ufbxi_restrict mesh, ufbxi_node *node)
 {
-	ufbx_mesh *ufbxi_restrict mesh = ufbxi_push_element(uc, info, ufbx_mesh, UFBX_ELEMENT_MESH);
-	ufbxi_check(mesh);
-
-	// In up to version 7100 FBX files blend shapes are contained within the same geometry node
-	if (uc->version <= 7100) {
-		ufbxi_check(ufbxi_read_synthetic_blend_shapes(uc, node, info));
-	}
-
-	ufbxi_patch_mesh_reals(mesh);
-
-	// Sometimes there are empty meshes in FBX files?
-	// TODO: Should these be included in output? option? strict mode?
 	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
 	ufbxi_node *node_indices = ufbxi_find_child(node, ufbxi_PolygonVertexIndex);
-	if (!node_vertices) return 1;
-
-	if (uc->opts.ignore_geometry) return 1;
+	ufbxi_check(node_vertices);
 
 	ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
 	ufbxi_value_array *indices = node_indices ? ufbxi_get_array(node_indices, 'i') : NULL;
@@ -13192,11 +15135,18 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 	mesh->vertex_position.indices.count = mesh->num_indices;
 	mesh->vertex_position.unique_per_vertex = true;
 
+	// If the index array was decoded in a task we already know the number of faces
+	size_t num_faces = SIZE_MAX;
+	if (indices && indices->has_index_stats) {
+		num_faces = indices->index_num_negative;
+	}
+
 	// Check/make sure that the last index is negated (last of polygon)
 	if (mesh->num_indices > 0) {
 		if ((int32_t)index_data[mesh->num_indices - 1] >= 0) {
 			if (uc->opts.strict) ufbxi_fail("Non-negated last index");
 			index_data[mesh->num_indices - 1] = ~index_data[mesh->num_indices - 1];
+			if (num_faces != SIZE_MAX) num_faces++;
 		}
 	}
 
@@ -13237,7 +15187,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 		mesh->num_edges = mesh->edges.count;
 	}
 
-	ufbxi_check(ufbxi_process_indices(uc, mesh, index_data));
+	ufbxi_check(ufbxi_process_indices(uc, mesh, index_data, num_faces));
 
 	// Count the number of UV/color sets
 	size_t num_uv = 0, num_color = 0, num_bitangents = 0, num_tangents = 0;
@@ -13501,6 +15451,76 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 		ufbxi_check(extra->texture_arr);
 	}
 
+	return 1;
+}
+
+// Pass a mesh to `ufbx_load_opts.mesh_cb` and reset it to `empty_mesh`, the state before reading any geometry.
+// Releases everything allocated from `tmp_mesh_geometry`.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_stream_mesh(ufbxi_context *uc, ufbx_mesh *mesh, const ufbx_mesh *empty_mesh)
+{
+	// The shared procedural index buffers are only generated in `ufbxi_finalize_scene()`,
+	// so create temporary ones for this mesh.
+	size_t num_indices = ufbxi_max_sz(mesh->num_indices, mesh->num_faces);
+	uint32_t *zero_indices = ufbxi_push_zero(&uc->tmp_mesh_geometry, uint32_t, num_indices);
+	uint32_t *consecutive_indices = ufbxi_push(&uc->tmp_mesh_geometry, uint32_t, num_indices);
+	ufbxi_check(zero_indices && consecutive_indices);
+	for (size_t i = 0; i < num_indices; i++) {
+		consecutive_indices[i] = (uint32_t)i;
+	}
+
+	uc->zero_indices = zero_indices;
+	uc->consecutive_indices = consecutive_indices;
+	ufbxi_patch_mesh_index_pointers(uc, mesh);
+	uc->zero_indices = NULL;
+	uc->consecutive_indices = NULL;
+
+	bool ok = uc->opts.mesh_cb.fn(uc->opts.mesh_cb.user, mesh);
+	*mesh = *empty_mesh;
+	ufbxi_buf_clear(&uc->tmp_mesh_geometry);
+	ufbxi_check_msg(ok, "Cancelled");
+
+	return 1;
+}
+
+// Read mesh geometry into `tmp_mesh_geometry` instead of the result buffer so it can be
+// released after `ufbx_load_opts.mesh_cb` returns.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_streamed_mesh(ufbxi_context *uc, ufbx_mesh *mesh, ufbxi_node *node)
+{
+	ufbx_mesh empty_mesh = *mesh;
+
+	ufbxi_buf result = uc->result;
+	uc->result = uc->tmp_mesh_geometry;
+	uc->warnings.result = &result;
+	int ok = ufbxi_read_mesh_geometry(uc, mesh, node);
+	uc->warnings.result = &uc->result;
+	uc->tmp_mesh_geometry = uc->result;
+	uc->result = result;
+	ufbxi_check(ok);
+
+	ufbxi_check(ufbxi_stream_mesh(uc, mesh, &empty_mesh));
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
+{
+	ufbx_mesh *ufbxi_restrict mesh = ufbxi_push_element(uc, info, ufbx_mesh, UFBX_ELEMENT_MESH);
+	ufbxi_check(mesh);
+
+	// In up to version 7100 FBX files blend shapes are contained within the same geometry node
+	if (uc->version <= 7100) {
+		ufbxi_check(ufbxi_read_synthetic_blend_shapes(uc, node, info));
+	}
+
+	ufbxi_patch_mesh_reals(mesh);
+
+	// Sometimes there are empty meshes in FBX files?
+	// TODO: Should these be included in output? option? strict mode?
+	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
+	if (!node_vertices) return 1;
+
+	if (uc->opts.ignore_geometry) return 1;
+
 	// Subdivision
 
 	ufbxi_ignore(ufbxi_find_val1(node, ufbxi_PreviewDivisionLevels, "I", &mesh->subdivision_preview_levels));
@@ -13518,6 +15538,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 		}
 	}
 
+	if (uc->opts.mesh_cb.fn) {
+		ufbxi_check(ufbxi_read_streamed_mesh(uc, mesh, node));
+	} else {
+		ufbxi_check(ufbxi_read_mesh_geometry(uc, mesh, node));
+	}
+
 	return 1;
 }
 
@@ -13553,6 +15579,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_nurbs_curve(ufbxi_context *
 		ufbxi_check(points);
 		ufbxi_check(knot);
 		ufbxi_check(points->size % 4 == 0);
+		ufbxi_check(ufbxi_retain_streamed_array(uc, points));
+		ufbxi_check(ufbxi_retain_streamed_array(uc, knot));
 
 		nurbs->control_points.count = points->size / 4;
 		nurbs->control_points.data = (ufbx_vec4*)points->data;
@@ -13592,6 +15620,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_nurbs_surface(ufbxi_context
 		ufbxi_check(knot_v);
 		ufbxi_check(points->size % 4 == 0);
 		ufbxi_check(points->size / 4 == (size_t)dimension_u * (size_t)dimension_v);
+		ufbxi_check(ufbxi_retain_streamed_array(uc, points));
+		ufbxi_check(ufbxi_retain_streamed_array(uc, knot_u));
+		ufbxi_check(ufbxi_retain_streamed_array(uc, knot_v));
 
 		nurbs->control_points.count = points->size / 4;
 		nurbs->control_points.data = (ufbx_vec4*)points->data;
@@ -13615,6 +15646,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_line(ufbxi_context *uc, ufb
 		ufbxi_check(points);
 		ufbxi_check(points_index);
 		ufbxi_check(points->size % 3 == 0);
+		ufbxi_check(ufbxi_retain_streamed_array(uc, points));
+		ufbxi_check(ufbxi_retain_streamed_array(uc, points_index));
 
 		if (points->size > 0) {
 			line->control_points.count = points->size / 3;
@@ -14296,7 +16329,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_video(ufbxi_context *uc, uf
 	ufbxi_ignore(ufbxi_find_val1(node, ufbxi_RelativeFilename, "b", &video->raw_relative_filename));
 
 	ufbxi_node *content_node = ufbxi_find_child(node, ufbxi_Content);
-	ufbxi_check(ufbxi_read_embedded_blob(uc, &video->content, content_node));
+	ufbxi_check(ufbxi_read_embedded_blob(uc, &video->content, &video->content_location, content_node));
 
 	return 1;
 }
@@ -14468,7 +16501,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_audio_clip(ufbxi_context *u
 	audio->relative_filename = ufbx_empty_string;
 
 	ufbxi_node *content_node = ufbxi_find_child(node, ufbxi_Content);
-	ufbxi_check(ufbxi_read_embedded_blob(uc, &audio->content, content_node));
+	ufbxi_check(ufbxi_read_embedded_blob(uc, &audio->content, &audio->content_location, content_node));
 
 	return 1;
 }
@@ -14789,12 +16822,18 @@ typedef struct {
 	ufbxi_node **nodes;
 	size_t num_nodes;
 	uint32_t task_index;
+	ufbxi_deflate_task *split_deflate_tasks;
 } ufbxi_object_batch;
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_context *uc)
 {
 	uc->parse_threaded = true;
 
+	// In-memory ASCII files can be indexed up front to find array blocks.
+	if (uc->from_ascii && !uc->read_fn && !uc->opts.force_single_thread_ascii_parsing) {
+		ufbxi_check(ufbxi_ascii_build_index(uc));
+	}
+
 	bool parsed_to_end = false;
 	ufbxi_object_batch batches[UFBX_THREAD_GROUP_COUNT]; // ufbxi_uninit
 	memset(batches, 0, sizeof(batches));
@@ -14806,6 +16845,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 
 		ufbxi_check(ufbxi_thread_pool_wait_group(&uc->thread_pool));
 
+#if !defined(ufbx_inflate)
+		for (ufbxi_deflate_task *t = batch->split_deflate_tasks; t; t = t->next_split) {
+			ufbxi_check(ufbxi_finish_split_deflate(uc, t));
+		}
+#endif
+		batch->split_deflate_tasks = NULL;
+
 		if (batch->num_nodes > 0) {
 			ufbxi_for_ptr(ufbxi_node, p_node, batch->nodes, batch->num_nodes) {
 				ufbxi_buf_clear(&uc->tmp_parse);
@@ -14834,6 +16880,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 				ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->read_buffer, &uc->read_buffer_size, size));
 			}
 			memcpy(uc->read_buffer, ua->src, size);
+			uc->data_offset += ufbxi_to_size(ua->src - uc->data_begin);
 			uc->data = uc->data_begin = ua->src = uc->read_buffer;
 			ua->src_end = uc->read_buffer + size;
 			ua->src_is_retained = false;
@@ -14876,6 +16923,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 			batch->nodes = ufbxi_push_pop(tmp_buf, &uc->tmp_stack, ufbxi_node*, num_nodes);
 			ufbxi_check(batch->nodes);
 			batch->task_index = uc->thread_pool.start_index;
+			batch->split_deflate_tasks = uc->split_deflate_tasks;
+			uc->split_deflate_tasks = NULL;
 
 		}
 
@@ -14894,6 +16943,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 	ufbxi_check(ufbxi_thread_pool_wait_all(&uc->thread_pool));
 
 	uc->parse_threaded = false;
+	memset(&uc->ascii_index, 0, sizeof(uc->ascii_index));
 
 	return 1;
 }
@@ -15784,6 +17834,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_legacy_mesh(ufbxi_context *
 
 	if (uc->opts.ignore_geometry) return 1;
 
+	ufbx_mesh empty_mesh = *mesh;
+
 	ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
 	ufbxi_value_array *indices = ufbxi_get_array(node_indices, 'i');
 	ufbxi_check(vertices && indices);
@@ -15820,7 +17872,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_legacy_mesh(ufbxi_context *
 		}
 	}
 
-	ufbxi_check(ufbxi_process_indices(uc, mesh, index_data));
+	ufbxi_check(ufbxi_process_indices(uc, mesh, index_data, SIZE_MAX));
 
 	// Normals are either per-vertex or per-index in legacy FBX files?
 	// If the version is 5000 prefer per-vertex, otherwise per-index...
@@ -15924,6 +17976,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_legacy_mesh(ufbxi_context *
 
 	ufbxi_patch_mesh_reals(mesh);
 
+	// Legacy geometry is always in the result buffer, so streaming doesn't save any memory
+	if (uc->opts.mesh_cb.fn) {
+		ufbxi_check(ufbxi_stream_mesh(uc, mesh, &empty_mesh));
+	}
+
 	return 1;
 }
 
@@ -16472,6 +18529,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_init(ufbxi_context *uc)
 	uc->obj.tmp_face_group_infos.ator = &uc->ator_tmp;
 	uc->obj.tmp_meshes.ator = &uc->ator_tmp;
 	uc->obj.tmp_props.ator = &uc->ator_tmp;
+	uc->obj.tmp_chunks.ator = &uc->ator_tmp;
+	uc->obj.tmp_chunks.unordered = true;
+	uc->obj.tmp_chunks.clearable = true;
 
 	// .obj parsing does its own yield logic
 	uc->data_size += uc->yield_size;
@@ -16510,6 +18570,7 @@ static ufbxi_noinline void ufbxi_obj_free(ufbxi_context *uc)
 	ufbxi_buf_free(&uc->obj.tmp_face_group_infos);
 	ufbxi_buf_free(&uc->obj.tmp_meshes);
 	ufbxi_buf_free(&uc->obj.tmp_props);
+	ufbxi_buf_free(&uc->obj.tmp_chunks);
 
 	ufbxi_map_free(&uc->obj.group_map);
 
@@ -16591,8 +18652,75 @@ static ufbxi_noinline ufbx_string ufbxi_obj_span_token(ufbxi_context *uc, size_t
 	return result;
 }
 
+// Tokenize a line using `ufbxi_scan_mask16()` to find token boundaries 16 bytes at a time.
+// Bails out with `*p_fallback` for line continuations and leading comment tokens which
+// are left for `ufbxi_obj_tokenize()` to handle.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_tokenize_fast(ufbxi_context *uc, bool *p_fallback)
+{
+	const char *begin = uc->obj.line.data, *end = begin + uc->obj.line.length;
+	uc->obj.num_tokens = 0;
+
+	// `in_token` tracks whether the previous byte belongs to a token, `bits` contains
+	// alternating token start and end positions relative to `base`.
+	bool in_token = false;
+	for (const char *base = begin; base < end; base += 16) {
+		uint32_t space, escape;
+		if (ufbxi_to_size(end - base) >= 16) {
+			ufbxi_scan_mask mask = ufbxi_scan_mask16(base, '\\');
+			space = mask.space;
+			escape = mask.special;
+		} else {
+			space = 0;
+			escape = 0;
+			for (uint32_t i = 0; base + i != end; i++) {
+				space |= (ufbxi_is_space(base[i]) ? 1u : 0u) << i;
+				escape |= (base[i] == '\\' ? 1u : 0u) << i;
+			}
+			space |= ~0u << ufbxi_to_size(end - base);
+		}
+		if (escape) {
+			*p_fallback = true;
+			return 1;
+		}
+
+		uint32_t prev_space = space << 1u | (in_token ? 0u : 1u);
+		uint32_t bits = (space ^ prev_space) & 0xffff;
+		in_token = (space & 0x8000) == 0;
+
+		while (bits) {
+			const char *ptr = base + ufbxi_ctz32(bits);
+			bits &= bits - 1;
+
+			size_t num_tokens = uc->obj.num_tokens;
+			if ((space & (1u << (uint32_t)(ptr - base))) == 0) {
+				// Token start
+				if (*ptr == '#') {
+					// Trailing comments end the line, a leading '#' is a token of its own
+					if (num_tokens == 0) *p_fallback = true;
+					return 1;
+				}
+				ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->obj.tokens, &uc->obj.tokens_cap, num_tokens + 1));
+				uc->obj.tokens[num_tokens].data = ptr;
+				uc->obj.num_tokens = num_tokens + 1;
+			} else {
+				// Token end
+				ufbx_string *tok = &uc->obj.tokens[num_tokens - 1];
+				tok->length = ufbxi_to_size(ptr - tok->data);
+			}
+		}
+	}
+
+	// Lines always end in '\n' so the last token must be terminated
+	ufbxi_dev_assert(!in_token);
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_tokenize(ufbxi_context *uc)
 {
+	bool fallback = false;
+	ufbxi_check(ufbxi_obj_tokenize_fast(uc, &fallback));
+	if (!fallback) return 1;
+
 	const char *ptr = uc->obj.line.data, *end = ptr + uc->obj.line.length;
 	uc->obj.num_tokens = 0;
 
@@ -16702,30 +18830,8 @@ static ufbxi_noinline int ufbxi_obj_parse_vertex(ufbxi_context *uc, ufbxi_obj_at
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_index(ufbxi_context *uc, ufbx_string *s, uint32_t attrib)
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_push_index(ufbxi_context *uc, uint64_t index, bool negative, uint32_t attrib)
 {
-	const char *ptr = s->data, *end = ptr + s->length;
-
-	bool negative = false;
-	if (*ptr == '-') {
-		negative = true;
-		ptr++;
-	}
-
-	// As .obj indices are never zero we can detect missing indices
-	// by simply not writing to it.
-	uint64_t index = 0;
-	for (; ptr != end; ptr++) {
-		char c = *ptr;
-		if (c >= '0' && c <= '9') {
-			ufbxi_check(index < UINT64_MAX / 10 - 10);
-			index = index * 10 + (uint64_t)(c - '0');
-		} else if (c == '/') {
-			ptr++;
-			break;
-		}
-	}
-
 	if (negative) {
 		size_t count = uc->obj.vertex_count[attrib];
 		index = index <= count ? count - index : UINT64_MAX;
@@ -16754,13 +18860,43 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_index(ufbxi_context *u
 		range->max_ix = ufbxi_max64(range->max_ix, index);
 	}
 
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_index(ufbxi_context *uc, ufbx_string *s, uint32_t attrib)
+{
+	const char *ptr = s->data, *end = ptr + s->length;
+
+	bool negative = false;
+	if (*ptr == '-') {
+		negative = true;
+		ptr++;
+	}
+
+	// As .obj indices are never zero we can detect missing indices
+	// by simply not writing to it.
+	uint64_t index = 0;
+	for (; ptr != end; ptr++) {
+		char c = *ptr;
+		if (c >= '0' && c <= '9') {
+			ufbxi_check(index < UINT64_MAX / 10 - 10);
+			index = index * 10 + (uint64_t)(c - '0');
+		} else if (c == '/') {
+			ptr++;
+			break;
+		}
+	}
+
+	ufbxi_check(ufbxi_obj_push_index(uc, index, negative, attrib));
+
 	s->data = ptr;
 	s->length = ufbxi_to_size(end - ptr);
 
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_indices(ufbxi_context *uc, size_t token_begin, size_t num_tokens)
+// Parse a face from `uc->obj.tokens[]` or from `raw_indices` pre-parsed by `ufbxi_obj_parse_chunk()`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_indices(ufbxi_context *uc, size_t token_begin, size_t num_tokens, const uint64_t *raw_indices)
 {
 	bool flush_mesh = false;
 	if (uc->obj.object_dirty) {
@@ -16878,10 +19014,18 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_indices(ufbxi_context
 		*p_face_group = uc->obj.face_group;
 	}
 
-	for (size_t ix = 0; ix < num_indices; ix++) {
-		ufbx_string tok = uc->obj.tokens[token_begin + ix];
-		for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
-			ufbxi_check(ufbxi_obj_parse_index(uc, &tok, attrib));
+	if (raw_indices) {
+		for (size_t ix = 0; ix < num_indices * UFBXI_OBJ_NUM_ATTRIBS; ix++) {
+			uint64_t raw = raw_indices[ix];
+			uint32_t attrib = (uint32_t)(ix % UFBXI_OBJ_NUM_ATTRIBS);
+			ufbxi_check(ufbxi_obj_push_index(uc, raw & ~UFBXI_OBJ_RAW_INDEX_NEGATIVE, (raw & UFBXI_OBJ_RAW_INDEX_NEGATIVE) != 0, attrib));
+		}
+	} else {
+		for (size_t ix = 0; ix < num_indices; ix++) {
+			ufbx_string tok = uc->obj.tokens[token_begin + ix];
+			for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
+				ufbxi_check(ufbxi_obj_parse_index(uc, &tok, attrib));
+			}
 		}
 	}
 
@@ -16891,7 +19035,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_indices(ufbxi_context
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_multi_indices(ufbxi_context *uc, size_t window)
 {
 	for (size_t begin = 1; begin + window <= uc->obj.num_tokens; begin++) {
-		ufbxi_check(ufbxi_obj_parse_indices(uc, begin, window));
+		ufbxi_check(ufbxi_obj_parse_indices(uc, begin, window, NULL));
 	}
 	return 1;
 }
@@ -17266,10 +19410,269 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc
 	return 1;
 }
 
+// Pre-parse a single line of `chunk`, returns `false` if the chunk has run out of space.
+// Anything other than plain vertices and faces is skipped and parsed serially later.
+static ufbxi_noinline bool ufbxi_obj_parse_chunk_line(ufbxi_obj_chunk *chunk, const char *line, const char *line_end)
+{
+	const char *ptr = line;
+	while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r') ptr++;
+
+	uint32_t type; // ufbxi_uninit
+	if (ptr[0] == 'v' && ufbxi_is_space(ptr[1])) {
+		type = UFBXI_OBJ_ATTRIB_POSITION;
+		ptr += 1;
+	} else if (ptr[0] == 'v' && ptr[1] == 't' && ufbxi_is_space(ptr[2])) {
+		type = UFBXI_OBJ_ATTRIB_UV;
+		ptr += 2;
+	} else if (ptr[0] == 'v' && ptr[1] == 'n' && ufbxi_is_space(ptr[2])) {
+		type = UFBXI_OBJ_ATTRIB_NORMAL;
+		ptr += 2;
+	} else if (ptr[0] == 'f' && ufbxi_is_space(ptr[1])) {
+		type = UFBXI_OBJ_LINE_FACE;
+		ptr += 1;
+	} else {
+		return true;
+	}
+
+	size_t stride = type == UFBXI_OBJ_LINE_FACE ? 0 : ufbxi_obj_attrib_stride[type];
+	if (chunk->num_lines == chunk->lines_cap) return false;
+	if (chunk->values_cap - chunk->num_values < stride) return false;
+
+	ufbx_real *values = chunk->values + chunk->num_values;
+	uint64_t *indices = chunk->indices + chunk->num_indices;
+	size_t indices_left = chunk->indices_cap - chunk->num_indices;
+
+	size_t num_tokens = 0;
+	for (;;) {
+		while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r') ptr++;
+		if (*ptr == '\n') break;
+
+		const char *tok = ptr;
+		while (!ufbxi_is_space(*ptr)) {
+			// Comments and line continuations are left to the serial parser
+			if (*ptr == '#' || *ptr == '\\') return true;
+			ptr++;
+		}
+		const char *tok_end = ptr;
+
+		if (type == UFBXI_OBJ_LINE_FACE) {
+			if (indices_left < UFBXI_OBJ_NUM_ATTRIBS) return false;
+			indices_left -= UFBXI_OBJ_NUM_ATTRIBS;
+
+			// Matches `ufbxi_obj_parse_index()`, errors are reported by the serial parser
+			for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
+				bool negative = false;
+				if (*tok == '-') {
+					negative = true;
+					tok++;
+					if (tok == tok_end) return true;
+				}
+
+				uint64_t index = 0;
+				for (; tok != tok_end; tok++) {
+					char c = *tok;
+					if (c >= '0' && c <= '9') {
+						if (index >= UINT64_MAX / 10 - 10) return true;
+						index = index * 10 + (uint64_t)(c - '0');
+					} else if (c == '/') {
+						tok++;
+						break;
+					}
+				}
+
+				if (index & UFBXI_OBJ_RAW_INDEX_NEGATIVE) return true;
+				*indices++ = negative ? index | UFBXI_OBJ_RAW_INDEX_NEGATIVE : index;
+			}
+		} else if (num_tokens < stride) {
+			char *end; // ufbxi_uninit
+			double val = ufbxi_parse_double(tok, ufbxi_to_size(tok_end - tok), &end, chunk->parse_flags);
+			if (end != tok_end) return true;
+			values[num_tokens] = (ufbx_real)val;
+		}
+
+		num_tokens++;
+	}
+
+	if (type == UFBXI_OBJ_LINE_FACE) {
+		if (num_tokens == 0) return true;
+	} else {
+		if (num_tokens < stride) return true;
+		// Vertex colors are handled serially, see `ufbxi_obj_parse_file()`
+		if (type == UFBXI_OBJ_ATTRIB_POSITION && num_tokens >= 6) return true;
+	}
+
+	ufbxi_obj_line *dst = &chunk->lines[chunk->num_lines++];
+	dst->offset = (uint32_t)(line - chunk->data);
+	dst->length = (uint32_t)(line_end - line) + 1;
+	dst->type = type;
+	if (type == UFBXI_OBJ_LINE_FACE) {
+		dst->num_values = (uint32_t)num_tokens;
+		chunk->num_indices += num_tokens * UFBXI_OBJ_NUM_ATTRIBS;
+	} else {
+		dst->num_values = (uint32_t)stride;
+		chunk->num_values += stride;
+	}
+
+	return true;
+}
+
+static ufbxi_noinline void ufbxi_obj_parse_chunk(ufbxi_obj_chunk *chunk)
+{
+	const char *ptr = chunk->data, *end = ptr + chunk->data_size;
+	while (ptr != end) {
+		const char *line_end = (const char*)memchr(ptr, '\n', ufbxi_to_size(end - ptr));
+		ufbx_assert(line_end);
+		if (!ufbxi_obj_parse_chunk_line(chunk, ptr, line_end)) break;
+		ptr = line_end + 1;
+	}
+}
+
+static bool ufbxi_obj_chunk_task_fn(ufbxi_task *task)
+{
+	ufbxi_obj_parse_chunk((ufbxi_obj_chunk*)task->data);
+
+	// Lines that could not be pre-parsed are parsed serially
+	return true;
+}
+
+// Split the buffered data into line-aligned chunks and pre-parse them in parallel.
+// The chunks stay valid until the serial parser reaches `uc->obj.block_end_offset`,
+// as `ufbxi_obj_read_line()` does not need to refill within complete lines.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_block(ufbxi_context *uc)
+{
+	uc->obj.chunks = NULL;
+	uc->obj.num_chunks = 0;
+	uc->obj.chunk_index = 0;
+	ufbxi_buf_clear(&uc->obj.tmp_chunks);
+
+	size_t max_chunks = ufbxi_min_sz(UFBXI_OBJ_MAX_CHUNKS, ufbxi_thread_pool_available_tasks(&uc->thread_pool));
+	size_t max_block_size = max_chunks * UFBXI_OBJ_CHUNK_BYTES;
+	if (uc->data_size < max_block_size && !uc->eof) {
+		ufbxi_check(ufbxi_refill(uc, max_block_size, false));
+	}
+
+	size_t block_size = ufbxi_min_sz(uc->data_size, max_block_size);
+	while (block_size > 0 && uc->data[block_size - 1] != '\n') {
+		block_size--;
+	}
+
+	// Retry at the next line if there are no complete lines in the buffer
+	uc->obj.block_end_offset = ufbxi_get_read_offset(uc) + ufbxi_max_sz(block_size, 1);
+
+	size_t num_chunks = ufbxi_min_sz(block_size / UFBXI_OBJ_MIN_CHUNK_BYTES, max_chunks);
+	if (num_chunks < 2) return 1;
+
+	ufbxi_obj_chunk *chunks = ufbxi_push_zero(&uc->obj.tmp_chunks, ufbxi_obj_chunk, num_chunks);
+	ufbxi_check(chunks);
+
+	const char *block_begin = uc->data, *block_end = uc->data + block_size;
+	const char *chunk_begin = block_begin;
+	size_t num_created = 0;
+	for (size_t i = 0; i < num_chunks && chunk_begin != block_end; i++) {
+		const char *chunk_end = block_end;
+		if (i + 1 < num_chunks) {
+			const char *split = block_begin + block_size / num_chunks * (i + 1);
+			if (split < chunk_begin) split = chunk_begin;
+			chunk_end = (const char*)memchr(split, '\n', ufbxi_to_size(block_end - split)) + 1;
+		}
+
+		// Reserve space for typical lines, chunks with denser data are partially parsed serially
+		size_t size = ufbxi_to_size(chunk_end - chunk_begin);
+		ufbxi_obj_chunk *chunk = &chunks[num_created++];
+		chunk->data = chunk_begin;
+		chunk->data_size = size;
+		chunk->parse_flags = uc->double_parse_flags;
+		chunk->lines_cap = size / 16 + 1;
+		chunk->values_cap = size / 8 + 4;
+		chunk->indices_cap = size / 4 + 8;
+		chunk->lines = ufbxi_push(&uc->obj.tmp_chunks, ufbxi_obj_line, chunk->lines_cap);
+		chunk->values = ufbxi_push(&uc->obj.tmp_chunks, ufbx_real, chunk->values_cap);
+		chunk->indices = ufbxi_push(&uc->obj.tmp_chunks, uint64_t, chunk->indices_cap);
+		ufbxi_check(chunk->lines && chunk->values && chunk->indices);
+
+		chunk_begin = chunk_end;
+	}
+
+	for (size_t i = 0; i < num_created; i++) {
+		ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_obj_chunk_task_fn);
+		ufbxi_check(task);
+		task->data = &chunks[i];
+		ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+	}
+
+	ufbxi_thread_pool_flush_group(&uc->thread_pool);
+	ufbxi_check(ufbxi_thread_pool_wait_all(&uc->thread_pool));
+
+	uc->obj.chunks = chunks;
+	uc->obj.num_chunks = num_created;
+
+	return 1;
+}
+
+// Parse the current line from pre-parsed chunk data if possible, sets `*p_parsed` on success.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_chunk_data(ufbxi_context *uc, bool *p_parsed)
+{
+	const char *line_data = uc->obj.line.data;
+	while (uc->obj.chunk_index < uc->obj.num_chunks) {
+		ufbxi_obj_chunk *chunk = &uc->obj.chunks[uc->obj.chunk_index];
+		if (chunk->line_index == chunk->num_lines) {
+			uc->obj.chunk_index++;
+			continue;
+		}
+
+		const ufbxi_obj_line *line = &chunk->lines[chunk->line_index];
+		const char *data = chunk->data + line->offset;
+		if (data > line_data) return 1;
+
+		size_t value_index = chunk->value_index;
+		size_t index_index = chunk->index_index;
+		chunk->line_index++;
+		if (line->type == UFBXI_OBJ_LINE_FACE) {
+			chunk->index_index += line->num_values * UFBXI_OBJ_NUM_ATTRIBS;
+		} else {
+			chunk->value_index += line->num_values;
+		}
+
+		// Chunks may contain lines that are a part of a line continuation
+		if (data != line_data || line->length != uc->obj.line.length) continue;
+
+		if (line->type == UFBXI_OBJ_LINE_FACE) {
+			ufbxi_check(ufbxi_obj_parse_indices(uc, 0, line->num_values, chunk->indices + index_index));
+		} else {
+			ufbxi_obj_attrib attrib = (ufbxi_obj_attrib)line->type;
+			ufbx_real *vals = ufbxi_push_fast(&uc->obj.tmp_vertices[attrib], ufbx_real, line->num_values);
+			ufbxi_check(vals);
+			memcpy(vals, chunk->values + value_index, line->num_values * sizeof(ufbx_real));
+			uc->obj.vertex_count[attrib]++;
+		}
+
+		*p_parsed = true;
+		return 1;
+	}
+
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc)
 {
+	// Vertices and faces can be pre-parsed in parallel, they are not needed
+	// if ignoring geometry.
+	bool threaded = uc->thread_pool.enabled && !uc->opts.ignore_geometry;
+
 	while (!uc->obj.eof) {
-		ufbxi_check(ufbxi_obj_tokenize_line(uc));
+		if (threaded && ufbxi_get_read_offset(uc) >= uc->obj.block_end_offset) {
+			ufbxi_check(ufbxi_obj_parse_block(uc));
+		}
+
+		ufbxi_check(ufbxi_obj_read_line(uc));
+
+		if (uc->obj.num_chunks > 0) {
+			bool parsed = false;
+			ufbxi_check(ufbxi_obj_parse_chunk_data(uc, &parsed));
+			if (parsed) continue;
+		}
+
+		ufbxi_check(ufbxi_obj_tokenize(uc));
 		size_t num_tokens = uc->obj.num_tokens;
 		if (num_tokens == 0) continue;
 
@@ -17294,7 +19697,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc
 		} else if (key == ufbxi_obj_cmd2('v','n')) {
 			ufbxi_check(ufbxi_obj_parse_vertex(uc, UFBXI_OBJ_ATTRIB_NORMAL, 1));
 		} else if (key == ufbxi_obj_cmd1('f')) {
-			ufbxi_check(ufbxi_obj_parse_indices(uc, 1, uc->obj.num_tokens - 1));
+			ufbxi_check(ufbxi_obj_parse_indices(uc, 1, uc->obj.num_tokens - 1, NULL));
 		} else if (key == ufbxi_obj_cmd1('p')) {
 			ufbxi_check(ufbxi_obj_parse_multi_indices(uc, 1));
 		} else if (key == ufbxi_obj_cmd1('l')) {
@@ -18771,15 +21174,6 @@ ufbxi_nodiscard ufbxi_noinline static ufbx_connection *ufbxi_find_prop_connectio
 	return index < SIZE_MAX ? &element->connections_dst.data[index] : NULL;
 }
 
-ufbxi_forceinline static void ufbxi_patch_index_pointer(ufbxi_context *uc, uint32_t **p_index)
-{
-	if (*p_index == ufbxi_sentinel_index_zero) {
-		*p_index = uc->zero_indices;
-	} else if (*p_index == ufbxi_sentinel_index_consecutive) {
-		*p_index = uc->consecutive_indices;
-	}
-}
-
 ufbxi_nodiscard static bool ufbxi_cmp_anim_prop_less(const ufbx_anim_prop *a, const ufbx_anim_prop *b)
 {
 	if (a->element != b->element) return a->element < b->element;
@@ -20215,6 +22609,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_texture_file(ufbxi_contex
 	ufbxi_patch_empty(file->raw_relative_filename, size, texture->raw_relative_filename);
 	ufbxi_patch_empty(file->raw_absolute_filename, size, texture->raw_absolute_filename);
 	ufbxi_patch_empty(file->content, size, texture->content);
+	ufbxi_patch_empty(file->content_location, size, texture->content_location);
 
 	return 1;
 }
@@ -20883,20 +23278,21 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_file_contents(ufbxi_context
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_file_content(ufbxi_context *uc, ufbx_string *p_filename, ufbx_blob *p_data)
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_file_content(ufbxi_context *uc, ufbx_string *p_filename, ufbx_blob *p_data, ufbx_embedded_location *p_location)
 {
-	if (p_data->size == 0 || p_filename->length == 0) return 1;
+	if ((p_data->size == 0 && p_location->size == 0) || p_filename->length == 0) return 1;
 	ufbxi_file_content *content = ufbxi_push(&uc->tmp_stack, ufbxi_file_content, 1);
 	ufbxi_check(content);
 
 	content->absolute_filename = *p_filename;
 	content->content = *p_data;
+	content->content_location = *p_location;
 	return 1;
 }
 
-ufbxi_noinline static void ufbxi_fetch_file_content(ufbxi_context *uc, ufbx_string *p_filename, ufbx_blob *p_data)
+ufbxi_noinline static void ufbxi_fetch_file_content(ufbxi_context *uc, ufbx_string *p_filename, ufbx_blob *p_data, ufbx_embedded_location *p_location)
 {
-	if (p_data->size > 0) return;
+	if (p_data->size > 0 || p_location->size > 0) return;
 	ufbx_string filename = *p_filename;
 	size_t index = SIZE_MAX;
 	ufbxi_macro_lower_bound_eq(ufbxi_file_content, 8, &index, uc->file_content, 0, uc->num_file_content,
@@ -20904,6 +23300,7 @@ ufbxi_noinline static void ufbxi_fetch_file_content(ufbxi_context *uc, ufbx_stri
 		( a->absolute_filename.data == filename.data ));
 	if (index != SIZE_MAX) {
 		*p_data = uc->file_content[index].content;
+		*p_location = uc->file_content[index].content_location;
 	}
 }
 
@@ -20915,7 +23312,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_file_content(ufbxi_conte
 		ufbx_video *video = *p_video;
 		ufbxi_check(ufbxi_resolve_filenames(uc, (ufbxi_strblob*)&video->filename, (ufbxi_strblob*)&video->absolute_filename, (ufbxi_strblob*)&video->relative_filename, false));
 		ufbxi_check(ufbxi_resolve_filenames(uc, (ufbxi_strblob*)&video->raw_filename, (ufbxi_strblob*)&video->raw_absolute_filename, (ufbxi_strblob*)&video->raw_relative_filename, true));
-		ufbxi_check(ufbxi_push_file_content(uc, &video->absolute_filename, &video->content));
+		ufbxi_check(ufbxi_push_file_content(uc, &video->absolute_filename, &video->content, &video->content_location));
 	}
 
 	ufbxi_for_ptr_list(ufbx_audio_clip, p_clip, uc->scene.audio_clips) {
@@ -20926,7 +23323,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_file_content(ufbxi_conte
 		clip->raw_relative_filename = ufbx_find_blob(&clip->props, "RelPath", ufbx_empty_blob);
 		ufbxi_check(ufbxi_resolve_filenames(uc, (ufbxi_strblob*)&clip->filename, (ufbxi_strblob*)&clip->absolute_filename, (ufbxi_strblob*)&clip->relative_filename, false));
 		ufbxi_check(ufbxi_resolve_filenames(uc, (ufbxi_strblob*)&clip->raw_filename, (ufbxi_strblob*)&clip->raw_absolute_filename, (ufbxi_strblob*)&clip->raw_relative_filename, true));
-		ufbxi_check(ufbxi_push_file_content(uc, &clip->absolute_filename, &clip->content));
+		ufbxi_check(ufbxi_push_file_content(uc, &clip->absolute_filename, &clip->content, &clip->content_location));
 	}
 
 	uc->num_file_content = uc->tmp_stack.num_items - initial_stack;
@@ -20936,12 +23333,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_file_content(ufbxi_conte
 
 	ufbxi_for_ptr_list(ufbx_video, p_video, uc->scene.videos) {
 		ufbx_video *video = *p_video;
-		ufbxi_fetch_file_content(uc, &video->absolute_filename, &video->content);
+		ufbxi_fetch_file_content(uc, &video->absolute_filename, &video->content, &video->content_location);
 	}
 
 	ufbxi_for_ptr_list(ufbx_audio_clip, p_clip, uc->scene.audio_clips) {
 		ufbx_audio_clip *clip = *p_clip;
-		ufbxi_fetch_file_content(uc, &clip->absolute_filename, &clip->content);
+		ufbxi_fetch_file_content(uc, &clip->absolute_filename, &clip->content, &clip->content_location);
 	}
 
 	return 1;
@@ -21040,12 +23437,24 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf
 	return 1;
 }
 
+typedef struct ufbxi_anim_cursor_imp ufbxi_anim_cursor_imp;
+
 typedef struct {
 	ufbxi_refcount refcount;
 	ufbx_anim anim;
 	uint32_t magic;
+
+	// Set for `ufbx_anim_cursor.anim`, the cursor owns the animation.
+	ufbxi_anim_cursor_imp *cursor;
 } ufbxi_anim_imp;
 
+// Returns the cursor of `ufbx_anim_cursor.anim`, custom animations are always `ufbxi_anim_imp`.
+static ufbxi_forceinline ufbxi_anim_cursor_imp *ufbxi_get_anim_cursor(const ufbx_anim *anim)
+{
+	if (!anim->custom) return NULL;
+	return ufbxi_get_imp(ufbxi_anim_imp, anim)->cursor;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_anim(ufbxi_context *uc, ufbx_anim **p_anim, ufbx_anim_layer **layers, size_t num_layers)
 {
 	ufbx_anim *anim = ufbxi_push_zero(&uc->result, ufbx_anim, 1);
@@ -21446,25 +23855,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 		ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
 			ufbx_mesh *mesh = *p_mesh;
 
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_position.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_normal.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_color.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_crease.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->face_material.data);
-			ufbxi_patch_index_pointer(uc, &mesh->face_group.data);
-
-			ufbxi_patch_index_pointer(uc, &mesh->skinned_position.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->skinned_normal.indices.data);
-
-			ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
-				ufbxi_patch_index_pointer(uc, &set->vertex_uv.indices.data);
-				ufbxi_patch_index_pointer(uc, &set->vertex_bitangent.indices.data);
-				ufbxi_patch_index_pointer(uc, &set->vertex_tangent.indices.data);
-			}
-
-			ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
-				ufbxi_patch_index_pointer(uc, &set->vertex_color.indices.data);
-			}
+			ufbxi_patch_mesh_index_pointers(uc, mesh);
 
 			// Generate normals if necessary
 			if (!mesh->vertex_normal.exists && uc->opts.generate_missing_normals) {
@@ -21481,10 +23872,6 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 				mesh->vertex_color = mesh->color_sets.data[0].vertex_color;
 			}
 
-			if (mesh->face_group_parts.count == 1) {
-				ufbxi_patch_index_pointer(uc, &mesh->face_group_parts.data[0].face_indices.data);
-			}
-
 			ufbxi_check(ufbxi_fetch_mesh_materials(uc, &mesh->materials, &mesh->element, true));
 
 			// Patch materials to instances if necessary
@@ -21877,6 +24264,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 		texture->video = (ufbx_video*)ufbxi_fetch_dst_element(&texture->element, false, NULL, UFBX_ELEMENT_VIDEO);
 		if (texture->video) {
 			texture->content = texture->video->content;
+			texture->content_location = texture->video->content_location;
 		}
 
 		ufbxi_check(ufbxi_finalize_shader_texture(uc, texture));
@@ -23178,25 +25566,37 @@ ufbxi_noinline static void ufbxi_update_adjust_transforms(ufbxi_context *uc, ufb
 	}
 }
 
-ufbxi_noinline static void ufbxi_update_scene(ufbx_scene *scene, bool initial, const ufbx_transform_override *transform_overrides, size_t num_transform_overrides)
+static ufbxi_forceinline bool ufbxi_in_element_mask(const bool *element_mask, const void *element)
+{
+	return !element_mask || element_mask[((const ufbx_element*)element)->element_id];
+}
+
+// Update derived values of the elements in `element_mask` indexed by `element_id`, or all if `NULL`.
+ufbxi_noinline static void ufbxi_update_scene(ufbx_scene *scene, bool initial, const ufbx_transform_override *transform_overrides, size_t num_transform_overrides,
+	const bool *element_mask)
 {
 	ufbxi_for_ptr_list(ufbx_node, p_node, scene->nodes) {
+		if (!ufbxi_in_element_mask(element_mask, *p_node)) continue;
 		ufbxi_update_node(*p_node, transform_overrides, num_transform_overrides);
 	}
 
 	ufbxi_for_ptr_list(ufbx_light, p_light, scene->lights) {
+		if (!ufbxi_in_element_mask(element_mask, *p_light)) continue;
 		ufbxi_update_light(*p_light);
 	}
 
 	ufbxi_for_ptr_list(ufbx_camera, p_camera, scene->cameras) {
+		if (!ufbxi_in_element_mask(element_mask, *p_camera)) continue;
 		ufbxi_update_camera(scene, *p_camera);
 	}
 
 	ufbxi_for_ptr_list(ufbx_bone, p_bone, scene->bones) {
+		if (!ufbxi_in_element_mask(element_mask, *p_bone)) continue;
 		ufbxi_update_bone(scene, *p_bone);
 	}
 
 	ufbxi_for_ptr_list(ufbx_line_curve, p_line, scene->line_curves) {
+		if (!ufbxi_in_element_mask(element_mask, *p_line)) continue;
 		ufbxi_update_line_curve(*p_line);
 	}
 
@@ -23209,32 +25609,39 @@ ufbxi_noinline static void ufbxi_update_scene(ufbx_scene *scene, bool initial, c
 	}
 
 	ufbxi_for_ptr_list(ufbx_skin_cluster, p_cluster, scene->skin_clusters) {
+		if (!ufbxi_in_element_mask(element_mask, *p_cluster)) continue;
 		ufbxi_update_skin_cluster(*p_cluster);
 	}
 
 	ufbxi_for_ptr_list(ufbx_blend_channel, p_channel, scene->blend_channels) {
+		if (!ufbxi_in_element_mask(element_mask, *p_channel)) continue;
 		ufbxi_update_blend_channel(*p_channel);
 	}
 
 	ufbxi_for_ptr_list(ufbx_texture, p_texture, scene->textures) {
+		if (!ufbxi_in_element_mask(element_mask, *p_texture)) continue;
 		ufbxi_update_texture(*p_texture);
 	}
 
 	ufbxi_propagate_main_textures(scene);
 
 	ufbxi_for_ptr_list(ufbx_material, p_material, scene->materials) {
+		if (!ufbxi_in_element_mask(element_mask, *p_material)) continue;
 		ufbxi_update_material(scene, *p_material);
 	}
 
 	ufbxi_for_ptr_list(ufbx_anim_stack, p_stack, scene->anim_stacks) {
+		if (!ufbxi_in_element_mask(element_mask, *p_stack)) continue;
 		ufbxi_update_anim_stack(scene, *p_stack);
 	}
 
 	ufbxi_for_ptr_list(ufbx_display_layer, p_layer, scene->display_layers) {
+		if (!ufbxi_in_element_mask(element_mask, *p_layer)) continue;
 		ufbxi_update_display_layer(*p_layer);
 	}
 
 	ufbxi_for_ptr_list(ufbx_constraint, p_constraint, scene->constraints) {
+		if (!ufbxi_in_element_mask(element_mask, *p_constraint)) continue;
 		ufbxi_update_constraint(*p_constraint);
 	}
 
@@ -24427,32 +26834,634 @@ static ufbxi_forceinline double ufbxi_find_cubic_bezier_t(double p1, double p2,
 	return t;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *scene, ufbx_error *error, ufbxi_buf *buf_result, ufbxi_buf *buf_tmp,
-	double time, bool load_caches, ufbx_geometry_cache_data_opts *cache_opts)
+// Number of cubic segments to solve at once in batched curve evaluation.
+#define UFBXI_BEZIER_BATCH_SIZE 16
+
+// Cubic segments waiting for `ufbxi_find_cubic_bezier_t()`, stored as SoA so
+// that the Newton-Rhapson iterations can be done for multiple segments at once.
+typedef struct {
+	size_t count;
+	double p1[UFBXI_BEZIER_BATCH_SIZE];
+	double p2[UFBXI_BEZIER_BATCH_SIZE];
+	double x0[UFBXI_BEZIER_BATCH_SIZE];
+	double y0[UFBXI_BEZIER_BATCH_SIZE];
+	double y1[UFBXI_BEZIER_BATCH_SIZE];
+	double y2[UFBXI_BEZIER_BATCH_SIZE];
+	double y3[UFBXI_BEZIER_BATCH_SIZE];
+	ufbx_real *dst[UFBXI_BEZIER_BATCH_SIZE];
+} ufbxi_bezier_batch;
+
+// Evaluate a cubic Bezier segment with control values `y0..y3` at `t`.
+static ufbxi_forceinline ufbx_real ufbxi_evaluate_bezier(double t, double y0, double y1, double y2, double y3)
+{
+	double t2 = t*t, t3 = t2*t;
+	double u = 1.0 - t, u2 = u*u, u3 = u2*u;
+	return (ufbx_real)(u3*y0 + 3.0 * (u2*t*y1 + u*t2*y2) + t3*y3);
+}
+
+// Evaluate all the segments in `batch`, equivalent to the cubic case in `ufbx_evaluate_curve()`.
+static ufbxi_noinline void ufbxi_flush_bezier_batch(ufbxi_bezier_batch *batch)
+{
+	size_t count = batch->count;
+	double ts[UFBXI_BEZIER_BATCH_SIZE]; // ufbxi_uninit
+	size_t i = 0;
+
+#if UFBXI_HAS_SSE
+	// Same operations as the first three iterations of `ufbxi_find_cubic_bezier_t()`
+	// for two segments at a time, lanes that have not converged are re-solved below.
+	const __m128d one = _mm_set1_pd(1.0), two = _mm_set1_pd(2.0), three = _mm_set1_pd(3.0);
+	const __m128d eps = _mm_set1_pd(8.881784197001252e-16), sign = _mm_set1_pd(-0.0);
+	for (; i + 2 <= count; i += 2) {
+		__m128d p1_3 = _mm_mul_pd(_mm_loadu_pd(batch->p1 + i), three);
+		__m128d p2_3 = _mm_mul_pd(_mm_loadu_pd(batch->p2 + i), three);
+		__m128d x0 = _mm_loadu_pd(batch->x0 + i);
+		__m128d a = _mm_add_pd(_mm_sub_pd(p1_3, p2_3), one);
+		__m128d b = _mm_sub_pd(_mm_sub_pd(p2_3, p1_3), p1_3);
+		__m128d c = p1_3;
+		__m128d a_3 = _mm_mul_pd(three, a), b_2 = _mm_mul_pd(two, b);
+		__m128d t = x0, x1 = x0;
+
+		for (int iter = 0; iter < 3; iter++) {
+			__m128d t2 = _mm_mul_pd(t, t), t3 = _mm_mul_pd(t2, t);
+			x1 = _mm_sub_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a, t3), _mm_mul_pd(b, t2)), _mm_mul_pd(c, t)), x0);
+			__m128d dx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a_3, t2), _mm_mul_pd(b_2, t)), c);
+			t = _mm_sub_pd(t, _mm_div_pd(x1, dx));
+		}
+
+		_mm_storeu_pd(ts + i, t);
+		int converged = _mm_movemask_pd(_mm_cmple_pd(_mm_andnot_pd(sign, x1), eps));
+		if ((converged & 1) == 0) ts[i + 0] = ufbxi_find_cubic_bezier_t(batch->p1[i + 0], batch->p2[i + 0], batch->x0[i + 0]);
+		if ((converged & 2) == 0) ts[i + 1] = ufbxi_find_cubic_bezier_t(batch->p1[i + 1], batch->p2[i + 1], batch->x0[i + 1]);
+	}
+#endif
+
+	for (; i < count; i++) {
+		ts[i] = ufbxi_find_cubic_bezier_t(batch->p1[i], batch->p2[i], batch->x0[i]);
+	}
+
+	for (i = 0; i < count; i++) {
+		*batch->dst[i] = ufbxi_evaluate_bezier(ts[i], batch->y0[i], batch->y1[i], batch->y2[i], batch->y3[i]);
+	}
+
+	batch->count = 0;
+}
+
+// Find the first keyframe with `time > time` in `keys[begin:count]`.
+static ufbxi_forceinline size_t ufbxi_search_curve_key(const ufbx_keyframe *keys, size_t begin, size_t count, double time)
+{
+	size_t end = count;
+	while (end - begin >= 8) {
+		size_t mid = (begin + end) >> 1;
+		if (keys[mid].time <= time) {
+			begin = mid + 1;
+		} else {
+			end = mid;
+		}
+	}
+
+	for (; begin < end; begin++) {
+		if (keys[begin].time > time) break;
+	}
+	return begin;
+}
+
+// Find the first keyframe with `time > time` starting from a known valid lower bound `begin`.
+static ufbxi_forceinline size_t ufbxi_find_curve_key(const ufbx_keyframe *keys, size_t begin, size_t count, double time)
 {
+	// Step linearly a few keys first as the next time is usually close to the previous one
+	size_t end = ufbxi_min_sz(begin + 4, count);
+	for (; begin < end; begin++) {
+		if (keys[begin].time > time) return begin;
+	}
+
+	return ufbxi_search_curve_key(keys, begin, count, time);
+}
+
+// Evaluate `curve` at `time` where `index` is the first keyframe after `time`.
+static ufbxi_noinline ufbx_real ufbxi_evaluate_curve_key(const ufbx_anim_curve *curve, size_t index, double time)
+{
+	const ufbx_keyframe *keys = curve->keyframes.data;
+
+	// First or last keyframe
+	if (index == 0) return keys[0].value;
+	if (index == curve->keyframes.count) return keys[index - 1].value;
+
+	const ufbx_keyframe *next = &keys[index];
+	const ufbx_keyframe *prev = next - 1;
+
+	// Exact keyframe
+	if (prev->time == time) return prev->value;
+
+	double rcp_delta = 1.0 / (next->time - prev->time);
+	double t = (time - prev->time) * rcp_delta;
+
+	switch (prev->interpolation) {
+
+	case UFBX_INTERPOLATION_CONSTANT_PREV:
+		return prev->value;
+
+	case UFBX_INTERPOLATION_CONSTANT_NEXT:
+		return next->value;
+
+	case UFBX_INTERPOLATION_LINEAR:
+		return (ufbx_real)(prev->value*(1.0 - t) + next->value*t);
+
+	case UFBX_INTERPOLATION_CUBIC:
+	{
+		double x1 = prev->right.dx * rcp_delta;
+		double x2 = 1.0 - next->left.dx * rcp_delta;
+		t = ufbxi_find_cubic_bezier_t(x1, x2, t);
+
+		double y0 = prev->value;
+		double y3 = next->value;
+		double y1 = y0 + prev->right.dy;
+		double y2 = y3 - next->left.dy;
+
+		return ufbxi_evaluate_bezier(t, y0, y1, y2, y3);
+	}
+
+	default:
+		ufbxi_unreachable("Bad interpolation mode");
+		return 0.0f;
+
+	}
+}
+
+// Evaluate `curve` at `time` where `index` is the first keyframe after `time`.
+// Cubic segments are deferred to `batch`, see `ufbxi_flush_bezier_batch()`,
+// everything else is evaluated directly with `ufbxi_evaluate_curve_key()`.
+static ufbxi_forceinline void ufbxi_evaluate_curve_segment(ufbxi_bezier_batch *batch, const ufbx_anim_curve *curve, size_t index, double time, ufbx_real *dst)
+{
+	const ufbx_keyframe *keys = curve->keyframes.data;
+	if (index == 0 || index == curve->keyframes.count) {
+		*dst = ufbxi_evaluate_curve_key(curve, index, time);
+		return;
+	}
+
+	const ufbx_keyframe *next = &keys[index];
+	const ufbx_keyframe *prev = next - 1;
+	if (prev->interpolation != UFBX_INTERPOLATION_CUBIC || prev->time == time) {
+		*dst = ufbxi_evaluate_curve_key(curve, index, time);
+		return;
+	}
+
+	double rcp_delta = 1.0 / (next->time - prev->time);
+	size_t lane = batch->count;
+	batch->p1[lane] = prev->right.dx * rcp_delta;
+	batch->p2[lane] = 1.0 - next->left.dx * rcp_delta;
+	batch->x0[lane] = (time - prev->time) * rcp_delta;
+	batch->y0[lane] = prev->value;
+	batch->y3[lane] = next->value;
+	batch->y1[lane] = batch->y0[lane] + prev->right.dy;
+	batch->y2[lane] = batch->y3[lane] - next->left.dy;
+	batch->dst[lane] = dst;
+	batch->count = lane + 1;
+	if (batch->count == UFBXI_BEZIER_BATCH_SIZE) {
+		ufbxi_flush_bezier_batch(batch);
+	}
+}
+
+// -- Animation cursor
+
+struct ufbxi_anim_cursor_imp {
+	ufbx_anim_cursor cursor;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+
+	ufbx_scene *scene;
+	ufbx_anim *retained_anim;
+	ufbxi_anim_imp anim_imp;
+
+	// Indexed by `ufbx_anim_curve.typed_id`, first keyframe after the previous evaluation time
+	uint32_t *key_indices;
+	size_t num_curves;
+};
+
+static ufbxi_noinline ufbx_real ufbxi_evaluate_curve_with_cursor(ufbxi_anim_cursor_imp *imp, const ufbx_anim_curve *curve, double time, ufbx_real default_value)
+{
+	if (!curve) return default_value;
+	size_t num_keys = curve->keyframes.count;
+	const ufbx_keyframe *keys = curve->keyframes.data;
+	if (num_keys <= 1) {
+		return num_keys == 1 ? keys[0].value : default_value;
+	}
+
+	// Curves from other scenes, eg. ones created by `ufbx_evaluate_scene()`, are not tracked
+	uint32_t typed_id = curve->element.typed_id;
+	if (typed_id >= imp->num_curves || imp->scene->anim_curves.data[typed_id] != curve) {
+		return ufbx_evaluate_curve(curve, time, default_value);
+	}
+
+	// Continue from the previous keyframe unless seeking backwards
+	size_t prev_index = imp->key_indices[typed_id];
+	if (prev_index > num_keys || (prev_index > 0 && keys[prev_index - 1].time > time)) {
+		prev_index = 0;
+		imp->cursor.num_search_lookups++;
+	} else {
+		imp->cursor.num_sequential_lookups++;
+	}
+
+	size_t index = ufbxi_find_curve_key(keys, prev_index, num_keys, time);
+	imp->key_indices[typed_id] = (uint32_t)index;
+	return ufbxi_evaluate_curve_key(curve, index, time);
+}
+
+static ufbxi_forceinline ufbx_real ufbxi_evaluate_anim_curve(ufbxi_anim_cursor_imp *cursor, const ufbx_anim_curve *curve, double time, ufbx_real default_value)
+{
+	if (cursor) {
+		return ufbxi_evaluate_curve_with_cursor(cursor, curve, time, default_value);
+	} else {
+		return ufbx_evaluate_curve(curve, time, default_value);
+	}
+}
+
+static ufbxi_noinline ufbx_real ufbxi_evaluate_anim_value_real(ufbxi_anim_cursor_imp *cursor, const ufbx_anim_value *anim_value, double time)
+{
+	ufbx_real res = anim_value->default_value.x;
+	if (anim_value->curves[0]) res = ufbxi_evaluate_anim_curve(cursor, anim_value->curves[0], time, res);
+	return res;
+}
+
+static ufbxi_noinline ufbx_vec3 ufbxi_evaluate_anim_value_vec3(ufbxi_anim_cursor_imp *cursor, const ufbx_anim_value *anim_value, double time)
+{
+	ufbx_vec3 res = anim_value->default_value;
+	if (anim_value->curves[0]) res.x = ufbxi_evaluate_anim_curve(cursor, anim_value->curves[0], time, res.x);
+	if (anim_value->curves[1]) res.y = ufbxi_evaluate_anim_curve(cursor, anim_value->curves[1], time, res.y);
+	if (anim_value->curves[2]) res.z = ufbxi_evaluate_anim_curve(cursor, anim_value->curves[2], time, res.z);
+	return res;
+}
+
+// Dual quaternion of `ufbx_skin_cluster.geometry_to_world_transform` used for skinning.
+typedef struct {
+	ufbx_quat q0, qe;
+	ufbx_vec3 scale;
+} ufbxi_skin_dual_quat;
+
+static ufbxi_forceinline ufbxi_skin_dual_quat ufbxi_get_skin_dual_quat(const ufbx_skin_cluster *cluster)
+{
+	ufbx_transform t = cluster->geometry_to_world_transform;
+	ufbx_quat qt = { 0.5f * t.translation.x, 0.5f * t.translation.y, 0.5f * t.translation.z };
+	ufbxi_skin_dual_quat dq; // ufbxi_uninit
+	dq.q0 = t.rotation;
+	dq.qe = ufbxi_mul_quat(qt, t.rotation);
+	dq.scale = t.scale;
+	return dq;
+}
+
+// Implementation of `ufbx_get_skin_vertex_matrix()`, `dual_quats` may contain
+// `ufbxi_get_skin_dual_quat()` of each cluster to avoid computing them per vertex.
+static ufbxi_noinline ufbx_matrix ufbxi_get_skin_vertex_matrix(const ufbx_skin_deformer *skin, ufbx_skin_vertex skin_vertex, const ufbxi_skin_dual_quat *dual_quats, const ufbx_matrix *fallback)
+{
+
+	ufbx_matrix mat = { 0.0f };
+	ufbx_quat q0 = { 0.0f }, qe = { 0.0f };
+	ufbx_quat first_q0 = { 0.0f };
+	ufbx_vec3 qs = { 0.0f, 0.0f, 0.0f };
+	ufbx_real total_weight = 0.0f;
+
+	for (uint32_t i = 0; i < skin_vertex.num_weights; i++) {
+		ufbx_skin_weight weight = skin->weights.data[skin_vertex.weight_begin + i];
+		ufbx_skin_cluster *cluster = skin->clusters.data[weight.cluster_index];
+		const ufbx_node *node = cluster->bone_node;
+		if (!node) continue;
+
+		total_weight += weight.weight;
+		if (skin_vertex.dq_weight > 0.0f) {
+			ufbxi_skin_dual_quat dq = dual_quats ? dual_quats[weight.cluster_index] : ufbxi_get_skin_dual_quat(cluster);
+			if (i == 0) first_q0 = dq.q0;
+
+			// Negating `q0` negates `qe` exactly as it's linear in `q0`
+			if (ufbx_quat_dot(first_q0, dq.q0) < 0.0f) {
+				dq.q0.x = -dq.q0.x;
+				dq.q0.y = -dq.q0.y;
+				dq.q0.z = -dq.q0.z;
+				dq.q0.w = -dq.q0.w;
+				dq.qe.x = -dq.qe.x;
+				dq.qe.y = -dq.qe.y;
+				dq.qe.z = -dq.qe.z;
+				dq.qe.w = -dq.qe.w;
+			}
+
+			ufbxi_add_weighted_quat(&q0, dq.q0, weight.weight);
+			ufbxi_add_weighted_quat(&qe, dq.qe, weight.weight);
+			ufbxi_add_weighted_vec3(&qs, dq.scale, weight.weight);
+		}
+
+		if (skin_vertex.dq_weight < 1.0f) {
+			ufbxi_add_weighted_mat(&mat, &cluster->geometry_to_world, (1.0f-skin_vertex.dq_weight) * weight.weight);
+		}
+	}
+
+	if (total_weight <= 0.0f) {
+		if (fallback) {
+			return *fallback;
+		} else {
+			return ufbx_identity_matrix;
+		}
+	}
+
+	if (ufbx_fabs(total_weight - 1.0f) > UFBX_EPSILON) {
+		ufbx_real rcp_weight = ufbx_fabs(total_weight) > UFBX_EPSILON ? 1.0f / total_weight : 0.0f;
+		if (skin_vertex.dq_weight > 0.0f) {
+			q0.x *= rcp_weight; q0.y *= rcp_weight; q0.z *= rcp_weight; q0.w *= rcp_weight;
+			qe.x *= rcp_weight; qe.y *= rcp_weight; qe.z *= rcp_weight; qe.w *= rcp_weight;
+			qs.x *= rcp_weight; qs.y *= rcp_weight; qs.z *= rcp_weight;
+		}
+		if (skin_vertex.dq_weight < 1.0f) {
+			mat.m00 *= rcp_weight; mat.m01 *= rcp_weight; mat.m02 *= rcp_weight; mat.m03 *= rcp_weight;
+			mat.m10 *= rcp_weight; mat.m11 *= rcp_weight; mat.m12 *= rcp_weight; mat.m13 *= rcp_weight;
+			mat.m20 *= rcp_weight; mat.m21 *= rcp_weight; mat.m22 *= rcp_weight; mat.m23 *= rcp_weight;
+		}
+	}
+
+	if (skin_vertex.dq_weight > 0.0f) {
+		ufbx_transform dqt; // ufbxi_uninit
+		ufbx_real rcp_len = (ufbx_real)(1.0 / ufbx_sqrt(q0.x*q0.x + q0.y*q0.y + q0.z*q0.z + q0.w*q0.w));
+		ufbx_real rcp_len2x2 = 2.0f * rcp_len * rcp_len;
+		dqt.rotation.x = q0.x * rcp_len;
+		dqt.rotation.y = q0.y * rcp_len;
+		dqt.rotation.z = q0.z * rcp_len;
+		dqt.rotation.w = q0.w * rcp_len;
+		dqt.scale.x = qs.x;
+		dqt.scale.y = qs.y;
+		dqt.scale.z = qs.z;
+		dqt.translation.x = rcp_len2x2 * (- qe.w*q0.x + qe.x*q0.w - qe.y*q0.z + qe.z*q0.y);
+		dqt.translation.y = rcp_len2x2 * (- qe.w*q0.y + qe.x*q0.z + qe.y*q0.w - qe.z*q0.x);
+		dqt.translation.z = rcp_len2x2 * (- qe.w*q0.z - qe.x*q0.y + qe.y*q0.x + qe.z*q0.w);
+		ufbx_matrix dqm = ufbx_transform_to_matrix(&dqt);
+		if (skin_vertex.dq_weight < 1.0f) {
+			ufbxi_add_weighted_mat(&mat, &dqm, skin_vertex.dq_weight);
+		} else {
+			mat = dqm;
+		}
+	}
+
+	return mat;
+}
+
 #if UFBXI_FEATURE_SKINNING_EVALUATION
-	size_t max_skinned_indices = 0;
+
+typedef struct {
+	const ufbx_skin_deformer *skin;
+	const ufbxi_skin_dual_quat *dual_quats; // < Indexed by cluster, see `ufbxi_get_skin_vertex_matrix()`
+	const ufbx_matrix *fallback;
+	ufbx_vec3 *positions;
+	size_t begin, end;
+} ufbxi_skin_chunk;
+
+// Equivalent to `ufbx_get_skin_vertex_matrix()` for vertices with `dq_weight == 0`.
+static ufbxi_forceinline void ufbxi_linear_blend_skin_matrix(ufbx_matrix *mat, const ufbx_skin_deformer *skin, ufbx_skin_vertex skin_vertex, const ufbx_matrix *fallback)
+{
+	const ufbx_skin_weight *weights = skin->weights.data + skin_vertex.weight_begin;
+	ufbx_skin_cluster *const *clusters = skin->clusters.data;
+	ufbx_real total_weight = 0.0f;
+
+#if UFBXI_HAS_SSE && !defined(UFBX_REAL_IS_FLOAT)
+	__m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd(), a2 = _mm_setzero_pd();
+	__m128d a3 = _mm_setzero_pd(), a4 = _mm_setzero_pd(), a5 = _mm_setzero_pd();
+	for (uint32_t i = 0; i < skin_vertex.num_weights; i++) {
+		const ufbx_skin_cluster *cluster = clusters[weights[i].cluster_index];
+		if (!cluster->bone_node) continue;
+		total_weight += weights[i].weight;
+
+		const double *m = cluster->geometry_to_world.v;
+		__m128d w = _mm_set1_pd(weights[i].weight);
+		a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(m + 0), w));
+		a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(m + 2), w));
+		a2 = _mm_add_pd(a2, _mm_mul_pd(_mm_loadu_pd(m + 4), w));
+		a3 = _mm_add_pd(a3, _mm_mul_pd(_mm_loadu_pd(m + 6), w));
+		a4 = _mm_add_pd(a4, _mm_mul_pd(_mm_loadu_pd(m + 8), w));
+		a5 = _mm_add_pd(a5, _mm_mul_pd(_mm_loadu_pd(m + 10), w));
+	}
+	_mm_storeu_pd(mat->v + 0, a0);
+	_mm_storeu_pd(mat->v + 2, a1);
+	_mm_storeu_pd(mat->v + 4, a2);
+	_mm_storeu_pd(mat->v + 6, a3);
+	_mm_storeu_pd(mat->v + 8, a4);
+	_mm_storeu_pd(mat->v + 10, a5);
+#elif UFBXI_HAS_SSE
+	__m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps(), a2 = _mm_setzero_ps();
+	for (uint32_t i = 0; i < skin_vertex.num_weights; i++) {
+		const ufbx_skin_cluster *cluster = clusters[weights[i].cluster_index];
+		if (!cluster->bone_node) continue;
+		total_weight += weights[i].weight;
+
+		const float *m = cluster->geometry_to_world.v;
+		__m128 w = _mm_set1_ps(weights[i].weight);
+		a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(m + 0), w));
+		a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+		a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+	}
+	_mm_storeu_ps(mat->v + 0, a0);
+	_mm_storeu_ps(mat->v + 4, a1);
+	_mm_storeu_ps(mat->v + 8, a2);
+#else
+	memset(mat, 0, sizeof(ufbx_matrix));
+	for (uint32_t i = 0; i < skin_vertex.num_weights; i++) {
+		const ufbx_skin_cluster *cluster = clusters[weights[i].cluster_index];
+		if (!cluster->bone_node) continue;
+		total_weight += weights[i].weight;
+		ufbxi_add_weighted_mat(mat, &cluster->geometry_to_world, weights[i].weight);
+	}
+#endif
+
+	if (total_weight <= 0.0f) {
+		*mat = fallback ? *fallback : ufbx_identity_matrix;
+	} else if (ufbx_fabs(total_weight - 1.0f) > UFBX_EPSILON) {
+		ufbx_real rcp_weight = ufbx_fabs(total_weight) > UFBX_EPSILON ? 1.0f / total_weight : 0.0f;
+		for (size_t i = 0; i < 12; i++) {
+			mat->v[i] *= rcp_weight;
+		}
+	}
+}
+
+// Skin `positions[begin, end)` in place. Linear blend skinned vertices are handled
+// inline, dual quaternion ones use the precomputed `dual_quats` of the clusters.
+static ufbxi_noinline void ufbxi_skin_positions(const ufbxi_skin_chunk *chunk)
+{
+	const ufbx_skin_deformer *skin = chunk->skin;
+	ufbx_vec3 *positions = chunk->positions;
+	size_t end = ufbxi_min_sz(chunk->end, skin->vertices.count);
+	for (size_t i = chunk->begin; i < end; i++) {
+		ufbx_skin_vertex skin_vertex = skin->vertices.data[i];
+		ufbx_matrix mat; // ufbxi_uninit
+		if (skin_vertex.dq_weight != 0.0f) {
+			mat = ufbxi_get_skin_vertex_matrix(skin, skin_vertex, chunk->dual_quats, chunk->fallback);
+		} else {
+			ufbxi_linear_blend_skin_matrix(&mat, skin, skin_vertex, chunk->fallback);
+		}
+
+		ufbx_vec3 v = positions[i];
+		positions[i].x = mat.m00*v.x + mat.m01*v.y + mat.m02*v.z + mat.m03;
+		positions[i].y = mat.m10*v.x + mat.m11*v.y + mat.m12*v.z + mat.m13;
+		positions[i].z = mat.m20*v.x + mat.m21*v.y + mat.m22*v.z + mat.m23;
+	}
+}
+
+static bool ufbxi_skin_positions_task_fn(ufbxi_task *task)
+{
+	ufbxi_skin_positions((const ufbxi_skin_chunk*)task->data);
+	return true;
+}
+
+#endif
+
+typedef struct {
+	uint32_t *normal_indices; // < NULL if the mesh is not deformed
+	size_t num_normals;
+} ufbxi_cached_normal_mapping;
+
+typedef struct {
+	ufbx_evaluate_cache cache;
+	uint32_t magic;
+
+	ufbxi_allocator ator_result;
+	ufbxi_buf result;
+
+	// Indexed by `ufbx_mesh.typed_id`
+	ufbxi_cached_normal_mapping *normal_mappings;
+} ufbxi_evaluate_cache_imp;
+
+ufbx_static_assert(evaluate_cache_imp_offset, offsetof(ufbxi_evaluate_cache_imp, cache) == 0);
+
+typedef struct {
+	ufbx_error error;
+
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	ufbxi_buf result;
+	ufbxi_buf tmp;
+
+	const ufbx_scene *scene;
+	ufbx_evaluate_cache cache;
+
+	ufbxi_evaluate_cache_imp *imp;
+} ufbxi_evaluate_cache_context;
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_create_evaluate_cache_imp(ufbxi_evaluate_cache_context *cc)
+{
+	const ufbx_scene *scene = cc->scene;
+
+	size_t max_indices = 0;
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && mesh->cache_deformers.count == 0) continue;
+		max_indices = ufbxi_max_sz(max_indices, mesh->num_indices);
+	}
+
+	ufbx_topo_edge *topo = ufbxi_push(&cc->tmp, ufbx_topo_edge, max_indices);
+	ufbxi_check_err(&cc->error, topo);
+
+	ufbxi_cached_normal_mapping *normal_mappings = ufbxi_push_zero(&cc->result, ufbxi_cached_normal_mapping, scene->meshes.count);
+	ufbxi_check_err(&cc->error, normal_mappings);
 
 	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
 		ufbx_mesh *mesh = *p_mesh;
-		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
+		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && mesh->cache_deformers.count == 0) continue;
+		if (mesh->num_indices == 0) continue;
+
+		size_t num_indices = mesh->num_indices;
+		uint32_t *normal_indices = ufbxi_push(&cc->result, uint32_t, num_indices);
+		ufbxi_check_err(&cc->error, normal_indices);
+
+		ufbx_compute_topology(mesh, topo, num_indices);
+		ufbxi_cached_normal_mapping *mapping = &normal_mappings[mesh->typed_id];
+		mapping->normal_indices = normal_indices;
+		mapping->num_normals = ufbx_generate_normal_mapping(mesh, topo, num_indices, normal_indices, num_indices, false);
+		cc->cache.num_meshes++;
+	}
+
+	cc->cache.scene = (ufbx_scene*)scene;
+
+	cc->imp = ufbxi_push(&cc->result, ufbxi_evaluate_cache_imp, 1);
+	ufbxi_check_err(&cc->error, cc->imp);
+	memset(cc->imp, 0, sizeof(ufbxi_evaluate_cache_imp));
+
+	cc->imp->cache = cc->cache;
+	cc->imp->magic = UFBXI_EVALUATE_CACHE_IMP_MAGIC;
+	cc->imp->normal_mappings = normal_mappings;
+	cc->imp->ator_result = cc->ator_result;
+	cc->imp->result = cc->result;
+	cc->imp->result.ator = &cc->imp->ator_result;
+
+	// `error` refers to the context on the stack, the cache never allocates after creation.
+	cc->imp->ator_result.error = NULL;
+
+	return 1;
+}
+
+static ufbxi_noinline void ufbxi_free_evaluate_cache_imp(ufbxi_evaluate_cache_imp *imp)
+{
+	// `result` contains `imp` itself so copy everything out first
+	ufbxi_allocator ator = imp->ator_result;
+	ufbxi_buf buf = imp->result;
+	buf.ator = &ator;
+	ufbxi_buf_free(&buf);
+	ufbxi_free_ator(&ator);
+}
+
+// Returns `true` if `mesh` is modified by `ufbxi_evaluate_skinning()`.
+static ufbxi_forceinline bool ufbxi_is_mesh_deformed(const ufbx_mesh *mesh, bool load_caches)
+{
+	return mesh->blend_deformers.count > 0 || mesh->skin_deformers.count > 0 || (mesh->cache_deformers.count > 0 && load_caches);
+}
+
+// Returns `true` if `mesh` has generated normals left over from a previous in-place evaluation.
+static ufbxi_forceinline bool ufbxi_has_evaluated_normals(const ufbx_mesh *mesh, const ufbx_mesh *src_mesh)
+{
+	return src_mesh && mesh->generated_normals && mesh->skinned_normal.indices.data != src_mesh->skinned_normal.indices.data;
+}
+
+// If `in_place_src` is specified `scene` is evaluated in place and any buffers not
+// shared with the original scene `in_place_src` are overwritten instead of allocated.
+// Only meshes in `element_mask` are evaluated if specified.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *scene, ufbx_error *error, ufbxi_buf *buf_result, ufbxi_buf *buf_tmp,
+	ufbxi_thread_pool *thread_pool, const ufbxi_evaluate_cache_imp *cache, const ufbx_scene *in_place_src,
+	const bool *element_mask, double time, bool load_caches, ufbx_geometry_cache_data_opts *cache_opts)
+{
+#if UFBXI_FEATURE_SKINNING_EVALUATION
+	size_t max_skinned_indices = 0;
+
+	for (size_t mesh_ix = 0; mesh_ix < scene->meshes.count; mesh_ix++) {
+		ufbx_mesh *mesh = scene->meshes.data[mesh_ix];
+		const ufbx_mesh *src_mesh = in_place_src ? in_place_src->meshes.data[mesh_ix] : NULL;
+		if (!ufbxi_is_mesh_deformed(mesh, load_caches)) continue;
+		if (element_mask && !element_mask[mesh->element_id]) continue;
+		if (cache && cache->normal_mappings[mesh->typed_id].normal_indices) continue;
+		if (ufbxi_has_evaluated_normals(mesh, src_mesh)) continue;
 		max_skinned_indices = ufbxi_max_sz(max_skinned_indices, mesh->num_indices);
 	}
 
 	ufbx_topo_edge *topo = ufbxi_push(buf_tmp, ufbx_topo_edge, max_skinned_indices);
 	ufbxi_check_err(error, topo);
 
-	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
-		ufbx_mesh *mesh = *p_mesh;
-		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
+	bool *mesh_needs_normals = ufbxi_push_zero(buf_tmp, bool, scene->meshes.count);
+	ufbxi_check_err(error, mesh_needs_normals);
+
+	for (size_t mesh_ix = 0; mesh_ix < scene->meshes.count; mesh_ix++) {
+		ufbx_mesh *mesh = scene->meshes.data[mesh_ix];
+		if (!ufbxi_is_mesh_deformed(mesh, load_caches)) continue;
+		if (element_mask && !element_mask[mesh->element_id]) continue;
 		if (mesh->num_vertices == 0) continue;
 
+		const ufbx_mesh *src_mesh = in_place_src ? in_place_src->meshes.data[mesh_ix] : NULL;
 		size_t num_vertices = mesh->num_vertices;
-		ufbx_vec3 *result_pos = ufbxi_push(buf_result, ufbx_vec3, num_vertices + 1);
-		ufbxi_check_err(error, result_pos);
+		ufbx_vec3 *result_pos = NULL;
+		if (src_mesh && mesh->skinned_position.values.data != src_mesh->skinned_position.values.data) {
+			result_pos = mesh->skinned_position.values.data;
+		} else {
+			result_pos = ufbxi_push(buf_result, ufbx_vec3, num_vertices + 1);
+			ufbxi_check_err(error, result_pos);
+
+			result_pos[0] = ufbx_zero_vec3;
+			result_pos++;
+		}
 
-		result_pos[0] = ufbx_zero_vec3;
-		result_pos++;
+		if (src_mesh) {
+			mesh->skinned_is_local = src_mesh->skinned_is_local;
+		}
 
 		bool cached_position = false, cached_normals = false;
 		if (load_caches && mesh->cache_deformers.count > 0) {
@@ -24468,15 +27477,25 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 					}
 				} else if (channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_NORMAL && !cached_normals) {
 					// TODO: Is this right at all?
-					size_t num_normals = mesh->skinned_normal.values.count;
-					ufbx_vec3 *normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
-					ufbxi_check_err(error, normal_data);
-					normal_data[0] = ufbx_zero_vec3;
-					normal_data++;
+					const ufbx_vertex_vec3 *src_normal = src_mesh ? &src_mesh->skinned_normal : &mesh->skinned_normal;
+					size_t num_normals = src_normal->values.count;
+					ufbx_vec3 *normal_data = NULL;
+					if (src_mesh && mesh->skinned_normal.indices.data == src_normal->indices.data && mesh->skinned_normal.values.data != src_normal->values.data) {
+						normal_data = mesh->skinned_normal.values.data;
+					} else {
+						normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
+						ufbxi_check_err(error, normal_data);
+						normal_data[0] = ufbx_zero_vec3;
+						normal_data++;
+					}
 
 					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, normal_data, num_normals, cache_opts);
 					if (num_read == num_normals) {
 						cached_normals = true;
+						if (src_mesh) {
+							mesh->skinned_normal = src_mesh->skinned_normal;
+							mesh->generated_normals = src_mesh->generated_normals;
+						}
 						mesh->skinned_normal.values.data = normal_data;
 					}
 				}
@@ -24492,11 +27511,44 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 
 			// TODO: What should we do about multiple skins??
 			if (mesh->skin_deformers.count > 0) {
-				ufbx_matrix *fallback = mesh->instances.count > 0 ? &mesh->instances.data[0]->geometry_to_world : NULL;
 				ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
-				for (size_t i = 0; i < num_vertices; i++) {
-					ufbx_matrix mat = ufbx_get_skin_vertex_matrix(skin, i, fallback);
-					result_pos[i] = ufbx_transform_position(&mat, result_pos[i]);
+				ufbxi_skin_chunk whole = { 0 };
+				whole.skin = skin;
+				whole.fallback = mesh->instances.count > 0 ? &mesh->instances.data[0]->geometry_to_world : NULL;
+				whole.positions = result_pos;
+				whole.begin = 0;
+				whole.end = num_vertices;
+
+				if (skin->skinning_method == UFBX_SKINNING_METHOD_DUAL_QUATERNION || skin->skinning_method == UFBX_SKINNING_METHOD_BLENDED_DQ_LINEAR || skin->num_dq_weights > 0) {
+					ufbxi_skin_dual_quat *dual_quats = ufbxi_push(buf_tmp, ufbxi_skin_dual_quat, skin->clusters.count);
+					ufbxi_check_err(error, dual_quats);
+					for (size_t i = 0; i < skin->clusters.count; i++) {
+						dual_quats[i] = ufbxi_get_skin_dual_quat(skin->clusters.data[i]);
+					}
+					whole.dual_quats = dual_quats;
+				}
+
+				// Split large meshes into vertex ranges, normals are computed only after all tasks are done
+				if (thread_pool && thread_pool->enabled && num_vertices > UFBXI_SKINNING_CHUNK_SIZE) {
+					size_t num_chunks = (num_vertices + UFBXI_SKINNING_CHUNK_SIZE - 1) / UFBXI_SKINNING_CHUNK_SIZE;
+					ufbxi_skin_chunk *chunks = ufbxi_push(buf_tmp, ufbxi_skin_chunk, num_chunks);
+					ufbxi_check_err(error, chunks);
+					for (size_t i = 0; i < num_chunks; i++) {
+						ufbxi_skin_chunk *chunk = &chunks[i];
+						*chunk = whole;
+						chunk->begin = i * UFBXI_SKINNING_CHUNK_SIZE;
+						chunk->end = ufbxi_min_sz(chunk->begin + UFBXI_SKINNING_CHUNK_SIZE, num_vertices);
+
+						ufbxi_task *task = ufbxi_thread_pool_create_task(thread_pool, &ufbxi_skin_positions_task_fn);
+						if (task) {
+							task->data = chunk;
+							ufbxi_thread_pool_run_task(thread_pool, task);
+						} else {
+							ufbxi_skin_positions(chunk);
+						}
+					}
+				} else {
+					ufbxi_skin_positions(&whole);
 				}
 
 				mesh->skinned_is_local = false;
@@ -24504,14 +27556,35 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 		}
 
 		mesh->skinned_position.values.data = result_pos;
+		mesh_needs_normals[mesh_ix] = !cached_normals;
+	}
 
-		if (!cached_normals) {
+	if (thread_pool && thread_pool->enabled) {
+		ufbxi_thread_pool_flush_group(thread_pool);
+		ufbxi_check_err(error, ufbxi_thread_pool_wait_all(thread_pool));
+	}
+
+	for (size_t mesh_ix = 0; mesh_ix < scene->meshes.count; mesh_ix++) {
+		ufbx_mesh *mesh = scene->meshes.data[mesh_ix];
+		const ufbx_mesh *src_mesh = in_place_src ? in_place_src->meshes.data[mesh_ix] : NULL;
+		if (mesh_needs_normals[mesh_ix] && ufbxi_has_evaluated_normals(mesh, src_mesh)) {
+			// Topology does not change between evaluations so only the values need to be updated
+			ufbx_compute_normals(mesh, &mesh->skinned_position, mesh->skinned_normal.indices.data, mesh->skinned_normal.indices.count,
+				mesh->skinned_normal.values.data, mesh->skinned_normal.values.count);
+		} else if (mesh_needs_normals[mesh_ix]) {
 			size_t num_indices = mesh->num_indices;
 			uint32_t *normal_indices = ufbxi_push(buf_result, uint32_t, num_indices);
 			ufbxi_check_err(error, normal_indices);
 
-			ufbx_compute_topology(mesh, topo, num_indices);
-			size_t num_normals = ufbx_generate_normal_mapping(mesh, topo, num_indices, normal_indices, num_indices, false);
+			size_t num_normals = 0;
+			const ufbxi_cached_normal_mapping *mapping = cache ? &cache->normal_mappings[mesh->typed_id] : NULL;
+			if (mapping && mapping->normal_indices) {
+				memcpy(normal_indices, mapping->normal_indices, num_indices * sizeof(uint32_t));
+				num_normals = mapping->num_normals;
+			} else {
+				ufbx_compute_topology(mesh, topo, num_indices);
+				num_normals = ufbx_generate_normal_mapping(mesh, topo, num_indices, normal_indices, num_indices, false);
+			}
 
 			if (num_normals == mesh->num_vertices) {
 				mesh->skinned_normal.unique_per_vertex = true;
@@ -24596,7 +27669,22 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		}
 		ufbx_error error;
 		error.type = UFBX_ERROR_NONE;
-		if (uc->opts.open_main_file_with_default || uc->opts.open_file_cb.fn == &ufbx_default_open_file) {
+		bool open_default = uc->opts.open_main_file_with_default || uc->opts.open_file_cb.fn == &ufbx_default_open_file;
+#if UFBXI_HAS_MMAP
+		// Memory mapped files are parsed like `ufbx_load_memory()`, on failure fall
+		// back to opening the file normally which also reports a proper error.
+		if (open_default && uc->opts.map_main_file) {
+			if (ufbxi_map_file(&uc->ator_tmp, &uc->mapped_data, &uc->mapped_size, filename, filename_len, opts.filename_null_terminated)) {
+				uc->data_begin = uc->data = (const char*)uc->mapped_data;
+				uc->data_size = uc->mapped_size;
+				uc->progress_bytes_total = uc->mapped_size;
+				ok = true;
+			}
+		}
+#endif
+		if (ok) {
+			// Already mapped
+		} else if (open_default) {
 			ufbx_open_file_context ctx = (ufbx_open_file_context)&uc->ator_tmp;
 			ok = ufbx_open_file_ctx(&stream, ctx, filename, filename_len, &opts, &error);
 		} else {
@@ -24717,7 +27805,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	ufbxi_check(ufbxi_modify_geometry(uc));
 	ufbxi_postprocess_scene(uc);
 
-	ufbxi_update_scene(&uc->scene, true, NULL, 0);
+	ufbxi_update_scene(&uc->scene, true, NULL, 0, NULL);
 
 	// Force a non-NULL anim pointer
 	if (!uc->scene.anim) {
@@ -24732,7 +27820,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	if (uc->opts.evaluate_skinning) {
 		ufbx_geometry_cache_data_opts cache_opts = { 0 };
 		cache_opts.open_file_cb = uc->opts.open_file_cb;
-		ufbxi_check(ufbxi_evaluate_skinning(&uc->scene, &uc->error, &uc->result, &uc->tmp,
+		ufbxi_check(ufbxi_evaluate_skinning(&uc->scene, &uc->error, &uc->result, &uc->tmp, &uc->thread_pool, NULL, NULL, NULL,
 			0.0, uc->opts.load_external_files && uc->opts.evaluate_caches, &cache_opts));
 	}
 
@@ -24766,6 +27854,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	imp->refcount.buf.ator = &imp->refcount.ator;
 	imp->string_buf = uc->string_pool.buf;
 	imp->string_buf.ator = &imp->refcount.ator;
+	imp->evaluated_props = NULL;
+	imp->saved_skinning = NULL;
 
 	imp->scene.metadata.result_memory_used = imp->refcount.ator.current_size;
 	imp->scene.metadata.temp_memory_used = uc->ator_tmp.current_size;
@@ -24812,10 +27902,12 @@ static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
 		ufbxi_buf_free(&uc->tmp_typed_element_offsets[i]);
 	}
 	ufbxi_buf_free(&uc->tmp_mesh_textures);
+	ufbxi_buf_free(&uc->tmp_mesh_geometry);
 	ufbxi_buf_free(&uc->tmp_full_weights);
 	ufbxi_buf_free(&uc->tmp_dom_nodes);
 	ufbxi_buf_free(&uc->tmp_element_id);
 	ufbxi_buf_free(&uc->tmp_ascii_spans);
+	ufbxi_buf_free(&uc->tmp_ascii_index);
 
 	ufbxi_free(&uc->ator_tmp, ufbxi_node, uc->top_nodes, uc->top_nodes_cap);
 	ufbxi_free(&uc->ator_tmp, void*, uc->element_extra_arr, uc->element_extra_cap);
@@ -24850,6 +27942,8 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		uc->local_big_endian = buf[0] == 0xbb;
 	}
 
+	uc->has_avx2 = ufbxi_cpu_has_avx2();
+
 	uc->double_parse_flags = ufbxi_parse_double_init_flags();
 
 	if (user_opts) {
@@ -24858,6 +27952,10 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		memset(&uc->opts, 0, sizeof(uc->opts));
 	}
 
+	if (uc->opts.approximate_float_parsing) {
+		uc->double_parse_flags |= UFBXI_PARSE_DOUBLE_APPROXIMATE;
+	}
+
 	if (uc->opts.file_size_estimate) {
 		uc->progress_bytes_total = uc->opts.file_size_estimate;
 	}
@@ -24932,10 +28030,12 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		uc->tmp_typed_element_offsets[i].ator = &uc->ator_tmp;
 	}
 	uc->tmp_mesh_textures.ator = &uc->ator_tmp;
+	uc->tmp_mesh_geometry.ator = &uc->ator_tmp;
 	uc->tmp_full_weights.ator = &uc->ator_tmp;
 	uc->tmp_dom_nodes.ator = &uc->ator_tmp;
 	uc->tmp_element_id.ator = &uc->ator_tmp;
 	uc->tmp_ascii_spans.ator = &uc->ator_tmp;
+	uc->tmp_ascii_index.ator = &uc->ator_tmp;
 
 	for (size_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
 		uc->tmp_thread_parse[i].ator = &uc->ator_tmp;
@@ -24948,6 +28048,8 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 	uc->tmp.unordered = true;
 	uc->tmp_parse.unordered = true;
 	uc->tmp_parse.clearable = true;
+	uc->tmp_mesh_geometry.unordered = true;
+	uc->tmp_mesh_geometry.clearable = true;
 	uc->result.unordered = true;
 
 	uc->warnings.error = &uc->error;
@@ -24969,6 +28071,12 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		uc->close_fn(uc->read_user);
 	}
 
+#if UFBXI_HAS_MMAP
+	if (uc->mapped_data) {
+		ufbxi_unmap_file(uc->mapped_data, uc->mapped_size);
+	}
+#endif
+
 	ufbxi_free_temp(uc);
 
 	if (ok) {
@@ -25115,7 +28223,7 @@ static ufbxi_forceinline bool ufbxi_anim_layer_might_contain_id(const ufbx_anim_
 	return ok;
 }
 
-static ufbxi_noinline void ufbxi_evaluate_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, size_t num_props)
+static ufbxi_noinline void ufbxi_evaluate_props(ufbxi_anim_cursor_imp *cursor, const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, size_t num_props)
 {
 	ufbxi_anim_layer_combine_ctx combine_ctx = { anim, element, time };
 
@@ -25131,7 +28239,7 @@ static ufbxi_noinline void ufbxi_evaluate_props(const ufbx_anim *anim, const ufb
 		if (layer->weight_is_animated && layer->blended) {
 			ufbx_anim_prop *weight_aprop = ufbxi_find_anim_prop_start(layer, &layer->element);
 			if (weight_aprop) {
-				weight = ufbx_evaluate_anim_value_real(weight_aprop->anim_value, time) / (ufbx_real)100.0;
+				weight = ufbxi_evaluate_anim_value_real(cursor, weight_aprop->anim_value, time) / (ufbx_real)100.0;
 				if (weight < 0.0f) weight = 0.0f;
 				if (weight > 0.99999f) weight = 1.0f;
 			}
@@ -25160,7 +28268,7 @@ static ufbxi_noinline void ufbxi_evaluate_props(const ufbx_anim *anim, const ufb
 			// This could be done by having `UFBX_PROP_FLAG_ANIMATION_EVALUATED`
 			// that gets set for the first layer of animation that is applied.
 			if (aprop->prop_name.data == prop->name.data) {
-				ufbx_vec3 v = ufbx_evaluate_anim_value_vec3(aprop->anim_value, time);
+				ufbx_vec3 v = ufbxi_evaluate_anim_value_vec3(cursor, aprop->anim_value, time);
 				if (layer_ix == 0) {
 					prop->value_vec3 = v;
 				} else {
@@ -25323,7 +28431,7 @@ static ufbxi_noinline ufbx_props ufbxi_evaluate_selected_props(const ufbx_anim *
 		}
 	}
 
-	ufbxi_evaluate_props(anim, element, time, props, num_props);
+	ufbxi_evaluate_props(ufbxi_get_anim_cursor(anim), anim, element, time, props, num_props);
 
 	ufbx_props prop_list;
 	prop_list.props.data = props;
@@ -25332,6 +28440,35 @@ static ufbxi_noinline ufbx_props ufbxi_evaluate_selected_props(const ufbx_anim *
 	return prop_list;
 }
 
+static ufbxi_noinline ufbx_props ufbxi_evaluate_element_props(ufbxi_anim_cursor_imp *cursor, const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *buffer, size_t buffer_size)
+{
+	ufbx_props ret = { NULL };
+	if (!element) return ret;
+
+	size_t num_anim = 0;
+	ufbxi_prop_iter iter; // ufbxi_uninit
+	ufbxi_init_prop_iter(&iter, anim, element);
+	const ufbx_prop *prop = NULL;
+	while ((prop = ufbxi_next_prop(&iter)) != NULL) {
+		if (!(prop->flags & (UFBX_PROP_FLAG_ANIMATED|UFBX_PROP_FLAG_OVERRIDDEN|UFBX_PROP_FLAG_CONNECTED))) continue;
+		if (num_anim >= buffer_size) break;
+
+		ufbx_prop *dst = &buffer[num_anim++];
+		*dst = *prop;
+
+		if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) {
+			ufbxi_evaluate_connected_prop(dst, anim, element, prop->name.data, time);
+		}
+	}
+
+	ufbxi_evaluate_props(cursor, anim, element, time, buffer, num_anim);
+
+	ret.props.data = buffer;
+	ret.props.count = ret.num_animated = num_anim;
+	ret.defaults = (ufbx_props*)&element->props;
+	return ret;
+}
+
 #if UFBXI_FEATURE_SCENE_EVALUATION
 
 typedef struct {
@@ -25342,6 +28479,7 @@ typedef struct {
 	ufbx_scene src_scene;
 	ufbx_evaluate_opts opts;
 	ufbx_anim *anim;
+	ufbxi_anim_cursor_imp *cursor;
 	double time;
 
 	ufbx_error error;
@@ -25353,9 +28491,15 @@ typedef struct {
 	ufbxi_buf result;
 	ufbxi_buf tmp;
 
+	ufbxi_thread_pool thread_pool;
+
 	ufbx_scene scene;
 
 	ufbxi_scene_imp *scene_imp;
+	ufbx_prop_list *prop_buffers;
+
+	// Elements to evaluate indexed by `element_id`, `NULL` for all
+	bool *element_mask;
 } ufbxi_eval_context;
 
 static ufbxi_forceinline ufbx_element *ufbxi_translate_element(ufbxi_eval_context *ec, void *elem)
@@ -25389,10 +28533,153 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_translate_anim(ufbxi_eval_contex
 	ufbx_anim *anim = ufbxi_push_copy(&ec->result, ufbx_anim, 1, *p_anim);
 	ufbxi_check_err(&ec->error, anim);
 	ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &anim->layers));
+	// The copy is not a `ufbxi_anim_imp`, see `ufbxi_get_anim_cursor()`
+	anim->custom = false;
 	*p_anim = anim;
 	return 1;
 }
 
+static ufbxi_forceinline void ufbxi_mask_element(bool *mask, const void *element)
+{
+	if (element) mask[((const ufbx_element*)element)->element_id] = true;
+}
+
+// Include `mesh` and everything needed to deform it in `mask`.
+static ufbxi_noinline void ufbxi_mask_mesh(bool *mask, const ufbx_mesh *mesh)
+{
+	ufbxi_mask_element(mask, mesh);
+	ufbxi_for_ptr_list(ufbx_node, p_node, mesh->instances) {
+		ufbxi_mask_element(mask, *p_node);
+	}
+	ufbxi_for_ptr_list(ufbx_element, p_deformer, mesh->all_deformers) {
+		ufbxi_mask_element(mask, *p_deformer);
+	}
+	ufbxi_for_ptr_list(ufbx_skin_deformer, p_skin, mesh->skin_deformers) {
+		ufbxi_for_ptr_list(ufbx_skin_cluster, p_cluster, (*p_skin)->clusters) {
+			ufbxi_mask_element(mask, *p_cluster);
+			ufbxi_mask_element(mask, (*p_cluster)->bone_node);
+		}
+	}
+	ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, mesh->blend_deformers) {
+		ufbxi_for_ptr_list(ufbx_blend_channel, p_channel, (*p_blend)->channels) {
+			ufbxi_mask_element(mask, *p_channel);
+		}
+	}
+}
+
+// Resolve the elements that need to be evaluated for `ufbx_evaluate_opts.root_node_ids`
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_element_mask(ufbxi_eval_context *ec, const ufbx_scene *scene)
+{
+	if (ec->opts.root_node_ids.count == 0) return 1;
+
+	bool *mask = ufbxi_push_zero(&ec->tmp, bool, scene->elements.count);
+	ufbxi_check_err(&ec->error, mask);
+
+	ufbxi_for_list(const uint32_t, p_id, ec->opts.root_node_ids) {
+		ufbxi_check_err_msg(&ec->error, *p_id < scene->nodes.count, "Bad root node ID");
+		ufbxi_mask_element(mask, scene->nodes.data[*p_id]);
+	}
+
+	// Nodes are sorted by depth so parents are visited before their children
+	ufbxi_for_ptr_list(ufbx_node, p_node, scene->nodes) {
+		ufbx_node *node = *p_node;
+		if (node->parent && mask[node->parent->element_id]) {
+			ufbxi_mask_element(mask, node);
+		}
+	}
+
+	ufbxi_for_ptr_list(ufbx_constraint, p_constraint, scene->constraints) {
+		ufbx_constraint *constraint = *p_constraint;
+		if (!constraint->node || !mask[constraint->node->element_id]) continue;
+
+		ufbxi_mask_element(mask, constraint);
+		ufbxi_mask_element(mask, constraint->aim_up_node);
+		ufbxi_mask_element(mask, constraint->ik_effector);
+		ufbxi_mask_element(mask, constraint->ik_end_node);
+		ufbxi_for_list(ufbx_constraint_target, target, constraint->targets) {
+			ufbxi_mask_element(mask, target->node);
+		}
+	}
+
+	// Meshes are used if any instance is selected or they are deformed by selected bones
+	bool *mesh_used = ufbxi_push_zero(&ec->tmp, bool, scene->meshes.count);
+	ufbxi_check_err(&ec->error, mesh_used);
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		bool used = false;
+		ufbxi_for_ptr_list(ufbx_node, p_node, mesh->instances) {
+			used = used || mask[(*p_node)->element_id];
+		}
+		ufbxi_for_ptr_list(ufbx_skin_deformer, p_skin, mesh->skin_deformers) {
+			ufbxi_for_ptr_list(ufbx_skin_cluster, p_cluster, (*p_skin)->clusters) {
+				ufbx_node *bone = (*p_cluster)->bone_node;
+				used = used || (bone && mask[bone->element_id]);
+			}
+		}
+		mesh_used[mesh->typed_id] = used;
+	}
+
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		if (mesh_used[(*p_mesh)->typed_id]) {
+			ufbxi_mask_mesh(mask, *p_mesh);
+		}
+	}
+
+	// Deformers may be shared, include the other meshes using them
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		if (mesh_used[mesh->typed_id]) continue;
+		ufbxi_for_ptr_list(ufbx_element, p_deformer, mesh->all_deformers) {
+			if (mask[(*p_deformer)->element_id]) {
+				ufbxi_mask_mesh(mask, mesh);
+				break;
+			}
+		}
+	}
+
+	// World transforms depend on all the ancestors, visit children first to propagate
+	// through multiple levels. Also include helpers and attributes of all the nodes.
+	for (size_t i = scene->nodes.count; i > 0; i--) {
+		ufbx_node *node = scene->nodes.data[i - 1];
+		if (!mask[node->element_id]) continue;
+
+		ufbxi_mask_element(mask, node->parent);
+		ufbxi_mask_element(mask, node->geometry_transform_helper);
+		ufbxi_mask_element(mask, node->scale_helper);
+		ufbxi_for_ptr_list(ufbx_element, p_attrib, node->all_attribs) {
+			ufbxi_mask_element(mask, *p_attrib);
+		}
+		ufbxi_for_ptr_list(ufbx_material, p_material, node->materials) {
+			ufbx_material *material = *p_material;
+			ufbxi_mask_element(mask, material);
+			ufbxi_for_list(ufbx_material_texture, tex, material->textures) {
+				ufbxi_mask_element(mask, tex->texture);
+			}
+		}
+	}
+
+	ec->element_mask = mask;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_scene_skinning(ufbxi_eval_context *ec, ufbx_scene *scene, ufbxi_buf *buf_result, const ufbx_scene *in_place_src)
+{
+	ufbx_geometry_cache_data_opts cache_opts = { 0 };
+	cache_opts.open_file_cb = ec->opts.open_file_cb;
+	cache_opts.reader = ec->opts.cache_reader;
+	ufbxi_check_err(&ec->error, ufbxi_thread_pool_init(&ec->thread_pool, &ec->error, &ec->ator_tmp, &ec->opts.thread_opts));
+	const ufbxi_evaluate_cache_imp *cache = NULL;
+	if (ec->opts.cache) {
+		cache = (const ufbxi_evaluate_cache_imp*)ec->opts.cache;
+		ufbx_assert(cache->magic == UFBXI_EVALUATE_CACHE_IMP_MAGIC);
+		ufbxi_check_err_msg(&ec->error, cache->magic == UFBXI_EVALUATE_CACHE_IMP_MAGIC, "Bad evaluate cache");
+		ufbxi_check_err_msg(&ec->error, cache->cache.scene == &ec->src_imp->scene, "Evaluate cache created for a different scene");
+	}
+	ufbxi_check_err(&ec->error, ufbxi_evaluate_skinning(scene, &ec->error, buf_result, &ec->tmp, &ec->thread_pool, cache, in_place_src,
+		ec->element_mask, ec->time, ec->opts.load_external_files && ec->opts.evaluate_caches, &cache_opts));
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context *ec)
 {
 	ec->scene = ec->src_scene;
@@ -25431,6 +28718,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context
 	ec->scene.elements_by_name.data = ufbxi_push(&ec->result, ufbx_name_element, num_elements);
 	ufbxi_check_err(&ec->error, ec->scene.elements_by_name.data);
 
+	ec->prop_buffers = ufbxi_push_zero(&ec->result, ufbx_prop_list, num_elements);
+	ufbxi_check_err(&ec->error, ec->prop_buffers);
+
 	ec->scene.root_node = (ufbx_node*)ufbxi_translate_element(ec, ec->scene.root_node);
 	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->scene.anim));
 
@@ -25665,6 +28955,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context
 	ufbx_anim anim = *ec->anim;
 	ufbx_prop_override *over = anim.prop_overrides.data, *over_end = ufbxi_add_ptr(over, anim.prop_overrides.count);
 
+	ufbxi_check_err(&ec->error, ufbxi_evaluate_element_mask(ec, &ec->scene));
+	bool *mask = ec->element_mask;
+
 	// Evaluate the properties
 	ufbxi_for_ptr_list(ufbx_element, p_elem, ec->scene.elements) {
 		ufbx_element *elem = *p_elem;
@@ -25679,26 +28972,26 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context
 
 		num_animated += num_override;
 		if (num_animated == 0) continue;
+		if (mask && !mask[elem->element_id]) continue;
 
 		anim.prop_overrides.data = ufbxi_sub_ptr(over, num_override);
 		anim.prop_overrides.count = num_override;
 
 		ufbx_prop *props = ufbxi_push(&ec->result, ufbx_prop, num_animated);
 		ufbxi_check_err(&ec->error, props);
+		ec->prop_buffers[elem->element_id].data = props;
+		ec->prop_buffers[elem->element_id].count = num_animated;
 
 		elem->props = ufbx_evaluate_props(&anim, elem, ec->time, props, num_animated);
 		elem->props.defaults = &ec->src_scene.elements.data[elem->element_id]->props;
 	}
 
 	// Update all derived values
-	ufbxi_update_scene(&ec->scene, false, anim.transform_overrides.data, anim.transform_overrides.count);
+	ufbxi_update_scene(&ec->scene, false, anim.transform_overrides.data, anim.transform_overrides.count, mask);
 
 	// Evaluate skinning if requested
 	if (ec->opts.evaluate_skinning) {
-		ufbx_geometry_cache_data_opts cache_opts = { 0 };
-		cache_opts.open_file_cb = ec->opts.open_file_cb;
-		ufbxi_check_err(&ec->error, ufbxi_evaluate_skinning(&ec->scene, &ec->error, &ec->result, &ec->tmp,
-			ec->time, ec->opts.load_external_files && ec->opts.evaluate_caches, &cache_opts));
+		ufbxi_check_err(&ec->error, ufbxi_evaluate_scene_skinning(ec, &ec->scene, &ec->result, NULL));
 	}
 
 	// Retain the scene, this must be the final allocation as we copy
@@ -25711,6 +29004,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context
 
 	imp->magic = UFBXI_SCENE_IMP_MAGIC;
 	imp->scene = ec->scene;
+	imp->evaluated_props = ec->prop_buffers;
 	imp->refcount.ator = ec->ator_result;
 	imp->refcount.ator.error = NULL;
 
@@ -25756,7 +29050,10 @@ ufbxi_nodiscard static ufbxi_noinline ufbx_scene *ufbxi_evaluate_scene(ufbxi_eva
 	ec->result.unordered = true;
 	ec->tmp.unordered = true;
 
-	if (ufbxi_evaluate_imp(ec)) {
+	int ok = ufbxi_evaluate_imp(ec);
+	ufbxi_thread_pool_free(&ec->thread_pool);
+
+	if (ok) {
 		ufbxi_buf_free(&ec->tmp);
 		ufbxi_free_ator(&ec->ator_tmp);
 		if (p_error) {
@@ -25773,6 +29070,158 @@ ufbxi_nodiscard static ufbxi_noinline ufbx_scene *ufbxi_evaluate_scene(ufbxi_eva
 	}
 }
 
+// Evaluate into `dst_imp` returned by `ufbxi_evaluate_scene()` for the same source scene.
+// Any memory that cannot be reused is allocated from the retained buffer of `dst_imp`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_in_place_imp(ufbxi_eval_context *ec, ufbxi_scene_imp *dst_imp)
+{
+	ufbx_assert(dst_imp->magic == UFBXI_SCENE_IMP_MAGIC);
+	ufbxi_check_err_msg(&ec->error, dst_imp->magic == UFBXI_SCENE_IMP_MAGIC, "Bad scene");
+	ufbxi_check_err_msg(&ec->error, dst_imp->evaluated_props, "Scene was not returned by ufbx_evaluate_scene()");
+
+	ec->src_imp = (ufbxi_scene_imp*)dst_imp->refcount.parent;
+	ec->src_scene = ec->src_imp->scene;
+	if (!ec->anim) ec->anim = ec->src_scene.anim;
+	ec->cursor = ufbxi_get_anim_cursor(ec->anim);
+
+	ufbx_scene *scene = &dst_imp->scene;
+	ufbxi_buf *result = &dst_imp->refcount.buf;
+	ufbx_assert(scene->elements.count == ec->src_scene.elements.count);
+
+	// Animation props are looked up by element pointer so `anim` must refer to the source elements
+	ufbxi_for_ptr_list(ufbx_anim_layer, p_layer, ec->anim->layers) {
+		ufbxi_check_err_msg(&ec->error, (*p_layer)->element.scene == &ec->src_imp->scene, "Animation does not belong to the original scene");
+	}
+
+	ufbxi_check_err(&ec->error, ufbxi_evaluate_element_mask(ec, scene));
+	bool *mask = ec->element_mask;
+
+	// The local copy is not a `ufbxi_anim_imp`, pass the cursor explicitly instead
+	ufbx_anim anim = *ec->anim;
+	anim.custom = false;
+	ufbx_prop_override *over = anim.prop_overrides.data, *over_end = ufbxi_add_ptr(over, anim.prop_overrides.count);
+
+	// Evaluate the properties into the buffers of the previous evaluation
+	ufbxi_for_ptr_list(ufbx_element, p_elem, scene->elements) {
+		ufbx_element *elem = *p_elem;
+		ufbx_element *src = ec->src_scene.elements.data[elem->element_id];
+		size_t num_animated = src->props.num_animated;
+		size_t num_override = 0;
+
+		while (over != over_end && over->element_id == elem->element_id) {
+			num_override++;
+			over++;
+		}
+
+		num_animated += num_override;
+		if (mask && !mask[elem->element_id]) continue;
+		if (num_animated == 0) {
+			elem->props = src->props;
+			continue;
+		}
+
+		anim.prop_overrides.data = ufbxi_sub_ptr(over, num_override);
+		anim.prop_overrides.count = num_override;
+
+		ufbx_prop_list *buffer = &dst_imp->evaluated_props[elem->element_id];
+		if (num_animated > buffer->count) {
+			ufbx_prop *data = ufbxi_push(result, ufbx_prop, num_animated);
+			ufbxi_check_err(&ec->error, data);
+			buffer->data = data;
+			buffer->count = num_animated;
+		}
+
+		elem->props = ufbxi_evaluate_element_props(ec->cursor, &anim, src, ec->time, buffer->data, num_animated);
+		elem->props.defaults = &src->props;
+	}
+
+	ufbxi_update_scene(scene, false, anim.transform_overrides.data, anim.transform_overrides.count, mask);
+
+	// Meshes that are not skinned in this evaluation must use the unskinned views, keep
+	// their buffers in `saved_skinning` so that they can be reused if skinned later.
+	bool load_caches = ec->opts.load_external_files && ec->opts.evaluate_caches;
+	for (size_t i = 0; i < scene->meshes.count; i++) {
+		ufbx_mesh *mesh = scene->meshes.data[i];
+		const ufbx_mesh *src_mesh = ec->src_scene.meshes.data[i];
+		if (mask && !mask[mesh->element_id]) continue;
+
+		ufbxi_saved_skinning *saved = dst_imp->saved_skinning ? &dst_imp->saved_skinning[i] : NULL;
+		if (ec->opts.evaluate_skinning && mesh->num_vertices > 0 && ufbxi_is_mesh_deformed(mesh, load_caches)) {
+			if (saved && saved->valid) {
+				mesh->skinned_position = saved->skinned_position;
+				mesh->skinned_normal = saved->skinned_normal;
+				mesh->generated_normals = saved->generated_normals;
+				saved->valid = false;
+			}
+			continue;
+		}
+
+		if (mesh->skinned_position.values.data != src_mesh->skinned_position.values.data || mesh->skinned_normal.values.data != src_mesh->skinned_normal.values.data) {
+			if (!saved) {
+				dst_imp->saved_skinning = ufbxi_push_zero(result, ufbxi_saved_skinning, scene->meshes.count);
+				ufbxi_check_err(&ec->error, dst_imp->saved_skinning);
+				saved = &dst_imp->saved_skinning[i];
+			}
+			saved->skinned_position = mesh->skinned_position;
+			saved->skinned_normal = mesh->skinned_normal;
+			saved->generated_normals = mesh->generated_normals;
+			saved->valid = true;
+		}
+
+		mesh->skinned_position = src_mesh->skinned_position;
+		mesh->skinned_normal = src_mesh->skinned_normal;
+		mesh->generated_normals = src_mesh->generated_normals;
+		mesh->skinned_is_local = src_mesh->skinned_is_local;
+	}
+
+	if (ec->opts.evaluate_skinning) {
+		ufbxi_check_err(&ec->error, ufbxi_evaluate_scene_skinning(ec, scene, result, &ec->src_scene));
+	}
+
+	scene->metadata.result_memory_used = dst_imp->refcount.ator.current_size;
+	scene->metadata.temp_memory_used = ec->ator_tmp.current_size;
+	scene->metadata.result_allocs = dst_imp->refcount.ator.num_allocs;
+	scene->metadata.temp_allocs = ec->ator_tmp.num_allocs;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline bool ufbxi_evaluate_scene_in_place(ufbxi_eval_context *ec, ufbx_scene *state, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *user_opts, ufbx_error *p_error)
+{
+	if (user_opts) {
+		ec->opts = *user_opts;
+	} else {
+		memset(&ec->opts, 0, sizeof(ec->opts));
+	}
+
+	ufbxi_scene_imp *dst_imp = ufbxi_get_imp(ufbxi_scene_imp, state);
+	ec->anim = (ufbx_anim*)anim;
+	ec->time = time;
+
+	ufbxi_init_ator(&ec->error, &ec->ator_tmp, &ec->opts.temp_allocator, "temp");
+	ec->tmp.ator = &ec->ator_tmp;
+	ec->tmp.unordered = true;
+
+	// Allocations that cannot reuse previous buffers are retained by `state`
+	ufbx_error *prev_error = dst_imp->refcount.ator.error;
+	dst_imp->refcount.ator.error = &ec->error;
+	int ok = ufbxi_evaluate_in_place_imp(ec, dst_imp);
+	dst_imp->refcount.ator.error = prev_error;
+	ufbxi_thread_pool_free(&ec->thread_pool);
+
+	ufbxi_buf_free(&ec->tmp);
+	ufbxi_free_ator(&ec->ator_tmp);
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return true;
+	} else {
+		ufbxi_fix_error_type(&ec->error, "Failed to evaluate", p_error);
+		return false;
+	}
+}
+
 #endif
 
 typedef struct {
@@ -25952,6 +29401,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_create_anim_imp(ufbxi_create_ani
 
 	ac->imp->magic = UFBXI_ANIM_IMP_MAGIC;
 	ac->imp->anim = ac->anim;
+	ac->imp->cursor = NULL;
 	ac->imp->refcount.ator = ac->ator_result;
 	ac->imp->refcount.buf = ac->result;
 
@@ -25966,6 +29416,12 @@ typedef struct {
 	uint32_t magic;
 } ufbxi_baked_anim_imp;
 
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_compact_anim anim;
+	uint32_t magic;
+} ufbxi_compact_anim_imp;
+
 #if UFBXI_FEATURE_ANIMATION_BAKING
 
 typedef struct {
@@ -25975,6 +29431,32 @@ typedef struct {
 
 UFBX_LIST_TYPE(ufbxi_bake_time_list, ufbxi_bake_time);
 
+// Node transform (`prop_name == NULL`) or a single property to bake. The key times
+// are gathered and finalized serially, after which sampling the animation at the
+// times only reads the scene and can be done in parallel, see `ufbxi_bake_flush_jobs()`.
+typedef struct {
+	const ufbx_anim *anim;
+	ufbx_element *element;
+	const char *prop_name;
+
+	// Last property job of `element`, the baked element is created after finishing this.
+	bool end_element;
+
+	ufbx_baked_node *scale_helper_t;
+	ufbx_baked_node *scale_helper_s;
+	ufbx_vec3 constant_scale_t;
+	ufbx_vec3 constant_scale_s;
+
+	// Properties only use `times_t` and `keys_t`
+	ufbxi_bake_time_list times_t, times_r, times_s;
+	ufbx_baked_vec3_list keys_t;
+	ufbx_baked_quat_list keys_r;
+	ufbx_baked_vec3_list keys_s;
+} ufbxi_bake_job;
+
+// Maximum number of jobs to sample in parallel before finishing them.
+#define UFBXI_BAKE_MAX_JOBS 256
+
 typedef struct {
 	ufbx_error error;
 	ufbxi_allocator ator_tmp;
@@ -25992,14 +29474,25 @@ typedef struct {
 
 	ufbxi_bake_time_list layer_weight_times;
 
+	ufbxi_thread_pool thread_pool;
+
+	// Pending jobs to sample, see `ufbxi_bake_flush_jobs()`
+	ufbxi_bake_job *jobs;
+	size_t num_jobs;
+	size_t max_jobs;
+
 	ufbx_baked_node **baked_nodes;
 	bool *nodes_to_bake;
 
+	// Distance to the furthest descendant of each node, see `key_reduction_hierarchy_error`.
+	ufbx_real *node_reach;
+
 	char *tmp_arr;
 	size_t tmp_arr_size;
 
 	const ufbx_scene *scene;
 	const ufbx_anim *anim;
+	ufbx_anim anim_copy;
 	ufbx_bake_opts opts;
 
 	double ktime_offset;
@@ -26305,7 +29798,132 @@ static ufbxi_noinline bool ufbxi_postprocess_step(ufbxi_bake_context *bc, double
 	}
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_vec3(ufbxi_bake_context *bc, ufbx_baked_vec3_list *p_dst, bool *p_constant, ufbx_baked_vec3_list src)
+#define UFBXI_BAKE_KEY_STEP_FLAGS (UFBX_BAKED_KEY_STEP_LEFT|UFBX_BAKED_KEY_STEP_RIGHT|UFBX_BAKED_KEY_STEP_KEY)
+
+// Error-bounded key reduction: Starting from the full span, split each span at the key
+// with the largest error until linearly interpolating the span ends is within tolerance
+// for every key in between. Spans are resolved left to right using a stack of span ends,
+// so the kept keys can be compacted in place. Step keys are always kept.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_reduce_vec3(ufbxi_bake_context *bc, ufbx_baked_vec3_list *p_keys, double tolerance)
+{
+	ufbx_baked_vec3 *keys = p_keys->data;
+	size_t count = p_keys->count;
+	if (count <= 2) return 1;
+
+	ufbxi_check_err(&bc->error, ufbxi_grow_array(&bc->ator_tmp, &bc->tmp_arr, &bc->tmp_arr_size, count * sizeof(size_t)));
+	size_t *stack = (size_t*)bc->tmp_arr;
+	size_t stack_size = 0;
+
+	double threshold = tolerance * tolerance;
+	size_t dst = 1, begin = 0;
+	stack[stack_size++] = count - 1;
+	while (stack_size > 0) {
+		size_t end = stack[stack_size - 1];
+		ufbx_baked_vec3 prev = keys[begin], next = keys[end];
+		double duration = next.time - prev.time;
+
+		double max_error = 0.0;
+		size_t max_index = 0;
+		for (size_t i = begin + 1; i < end; i++) {
+			ufbx_baked_vec3 cur = keys[i];
+			double error = UFBX_INFINITY;
+			if ((cur.flags & UFBXI_BAKE_KEY_STEP_FLAGS) == 0 && duration > 0.0) {
+				double delta = (cur.time - prev.time) / duration;
+				ufbx_vec3 tmp = ufbxi_lerp3(prev.value, next.value, (ufbx_real)delta);
+				error = 0.0;
+				error += ((double)tmp.x - (double)cur.value.x) * ((double)tmp.x - (double)cur.value.x);
+				error += ((double)tmp.y - (double)cur.value.y) * ((double)tmp.y - (double)cur.value.y);
+				error += ((double)tmp.z - (double)cur.value.z) * ((double)tmp.z - (double)cur.value.z);
+			}
+			if (error > max_error) {
+				max_error = error;
+				max_index = i;
+			}
+		}
+
+		if (max_error > threshold) {
+			stack[stack_size++] = max_index;
+		} else {
+			keys[dst++] = next;
+			begin = end;
+			stack_size--;
+		}
+	}
+
+	p_keys->count = dst;
+	return 1;
+}
+
+// Squared chord length between `a` and `b` in double precision.
+static ufbxi_forceinline double ufbxi_quat_distance_sq(ufbx_quat a, ufbx_quat b)
+{
+	double dx = (double)a.x - (double)b.x;
+	double dy = (double)a.y - (double)b.y;
+	double dz = (double)a.z - (double)b.z;
+	double dw = (double)a.w - (double)b.w;
+	return dx*dx + dy*dy + dz*dz + dw*dw;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_reduce_quat(ufbxi_bake_context *bc, ufbx_baked_quat_list *p_keys, double tolerance)
+{
+	ufbx_baked_quat *keys = p_keys->data;
+	size_t count = p_keys->count;
+	if (count <= 2) return 1;
+
+	ufbxi_check_err(&bc->error, ufbxi_grow_array(&bc->ator_tmp, &bc->tmp_arr, &bc->tmp_arr_size, count * sizeof(size_t)));
+	size_t *stack = (size_t*)bc->tmp_arr;
+	size_t stack_size = 0;
+
+	// Compare chord lengths between unit quaternions to avoid precision issues with
+	// `acos()`, `theta = 4 * asin(chord / 2)` for a rotation of `theta` radians.
+	double chord = 2.0 * ufbx_sin(ufbx_fmin(tolerance, UFBXI_PI) * 0.25);
+	double threshold = chord * chord;
+
+	size_t dst = 1, begin = 0;
+	stack[stack_size++] = count - 1;
+	while (stack_size > 0) {
+		size_t end = stack[stack_size - 1];
+		ufbx_baked_quat prev = keys[begin], next = keys[end];
+		double duration = next.time - prev.time;
+
+		double max_error = 0.0;
+		size_t max_index = 0;
+		for (size_t i = begin + 1; i < end; i++) {
+			ufbx_baked_quat cur = keys[i];
+			double error = UFBX_INFINITY;
+			if ((cur.flags & UFBXI_BAKE_KEY_STEP_FLAGS) == 0 && duration > 0.0) {
+				if (bc->opts.key_reduction_rotation) {
+					double delta = (cur.time - prev.time) / duration;
+					ufbx_quat tmp = ufbx_quat_slerp(prev.value, next.value, (ufbx_real)delta);
+					error = ufbxi_quat_distance_sq(tmp, cur.value);
+				} else {
+					// Without rotation reduction only remove keys that are within
+					// tolerance of both ends, ie. plateaus.
+					double error_prev = ufbxi_quat_distance_sq(prev.value, cur.value);
+					double error_next = ufbxi_quat_distance_sq(next.value, cur.value);
+					error = ufbx_fmax(error_prev, error_next);
+				}
+			}
+			if (error > max_error) {
+				max_error = error;
+				max_index = i;
+			}
+		}
+
+		if (max_error > threshold) {
+			stack[stack_size++] = max_index;
+		} else {
+			keys[dst++] = next;
+			begin = end;
+			stack_size--;
+		}
+	}
+
+	p_keys->count = dst;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_vec3(ufbxi_bake_context *bc, ufbx_baked_vec3_list *p_dst, bool *p_constant, ufbx_baked_vec3_list src, double tolerance)
 {
 	if (src.count == 0) return 1;
 
@@ -26338,7 +29956,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_vec3(ufbxi_bake
 		src.count = dst;
 	}
 
-	if (bc->opts.key_reduction_enabled) {
+	if (bc->opts.key_reduction_enabled && bc->opts.key_reduction_mode == UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED) {
+		ufbxi_check_err(&bc->error, ufbxi_bake_reduce_vec3(bc, &src, tolerance));
+	} else if (bc->opts.key_reduction_enabled) {
 		double threshold = bc->opts.key_reduction_threshold * bc->opts.key_reduction_threshold;
 		for (size_t pass = 0; pass < bc->opts.key_reduction_passes; pass++) {
 			size_t dst = 1;
@@ -26387,7 +30007,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_vec3(ufbxi_bake
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_quat(ufbxi_bake_context *bc, ufbx_baked_quat_list *p_dst, bool *p_constant, ufbx_baked_quat_list src)
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_quat(ufbxi_bake_context *bc, ufbx_baked_quat_list *p_dst, bool *p_constant, ufbx_baked_quat_list src, double tolerance)
 {
 	if (src.count == 0) return 1;
 
@@ -26425,7 +30045,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_postprocess_quat(ufbxi_bake
 		src.data[i].value = ufbx_quat_fix_antipodal(src.data[i].value, src.data[i - 1].value);
 	}
 
-	if (bc->opts.key_reduction_enabled) {
+	if (bc->opts.key_reduction_enabled && bc->opts.key_reduction_mode == UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED) {
+		ufbxi_check_err(&bc->error, ufbxi_bake_reduce_quat(bc, &src, tolerance));
+	} else if (bc->opts.key_reduction_enabled) {
 		double threshold = bc->opts.key_reduction_threshold * bc->opts.key_reduction_threshold;
 		for (size_t pass = 0; pass < bc->opts.key_reduction_passes; pass++) {
 			size_t dst = 1;
@@ -26521,11 +30143,18 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_push_resampled_times(ufbxi_bake_
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context *bc, uint32_t element_id, ufbxi_bake_prop *props, size_t count)
+// Node transforms that depend on other baked scale helpers, these must be baked
+// immediately in order, see `ufbxi_bake_node()`.
+static ufbxi_forceinline bool ufbxi_bake_node_has_dependencies(const ufbx_node *node)
+{
+	return node->is_scale_helper || (node->parent && node->parent->scale_helper);
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_times(ufbxi_bake_context *bc, ufbxi_bake_job *job, ufbxi_bake_prop *props, size_t count)
 {
 	ufbx_assert(bc->baked_nodes && bc->nodes_to_bake);
 
-	ufbx_node *node = (ufbx_node*)bc->scene->elements.data[element_id];
+	ufbx_node *node = (ufbx_node*)job->element;
 	ufbxi_dev_assert(node->element.type == UFBX_ELEMENT_NODE);
 
 	bool complex_translation = false;
@@ -26553,24 +30182,23 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 		}
 	}
 
-	ufbxi_bake_time_list times_t, times_r, times_s;
-
 	// Translation
 	bool resample_translation = false;
 
 	// Account for the _resampled_ scale helper scale animation to keep the
 	// translation scale consistent with the parent scaling.
-	ufbx_baked_node *scale_helper_t = NULL;
-	ufbx_vec3 constant_scale_t = { 1.0f, 1.0f, 1.0f };
+	job->scale_helper_t = NULL;
+	job->constant_scale_t = ufbx_identity_transform.scale;
 	if (!node->is_scale_helper && node->parent && node->parent->scale_helper) {
-		scale_helper_t = bc->baked_nodes[node->parent->scale_helper->typed_id];
+		ufbx_baked_node *scale_helper_t = bc->baked_nodes[node->parent->scale_helper->typed_id];
+		job->scale_helper_t = scale_helper_t;
 		if (scale_helper_t) {
 			if (!scale_helper_t->constant_scale) {
 				resample_translation = true;
 			}
 			ufbxi_check_err(&bc->error, ufbxi_push_resampled_times(bc, &scale_helper_t->scale_keys));
 		} else {
-			constant_scale_t = node->parent->scale_helper->inherit_scale;
+			job->constant_scale_t = node->parent->scale_helper->inherit_scale;
 		}
 	}
 
@@ -26591,7 +30219,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 		}
 	}
 
-	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &times_t));
+	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &job->times_t));
 
 	// Rotation
 	if (complex_rotation) {
@@ -26609,24 +30237,25 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 			}
 		}
 	}
-	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &times_r));
+	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &job->times_r));
 
 	// Scaling
 	bool resample_scale = false;
 
 	// Account for the resampled scale
-	ufbx_baked_node *scale_helper_s = NULL;
-	ufbx_vec3 constant_scale_s = { 1.0f, 1.0f, 1.0f };
+	job->scale_helper_s = NULL;
+	job->constant_scale_s = ufbx_identity_transform.scale;
 	if (node->is_scale_helper && node->parent && node->parent->inherit_scale_node && node->parent->inherit_scale_node->scale_helper) {
 		ufbx_node *inherit_helper = node->parent->inherit_scale_node->scale_helper;
-		scale_helper_s = bc->baked_nodes[inherit_helper->typed_id];
+		ufbx_baked_node *scale_helper_s = bc->baked_nodes[inherit_helper->typed_id];
+		job->scale_helper_s = scale_helper_s;
 		if (scale_helper_s) {
 			if (!scale_helper_s->constant_scale) {
 				resample_scale = true;
 			}
 			ufbxi_check_err(&bc->error, ufbxi_push_resampled_times(bc, &scale_helper_s->scale_keys));
 		} else {
-			constant_scale_s = inherit_helper->local_transform.scale;
+			job->constant_scale_s = inherit_helper->local_transform.scale;
 		}
 	}
 
@@ -26635,23 +30264,34 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 			ufbxi_check_err(&bc->error, ufbxi_bake_times(bc, prop->anim_value, resample_scale, UFBX_BAKED_KEY_KEYFRAME));
 		}
 	}
-	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &times_s));
+	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &job->times_s));
 
-	ufbx_baked_vec3_list keys_t;
-	ufbx_baked_quat_list keys_r;
-	ufbx_baked_vec3_list keys_s;
+	job->keys_t.count = job->times_t.count;
+	job->keys_t.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, job->keys_t.count);
+	ufbxi_check_err(&bc->error, job->keys_t.data);
+
+	job->keys_r.count = job->times_r.count;
+	job->keys_r.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_quat, job->keys_r.count);
+	ufbxi_check_err(&bc->error, job->keys_r.data);
 
-	keys_t.count = times_t.count;
-	keys_t.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, keys_t.count);
-	ufbxi_check_err(&bc->error, keys_t.data);
+	job->keys_s.count = job->times_s.count;
+	job->keys_s.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, job->keys_s.count);
+	ufbxi_check_err(&bc->error, job->keys_s.data);
 
-	keys_r.count = times_r.count;
-	keys_r.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_quat, keys_r.count);
-	ufbxi_check_err(&bc->error, keys_r.data);
+	return 1;
+}
 
-	keys_s.count = times_s.count;
-	keys_s.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, keys_s.count);
-	ufbxi_check_err(&bc->error, keys_s.data);
+static ufbxi_noinline void ufbxi_bake_sample_node(ufbxi_bake_job *job)
+{
+	ufbx_node *node = (ufbx_node*)job->element;
+	ufbxi_bake_time_list times_t = job->times_t, times_r = job->times_r, times_s = job->times_s;
+	ufbx_baked_vec3_list keys_t = job->keys_t;
+	ufbx_baked_quat_list keys_r = job->keys_r;
+	ufbx_baked_vec3_list keys_s = job->keys_s;
+	const ufbx_baked_node *scale_helper_t = job->scale_helper_t;
+	const ufbx_baked_node *scale_helper_s = job->scale_helper_s;
+	ufbx_vec3 constant_scale_t = job->constant_scale_t;
+	ufbx_vec3 constant_scale_s = job->constant_scale_s;
 
 	size_t ix_t = 0, ix_r = 0, ix_s = 0;
 	while (ix_t < times_t.count || ix_r < times_r.count || ix_s < times_s.count) {
@@ -26695,7 +30335,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 		flags |= UFBX_TRANSFORM_FLAG_IGNORE_SCALE_HELPER|UFBX_TRANSFORM_FLAG_IGNORE_COMPONENTWISE_SCALE|UFBX_TRANSFORM_FLAG_EXPLICIT_INCLUDES;
 
 		double eval_time = ufbxi_bake_time_sample_time(bake_time);
-		ufbx_transform transform = ufbx_evaluate_transform_flags(bc->anim, node, eval_time, flags);
+		ufbx_transform transform = ufbx_evaluate_transform_flags(job->anim, node, eval_time, flags);
 
 		if (flags & UFBX_TRANSFORM_FLAG_INCLUDE_TRANSLATION) {
 			if (scale_helper_t) {
@@ -26738,20 +30378,35 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 			ix_s++;
 		}
 	}
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_finish(ufbxi_bake_context *bc, ufbxi_bake_job *job)
+{
+	ufbx_node *node = (ufbx_node*)job->element;
 
 	ufbx_baked_node *baked_node = ufbxi_push_zero(&bc->tmp_nodes, ufbx_baked_node, 1);
 	ufbxi_check_err(&bc->error, baked_node);
 
+	double tolerance_t = bc->opts.key_reduction_translation_tolerance;
+	double tolerance_r = bc->opts.key_reduction_rotation_tolerance * (UFBXI_PI / 180.0);
+	double tolerance_s = bc->opts.key_reduction_scale_tolerance;
+
+	// Rotating or scaling by a small error moves descendants at distance `reach`
+	// approximately by `error * reach`.
+	if (bc->node_reach && bc->node_reach[node->typed_id] > 0.0f) {
+		double reach = (double)bc->node_reach[node->typed_id];
+		tolerance_r = ufbx_fmin(tolerance_r, tolerance_t / reach);
+		tolerance_s = ufbx_fmin(tolerance_s, tolerance_t / reach);
+	}
+
 	baked_node->element_id = node->element_id;
 	baked_node->typed_id = node->typed_id;
-	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_node->translation_keys, &baked_node->constant_translation, keys_t));
-	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_quat(bc, &baked_node->rotation_keys, &baked_node->constant_rotation, keys_r));
-	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_node->scale_keys, &baked_node->constant_scale, keys_s));
+	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_node->translation_keys, &baked_node->constant_translation, job->keys_t, tolerance_t));
+	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_quat(bc, &baked_node->rotation_keys, &baked_node->constant_rotation, job->keys_r, tolerance_r));
+	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_node->scale_keys, &baked_node->constant_scale, job->keys_s, tolerance_s));
 
 	bc->baked_nodes[node->typed_id] = baked_node;
 
-	ufbxi_buf_clear(&bc->tmp_prop);
-
 	// If this node is a scale helper, make sure to bake its siblings and
 	// potentially their scale helpers if they are not a part of the animation.
 	if (node->is_scale_helper) {
@@ -26777,62 +30432,172 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_imp(ufbxi_bake_context
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node(ufbxi_bake_context *bc, uint32_t element_id, ufbxi_bake_prop *props, size_t count)
-{
-	ufbxi_check_err(&bc->error, ufbxi_bake_node_imp(bc, element_id, props, count));
-
-	// Baking a node may cause further nodes to be baked, so keep going
-	// until all dependencies are baked.
-	while (bc->tmp_bake_stack.num_items > 0) {
-		uint32_t child_id = 0;
-		ufbxi_pop(&bc->tmp_bake_stack, uint32_t, 1, &child_id);
-		ufbxi_check_err(&bc->error, ufbxi_bake_node_imp(bc, child_id, NULL, 0));
-	}
-
-	return 1;
-}
-
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_prop(ufbxi_bake_context *bc, ufbx_element *element, const char *prop_name, ufbxi_bake_prop *props, size_t count)
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_prop_times(ufbxi_bake_context *bc, ufbxi_bake_job *job, ufbxi_bake_prop *props, size_t count)
 {
 	ufbxi_for(ufbxi_bake_prop, prop, props, count) {
 		ufbxi_check_err(&bc->error, ufbxi_bake_times(bc, prop->anim_value, false, UFBX_BAKED_KEY_KEYFRAME));
 	}
 
-	ufbxi_bake_time_list times;
-	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &times));
+	ufbxi_check_err(&bc->error, ufbxi_finalize_bake_times(bc, &job->times_t));
 
-	ufbx_baked_vec3_list keys;
-	keys.count = times.count;
-	keys.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, keys.count);
-	ufbxi_check_err(&bc->error, keys.data);
+	job->keys_t.count = job->times_t.count;
+	job->keys_t.data = ufbxi_push(&bc->tmp_prop, ufbx_baked_vec3, job->keys_t.count);
+	ufbxi_check_err(&bc->error, job->keys_t.data);
 
-	ufbx_string name;
-	name.data = prop_name;
-	name.length = strlen(prop_name);
+	return 1;
+}
 
-	for (size_t i = 0; i < times.count; i++) {
-		ufbxi_bake_time bake_time = times.data[i];
+static ufbxi_noinline void ufbxi_bake_sample_prop(ufbxi_bake_job *job)
+{
+	size_t name_len = strlen(job->prop_name);
+	ufbx_baked_vec3_list keys = job->keys_t;
+	for (size_t i = 0; i < job->times_t.count; i++) {
+		ufbxi_bake_time bake_time = job->times_t.data[i];
 		double eval_time = ufbxi_bake_time_sample_time(bake_time);
-		ufbx_prop prop = ufbx_evaluate_prop_len(bc->anim, element, name.data, name.length, eval_time);
+		ufbx_prop prop = ufbx_evaluate_prop_len(job->anim, job->element, job->prop_name, name_len, eval_time);
 		keys.data[i].time = bake_time.time;
 		keys.data[i].value = prop.value_vec3;
 		keys.data[i].flags = (ufbx_baked_key_flags)bake_time.flags;
 	}
+}
 
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_prop_finish(ufbxi_bake_context *bc, ufbxi_bake_job *job)
+{
 	ufbx_baked_prop *baked_prop = ufbxi_push_zero(&bc->tmp_props, ufbx_baked_prop, 1);
 	ufbxi_check_err(&bc->error, baked_prop);
 
-	baked_prop->name.length = strlen(prop_name);
-	baked_prop->name.data = ufbxi_push_copy(&bc->result, char, baked_prop->name.length + 1, prop_name);
+	baked_prop->name.length = strlen(job->prop_name);
+	baked_prop->name.data = ufbxi_push_copy(&bc->result, char, baked_prop->name.length + 1, job->prop_name);
 	ufbxi_check_err(&bc->error, baked_prop->name.data);
 
-	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_prop->keys, &baked_prop->constant_value, keys));
+	ufbxi_check_err(&bc->error, ufbxi_bake_postprocess_vec3(bc, &baked_prop->keys, &baked_prop->constant_value, job->keys_t, bc->opts.key_reduction_prop_tolerance));
+
+	if (job->end_element) {
+		size_t num_props = bc->tmp_props.num_items;
+		ufbx_baked_element *baked_elem = ufbxi_push_zero(&bc->tmp_elements, ufbx_baked_element, 1);
+		ufbxi_check_err(&bc->error, baked_elem);
+
+		baked_elem->element_id = job->element->element_id;
+		baked_elem->props.count = num_props;
+		baked_elem->props.data = ufbxi_push_pop(&bc->result, &bc->tmp_props, ufbx_baked_prop, num_props);
+		ufbxi_check_err(&bc->error, baked_elem->props.data);
+	}
+
+	return 1;
+}
+
+static ufbxi_noinline void ufbxi_bake_sample_job(ufbxi_bake_job *job)
+{
+	if (job->prop_name) {
+		ufbxi_bake_sample_prop(job);
+	} else {
+		ufbxi_bake_sample_node(job);
+	}
+}
+
+static bool ufbxi_bake_task_fn(ufbxi_task *task)
+{
+	ufbxi_bake_sample_job((ufbxi_bake_job*)task->data);
+	return true;
+}
+
+// Sample all the pending jobs, potentially in parallel, and finish them in order.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_flush_jobs(ufbxi_bake_context *bc)
+{
+	size_t num_jobs = bc->num_jobs;
+	if (num_jobs == 0) return 1;
+
+	if (bc->thread_pool.enabled && num_jobs > 1) {
+		for (size_t i = 0; i < num_jobs; i++) {
+			ufbxi_task *task = ufbxi_thread_pool_create_task(&bc->thread_pool, &ufbxi_bake_task_fn);
+			if (task) {
+				task->data = &bc->jobs[i];
+				ufbxi_thread_pool_run_task(&bc->thread_pool, task);
+			} else {
+				ufbxi_bake_sample_job(&bc->jobs[i]);
+			}
+		}
 
+		ufbxi_thread_pool_flush_group(&bc->thread_pool);
+		ufbxi_check_err(&bc->error, ufbxi_thread_pool_wait_all(&bc->thread_pool));
+	} else {
+		for (size_t i = 0; i < num_jobs; i++) {
+			ufbxi_bake_sample_job(&bc->jobs[i]);
+		}
+	}
+
+	for (size_t i = 0; i < num_jobs; i++) {
+		ufbxi_bake_job *job = &bc->jobs[i];
+		if (job->prop_name) {
+			ufbxi_check_err(&bc->error, ufbxi_bake_prop_finish(bc, job));
+		} else {
+			ufbxi_check_err(&bc->error, ufbxi_bake_node_finish(bc, job));
+		}
+	}
+
+	bc->num_jobs = 0;
 	ufbxi_buf_clear(&bc->tmp_prop);
 
 	return 1;
 }
 
+static ufbxi_noinline ufbxi_bake_job *ufbxi_bake_push_job(ufbxi_bake_context *bc, ufbx_element *element, const char *prop_name)
+{
+	ufbx_assert(bc->num_jobs < bc->max_jobs);
+	ufbxi_bake_job *job = &bc->jobs[bc->num_jobs++];
+	memset(job, 0, sizeof(ufbxi_bake_job));
+	job->anim = bc->anim;
+	job->element = element;
+	job->prop_name = prop_name;
+	return job;
+}
+
+// Flush the jobs if there is no space left for more.
+ufbxi_nodiscard static ufbxi_forceinline int ufbxi_bake_commit_job(ufbxi_bake_context *bc)
+{
+	if (bc->num_jobs >= bc->max_jobs) {
+		ufbxi_check_err(&bc->error, ufbxi_bake_flush_jobs(bc));
+	}
+	return 1;
+}
+
+// Bake a node transform and any nodes it depends on immediately.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node_now(ufbxi_bake_context *bc, uint32_t element_id, ufbxi_bake_prop *props, size_t count)
+{
+	ufbxi_check_err(&bc->error, ufbxi_bake_flush_jobs(bc));
+
+	ufbxi_bake_job *job = ufbxi_bake_push_job(bc, bc->scene->elements.data[element_id], NULL);
+	ufbxi_check_err(&bc->error, ufbxi_bake_node_times(bc, job, props, count));
+	ufbxi_check_err(&bc->error, ufbxi_bake_flush_jobs(bc));
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_node(ufbxi_bake_context *bc, uint32_t element_id, ufbxi_bake_prop *props, size_t count)
+{
+	ufbx_node *node = (ufbx_node*)bc->scene->elements.data[element_id];
+
+	// Independent nodes can be sampled in parallel with other jobs
+	if (!ufbxi_bake_node_has_dependencies(node)) {
+		ufbxi_bake_job *job = ufbxi_bake_push_job(bc, &node->element, NULL);
+		ufbxi_check_err(&bc->error, ufbxi_bake_node_times(bc, job, props, count));
+		ufbxi_check_err(&bc->error, ufbxi_bake_commit_job(bc));
+		return 1;
+	}
+
+	ufbxi_check_err(&bc->error, ufbxi_bake_node_now(bc, element_id, props, count));
+
+	// Baking a node may cause further nodes to be baked, so keep going
+	// until all dependencies are baked.
+	while (bc->tmp_bake_stack.num_items > 0) {
+		uint32_t child_id = 0;
+		ufbxi_pop(&bc->tmp_bake_stack, uint32_t, 1, &child_id);
+		ufbxi_check_err(&bc->error, ufbxi_bake_node_now(bc, child_id, NULL, 0));
+	}
+
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_element(ufbxi_bake_context *bc, uint32_t element_id, ufbxi_bake_prop *props, size_t count)
 {
 	ufbx_element *element = bc->scene->elements.data[element_id];
@@ -26840,6 +30605,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_element(ufbxi_bake_context
 		ufbxi_check_err(&bc->error, ufbxi_bake_node(bc, element_id, props, count));
 	}
 
+	ufbxi_bake_job *prev_job = NULL;
+
 	size_t begin = 0;
 	while (begin < count) {
 		const char *prop_name = props[begin].prop_name;
@@ -26854,19 +30621,19 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_element(ufbxi_bake_context
 			continue;
 		}
 
-		ufbxi_check_err(&bc->error, ufbxi_bake_anim_prop(bc, element, prop_name, props + begin, end - begin));
+		// Commit the previous job only now so the last job can be marked as `end_element`
+		if (prev_job) {
+			ufbxi_check_err(&bc->error, ufbxi_bake_commit_job(bc));
+		}
+
+		prev_job = ufbxi_bake_push_job(bc, element, prop_name);
+		ufbxi_check_err(&bc->error, ufbxi_bake_prop_times(bc, prev_job, props + begin, end - begin));
 		begin = end;
 	}
 
-	size_t num_props = bc->tmp_props.num_items;
-	if (num_props > 0) {
-		ufbx_baked_element *baked_elem = ufbxi_push_zero(&bc->tmp_elements, ufbx_baked_element, 1);
-		ufbxi_check_err(&bc->error, baked_elem);
-
-		baked_elem->element_id = element->element_id;
-		baked_elem->props.count = num_props;
-		baked_elem->props.data = ufbxi_push_pop(&bc->result, &bc->tmp_props, ufbx_baked_prop, num_props);
-		ufbxi_check_err(&bc->error, baked_elem->props.data);
+	if (prev_job) {
+		prev_job->end_element = true;
+		ufbxi_check_err(&bc->error, ufbxi_bake_commit_job(bc));
 	}
 
 	return 1;
@@ -26896,6 +30663,22 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim(ufbxi_bake_context *bc
 		ufbxi_check_err(&bc->error, bc->baked_nodes);
 		bc->nodes_to_bake = ufbxi_push_zero(&bc->result, bool, scene->nodes.count);
 		ufbxi_check_err(&bc->error, bc->nodes_to_bake);
+
+		if (bc->opts.key_reduction_enabled && bc->opts.key_reduction_hierarchy_error) {
+			bc->node_reach = ufbxi_push_zero(&bc->tmp, ufbx_real, scene->nodes.count);
+			ufbxi_check_err(&bc->error, bc->node_reach);
+
+			// Measure the rest pose distance from each node to all of its descendants.
+			ufbxi_for_ptr_list(ufbx_node, p_node, scene->nodes) {
+				ufbx_node *node = *p_node;
+				ufbx_vec3 pos = node->node_to_world.cols[3];
+				for (ufbx_node *parent = node->parent; parent; parent = parent->parent) {
+					ufbx_real dist = ufbxi_length3(ufbxi_sub3(pos, parent->node_to_world.cols[3]));
+					ufbx_real *reach = &bc->node_reach[parent->typed_id];
+					if (dist > *reach) *reach = dist;
+				}
+			}
+		}
 	}
 
 	ufbxi_for_ptr_list(ufbx_anim_layer, p_layer, anim->layers) {
@@ -26964,6 +30747,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim(ufbxi_bake_context *bc
 		begin = end;
 	}
 
+	ufbxi_check_err(&bc->error, ufbxi_bake_flush_jobs(bc));
+
 	size_t num_nodes = bc->tmp_nodes.num_items;
 	size_t num_elements = bc->tmp_elements.num_items;
 
@@ -26999,6 +30784,10 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_imp(ufbxi_bake_context
 	if (bc->opts.max_keyframe_segments == 0) bc->opts.max_keyframe_segments = 32;
 	if (bc->opts.key_reduction_threshold == 0) bc->opts.key_reduction_threshold = 0.000001;
 	if (bc->opts.key_reduction_passes == 0) bc->opts.key_reduction_passes = 4;
+	if (bc->opts.key_reduction_translation_tolerance <= 0.0) bc->opts.key_reduction_translation_tolerance = 0.001;
+	if (bc->opts.key_reduction_rotation_tolerance <= 0.0) bc->opts.key_reduction_rotation_tolerance = 0.01;
+	if (bc->opts.key_reduction_scale_tolerance <= 0.0) bc->opts.key_reduction_scale_tolerance = 0.0001;
+	if (bc->opts.key_reduction_prop_tolerance <= 0.0) bc->opts.key_reduction_prop_tolerance = 0.0001;
 
 	if (bc->opts.trim_start_time && anim->time_begin > 0.0) {
 		bc->ktime_offset = -anim->time_begin * (double)bc->scene->metadata.ktime_second;
@@ -27024,7 +30813,12 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_imp(ufbxi_bake_context
 	bc->tmp_props.ator = &bc->ator_tmp;
 	bc->tmp_bake_stack.ator = &bc->ator_tmp;
 
-	bc->anim = anim;
+	// Animation cursors are not thread-safe and would not help as all times of
+	// a single property are sampled in order anyway. The copy is not a custom
+	// `ufbxi_anim_imp` so clearing `custom` also detaches any cursor.
+	bc->anim_copy = *anim;
+	bc->anim_copy.custom = false;
+	bc->anim = &bc->anim_copy;
 	if (anim->time_begin < anim->time_end) {
 		bc->time_begin = anim->time_begin;
 		bc->time_end = anim->time_end;
@@ -27035,6 +30829,12 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_imp(ufbxi_bake_context
 	bc->imp = ufbxi_push(&bc->result, ufbxi_baked_anim_imp, 1);
 	ufbxi_check_err(&bc->error, bc->imp);
 
+	ufbxi_check_err(&bc->error, ufbxi_thread_pool_init(&bc->thread_pool, &bc->error, &bc->ator_tmp, &bc->opts.thread_opts));
+
+	bc->max_jobs = bc->thread_pool.enabled ? UFBXI_BAKE_MAX_JOBS : 1;
+	bc->jobs = ufbxi_push(&bc->tmp, ufbxi_bake_job, bc->max_jobs);
+	ufbxi_check_err(&bc->error, bc->jobs);
+
 	ufbxi_check_err(&bc->error, ufbxi_bake_anim(bc));
 
 	ufbxi_init_ref(&bc->imp->refcount, UFBXI_BAKED_ANIM_IMP_MAGIC, NULL);
@@ -27052,6 +30852,236 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_imp(ufbxi_bake_context
 	return 1;
 }
 
+// -- Compact animation
+
+typedef struct {
+	ufbx_error error;
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	ufbxi_buf result;
+	ufbxi_buf tmp;
+
+	ufbx_compact_anim_opts opts;
+	const ufbx_baked_anim *bake;
+
+	// Uniform samples of the current track
+	ufbx_vec3 *vec3_samples;
+
+	// Quantized samples, allocated for the worst case of no constant tracks
+	uint16_t *data;
+	size_t num_data;
+
+	ufbx_compact_anim anim;
+	ufbxi_compact_anim_imp *imp;
+} ufbxi_compact_context;
+
+static ufbxi_forceinline double ufbxi_compact_sample_time(const ufbxi_compact_context *cc, size_t index)
+{
+	return cc->anim.time_begin + (double)index / cc->anim.sample_rate;
+}
+
+static ufbxi_forceinline uint16_t ufbxi_quantize_u16(ufbx_real value, ufbx_real min, ufbx_real scale)
+{
+	if (!(scale > 0.0f)) return 0;
+	double q = ufbx_rint((double)(value - min) / (double)scale);
+	if (!(q > 0.0)) return 0;
+	if (q >= 65535.0) return 65535;
+	return (uint16_t)q;
+}
+
+// Encode a rotation as the three smallest components of the quaternion with the
+// largest one being positive, allowing it to be reconstructed from the unit length.
+// The smallest components are in `[-1/sqrt(2), 1/sqrt(2)]` and quantized to 15 bits.
+static ufbxi_noinline void ufbxi_encode_smallest_three(uint16_t *dst, ufbx_quat q)
+{
+	uint32_t largest = 0;
+	for (uint32_t i = 1; i < 4; i++) {
+		if (ufbx_fabs(q.v[i]) > ufbx_fabs(q.v[largest])) largest = i;
+	}
+
+	double sign = q.v[largest] < 0.0f ? -1.0 : 1.0;
+	uint16_t values[3];
+	uint32_t num_values = 0;
+	for (uint32_t i = 0; i < 4; i++) {
+		if (i == largest) continue;
+		double v = (double)q.v[i] * sign * UFBXI_SQRT_2 * 0.5 + 0.5;
+		double v_q = ufbx_rint(v * 32767.0);
+		if (!(v_q > 0.0)) v_q = 0.0;
+		if (v_q > 32767.0) v_q = 32767.0;
+		values[num_values++] = (uint16_t)v_q;
+	}
+
+	dst[0] = (uint16_t)(values[0] | (largest >> 1) << 15);
+	dst[1] = (uint16_t)(values[1] | (largest & 1) << 15);
+	dst[2] = values[2];
+}
+
+static ufbxi_noinline void ufbxi_compact_vec3_track(ufbxi_compact_context *cc, ufbx_compact_vec3_track *dst, ufbx_baked_vec3_list keys, bool constant, ufbx_vec3 default_value)
+{
+	size_t num_samples = constant || keys.count <= 1 ? 1 : cc->anim.num_samples;
+	ufbx_vec3 *samples = cc->vec3_samples;
+
+	ufbx_vec3 min_v = { UFBX_INFINITY, UFBX_INFINITY, UFBX_INFINITY };
+	ufbx_vec3 max_v = { -UFBX_INFINITY, -UFBX_INFINITY, -UFBX_INFINITY };
+	for (size_t i = 0; i < num_samples; i++) {
+		ufbx_vec3 v = default_value;
+		if (keys.count > 0) {
+			v = ufbx_evaluate_baked_vec3(keys, ufbxi_compact_sample_time(cc, i));
+		}
+		samples[i] = v;
+		min_v.x = ufbxi_min_real(min_v.x, v.x);
+		min_v.y = ufbxi_min_real(min_v.y, v.y);
+		min_v.z = ufbxi_min_real(min_v.z, v.z);
+		max_v.x = ufbxi_max_real(max_v.x, v.x);
+		max_v.y = ufbxi_max_real(max_v.y, v.y);
+		max_v.z = ufbxi_max_real(max_v.z, v.z);
+	}
+
+	if (min_v.x == max_v.x && min_v.y == max_v.y && min_v.z == max_v.z) {
+		num_samples = 1;
+	}
+
+	dst->data_offset = (uint32_t)cc->num_data;
+	dst->num_samples = (uint32_t)num_samples;
+	dst->min = min_v;
+	dst->scale.x = (max_v.x - min_v.x) / (ufbx_real)65535.0;
+	dst->scale.y = (max_v.y - min_v.y) / (ufbx_real)65535.0;
+	dst->scale.z = (max_v.z - min_v.z) / (ufbx_real)65535.0;
+
+	uint16_t *data = cc->data + cc->num_data;
+	for (size_t i = 0; i < num_samples; i++) {
+		ufbx_vec3 v = samples[i];
+		data[i*3 + 0] = ufbxi_quantize_u16(v.x, dst->min.x, dst->scale.x);
+		data[i*3 + 1] = ufbxi_quantize_u16(v.y, dst->min.y, dst->scale.y);
+		data[i*3 + 2] = ufbxi_quantize_u16(v.z, dst->min.z, dst->scale.z);
+	}
+	cc->num_data += num_samples * 3;
+}
+
+static ufbxi_noinline void ufbxi_compact_quat_track(ufbxi_compact_context *cc, ufbx_compact_quat_track *dst, ufbx_baked_quat_list keys, bool constant)
+{
+	size_t num_samples = constant || keys.count <= 1 ? 1 : cc->anim.num_samples;
+
+	uint16_t *data = cc->data + cc->num_data;
+	bool all_equal = true;
+	for (size_t i = 0; i < num_samples; i++) {
+		ufbx_quat q = ufbx_identity_quat;
+		if (keys.count > 0) {
+			q = ufbx_evaluate_baked_quat(keys, ufbxi_compact_sample_time(cc, i));
+		}
+		ufbxi_encode_smallest_three(data + i*3, ufbx_quat_normalize(q));
+		if (i > 0 && memcmp(data + i*3, data, 3 * sizeof(uint16_t)) != 0) {
+			all_equal = false;
+		}
+	}
+
+	if (all_equal) {
+		num_samples = 1;
+	}
+
+	dst->data_offset = (uint32_t)cc->num_data;
+	dst->num_samples = (uint32_t)num_samples;
+	cc->num_data += num_samples * 3;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_compact_baked_anim_imp(ufbxi_compact_context *cc)
+{
+	const ufbx_baked_anim *bake = cc->bake;
+	if (cc->opts.sample_rate <= 0.0) cc->opts.sample_rate = 30.0;
+
+	ufbxi_init_ator(&cc->error, &cc->ator_tmp, &cc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&cc->error, &cc->ator_result, &cc->opts.result_allocator, "result");
+
+	cc->result.unordered = true;
+	cc->result.ator = &cc->ator_result;
+
+	cc->tmp.unordered = true;
+	cc->tmp.ator = &cc->ator_tmp;
+
+	double sample_rate = cc->opts.sample_rate;
+	size_t num_samples = 1;
+	if (bake->key_time_min < bake->key_time_max) {
+		// Don't add an extra sample due to rounding errors in the duration
+		double num_intervals = ufbx_ceil((bake->key_time_max - bake->key_time_min) * sample_rate - 0.001);
+		ufbxi_check_err_msg(&cc->error, num_intervals < (double)UINT32_MAX, "Too many samples");
+		num_samples = (size_t)num_intervals + 1;
+	}
+
+	cc->anim.sample_rate = sample_rate;
+	cc->anim.time_begin = bake->key_time_min;
+	cc->anim.time_end = bake->key_time_min + (double)(num_samples - 1) / sample_rate;
+	cc->anim.num_samples = num_samples;
+
+	size_t num_tracks = bake->nodes.count * 3;
+	ufbxi_for_list(ufbx_baked_element, elem, bake->elements) {
+		num_tracks += elem->props.count;
+	}
+
+	// Track offsets are stored as 32-bit integers
+	ufbxi_check_err_msg(&cc->error, num_tracks == 0 || num_samples <= UINT32_MAX / 3 / num_tracks, "Too many samples");
+	size_t max_data = num_tracks * num_samples * 3;
+
+	cc->data = ufbxi_push(&cc->tmp, uint16_t, max_data);
+	ufbxi_check_err(&cc->error, cc->data);
+	cc->vec3_samples = ufbxi_push(&cc->tmp, ufbx_vec3, num_samples);
+	ufbxi_check_err(&cc->error, cc->vec3_samples);
+
+	cc->anim.nodes.count = bake->nodes.count;
+	cc->anim.nodes.data = ufbxi_push_zero(&cc->result, ufbx_compact_node, bake->nodes.count);
+	ufbxi_check_err(&cc->error, cc->anim.nodes.data);
+
+	ufbx_vec3 zero = { 0.0f, 0.0f, 0.0f };
+	ufbx_vec3 one = { 1.0f, 1.0f, 1.0f };
+	for (size_t i = 0; i < bake->nodes.count; i++) {
+		const ufbx_baked_node *src = &bake->nodes.data[i];
+		ufbx_compact_node *dst = &cc->anim.nodes.data[i];
+		dst->typed_id = src->typed_id;
+		dst->element_id = src->element_id;
+		ufbxi_compact_vec3_track(cc, &dst->translation, src->translation_keys, src->constant_translation, zero);
+		ufbxi_compact_quat_track(cc, &dst->rotation, src->rotation_keys, src->constant_rotation);
+		ufbxi_compact_vec3_track(cc, &dst->scale, src->scale_keys, src->constant_scale, one);
+	}
+
+	cc->anim.elements.count = bake->elements.count;
+	cc->anim.elements.data = ufbxi_push_zero(&cc->result, ufbx_compact_element, bake->elements.count);
+	ufbxi_check_err(&cc->error, cc->anim.elements.data);
+
+	for (size_t i = 0; i < bake->elements.count; i++) {
+		const ufbx_baked_element *src = &bake->elements.data[i];
+		ufbx_compact_element *dst = &cc->anim.elements.data[i];
+		dst->element_id = src->element_id;
+		dst->props.count = src->props.count;
+		dst->props.data = ufbxi_push_zero(&cc->result, ufbx_compact_prop, src->props.count);
+		ufbxi_check_err(&cc->error, dst->props.data);
+
+		for (size_t j = 0; j < src->props.count; j++) {
+			const ufbx_baked_prop *src_prop = &src->props.data[j];
+			ufbx_compact_prop *dst_prop = &dst->props.data[j];
+			dst_prop->name.length = src_prop->name.length;
+			dst_prop->name.data = ufbxi_push_copy(&cc->result, char, src_prop->name.length + 1, src_prop->name.data);
+			ufbxi_check_err(&cc->error, dst_prop->name.data);
+			ufbxi_compact_vec3_track(cc, &dst_prop->value, src_prop->keys, src_prop->constant_value, zero);
+		}
+	}
+
+	cc->anim.data.count = cc->num_data;
+	cc->anim.data.data = ufbxi_push_copy(&cc->result, uint16_t, cc->num_data, cc->data);
+	ufbxi_check_err(&cc->error, cc->anim.data.data);
+
+	cc->imp = ufbxi_push(&cc->result, ufbxi_compact_anim_imp, 1);
+	ufbxi_check_err(&cc->error, cc->imp);
+
+	ufbxi_init_ref(&cc->imp->refcount, UFBXI_COMPACT_ANIM_IMP_MAGIC, NULL);
+
+	cc->imp->magic = UFBXI_COMPACT_ANIM_IMP_MAGIC;
+	cc->imp->anim = cc->anim;
+	cc->imp->refcount.ator = cc->ator_result;
+	cc->imp->refcount.buf = cc->result;
+
+	return 1;
+}
+
 #endif
 
 // -- NURBS
@@ -27975,6 +32005,285 @@ ufbxi_noinline static uint32_t ufbxi_triangulate_ngon(ufbxi_ngon_context *nc, ui
 	return num_triangles;
 }
 
+// Split a quad along the shortest diagonal unless a vertex crosses the diagonal.
+static ufbxi_forceinline void ufbxi_triangulate_quad(uint32_t *indices, const ufbx_mesh *mesh, uint32_t index_begin)
+{
+	uint32_t i0 = index_begin + 0;
+	uint32_t i1 = index_begin + 1;
+	uint32_t i2 = index_begin + 2;
+	uint32_t i3 = index_begin + 3;
+	ufbx_vec3 v0 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i0]];
+	ufbx_vec3 v1 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i1]];
+	ufbx_vec3 v2 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i2]];
+	ufbx_vec3 v3 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i3]];
+
+	ufbx_vec3 a = ufbxi_sub3(v2, v0);
+	ufbx_vec3 b = ufbxi_sub3(v3, v1);
+
+	ufbx_vec3 na1 = ufbxi_normalize3(ufbxi_cross3(a, ufbxi_sub3(v1, v0)));
+	ufbx_vec3 na3 = ufbxi_normalize3(ufbxi_cross3(a, ufbxi_sub3(v0, v3)));
+	ufbx_vec3 nb0 = ufbxi_normalize3(ufbxi_cross3(b, ufbxi_sub3(v1, v0)));
+	ufbx_vec3 nb2 = ufbxi_normalize3(ufbxi_cross3(b, ufbxi_sub3(v2, v1)));
+
+	ufbx_real dot_aa = ufbxi_dot3(a, a);
+	ufbx_real dot_bb = ufbxi_dot3(b, b);
+	ufbx_real dot_na = ufbxi_dot3(na1, na3);
+	ufbx_real dot_nb = ufbxi_dot3(nb0, nb2);
+
+	bool split_a = dot_aa <= dot_bb;
+
+	if (dot_na < 0.0f || dot_nb < 0.0f) {
+		split_a = dot_na >= dot_nb;
+	}
+
+	if (split_a) {
+		indices[0] = i0;
+		indices[1] = i1;
+		indices[2] = i2;
+		indices[3] = i2;
+		indices[4] = i3;
+		indices[5] = i0;
+	} else {
+		indices[0] = i1;
+		indices[1] = i2;
+		indices[2] = i3;
+		indices[3] = i3;
+		indices[4] = i0;
+		indices[5] = i1;
+	}
+}
+
+// Aim for roughly this many triangles per threaded triangulation task.
+#define UFBXI_TRIANGULATE_CHUNK_TRIANGLES 0x4000
+
+typedef struct {
+	const ufbx_mesh *mesh;
+	const uint32_t *face_indices; // < Optional indirection to `mesh->faces[]`
+	size_t face_begin, face_end;
+	uint32_t *indices;
+} ufbxi_triangulate_chunk;
+
+// Triangulate the faces `[face_begin, face_end)` of `chunk`.
+// The faces must have been validated beforehand and `chunk->indices` must have space
+// for exactly the triangles of the faces in the chunk.
+static ufbxi_noinline void ufbxi_triangulate_faces(const ufbxi_triangulate_chunk *chunk)
+{
+	const ufbx_mesh *mesh = chunk->mesh;
+	const ufbx_face *faces = mesh->faces.data;
+	const uint32_t *face_indices = chunk->face_indices;
+	uint32_t *dst = chunk->indices;
+
+	size_t ix = chunk->face_begin, end = chunk->face_end;
+	while (ix < end) {
+
+#if UFBXI_HAS_SSE
+		// Fast path: Expand runs of four triangles at once, `ufbx_face` is `{ index_begin, num_indices }`
+		if (!face_indices) {
+			const __m128i three = _mm_set1_epi32(3);
+			const __m128i offset0 = _mm_setr_epi32(0, 1, 2, 0);
+			const __m128i offset1 = _mm_setr_epi32(1, 2, 0, 1);
+			const __m128i offset2 = _mm_setr_epi32(2, 0, 1, 2);
+			while (end - ix >= 4) {
+				__m128 f01 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(faces + ix + 0)));
+				__m128 f23 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(faces + ix + 2)));
+				__m128i counts = _mm_castps_si128(_mm_shuffle_ps(f01, f23, _MM_SHUFFLE(3,1,3,1)));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(counts, three)) != 0xffff) break;
+
+				__m128i begins = _mm_castps_si128(_mm_shuffle_ps(f01, f23, _MM_SHUFFLE(2,0,2,0)));
+				_mm_storeu_si128((__m128i*)(dst + 0), _mm_add_epi32(_mm_shuffle_epi32(begins, _MM_SHUFFLE(1,0,0,0)), offset0));
+				_mm_storeu_si128((__m128i*)(dst + 4), _mm_add_epi32(_mm_shuffle_epi32(begins, _MM_SHUFFLE(2,2,1,1)), offset1));
+				_mm_storeu_si128((__m128i*)(dst + 8), _mm_add_epi32(_mm_shuffle_epi32(begins, _MM_SHUFFLE(3,3,3,2)), offset2));
+				dst += 12;
+				ix += 4;
+			}
+			if (ix == end) break;
+		}
+#endif
+
+		ufbx_face face = faces[face_indices ? face_indices[ix] : ix];
+		ix++;
+
+		if (face.num_indices == 3) {
+			dst[0] = face.index_begin + 0;
+			dst[1] = face.index_begin + 1;
+			dst[2] = face.index_begin + 2;
+			dst += 3;
+		} else if (face.num_indices == 4) {
+			ufbxi_triangulate_quad(dst, mesh, face.index_begin);
+			dst += 6;
+		} else if (face.num_indices > 4) {
+			ufbxi_ngon_context nc = { 0 };
+			nc.positions = mesh->vertex_position;
+			nc.face = face;
+
+			// `ufbxi_triangulate_ngon()` needs a bit of extra scratch space for pentagons
+			uint32_t num_ngon_indices = (face.num_indices - 2) * 3;
+			if (face.num_indices == 5) {
+				uint32_t local_indices[12]; // ufbxi_uninit
+				uint32_t num_tris = ufbxi_triangulate_ngon(&nc, local_indices, 12);
+				memcpy(dst, local_indices, num_tris * 3 * sizeof(uint32_t));
+			} else {
+				ufbxi_ignore(ufbxi_triangulate_ngon(&nc, dst, num_ngon_indices));
+			}
+			dst += num_ngon_indices;
+		}
+	}
+}
+
+static bool ufbxi_triangulate_task_fn(ufbxi_task *task)
+{
+	ufbxi_triangulate_faces((const ufbxi_triangulate_chunk*)task->data);
+	return true;
+}
+
+typedef struct {
+	const ufbx_mesh *mesh;
+	const uint32_t *face_indices;
+	size_t num_faces;
+
+	ufbx_error error;
+	ufbxi_allocator ator_tmp;
+	ufbxi_thread_pool thread_pool;
+	ufbx_triangulate_opts opts;
+
+	uint32_t *indices;
+	size_t num_indices;
+	size_t num_triangles;
+
+	ufbxi_triangulate_chunk *chunks;
+	size_t num_chunks;
+} ufbxi_mesh_triangulate_context;
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_triangulate_mesh_imp(ufbxi_mesh_triangulate_context *tc)
+{
+	const ufbx_mesh *mesh = tc->mesh;
+	const ufbx_face *faces = mesh->faces.data;
+	size_t num_faces = tc->num_faces;
+
+	ufbxi_init_ator(&tc->error, &tc->ator_tmp, &tc->opts.temp_allocator, "temp");
+
+	// Validate the faces up front so the triangulation itself can't fail
+	size_t num_triangles = 0;
+	for (size_t i = 0; i < num_faces; i++) {
+		size_t face_ix = i;
+		if (tc->face_indices) {
+			face_ix = tc->face_indices[i];
+			ufbxi_check_err_msg(&tc->error, face_ix < mesh->faces.count, "Face index out of bounds");
+		}
+		ufbx_face face = faces[face_ix];
+		ufbxi_check_err_msg(&tc->error, face.index_begin <= mesh->num_indices && mesh->num_indices - face.index_begin >= face.num_indices, "Face indices out of bounds");
+		if (face.num_indices >= 3) {
+			num_triangles += face.num_indices - 2;
+		}
+	}
+
+	ufbxi_check_err_msg(&tc->error, num_triangles <= tc->num_indices / 3, "Not enough space for triangle indices");
+	tc->num_triangles = num_triangles;
+
+	ufbxi_check_err(&tc->error, ufbxi_thread_pool_init(&tc->thread_pool, &tc->error, &tc->ator_tmp, &tc->opts.thread_opts));
+
+	ufbxi_triangulate_chunk whole = { 0 };
+	whole.mesh = mesh;
+	whole.face_indices = tc->face_indices;
+	whole.face_begin = 0;
+	whole.face_end = num_faces;
+	whole.indices = tc->indices;
+
+	size_t num_chunks = 1;
+	if (tc->thread_pool.enabled && num_triangles > UFBXI_TRIANGULATE_CHUNK_TRIANGLES) {
+		num_chunks = (num_triangles + UFBXI_TRIANGULATE_CHUNK_TRIANGLES - 1) / UFBXI_TRIANGULATE_CHUNK_TRIANGLES;
+		num_chunks = ufbxi_min_sz(num_chunks, ufbxi_thread_pool_available_tasks(&tc->thread_pool));
+	}
+
+	if (num_chunks <= 1) {
+		ufbxi_triangulate_faces(&whole);
+		return 1;
+	}
+
+	tc->chunks = ufbxi_alloc(&tc->ator_tmp, ufbxi_triangulate_chunk, num_chunks);
+	ufbxi_check_err(&tc->error, tc->chunks);
+	tc->num_chunks = num_chunks;
+
+	// Split the faces into chunks containing roughly the same number of triangles
+	size_t chunk_triangles = (num_triangles + num_chunks - 1) / num_chunks;
+	size_t chunk_ix = 0, chunk_begin = 0, triangle_begin = 0, triangle_count = 0;
+	for (size_t i = 0; i < num_faces; i++) {
+		ufbx_face face = faces[tc->face_indices ? tc->face_indices[i] : i];
+		if (face.num_indices >= 3) {
+			triangle_count += face.num_indices - 2;
+		}
+
+		bool last = i + 1 == num_faces;
+		if ((triangle_count - triangle_begin >= chunk_triangles && chunk_ix + 1 < num_chunks) || last) {
+			ufbxi_triangulate_chunk *chunk = &tc->chunks[chunk_ix++];
+			*chunk = whole;
+			chunk->face_begin = chunk_begin;
+			chunk->face_end = i + 1;
+			chunk->indices = tc->indices + triangle_begin * 3;
+			chunk_begin = i + 1;
+			triangle_begin = triangle_count;
+		}
+	}
+	ufbx_assert(triangle_count == num_triangles);
+
+	for (size_t i = 0; i < chunk_ix; i++) {
+		ufbxi_task *task = ufbxi_thread_pool_create_task(&tc->thread_pool, &ufbxi_triangulate_task_fn);
+		if (task) {
+			task->data = &tc->chunks[i];
+			ufbxi_thread_pool_run_task(&tc->thread_pool, task);
+		} else {
+			ufbxi_triangulate_faces(&tc->chunks[i]);
+		}
+	}
+
+	ufbxi_thread_pool_flush_group(&tc->thread_pool);
+	ufbxi_check_err(&tc->error, ufbxi_thread_pool_wait_all(&tc->thread_pool));
+
+	return 1;
+}
+
+ufbxi_noinline static size_t ufbxi_triangulate_mesh(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const uint32_t *face_indices, size_t num_faces, const ufbx_triangulate_opts *user_opts, ufbx_error *p_error)
+{
+	ufbxi_mesh_triangulate_context tc = { 0 };
+	if (user_opts) {
+		tc.opts = *user_opts;
+	}
+
+	tc.mesh = mesh;
+	tc.face_indices = face_indices;
+	tc.num_faces = num_faces;
+	tc.indices = indices;
+	tc.num_indices = num_indices;
+
+	int ok = ufbxi_triangulate_mesh_imp(&tc);
+
+	ufbxi_thread_pool_free(&tc.thread_pool);
+	ufbxi_free(&tc.ator_tmp, ufbxi_triangulate_chunk, tc.chunks, tc.num_chunks);
+	ufbxi_free_ator(&tc.ator_tmp);
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return tc.num_triangles;
+	} else {
+		ufbxi_fix_error_type(&tc.error, "Failed to triangulate", p_error);
+		return 0;
+	}
+}
+
+#else
+
+ufbxi_noinline static size_t ufbxi_triangulate_mesh(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const uint32_t *face_indices, size_t num_faces, const ufbx_triangulate_opts *user_opts, ufbx_error *p_error)
+{
+	if (p_error) {
+		memset(p_error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(p_error, "UFBX_ENABLE_TRIANGULATION");
+		ufbxi_report_err_msg(p_error, "UFBXI_FEATURE_TRIANGULATION", "Feature disabled");
+	}
+	return 0;
+}
+
 #endif
 
 static bool ufbxi_topo_less_index_prev_next(void *user, const void *va, const void *vb)
@@ -29368,160 +33677,560 @@ ufbxi_noinline static ufbx_mesh *ufbxi_subdivide_mesh(const ufbx_mesh *mesh, siz
 
 #endif
 
-// -- Utility
+// -- Embedded content
 
-#if UFBXI_FEATURE_INDEX_GENERATION
+// Incremental decoder for `UFBX_EMBEDDED_ENCODING_BASE64`, equivalent to calling
+// `ufbxi_decode_base64()` on each quoted string and concatenating the results.
+// Like in loading, content with any malformed string is discarded as a whole.
+typedef struct {
+	uint8_t table[256];
+
+	char *dst;
+	size_t dst_size;
+	size_t pos;
+	bool failed;
+
+	bool in_string;
+	uint32_t num_group;
+	uint32_t group[4];
+	uint32_t error_mask, pad_error;
+	uint64_t string_length;
+	char tail[4];
+} ufbxi_base64_decoder;
+
+static ufbxi_forceinline void ufbxi_base64_put(ufbxi_base64_decoder *dec, uint32_t value)
+{
+	if (dec->pos < dec->dst_size) dec->dst[dec->pos] = (char)(uint8_t)value;
+	dec->pos++;
+}
+
+static ufbxi_noinline void ufbxi_base64_decode_chunk(ufbxi_base64_decoder *dec, const char *src, size_t size)
+{
+	const char *end = src + size;
+	while (src != end) {
+		if (!dec->in_string) {
+			const char *quot = (const char*)memchr(src, '"', ufbxi_to_size(end - src));
+			if (!quot) break;
+			src = quot + 1;
+			dec->in_string = true;
+			dec->num_group = 0;
+			dec->error_mask = 0;
+			dec->pad_error = 0;
+			dec->string_length = 0;
+			continue;
+		}
 
-static int ufbxi_map_cmp_vertex(void *user, const void *va, const void *vb)
+		char c = *src++;
+		if (c == '"') {
+			if (dec->string_length >= 4) {
+				bool bad_padding = false;
+				dec->pos -= ufbxi_base64_padding(dec->tail, &bad_padding);
+				if (bad_padding) dec->pad_error |= 0x40;
+			}
+			if ((dec->error_mask & 0x80) != 0 || (dec->pad_error & 0x40) != 0 || dec->string_length % 4 != 0) {
+				dec->failed = true;
+			}
+			dec->in_string = false;
+			continue;
+		}
+
+		dec->tail[0] = dec->tail[1];
+		dec->tail[1] = dec->tail[2];
+		dec->tail[2] = dec->tail[3];
+		dec->tail[3] = c;
+		dec->string_length++;
+
+		dec->group[dec->num_group++] = dec->table[(size_t)(uint8_t)c];
+		if (dec->num_group == 4) {
+			uint32_t a = dec->group[0], b = dec->group[1], cc = dec->group[2], d = dec->group[3];
+			dec->pad_error = dec->error_mask;
+			dec->error_mask |= a | b | cc | d;
+			ufbxi_base64_put(dec, a << 2 | b >> 4);
+			ufbxi_base64_put(dec, b << 4 | cc >> 2);
+			ufbxi_base64_put(dec, cc << 6 | d);
+			dec->num_group = 0;
+		}
+	}
+}
+
+static ufbxi_noinline void ufbxi_base64_decoder_init(ufbxi_base64_decoder *dec, void *dst, size_t dst_size)
 {
-	size_t size = *(size_t*)user;
-#if defined(UFBX_REGRESSION)
-	ufbx_assert(size % 8 == 0);
-#endif
-	for (size_t i = 0; i < size; i += 8) {
-		uint64_t a = *(const uint64_t*)((const char*)va + i);
-		uint64_t b = *(const uint64_t*)((const char*)vb + i);
-		if (a != b) return a < b ? -1 : +1;
+	memset(dec, 0, sizeof(ufbxi_base64_decoder));
+	ufbxi_init_base64_table(dec->table);
+	dec->dst = (char*)dst;
+	dec->dst_size = dst_size;
+}
+
+static ufbxi_noinline bool ufbxi_skip_stream(ufbx_stream *stream, uint64_t offset)
+{
+	if (stream->skip_fn) {
+		while (offset > 0) {
+			size_t to_skip = (size_t)ufbxi_min64(offset, UFBXI_MAX_SKIP_SIZE);
+			if (!stream->skip_fn(stream->user, to_skip)) return false;
+			offset -= to_skip;
+		}
+	} else {
+		char buffer[4096]; // ufbxi_uninit
+		while (offset > 0) {
+			size_t to_skip = (size_t)ufbxi_min64(offset, sizeof(buffer));
+			size_t num_read = stream->read_fn(stream->user, buffer, to_skip);
+			if (num_read != to_skip) return false;
+			offset -= to_skip;
+		}
 	}
-	return 0;
+	return true;
 }
 
+// -- Utility
+
+#if UFBXI_FEATURE_INDEX_GENERATION
+
+// Pack vertices in tasks of this many vertices when using a thread pool.
+#define UFBXI_GENERATE_INDICES_CHUNK_SIZE 0x10000
+
+// Number of vertices to pack ahead of deduplication when not threaded.
+#define UFBXI_GENERATE_INDICES_BATCH_SIZE 64
+
 typedef struct {
-	char *begin, *ptr;
+	char *begin;
 	size_t vertex_size;
 	size_t packed_offset;
 } ufbxi_vertex_stream;
 
-static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *user_streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_allocator_opts *allocator, ufbx_error *error)
+typedef struct {
+	const ufbxi_vertex_stream *streams;
+	size_t num_streams;
+	size_t packed_size;
+	bool has_padding;
+	size_t begin, end;
+
+	// Destination for vertices `[begin, end)`
+	char *packed;
+	uint32_t *hashes;
+} ufbxi_pack_vertices_chunk;
+
+typedef struct {
+	ufbx_error error;
+	ufbxi_allocator ator;
+	ufbxi_thread_pool thread_pool;
+	ufbx_generate_indices_opts opts;
+
+	const ufbx_vertex_stream *user_streams;
+	size_t num_streams;
+	uint32_t *indices;
+	size_t num_indices;
+
+	ufbxi_vertex_stream local_streams[16];
+	ufbxi_vertex_stream *streams;
+	size_t packed_size;
+	bool has_padding;
+
+	// Packed unique vertices, grown with `slots[]` as the load factor limits `num_vertices`
+	char *vertices;
+	size_t num_vertices;
+	size_t vertex_capacity;
+
+	// Open addressing hash table of `vertices[]`, stores `hash << 32 | (index + 1)` or zero if empty.
+	// Grown based on the number of unique vertices to keep it dense in cache.
+	uint64_t *slots;
+	size_t num_slots;
+
+	// Vertices are packed to per-chunk scratch buffers of `chunk_size` vertices before deduplication
+	ufbxi_pack_vertices_chunk *chunks;
+	size_t num_chunks;
+	size_t chunk_size;
+} ufbxi_generate_indices_context;
+
+static ufbxi_forceinline void ufbxi_copy_vertex_data(char *dst, const char *src, size_t size)
 {
-	bool fail = false;
+	// Let the compiler expand the common attribute sizes into plain moves
+	switch (size) {
+	case 4: memcpy(dst, src, 4); break;
+	case 8: memcpy(dst, src, 8); break;
+	case 12: memcpy(dst, src, 12); break;
+	case 16: memcpy(dst, src, 16); break;
+	default: memcpy(dst, src, size); break;
+	}
+}
 
-	ufbxi_allocator ator = { 0 };
-	ufbxi_init_ator(error, &ator, allocator, "allocator");
+static ufbxi_forceinline void ufbxi_pack_vertex(char *dst, const ufbxi_vertex_stream *streams, size_t num_streams, size_t packed_size, bool has_padding, size_t index)
+{
+	if (has_padding) {
+		memset(dst, 0, packed_size);
+	}
+	for (size_t i = 0; i < num_streams; i++) {
+		size_t size = streams[i].vertex_size;
+		ufbxi_copy_vertex_data(dst + streams[i].packed_offset, streams[i].begin + index * size, size);
+	}
+}
+
+// Packed vertices are always aligned to and padded to a multiple of 8 bytes.
+static ufbxi_forceinline uint32_t ufbxi_hash_packed_vertex(const char *data, size_t size)
+{
+	uint64_t hash = size;
+	for (size_t i = 0; i < size; i += 8) {
+		uint64_t word = *(const uint64_t*)(data + i);
+		hash = ((hash << 27u | hash >> 37u) ^ word) * UINT64_C(0x9e3779b97f4a7c15);
+	}
+	return ufbxi_hash64(hash);
+}
 
-	ufbxi_vertex_stream local_streams[16]; // ufbxi_uninit
-	uint64_t local_packed_vertex[64]; // ufbxi_uninit
+static ufbxi_forceinline bool ufbxi_packed_vertex_equal(const char *a, const char *b, size_t size)
+{
+	size_t i = 0;
+#if UFBXI_HAS_SSE
+	for (; i + 16 <= size; i += 16) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff) return false;
+	}
+#endif
+	for (; i < size; i += 8) {
+		if (*(const uint64_t*)(a + i) != *(const uint64_t*)(b + i)) return false;
+	}
+	return true;
+}
 
-	ufbxi_vertex_stream *streams = NULL;
-	if (num_streams > ufbxi_arraycount(local_streams)) {
-		streams = ufbxi_alloc(&ator, ufbxi_vertex_stream, num_streams);
-		if (!streams) fail = true;
-	} else {
-		streams = local_streams;
+static ufbxi_noinline void ufbxi_pack_vertices(const ufbxi_pack_vertices_chunk *chunk)
+{
+	size_t packed_size = chunk->packed_size;
+	char *dst = chunk->packed;
+	uint32_t *hashes = chunk->hashes;
+	for (size_t i = chunk->begin; i < chunk->end; i++) {
+		ufbxi_pack_vertex(dst, chunk->streams, chunk->num_streams, packed_size, chunk->has_padding, i);
+		*hashes++ = ufbxi_hash_packed_vertex(dst, packed_size);
+		dst += packed_size;
 	}
+}
 
-	size_t packed_size = 0;
-	if (!fail) {
-		for (size_t i = 0; i < num_streams; i++) {
-			if (user_streams[i].vertex_count < num_indices) {
-				ufbxi_fmt_err_info(error, "%zu", i);
-				ufbxi_report_err_msg(error, "user_streams[i].vertex_count < num_indices", "Truncated vertex stream");
-				fail = true;
-				break;
-			}
+static bool ufbxi_pack_vertices_task_fn(ufbxi_task *task)
+{
+	ufbxi_pack_vertices((const ufbxi_pack_vertices_chunk*)task->data);
+	return true;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_grow_vertex_slots(ufbxi_generate_indices_context *ic)
+{
+	size_t num_slots = ic->num_slots * 2;
+
+	// The load factor limits the number of unique vertices so grow them alongside the table
+	size_t num_words = ic->packed_size / 8;
+	char *vertices = (char*)ufbxi_alloc(&ic->ator, uint64_t, num_slots / 2 * num_words);
+	ufbxi_check_err(&ic->error, vertices);
+	memcpy(vertices, ic->vertices, ic->num_vertices * ic->packed_size);
+	ufbxi_free(&ic->ator, uint64_t, ic->vertices, ic->vertex_capacity * num_words);
+	ic->vertices = vertices;
+	ic->vertex_capacity = num_slots / 2;
+
+	uint64_t *slots = ufbxi_alloc(&ic->ator, uint64_t, num_slots);
+	ufbxi_check_err(&ic->error, slots);
+	memset(slots, 0, num_slots * sizeof(uint64_t));
+
+	// Entries store their hash so they can be re-inserted without the vertex data
+	size_t mask = num_slots - 1;
+	for (size_t i = 0; i < ic->num_slots; i++) {
+		uint64_t entry = ic->slots[i];
+		if (entry == 0) continue;
+		size_t slot = (uint32_t)(entry >> 32u) & mask;
+		while (slots[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		slots[slot] = entry;
+	}
+
+	ufbxi_free(&ic->ator, uint64_t, ic->slots, ic->num_slots);
+	ic->slots = slots;
+	ic->num_slots = num_slots;
+	return 1;
+}
 
-			size_t vertex_size = user_streams[i].vertex_size;
-			size_t align = ufbxi_size_align_mask(vertex_size);
-			packed_size = ufbxi_align_to_mask(packed_size, align);
-			streams[i].ptr = streams[i].begin = (char*)user_streams[i].data;
-			streams[i].vertex_size = vertex_size;
-			streams[i].packed_offset = packed_size;
-			packed_size += vertex_size;
+// Find the index of a packed `vertex` or insert it to the end of `vertices[]`.
+static ufbxi_forceinline int ufbxi_insert_packed_vertex(ufbxi_generate_indices_context *ic, uint32_t *p_index, const char *vertex, uint32_t hash)
+{
+	size_t packed_size = ic->packed_size;
+	size_t mask = ic->num_slots - 1;
+	size_t slot = hash & mask;
+	for (;;) {
+		uint64_t entry = ic->slots[slot];
+		if (entry == 0) break;
+		if ((uint32_t)(entry >> 32u) == hash) {
+			uint32_t index = (uint32_t)entry - 1;
+			if (ufbxi_packed_vertex_equal(ic->vertices + index * packed_size, vertex, packed_size)) {
+				*p_index = index;
+				return 1;
+			}
 		}
-		packed_size = ufbxi_align_to_mask(packed_size, 7);
+		slot = (slot + 1) & mask;
+	}
+
+	uint32_t index = (uint32_t)ic->num_vertices++;
+	memcpy(ic->vertices + index * packed_size, vertex, packed_size);
+	ic->slots[slot] = (uint64_t)hash << 32u | (uint64_t)(index + 1);
+	*p_index = index;
+
+	// Keep the load factor below 50%
+	if (ic->num_vertices * 2 >= ic->num_slots) {
+		ufbxi_check_err(&ic->error, ufbxi_grow_vertex_slots(ic));
 	}
+	return 1;
+}
 
-	if (!fail && packed_size == 0) {
-		ufbxi_report_err_msg(error, "packed_size != 0", "Zero vertex size");
-		fail = true;
+// Deduplicate the packed vertices of `chunk`, writing their indices to `ufbxi_generate_indices_context.indices`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_deduplicate_packed_vertices(ufbxi_generate_indices_context *ic, const ufbxi_pack_vertices_chunk *chunk)
+{
+	size_t packed_size = ic->packed_size;
+	size_t count = chunk->end - chunk->begin;
+	uint32_t *indices = ic->indices + chunk->begin;
+	const uint32_t *hashes = chunk->hashes;
+	const char *vertex = chunk->packed;
+
+	// Prefetch the hash table slots a few vertices ahead to hide cache misses
+	size_t prefetch_count = ufbxi_min_sz(count, 8);
+	for (size_t i = 0; i < prefetch_count; i++) {
+		ufbxi_prefetch(ic->slots + (hashes[i] & (ic->num_slots - 1)));
 	}
 
-	char *packed_vertex = NULL;
-	if (!fail) {
-		if (packed_size > sizeof(local_packed_vertex)) {
-			ufbx_assert(packed_size % 8 == 0);
-			packed_vertex = (char*)ufbxi_alloc(&ator, uint64_t, packed_size / 8);
-			if (!packed_vertex) fail = true;
-		} else {
-			packed_vertex = (char*)local_packed_vertex;
+	for (size_t i = 0; i < count; i++) {
+		if (i + 8 < count) {
+			ufbxi_prefetch(ic->slots + (hashes[i + 8] & (ic->num_slots - 1)));
 		}
+		ufbxi_check_err(&ic->error, ufbxi_insert_packed_vertex(ic, &indices[i], vertex, hashes[i]));
+		vertex += packed_size;
 	}
 
-	ufbxi_map map = { 0 };
-	ufbxi_map_init(&map, &ator, &ufbxi_map_cmp_vertex, &packed_size);
+	return 1;
+}
+
+// Allocate `num_chunks` chunks with scratch buffers for `chunk_size` packed vertices.
+// Scratch buffers are allocated on first use with `ufbxi_alloc_pack_chunk()`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_init_pack_chunks(ufbxi_generate_indices_context *ic, size_t num_chunks, size_t chunk_size)
+{
+	ic->chunks = ufbxi_alloc(&ic->ator, ufbxi_pack_vertices_chunk, num_chunks);
+	ufbxi_check_err(&ic->error, ic->chunks);
+	memset(ic->chunks, 0, num_chunks * sizeof(ufbxi_pack_vertices_chunk));
+	ic->num_chunks = num_chunks;
+	ic->chunk_size = chunk_size;
 
-	if (num_indices > 0 && !ufbxi_map_grow_size(&map, packed_size, num_indices)) {
-		fail = true;
+	for (size_t i = 0; i < num_chunks; i++) {
+		ufbxi_pack_vertices_chunk *chunk = &ic->chunks[i];
+		chunk->streams = ic->streams;
+		chunk->num_streams = ic->num_streams;
+		chunk->packed_size = ic->packed_size;
+		chunk->has_padding = ic->has_padding;
 	}
+	return 1;
+}
 
-	if (!fail) {
-		ufbx_assert(packed_vertex != NULL);
-		memset(packed_vertex, 0, packed_size);
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_alloc_pack_chunk(ufbxi_generate_indices_context *ic, ufbxi_pack_vertices_chunk *chunk)
+{
+	if (chunk->packed) return 1;
+	chunk->packed = (char*)ufbxi_alloc(&ic->ator, uint64_t, ic->chunk_size * (ic->packed_size / 8));
+	ufbxi_check_err(&ic->error, chunk->packed);
+	chunk->hashes = ufbxi_alloc(&ic->ator, uint32_t, ic->chunk_size);
+	ufbxi_check_err(&ic->error, chunk->hashes);
+	return 1;
+}
 
-		for (size_t i = 0; i < num_indices; i++) {
-			for (size_t si = 0; si < num_streams; si++) {
-				size_t size = streams[si].vertex_size, offset = streams[si].packed_offset;
-				char *ptr = streams[si].ptr;
-				memcpy(packed_vertex + offset, ptr, size);
-				streams[si].ptr = ptr + size;
-			}
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_generate_indices_threaded(ufbxi_generate_indices_context *ic)
+{
+	size_t num_indices = ic->num_indices;
+	size_t chunk_size = UFBXI_GENERATE_INDICES_CHUNK_SIZE;
 
-			uint32_t hash = ufbxi_hash_string(packed_vertex, packed_size);
-			void *entry = ufbxi_map_find_size(&map, packed_size, hash, packed_vertex);
-			if (!entry) {
-				entry = ufbxi_map_insert_size(&map, packed_size, hash, packed_vertex);
-				if (!entry) {
-					fail = true;
-					break;
-				}
-				memcpy(entry, packed_vertex, packed_size);
+	// Limit the packed vertices in flight per group by `ufbx_thread_opts.memory_limit`
+	size_t max_memory = ic->opts.thread_opts.memory_limit / UFBX_THREAD_GROUP_COUNT;
+	size_t max_chunks = max_memory / (chunk_size * (ic->packed_size + sizeof(uint32_t)));
+	max_chunks = ufbxi_min_sz(max_chunks, ic->thread_pool.num_tasks / UFBX_THREAD_GROUP_COUNT);
+	max_chunks = ufbxi_min_sz(max_chunks, (num_indices + chunk_size - 1) / chunk_size);
+	max_chunks = ufbxi_max_sz(max_chunks, 1);
+
+	ufbxi_check_err(&ic->error, ufbxi_init_pack_chunks(ic, max_chunks * UFBX_THREAD_GROUP_COUNT, chunk_size));
+
+	// Pack and hash batches of chunks in parallel, each batch is deduplicated once its
+	// group has finished while the following groups are still being packed.
+	size_t batch_chunks[UFBX_THREAD_GROUP_COUNT] = { 0 };
+	size_t begin = 0, empty_count = 0, batch_index = 0;
+	while (empty_count < UFBX_THREAD_GROUP_COUNT) {
+		ufbxi_pack_vertices_chunk *chunks = ic->chunks + batch_index * max_chunks;
+
+		ufbxi_check_err(&ic->error, ufbxi_thread_pool_wait_group(&ic->thread_pool));
+
+		// Deduplication is inherently serial
+		for (size_t i = 0; i < batch_chunks[batch_index]; i++) {
+			ufbxi_check_err(&ic->error, ufbxi_deduplicate_packed_vertices(ic, &chunks[i]));
+		}
+
+		size_t num_chunks = 0;
+		for (; num_chunks < max_chunks && begin < num_indices; num_chunks++) {
+			ufbxi_pack_vertices_chunk *chunk = &chunks[num_chunks];
+			ufbxi_check_err(&ic->error, ufbxi_alloc_pack_chunk(ic, chunk));
+			chunk->begin = begin;
+			chunk->end = ufbxi_min_sz(begin + chunk_size, num_indices);
+			begin = chunk->end;
+
+			ufbxi_task *task = ufbxi_thread_pool_create_task(&ic->thread_pool, &ufbxi_pack_vertices_task_fn);
+			if (task) {
+				task->data = chunk;
+				ufbxi_thread_pool_run_task(&ic->thread_pool, task);
+			} else {
+				ufbxi_pack_vertices(chunk);
 			}
-			uint32_t index = (uint32_t)(ufbxi_to_size((char*)entry - (char*)map.items) / packed_size);
-			indices[i] = index;
 		}
+		batch_chunks[batch_index] = num_chunks;
+
+		ufbxi_thread_pool_flush_group(&ic->thread_pool);
+
+		if (num_chunks == 0) {
+			empty_count += 1;
+		}
+
+		batch_index = (batch_index + 1) % UFBX_THREAD_GROUP_COUNT;
 	}
 
-	size_t result_vertices = 0;
-	if (!fail) {
-		result_vertices = map.size;
+	ufbxi_check_err(&ic->error, ufbxi_thread_pool_wait_all(&ic->thread_pool));
 
-		for (size_t si = 0; si < num_streams; si++) {
-			size_t vertex_size = streams[si].vertex_size;
-			char *dst = streams[si].begin;
-			char *src = ufbxi_add_ptr((char*)map.items, streams[si].packed_offset);
-			for (size_t i = 0; i < result_vertices; i++) {
-				memcpy(dst, src, vertex_size);
-				dst += vertex_size;
-				src += packed_size;
-			}
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_generate_indices_imp(ufbxi_generate_indices_context *ic)
+{
+	size_t num_streams = ic->num_streams;
+	size_t num_indices = ic->num_indices;
+
+	ufbxi_init_ator(&ic->error, &ic->ator, &ic->opts.temp_allocator, "allocator");
+
+	if (num_streams > ufbxi_arraycount(ic->local_streams)) {
+		ic->streams = ufbxi_alloc(&ic->ator, ufbxi_vertex_stream, num_streams);
+		ufbxi_check_err(&ic->error, ic->streams);
+	} else {
+		ic->streams = ic->local_streams;
+	}
+
+	size_t packed_size = 0, data_size = 0;
+	for (size_t i = 0; i < num_streams; i++) {
+		const ufbx_vertex_stream *user_stream = &ic->user_streams[i];
+		if (user_stream->vertex_count < num_indices) {
+			ufbxi_fmt_err_info(&ic->error, "%zu", i);
+			ufbxi_fail_err_msg(&ic->error, "user_streams[i].vertex_count < num_indices", "Truncated vertex stream");
 		}
 
-		ufbxi_clear_error(error);
+		size_t vertex_size = user_stream->vertex_size;
+		size_t align = ufbxi_size_align_mask(vertex_size);
+		packed_size = ufbxi_align_to_mask(packed_size, align);
+		ic->streams[i].begin = (char*)user_stream->data;
+		ic->streams[i].vertex_size = vertex_size;
+		ic->streams[i].packed_offset = packed_size;
+		packed_size += vertex_size;
+		data_size += vertex_size;
+	}
+	packed_size = ufbxi_align_to_mask(packed_size, 7);
+	ufbxi_check_err_msg(&ic->error, packed_size != 0, "Zero vertex size");
+
+	ic->packed_size = packed_size;
+	ic->has_padding = data_size != packed_size;
+	if (num_indices == 0) return 1;
+
+	ufbxi_check_err_msg(&ic->error, num_indices < UINT32_MAX, "Too many indices");
+	ufbxi_check_err_msg(&ic->error, num_indices <= SIZE_MAX / packed_size, "Too many indices");
+
+	ic->slots = ufbxi_alloc(&ic->ator, uint64_t, 64);
+	ufbxi_check_err(&ic->error, ic->slots);
+	ic->num_slots = 64;
+	memset(ic->slots, 0, ic->num_slots * sizeof(uint64_t));
+	ic->vertices = (char*)ufbxi_alloc(&ic->ator, uint64_t, ic->num_slots / 2 * (packed_size / 8));
+	ufbxi_check_err(&ic->error, ic->vertices);
+	ic->vertex_capacity = ic->num_slots / 2;
+
+	if (!ic->opts.thread_opts.memory_limit) {
+		ic->opts.thread_opts.memory_limit = 32*1024*1024;
+	}
+
+	ufbxi_check_err(&ic->error, ufbxi_thread_pool_init(&ic->thread_pool, &ic->error, &ic->ator, &ic->opts.thread_opts));
+
+	if (ic->thread_pool.enabled && num_indices > UFBXI_GENERATE_INDICES_CHUNK_SIZE) {
+		ufbxi_check_err(&ic->error, ufbxi_generate_indices_threaded(ic));
 	} else {
-		ufbxi_fix_error_type(error, "Failed to generate indices", NULL);
+		// Pack small batches of vertices ahead of deduplication to hide hash table latency
+		ufbxi_check_err(&ic->error, ufbxi_init_pack_chunks(ic, 1, UFBXI_GENERATE_INDICES_BATCH_SIZE));
+		ufbxi_pack_vertices_chunk *chunk = &ic->chunks[0];
+		ufbxi_check_err(&ic->error, ufbxi_alloc_pack_chunk(ic, chunk));
+		for (size_t begin = 0; begin < num_indices; begin += UFBXI_GENERATE_INDICES_BATCH_SIZE) {
+			chunk->begin = begin;
+			chunk->end = ufbxi_min_sz(begin + UFBXI_GENERATE_INDICES_BATCH_SIZE, num_indices);
+			ufbxi_pack_vertices(chunk);
+			ufbxi_check_err(&ic->error, ufbxi_deduplicate_packed_vertices(ic, chunk));
+		}
 	}
 
-	if (streams && streams != local_streams) {
-		ufbxi_free(&ator, ufbxi_vertex_stream, streams, num_streams);
+	// Write the unique vertices back to the streams
+	size_t num_vertices = ic->num_vertices;
+	for (size_t si = 0; si < num_streams; si++) {
+		size_t vertex_size = ic->streams[si].vertex_size;
+		char *dst = ic->streams[si].begin;
+		const char *src = ic->vertices + ic->streams[si].packed_offset;
+		for (size_t i = 0; i < num_vertices; i++) {
+			ufbxi_copy_vertex_data(dst, src, vertex_size);
+			dst += vertex_size;
+			src += packed_size;
+		}
 	}
-	if (packed_vertex && packed_vertex != (char*)local_packed_vertex) {
-		ufbxi_free(&ator, uint64_t, packed_vertex, packed_size / 8);
+
+	return 1;
+}
+
+static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *user_streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_generate_indices_opts *user_opts, ufbx_error *p_error)
+{
+	ufbxi_generate_indices_context ic; // ufbxi_uninit
+	memset(&ic, 0, sizeof(ic));
+	if (user_opts) {
+		ic.opts = *user_opts;
 	}
 
-	ufbxi_map_free(&map);
-	ufbxi_free_ator(&ator);
+	ic.user_streams = user_streams;
+	ic.num_streams = num_streams;
+	ic.indices = indices;
+	ic.num_indices = num_indices;
+
+	int ok = ufbxi_generate_indices_imp(&ic);
+
+	ufbxi_thread_pool_free(&ic.thread_pool);
+	if (ic.streams && ic.streams != ic.local_streams) {
+		ufbxi_free(&ic.ator, ufbxi_vertex_stream, ic.streams, num_streams);
+	}
+	if (ic.vertices) {
+		ufbxi_free(&ic.ator, uint64_t, ic.vertices, ic.vertex_capacity * (ic.packed_size / 8));
+	}
+	ufbxi_free(&ic.ator, uint64_t, ic.slots, ic.num_slots);
+	for (size_t i = 0; i < ic.num_chunks; i++) {
+		ufbxi_pack_vertices_chunk *chunk = &ic.chunks[i];
+		if (chunk->packed) {
+			ufbxi_free(&ic.ator, uint64_t, chunk->packed, ic.chunk_size * (ic.packed_size / 8));
+		}
+		if (chunk->hashes) {
+			ufbxi_free(&ic.ator, uint32_t, chunk->hashes, ic.chunk_size);
+		}
+	}
+	ufbxi_free(&ic.ator, ufbxi_pack_vertices_chunk, ic.chunks, ic.num_chunks);
+	ufbxi_free_ator(&ic.ator);
 
-	return result_vertices;
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return ic.num_vertices;
+	} else {
+		ufbxi_fix_error_type(&ic.error, "Failed to generate indices", p_error);
+		return 0;
+	}
 }
 
 #else
 
-static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *user_streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_allocator_opts *allocator, ufbx_error *error)
+static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *user_streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_generate_indices_opts *user_opts, ufbx_error *p_error)
 {
-	if (error) {
-		memset(error, 0, sizeof(ufbx_error));
-		ufbxi_fmt_err_info(error, "UFBX_ENABLE_INDEX_GENERATION");
-		ufbxi_report_err_msg(error, "UFBXI_FEATURE_INDEX_GENERATION", "Feature disabled");
+	if (p_error) {
+		memset(p_error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(p_error, "UFBX_ENABLE_INDEX_GENERATION");
+		ufbxi_report_err_msg(p_error, "UFBXI_FEATURE_INDEX_GENERATION", "Feature disabled");
 	}
 	return 0;
 }
@@ -30123,71 +34832,58 @@ ufbx_abi ufbx_real ufbx_evaluate_curve(const ufbx_anim_curve *curve, double time
 		}
 	}
 
-	size_t begin = 0;
-	size_t end = curve->keyframes.count;
-	const ufbx_keyframe *keys = curve->keyframes.data;
-	while (end - begin >= 8) {
-		size_t mid = (begin + end) >> 1;
-		if (keys[mid].time <= time) {
-			begin = mid + 1;
-		} else {
-			end = mid;
-		}
-	}
-
-	end = curve->keyframes.count;
-	for (; begin < end; begin++) {
-		const ufbx_keyframe *next = &keys[begin];
-		if (next->time <= time) continue;
-
-		// First keyframe
-		if (begin == 0) return next->value;
-
-		const ufbx_keyframe *prev = next - 1;
-
-		// Exact keyframe
-		if (prev->time == time) return prev->value;
-
-		double rcp_delta = 1.0 / (next->time - prev->time);
-		double t = (time - prev->time) * rcp_delta;
+	size_t index = ufbxi_search_curve_key(curve->keyframes.data, 0, curve->keyframes.count, time);
+	return ufbxi_evaluate_curve_key(curve, index, time);
+}
 
-		switch (prev->interpolation) {
+ufbx_abi void ufbx_evaluate_curves(const ufbx_anim_curve *const *curves, ufbx_real *values, size_t count, double time, ufbx_real default_value)
+{
+	ufbxi_bezier_batch batch; // ufbxi_uninit
+	batch.count = 0;
 
-		case UFBX_INTERPOLATION_CONSTANT_PREV:
-			return prev->value;
+	for (size_t i = 0; i < count; i++) {
+		const ufbx_anim_curve *curve = curves[i];
+		if (!curve || curve->keyframes.count <= 1) {
+			values[i] = ufbx_evaluate_curve(curve, time, default_value);
+			continue;
+		}
 
-		case UFBX_INTERPOLATION_CONSTANT_NEXT:
-			return next->value;
+		size_t index = ufbxi_find_curve_key(curve->keyframes.data, 0, curve->keyframes.count, time);
+		ufbxi_evaluate_curve_segment(&batch, curve, index, time, &values[i]);
+	}
 
-		case UFBX_INTERPOLATION_LINEAR:
-			return (ufbx_real)(prev->value*(1.0 - t) + next->value*t);
+	ufbxi_flush_bezier_batch(&batch);
+}
 
-		case UFBX_INTERPOLATION_CUBIC:
-		{
-			double x1 = prev->right.dx * rcp_delta;
-			double x2 = 1.0 - next->left.dx * rcp_delta;
-			t = ufbxi_find_cubic_bezier_t(x1, x2, t);
+ufbx_abi void ufbx_evaluate_curve_times(const ufbx_anim_curve *curve, const double *times, ufbx_real *values, size_t count, ufbx_real default_value)
+{
+	if (!curve || curve->keyframes.count <= 1) {
+		ufbx_real value = ufbx_evaluate_curve(curve, 0.0, default_value);
+		for (size_t i = 0; i < count; i++) {
+			values[i] = value;
+		}
+		return;
+	}
 
-			double t2 = t*t, t3 = t2*t;
-			double u = 1.0 - t, u2 = u*u, u3 = u2*u;
+	ufbxi_bezier_batch batch; // ufbxi_uninit
+	batch.count = 0;
 
-			double y0 = prev->value;
-			double y3 = next->value;
-			double y1 = y0 + prev->right.dy;
-			double y2 = y3 - next->left.dy;
+	const ufbx_keyframe *keys = curve->keyframes.data;
+	size_t num_keys = curve->keyframes.count;
 
-			return (ufbx_real)(u3*y0 + 3.0 * (u2*t*y1 + u*t2*y2) + t3*y3);
+	// Continue searching from the previous keyframe if `times` is increasing
+	size_t index = 0;
+	for (size_t i = 0; i < count; i++) {
+		double time = times[i];
+		if (index > 0 && keys[index - 1].time > time) {
+			index = 0;
 		}
 
-		default:
-			ufbxi_unreachable("Bad interpolation mode");
-			return 0.0f;
-
-		}
+		index = ufbxi_find_curve_key(keys, index, num_keys, time);
+		ufbxi_evaluate_curve_segment(&batch, curve, index, time, &values[i]);
 	}
 
-	// Last keyframe
-	return curve->keyframes.data[curve->keyframes.count - 1].value;
+	ufbxi_flush_bezier_batch(&batch);
 }
 
 ufbx_abi ufbxi_noinline ufbx_real ufbx_evaluate_anim_value_real(const ufbx_anim_value *anim_value, double time)
@@ -30245,38 +34941,14 @@ ufbx_abi ufbxi_noinline ufbx_prop ufbx_evaluate_prop_len(const ufbx_anim *anim,
 		ufbxi_evaluate_connected_prop(&result, anim, element, prop->name.data, time);
 	}
 
-	ufbxi_evaluate_props(anim, element, time, &result, 1);
+	ufbxi_evaluate_props(ufbxi_get_anim_cursor(anim), anim, element, time, &result, 1);
 
 	return result;
 }
 
 ufbx_abi ufbxi_noinline ufbx_props ufbx_evaluate_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *buffer, size_t buffer_size)
 {
-	ufbx_props ret = { NULL };
-	if (!element) return ret;
-
-	size_t num_anim = 0;
-	ufbxi_prop_iter iter; // ufbxi_uninit
-	ufbxi_init_prop_iter(&iter, anim, element);
-	const ufbx_prop *prop = NULL;
-	while ((prop = ufbxi_next_prop(&iter)) != NULL) {
-		if (!(prop->flags & (UFBX_PROP_FLAG_ANIMATED|UFBX_PROP_FLAG_OVERRIDDEN|UFBX_PROP_FLAG_CONNECTED))) continue;
-		if (num_anim >= buffer_size) break;
-
-		ufbx_prop *dst = &buffer[num_anim++];
-		*dst = *prop;
-
-		if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) {
-			ufbxi_evaluate_connected_prop(dst, anim, element, prop->name.data, time);
-		}
-	}
-
-	ufbxi_evaluate_props(anim, element, time, buffer, num_anim);
-
-	ret.props.data = buffer;
-	ret.props.count = ret.num_animated = num_anim;
-	ret.defaults = (ufbx_props*)&element->props;
-	return ret;
+	return ufbxi_evaluate_element_props(ufbxi_get_anim_cursor(anim), anim, element, time, buffer, buffer_size);
 }
 
 ufbx_abi ufbxi_noinline ufbx_transform ufbx_evaluate_transform(const ufbx_anim *anim, const ufbx_node *node, double time)
@@ -30438,6 +35110,154 @@ ufbx_abi ufbx_scene *ufbx_evaluate_scene(const ufbx_scene *scene, const ufbx_ani
 #endif
 }
 
+ufbx_abi bool ufbx_evaluate_scene_in_place(ufbx_scene *state, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_return(false, opts, error);
+	ufbx_assert(state);
+#if UFBXI_FEATURE_SCENE_EVALUATION
+	ufbxi_eval_context ec = { 0 };
+	return ufbxi_evaluate_scene_in_place(&ec, state, anim, time, opts, error);
+#else
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_SCENE_EVALUATION");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_SCENE_EVALUATION", "Feature disabled");
+	}
+	return false;
+#endif
+}
+
+ufbx_abi ufbx_evaluate_cache *ufbx_create_evaluate_cache(const ufbx_scene *scene, const ufbx_evaluate_cache_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_evaluate_cache, opts, error);
+	ufbx_assert(scene);
+
+	ufbx_evaluate_cache_opts cache_opts; // ufbxi_uninit
+	if (opts) {
+		cache_opts = *opts;
+	} else {
+		memset(&cache_opts, 0, sizeof(cache_opts));
+	}
+
+	ufbxi_evaluate_cache_context cc = { UFBX_ERROR_NONE };
+	cc.scene = scene;
+	ufbxi_init_ator(&cc.error, &cc.ator_tmp, &cache_opts.temp_allocator, "temp");
+	ufbxi_init_ator(&cc.error, &cc.ator_result, &cache_opts.result_allocator, "result");
+	cc.result.ator = &cc.ator_result;
+	cc.tmp.ator = &cc.ator_tmp;
+
+	int ok = ufbxi_create_evaluate_cache_imp(&cc);
+
+	ufbxi_buf_free(&cc.tmp);
+	ufbxi_free_ator(&cc.ator_tmp);
+
+	if (ok) {
+		if (error) {
+			ufbxi_clear_error(error);
+		}
+		return &cc.imp->cache;
+	} else {
+		ufbxi_fix_error_type(&cc.error, "Failed to create evaluate cache", error);
+		ufbxi_buf_free(&cc.result);
+		ufbxi_free_ator(&cc.ator_result);
+		return NULL;
+	}
+}
+
+ufbx_abi void ufbx_free_evaluate_cache(ufbx_evaluate_cache *cache)
+{
+	if (!cache) return;
+
+	ufbxi_evaluate_cache_imp *imp = (ufbxi_evaluate_cache_imp*)cache;
+	ufbx_assert(imp->magic == UFBXI_EVALUATE_CACHE_IMP_MAGIC);
+	if (imp->magic != UFBXI_EVALUATE_CACHE_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	ufbxi_free_evaluate_cache_imp(imp);
+}
+
+ufbx_abi ufbx_anim_cursor *ufbx_create_anim_cursor(const ufbx_scene *scene, const ufbx_anim *anim, const ufbx_anim_cursor_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_anim_cursor, opts, error);
+	ufbx_assert(scene);
+	if (!anim) anim = scene->anim;
+
+	ufbx_anim_cursor_opts cursor_opts; // ufbxi_uninit
+	if (opts) {
+		cursor_opts = *opts;
+	} else {
+		memset(&cursor_opts, 0, sizeof(cursor_opts));
+	}
+
+	ufbx_error err = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(&err, &ator, &cursor_opts.allocator, "cursor");
+
+	size_t num_curves = scene->anim_curves.count;
+	ufbxi_anim_cursor_imp *imp = ufbxi_alloc(&ator, ufbxi_anim_cursor_imp, 1);
+	uint32_t *key_indices = imp ? ufbxi_alloc(&ator, uint32_t, num_curves) : NULL;
+	if (!key_indices) {
+		ufbxi_fix_error_type(&err, "Failed to create anim cursor", error);
+		if (imp) ufbxi_free(&ator, ufbxi_anim_cursor_imp, imp, 1);
+		ufbxi_free_ator(&ator);
+		return NULL;
+	}
+
+	memset(imp, 0, sizeof(ufbxi_anim_cursor_imp));
+	memset(key_indices, 0, num_curves * sizeof(uint32_t));
+
+	imp->magic = UFBXI_ANIM_CURSOR_IMP_MAGIC;
+	imp->ator = ator;
+	imp->scene = (ufbx_scene*)scene;
+	imp->key_indices = key_indices;
+	imp->num_curves = num_curves;
+	imp->anim_imp.magic = UFBXI_ANIM_IMP_MAGIC;
+	imp->anim_imp.cursor = imp;
+	imp->anim_imp.anim = *anim;
+	imp->anim_imp.anim.custom = true;
+	imp->cursor.anim = &imp->anim_imp.anim;
+
+	// Keep the scene and custom animations alive as long as the cursor references them
+	ufbx_retain_scene(imp->scene);
+	if (anim->custom) {
+		imp->retained_anim = (ufbx_anim*)anim;
+		ufbx_retain_anim(imp->retained_anim);
+	}
+
+	if (error) {
+		ufbxi_clear_error(error);
+	}
+	return &imp->cursor;
+}
+
+ufbx_abi void ufbx_free_anim_cursor(ufbx_anim_cursor *cursor)
+{
+	if (!cursor) return;
+
+	ufbxi_anim_cursor_imp *imp = (ufbxi_anim_cursor_imp*)cursor;
+	ufbx_assert(imp->magic == UFBXI_ANIM_CURSOR_IMP_MAGIC);
+	if (imp->magic != UFBXI_ANIM_CURSOR_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	ufbx_free_anim(imp->retained_anim);
+	ufbx_free_scene(imp->scene);
+
+	// `ator` is stored in `imp` so copy it out first
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_free(&ator, uint32_t, imp->key_indices, imp->num_curves);
+	ufbxi_free(&ator, ufbxi_anim_cursor_imp, imp, 1);
+	ufbxi_free_ator(&ator);
+}
+
+ufbx_abi ufbx_real ufbx_evaluate_curve_cursor(ufbx_anim_cursor *cursor, const ufbx_anim_curve *curve, double time, ufbx_real default_value)
+{
+	if (!cursor) return ufbx_evaluate_curve(curve, time, default_value);
+
+	ufbxi_anim_cursor_imp *imp = (ufbxi_anim_cursor_imp*)cursor;
+	ufbx_assert(imp->magic == UFBXI_ANIM_CURSOR_IMP_MAGIC);
+	return ufbxi_evaluate_curve_with_cursor(imp, curve, time, default_value);
+}
+
 ufbx_abi ufbx_anim *ufbx_create_anim(const ufbx_scene *scene, const ufbx_anim_opts *opts, ufbx_error *error)
 {
 	ufbxi_check_opts_ptr(ufbx_anim, opts, error);
@@ -30472,6 +35292,7 @@ ufbx_abi void ufbx_free_anim(ufbx_anim *anim)
 	ufbxi_anim_imp *imp = ufbxi_get_imp(ufbxi_anim_imp, anim);
 	ufbx_assert(imp->magic == UFBXI_ANIM_IMP_MAGIC);
 	if (imp->magic != UFBXI_ANIM_IMP_MAGIC) return;
+	if (imp->cursor) return;
 	ufbxi_release_ref(&imp->refcount);
 }
 
@@ -30483,6 +35304,7 @@ ufbx_abi void ufbx_retain_anim(ufbx_anim *anim)
 	ufbxi_anim_imp *imp = ufbxi_get_imp(ufbxi_anim_imp, anim);
 	ufbx_assert(imp->magic == UFBXI_ANIM_IMP_MAGIC);
 	if (imp->magic != UFBXI_ANIM_IMP_MAGIC) return;
+	if (imp->cursor) return;
 	ufbxi_retain_ref(&imp->refcount);
 }
 
@@ -30504,6 +35326,7 @@ ufbx_abi ufbx_baked_anim *ufbx_bake_anim(const ufbx_scene *scene, const ufbx_ani
 
 	int ok = ufbxi_bake_anim_imp(&bc, anim);
 
+	ufbxi_thread_pool_free(&bc.thread_pool);
 	ufbxi_buf_free(&bc.tmp);
 	ufbxi_buf_free(&bc.tmp_prop);
 	ufbxi_buf_free(&bc.tmp_times);
@@ -30649,6 +35472,171 @@ ufbx_abi ufbx_quat ufbx_evaluate_baked_quat(ufbx_baked_quat_list keyframes, doub
 	return keyframes.data[keyframes.count - 1].value;
 }
 
+ufbx_abi ufbx_compact_anim *ufbx_compact_baked_anim(const ufbx_baked_anim *bake, const ufbx_compact_anim_opts *opts, ufbx_error *error)
+{
+	ufbx_assert(bake);
+#if UFBXI_FEATURE_ANIMATION_BAKING
+	ufbxi_check_opts_ptr(ufbx_compact_anim, opts, error);
+
+	ufbxi_compact_context cc = { UFBX_ERROR_NONE };
+	if (opts) {
+		cc.opts = *opts;
+	}
+
+	cc.bake = bake;
+
+	int ok = ufbxi_compact_baked_anim_imp(&cc);
+
+	ufbxi_buf_free(&cc.tmp);
+	ufbxi_free_ator(&cc.ator_tmp);
+
+	if (ok) {
+		ufbxi_clear_error(error);
+		ufbxi_compact_anim_imp *imp = cc.imp;
+		return &imp->anim;
+	} else {
+		ufbxi_fix_error_type(&cc.error, "Failed to compact baked anim", error);
+		ufbxi_buf_free(&cc.result);
+		ufbxi_free_ator(&cc.ator_result);
+		return NULL;
+	}
+#else
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_ANIMATION_BAKING");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_ANIMATION_BAKING", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
+
+ufbx_abi void ufbx_retain_compact_anim(ufbx_compact_anim *anim)
+{
+	if (!anim) return;
+
+	ufbxi_compact_anim_imp *imp = ufbxi_get_imp(ufbxi_compact_anim_imp, anim);
+	ufbx_assert(imp->magic == UFBXI_COMPACT_ANIM_IMP_MAGIC);
+	if (imp->magic != UFBXI_COMPACT_ANIM_IMP_MAGIC) return;
+	ufbxi_retain_ref(&imp->refcount);
+}
+
+ufbx_abi void ufbx_free_compact_anim(ufbx_compact_anim *anim)
+{
+	if (!anim) return;
+
+	ufbxi_compact_anim_imp *imp = ufbxi_get_imp(ufbxi_compact_anim_imp, anim);
+	ufbx_assert(imp->magic == UFBXI_COMPACT_ANIM_IMP_MAGIC);
+	if (imp->magic != UFBXI_COMPACT_ANIM_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+}
+
+ufbx_abi ufbx_compact_node *ufbx_find_compact_node(ufbx_compact_anim *anim, ufbx_node *node)
+{
+	if (!anim || !node) return NULL;
+	uint32_t typed_id = node->typed_id;
+	size_t index = SIZE_MAX;
+	ufbxi_macro_lower_bound_eq(ufbx_compact_node, 8, &index, anim->nodes.data, 0, anim->nodes.count,
+		( a->typed_id < typed_id ), ( a->typed_id == typed_id) );
+	return index < SIZE_MAX ? &anim->nodes.data[index] : NULL;
+}
+
+ufbx_abi ufbx_compact_element *ufbx_find_compact_element(ufbx_compact_anim *anim, ufbx_element *element)
+{
+	if (!anim || !element) return NULL;
+	uint32_t element_id = element->element_id;
+	size_t index = SIZE_MAX;
+	ufbxi_macro_lower_bound_eq(ufbx_compact_element, 8, &index, anim->elements.data, 0, anim->elements.count,
+		( a->element_id < element_id ), ( a->element_id == element_id) );
+	return index < SIZE_MAX ? &anim->elements.data[index] : NULL;
+}
+
+// Find the sample to interpolate from for `time` and the fraction to the next one.
+static ufbxi_forceinline size_t ufbxi_compact_sample_index(const ufbx_compact_anim *anim, uint32_t num_samples, double time, ufbx_real *p_t)
+{
+	double pos = (time - anim->time_begin) * anim->sample_rate;
+	*p_t = 0.0f;
+	if (!(pos > 0.0)) return 0;
+	if (pos >= (double)(num_samples - 1)) return num_samples - 1;
+	size_t index = (size_t)pos;
+	*p_t = (ufbx_real)(pos - (double)index);
+	return index;
+}
+
+static ufbxi_forceinline ufbx_vec3 ufbxi_decode_compact_vec3(const ufbx_compact_vec3_track *track, const uint16_t *data)
+{
+	ufbx_vec3 v;
+	v.x = track->min.x + track->scale.x * (ufbx_real)data[0];
+	v.y = track->min.y + track->scale.y * (ufbx_real)data[1];
+	v.z = track->min.z + track->scale.z * (ufbx_real)data[2];
+	return v;
+}
+
+// See `ufbxi_encode_smallest_three()`.
+static ufbxi_noinline ufbx_quat ufbxi_decode_smallest_three(const uint16_t *data)
+{
+	uint32_t largest = (uint32_t)(data[0] >> 15) << 1 | (uint32_t)(data[1] >> 15);
+
+	ufbx_quat q; // ufbxi_uninit
+	double sum = 0.0;
+	uint32_t num_values = 0;
+	for (uint32_t i = 0; i < 4; i++) {
+		if (i == largest) continue;
+		double v = ((double)(data[num_values++] & 0x7fff) * (2.0 / 32767.0) - 1.0) * (0.5 * UFBXI_SQRT_2);
+		q.v[i] = (ufbx_real)v;
+		sum += v * v;
+	}
+	q.v[largest] = (ufbx_real)ufbx_sqrt(ufbx_fmax(1.0 - sum, 0.0));
+	return q;
+}
+
+ufbx_abi ufbx_vec3 ufbx_evaluate_compact_vec3(const ufbx_compact_anim *anim, const ufbx_compact_vec3_track *track, double time)
+{
+	if (!anim || !track || track->num_samples == 0) {
+		ufbx_vec3 zero = { 0.0f };
+		return zero;
+	}
+
+	ufbx_real t;
+	size_t index = ufbxi_compact_sample_index(anim, track->num_samples, time, &t);
+	const uint16_t *data = anim->data.data + track->data_offset + index * 3;
+
+	ufbx_vec3 a = ufbxi_decode_compact_vec3(track, data);
+	if (t == 0.0f) return a;
+	ufbx_vec3 b = ufbxi_decode_compact_vec3(track, data + 3);
+	return ufbxi_lerp3(a, b, t);
+}
+
+ufbx_abi ufbx_quat ufbx_evaluate_compact_quat(const ufbx_compact_anim *anim, const ufbx_compact_quat_track *track, double time)
+{
+	if (!anim || !track || track->num_samples == 0) return ufbx_identity_quat;
+
+	ufbx_real t;
+	size_t index = ufbxi_compact_sample_index(anim, track->num_samples, time, &t);
+	const uint16_t *data = anim->data.data + track->data_offset + index * 3;
+
+	ufbx_quat a = ufbxi_decode_smallest_three(data);
+	if (t == 0.0f) return a;
+	ufbx_quat b = ufbx_quat_fix_antipodal(ufbxi_decode_smallest_three(data + 3), a);
+
+	ufbx_quat q;
+	q.x = a.x + (b.x - a.x) * t;
+	q.y = a.y + (b.y - a.y) * t;
+	q.z = a.z + (b.z - a.z) * t;
+	q.w = a.w + (b.w - a.w) * t;
+	return ufbx_quat_normalize(q);
+}
+
+ufbx_abi ufbx_transform ufbx_evaluate_compact_node(const ufbx_compact_anim *anim, const ufbx_compact_node *node, double time)
+{
+	if (!anim || !node) return ufbx_identity_transform;
+
+	ufbx_transform transform;
+	transform.translation = ufbx_evaluate_compact_vec3(anim, &node->translation, time);
+	transform.rotation = ufbx_evaluate_compact_quat(anim, &node->rotation, time);
+	transform.scale = ufbx_evaluate_compact_vec3(anim, &node->scale, time);
+	return transform;
+}
+
 ufbx_abi ufbx_bone_pose *ufbx_get_bone_pose(const ufbx_pose *pose, const ufbx_node *node)
 {
 	if (!pose || !node) return NULL;
@@ -31178,90 +36166,7 @@ ufbx_abi ufbxi_noinline ufbx_matrix ufbx_catch_get_skin_vertex_matrix(ufbx_panic
 	if (ufbxi_panicf(panic, vertex < skin->vertices.count, "vertex (%zu) out of bounds (%zu)", vertex, skin->vertices.count)) return ufbx_identity_matrix;
 
 	if (!skin || vertex >= skin->vertices.count) return ufbx_identity_matrix;
-	ufbx_skin_vertex skin_vertex = skin->vertices.data[vertex];
-
-	ufbx_matrix mat = { 0.0f };
-	ufbx_quat q0 = { 0.0f }, qe = { 0.0f };
-	ufbx_quat first_q0 = { 0.0f };
-	ufbx_vec3 qs = { 0.0f, 0.0f, 0.0f };
-	ufbx_real total_weight = 0.0f;
-
-	for (uint32_t i = 0; i < skin_vertex.num_weights; i++) {
-		ufbx_skin_weight weight = skin->weights.data[skin_vertex.weight_begin + i];
-		ufbx_skin_cluster *cluster = skin->clusters.data[weight.cluster_index];
-		const ufbx_node *node = cluster->bone_node;
-		if (!node) continue;
-
-		total_weight += weight.weight;
-		if (skin_vertex.dq_weight > 0.0f) {
-			ufbx_transform t = cluster->geometry_to_world_transform;
-			ufbx_quat vq0 = t.rotation;
-			if (i == 0) first_q0 = vq0;
-
-			if (ufbx_quat_dot(first_q0, vq0) < 0.0f) {
-				vq0.x = -vq0.x;
-				vq0.y = -vq0.y;
-				vq0.z = -vq0.z;
-				vq0.w = -vq0.w;
-			}
-
-			ufbx_quat vqt = { 0.5f * t.translation.x, 0.5f * t.translation.y, 0.5f * t.translation.z };
-			ufbx_quat vqe = ufbxi_mul_quat(vqt, vq0);
-			ufbxi_add_weighted_quat(&q0, vq0, weight.weight);
-			ufbxi_add_weighted_quat(&qe, vqe, weight.weight);
-			ufbxi_add_weighted_vec3(&qs, t.scale, weight.weight);
-		}
-
-		if (skin_vertex.dq_weight < 1.0f) {
-			ufbxi_add_weighted_mat(&mat, &cluster->geometry_to_world, (1.0f-skin_vertex.dq_weight) * weight.weight);
-		}
-	}
-
-	if (total_weight <= 0.0f) {
-		if (fallback) {
-			return *fallback;
-		} else {
-			return ufbx_identity_matrix;
-		}
-	}
-
-	if (ufbx_fabs(total_weight - 1.0f) > UFBX_EPSILON) {
-		ufbx_real rcp_weight = ufbx_fabs(total_weight) > UFBX_EPSILON ? 1.0f / total_weight : 0.0f;
-		if (skin_vertex.dq_weight > 0.0f) {
-			q0.x *= rcp_weight; q0.y *= rcp_weight; q0.z *= rcp_weight; q0.w *= rcp_weight;
-			qe.x *= rcp_weight; qe.y *= rcp_weight; qe.z *= rcp_weight; qe.w *= rcp_weight;
-			qs.x *= rcp_weight; qs.y *= rcp_weight; qs.z *= rcp_weight;
-		}
-		if (skin_vertex.dq_weight < 1.0f) {
-			mat.m00 *= rcp_weight; mat.m01 *= rcp_weight; mat.m02 *= rcp_weight; mat.m03 *= rcp_weight;
-			mat.m10 *= rcp_weight; mat.m11 *= rcp_weight; mat.m12 *= rcp_weight; mat.m13 *= rcp_weight;
-			mat.m20 *= rcp_weight; mat.m21 *= rcp_weight; mat.m22 *= rcp_weight; mat.m23 *= rcp_weight;
-		}
-	}
-
-	if (skin_vertex.dq_weight > 0.0f) {
-		ufbx_transform dqt; // ufbxi_uninit
-		ufbx_real rcp_len = (ufbx_real)(1.0 / ufbx_sqrt(q0.x*q0.x + q0.y*q0.y + q0.z*q0.z + q0.w*q0.w));
-		ufbx_real rcp_len2x2 = 2.0f * rcp_len * rcp_len;
-		dqt.rotation.x = q0.x * rcp_len;
-		dqt.rotation.y = q0.y * rcp_len;
-		dqt.rotation.z = q0.z * rcp_len;
-		dqt.rotation.w = q0.w * rcp_len;
-		dqt.scale.x = qs.x;
-		dqt.scale.y = qs.y;
-		dqt.scale.z = qs.z;
-		dqt.translation.x = rcp_len2x2 * (- qe.w*q0.x + qe.x*q0.w - qe.y*q0.z + qe.z*q0.y);
-		dqt.translation.y = rcp_len2x2 * (- qe.w*q0.y + qe.x*q0.z + qe.y*q0.w - qe.z*q0.x);
-		dqt.translation.z = rcp_len2x2 * (- qe.w*q0.z - qe.x*q0.y + qe.y*q0.x + qe.z*q0.w);
-		ufbx_matrix dqm = ufbx_transform_to_matrix(&dqt);
-		if (skin_vertex.dq_weight < 1.0f) {
-			ufbxi_add_weighted_mat(&mat, &dqm, skin_vertex.dq_weight);
-		} else {
-			mat = dqm;
-		}
-	}
-
-	return mat;
+	return ufbxi_get_skin_vertex_matrix(skin, skin->vertices.data[vertex], NULL, fallback);
 }
 
 ufbx_abi ufbxi_noinline uint32_t ufbx_get_blend_shape_offset_index(const ufbx_blend_shape *shape, size_t vertex)
@@ -31649,50 +36554,7 @@ ufbx_abi ufbxi_noinline uint32_t ufbx_catch_triangulate_face(ufbx_panic *panic,
 		return 1;
 	} else if (face.num_indices == 4) {
 		// Quad: Split along the shortest axis unless a vertex crosses the axis
-		uint32_t i0 = face.index_begin + 0;
-		uint32_t i1 = face.index_begin + 1;
-		uint32_t i2 = face.index_begin + 2;
-		uint32_t i3 = face.index_begin + 3;
-		ufbx_vec3 v0 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i0]];
-		ufbx_vec3 v1 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i1]];
-		ufbx_vec3 v2 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i2]];
-		ufbx_vec3 v3 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i3]];
-
-		ufbx_vec3 a = ufbxi_sub3(v2, v0);
-		ufbx_vec3 b = ufbxi_sub3(v3, v1);
-
-		ufbx_vec3 na1 = ufbxi_normalize3(ufbxi_cross3(a, ufbxi_sub3(v1, v0)));
-		ufbx_vec3 na3 = ufbxi_normalize3(ufbxi_cross3(a, ufbxi_sub3(v0, v3)));
-		ufbx_vec3 nb0 = ufbxi_normalize3(ufbxi_cross3(b, ufbxi_sub3(v1, v0)));
-		ufbx_vec3 nb2 = ufbxi_normalize3(ufbxi_cross3(b, ufbxi_sub3(v2, v1)));
-
-		ufbx_real dot_aa = ufbxi_dot3(a, a);
-		ufbx_real dot_bb = ufbxi_dot3(b, b);
-		ufbx_real dot_na = ufbxi_dot3(na1, na3);
-		ufbx_real dot_nb = ufbxi_dot3(nb0, nb2);
-
-		bool split_a = dot_aa <= dot_bb;
-
-		if (dot_na < 0.0f || dot_nb < 0.0f) {
-			split_a = dot_na >= dot_nb;
-		}
-
-		if (split_a) {
-			indices[0] = i0;
-			indices[1] = i1;
-			indices[2] = i2;
-			indices[3] = i2;
-			indices[4] = i3;
-			indices[5] = i0;
-		} else {
-			indices[0] = i1;
-			indices[1] = i2;
-			indices[2] = i3;
-			indices[3] = i3;
-			indices[4] = i0;
-			indices[5] = i1;
-		}
-
+		ufbxi_triangulate_quad(indices, mesh, face.index_begin);
 		return 2;
 	} else {
 		ufbxi_ngon_context nc = { 0 };
@@ -31716,6 +36578,20 @@ ufbx_abi ufbxi_noinline uint32_t ufbx_catch_triangulate_face(ufbx_panic *panic,
 #endif
 }
 
+ufbx_abi size_t ufbx_triangulate_mesh(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const ufbx_triangulate_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_return(0, opts, error);
+	if (!mesh) return 0;
+	return ufbxi_triangulate_mesh(indices, num_indices, mesh, NULL, mesh->num_faces, opts, error);
+}
+
+ufbx_abi size_t ufbx_triangulate_mesh_part(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const ufbx_mesh_part *part, const ufbx_triangulate_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_return(0, opts, error);
+	if (!mesh || !part) return 0;
+	return ufbxi_triangulate_mesh(indices, num_indices, mesh, part->face_indices.data, part->face_indices.count, opts, error);
+}
+
 ufbx_abi void ufbx_catch_compute_topology(ufbx_panic *panic, const ufbx_mesh *mesh, ufbx_topo_edge *indices, size_t num_indices)
 {
 	if (ufbxi_panicf(panic, num_indices >= mesh->num_indices, "Required mesh.num_indices (%zu) indices, got %zu", mesh->num_indices, num_indices)) return;
@@ -31927,6 +36803,590 @@ ufbx_abi void ufbx_retain_geometry_cache(ufbx_geometry_cache *cache)
 	ufbxi_retain_ref(&imp->refcount);
 }
 
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+
+typedef struct {
+	char *filename;
+	size_t filename_len;
+	uint64_t last_used;
+
+	// Open stream, `position` is the current offset in the file
+	ufbx_stream stream;
+	bool has_stream;
+	uint64_t position;
+
+	// Contents of the whole file if it is mapped or buffered
+	const char *data;
+	size_t data_size;
+	bool mapped;
+} ufbxi_cache_reader_file;
+
+typedef struct {
+	ufbx_geometry_cache_reader reader;
+	uint32_t magic;
+
+	ufbx_error error;
+	ufbxi_allocator ator;
+	ufbx_geometry_cache_reader_opts opts;
+
+	ufbxi_cache_reader_file *files;
+	size_t num_files;
+	uint64_t use_counter;
+
+	// Buffer for reading frames from streamed files
+	char *read_buf;
+	size_t read_buf_size;
+} ufbxi_cache_reader_imp;
+
+ufbx_static_assert(cache_reader_imp_offset, offsetof(ufbxi_cache_reader_imp, reader) == 0);
+
+static ufbxi_noinline void ufbxi_cache_reader_close_stream(ufbxi_cache_reader_file *file)
+{
+	if (file->has_stream && file->stream.close_fn) {
+		file->stream.close_fn(file->stream.user);
+	}
+	memset(&file->stream, 0, sizeof(ufbx_stream));
+	file->has_stream = false;
+	file->position = 0;
+}
+
+static ufbxi_noinline void ufbxi_cache_reader_close(ufbxi_cache_reader_imp *imp, ufbxi_cache_reader_file *file)
+{
+	ufbxi_cache_reader_close_stream(file);
+	if (file->mapped) {
+#if UFBXI_HAS_MMAP
+		ufbxi_unmap_file((void*)file->data, file->data_size);
+#endif
+	} else if (file->data) {
+		ufbxi_free(&imp->ator, char, (char*)file->data, file->data_size);
+	}
+	if (file->filename) {
+		ufbxi_free(&imp->ator, char, file->filename, file->filename_len + 1);
+	}
+	memset(file, 0, sizeof(ufbxi_cache_reader_file));
+}
+
+static ufbxi_noinline size_t ufbxi_cache_reader_read_stream(ufbx_stream *stream, char *dst, size_t size)
+{
+	size_t total = 0;
+	while (total < size) {
+		size_t num_read = stream->read_fn(stream->user, dst + total, size - total);
+		if (num_read == 0 || num_read > size - total) break;
+		total += num_read;
+	}
+	return total;
+}
+
+static ufbxi_noinline bool ufbxi_cache_reader_open(ufbxi_cache_reader_imp *imp, ufbxi_cache_reader_file *file)
+{
+	imp->reader.num_files_opened++;
+
+#if UFBXI_HAS_MMAP
+	if (!imp->opts.open_file_cb.fn) {
+		void *data = NULL;
+		size_t size = 0;
+		if (ufbxi_map_file(&imp->ator, &data, &size, file->filename, file->filename_len, true)) {
+			file->data = (const char*)data;
+			file->data_size = size;
+			file->mapped = true;
+			return true;
+		}
+	}
+#endif
+
+	ufbx_open_file_cb open_file_cb = imp->opts.open_file_cb;
+	if (!open_file_cb.fn) {
+		open_file_cb.fn = ufbx_default_open_file;
+	}
+	if (!ufbxi_open_file(&open_file_cb, &file->stream, file->filename, file->filename_len, NULL, &imp->ator, UFBX_OPEN_FILE_GEOMETRY_CACHE)) {
+		return false;
+	}
+	file->has_stream = true;
+	file->position = 0;
+
+	// Read small files fully so that frames can be read in any order, if
+	// anything fails here we just keep streaming the file. `SIZE_MAX` means
+	// that files should always be streamed.
+	size_t max_buffered_size = imp->opts.max_buffered_file_size;
+	uint64_t size = file->stream.size_fn && max_buffered_size != SIZE_MAX ? file->stream.size_fn(file->stream.user) : 0;
+	if (size > 0 && size <= max_buffered_size) {
+		char *data = ufbxi_alloc(&imp->ator, char, (size_t)size);
+		if (data) {
+			size_t num_read = ufbxi_cache_reader_read_stream(&file->stream, data, (size_t)size);
+			if (num_read == size) {
+				ufbxi_cache_reader_close_stream(file);
+				file->data = data;
+				file->data_size = (size_t)size;
+				return true;
+			}
+			ufbxi_free(&imp->ator, char, data, (size_t)size);
+			file->position = num_read;
+		}
+	}
+
+	return true;
+}
+
+static ufbxi_noinline ufbxi_cache_reader_file *ufbxi_cache_reader_find(ufbxi_cache_reader_imp *imp, ufbx_string filename)
+{
+	ufbxi_cache_reader_file *lru = NULL;
+	for (size_t i = 0; i < imp->num_files; i++) {
+		ufbxi_cache_reader_file *file = &imp->files[i];
+		if (file->filename && file->filename_len == filename.length && !memcmp(file->filename, filename.data, filename.length)) {
+			file->last_used = ++imp->use_counter;
+			return file;
+		}
+		if (!lru || file->last_used < lru->last_used) {
+			lru = file;
+		}
+	}
+
+	ufbxi_cache_reader_close(imp, lru);
+
+	lru->filename = ufbxi_alloc(&imp->ator, char, filename.length + 1);
+	if (!lru->filename) return NULL;
+	memcpy(lru->filename, filename.data, filename.length);
+	lru->filename[filename.length] = '\0';
+	lru->filename_len = filename.length;
+
+	if (!ufbxi_cache_reader_open(imp, lru)) {
+		ufbxi_cache_reader_close(imp, lru);
+		return NULL;
+	}
+
+	lru->last_used = ++imp->use_counter;
+	return lru;
+}
+
+// Returns a pointer to at most `size` bytes of data at the start of `frame`.
+static ufbxi_noinline const char *ufbxi_cache_reader_read_frame(ufbxi_cache_reader_imp *imp, const ufbx_cache_frame *frame, size_t size, size_t *p_size)
+{
+	ufbxi_cache_reader_file *file = ufbxi_cache_reader_find(imp, frame->filename);
+	if (!file) return NULL;
+
+	imp->reader.num_frames_read++;
+
+	// Streams can only be skipped forward, rewind `FILE*` streams to read earlier
+	// data and re-open the file for other streams.
+	uint64_t offset = frame->data_offset;
+	if (file->has_stream && offset < file->position) {
+		if (ufbxi_stdio_rewind(&file->stream)) {
+			file->position = 0;
+		} else {
+			ufbxi_cache_reader_close_stream(file);
+			if (!ufbxi_cache_reader_open(imp, file)) {
+				ufbxi_cache_reader_close(imp, file);
+				return NULL;
+			}
+		}
+	}
+
+	if (file->data) {
+		if (offset > file->data_size) return NULL;
+		*p_size = ufbxi_min_sz(size, file->data_size - (size_t)offset);
+		return file->data + offset;
+	}
+
+	while (file->position < offset) {
+		uint64_t left = offset - file->position;
+		if (file->stream.skip_fn) {
+			size_t to_skip = (size_t)ufbxi_min64(left, UFBXI_MAX_SKIP_SIZE);
+			if (!file->stream.skip_fn(file->stream.user, to_skip)) break;
+			file->position += to_skip;
+		} else {
+			char buffer[4096]; // ufbxi_uninit
+			size_t to_skip = (size_t)ufbxi_min64(left, sizeof(buffer));
+			size_t num_read = file->stream.read_fn(file->stream.user, buffer, to_skip);
+			if (num_read != to_skip) break;
+			file->position += to_skip;
+		}
+	}
+
+	// Failed to skip all the way
+	if (file->position != offset) {
+		ufbxi_cache_reader_close(imp, file);
+		return NULL;
+	}
+
+	if (imp->read_buf_size < size) {
+		if (imp->read_buf) {
+			ufbxi_free(&imp->ator, char, imp->read_buf, imp->read_buf_size);
+		}
+		imp->read_buf_size = 0;
+		imp->read_buf = ufbxi_alloc(&imp->ator, char, size);
+		if (!imp->read_buf) return NULL;
+		imp->read_buf_size = size;
+	}
+
+	size_t num_read = ufbxi_cache_reader_read_stream(&file->stream, imp->read_buf, size);
+	file->position += num_read;
+	*p_size = num_read;
+	return imp->read_buf;
+}
+
+// Convert raw (potentially unaligned) cache values to `ufbx_real`.
+static ufbxi_noinline void ufbxi_decode_cache_values(ufbx_real *dst, const char *src, size_t count, bool use_double, bool swap)
+{
+	size_t i = 0;
+#if UFBXI_HAS_SSE
+	if (use_double) {
+		for (; i + 2 <= count; i += 2) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 8));
+			if (swap) {
+				v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+				v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3)), _MM_SHUFFLE(0,1,2,3));
+			}
+#if defined(UFBX_REAL_IS_FLOAT)
+			_mm_storel_epi64((__m128i*)(dst + i), _mm_castps_si128(_mm_cvtpd_ps(_mm_castsi128_pd(v))));
+#else
+			_mm_storeu_pd(dst + i, _mm_castsi128_pd(v));
+#endif
+		}
+	} else {
+		for (; i + 4 <= count; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+			if (swap) {
+				v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+				v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+			}
+			__m128 f = _mm_castsi128_ps(v);
+#if defined(UFBX_REAL_IS_FLOAT)
+			_mm_storeu_ps(dst + i, f);
+#else
+			_mm_storeu_pd(dst + i, _mm_cvtps_pd(f));
+			_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+#endif
+		}
+	}
+#endif
+
+	for (; i < count; i++) {
+		if (use_double) {
+			char t, v[8]; // ufbxi_uninit
+			memcpy(v, src + i * 8, 8);
+			if (swap) {
+				t = v[0]; v[0] = v[7]; v[7] = t;
+				t = v[1]; v[1] = v[6]; v[6] = t;
+				t = v[2]; v[2] = v[5]; v[5] = t;
+				t = v[3]; v[3] = v[4]; v[4] = t;
+			}
+			double value; // ufbxi_uninit
+			memcpy(&value, v, 8);
+			dst[i] = (ufbx_real)value;
+		} else {
+			char t, v[4]; // ufbxi_uninit
+			memcpy(v, src + i * 4, 4);
+			if (swap) {
+				t = v[0]; v[0] = v[3]; v[3] = t;
+				t = v[1]; v[1] = v[2]; v[2] = t;
+			}
+			float value; // ufbxi_uninit
+			memcpy(&value, v, 4);
+			dst[i] = (ufbx_real)value;
+		}
+	}
+}
+
+typedef struct {
+	size_t prev, next;
+	double t; // < Blend weight of `next`, `prev == next` if there is nothing to blend
+} ufbxi_cache_sample;
+
+// Find the frames to sample `channel` at `time`, requires at least one frame.
+static ufbxi_noinline ufbxi_cache_sample ufbxi_find_cache_sample(const ufbx_cache_channel *channel, double time)
+{
+	size_t begin = 0;
+	size_t end = channel->frames.count;
+	const ufbx_cache_frame *frames = channel->frames.data;
+	while (end - begin >= 8) {
+		size_t mid = (begin + end) >> 1;
+		if (frames[mid].time < time) {
+			begin = mid + 1;
+		} else {
+			end = mid;
+		}
+	}
+
+	const double eps = 0.00000001;
+
+	ufbxi_cache_sample sample = { 0 };
+
+	end = channel->frames.count;
+	for (; begin < end; begin++) {
+		const ufbx_cache_frame *next = &frames[begin];
+		if (next->time < time) continue;
+
+		// First keyframe
+		if (begin == 0) {
+			return sample;
+		}
+
+		const ufbx_cache_frame *prev = next - 1;
+
+		// Snap to exact frames if near
+		sample.prev = sample.next = begin;
+		if (ufbx_fabs(next->time - time) < eps) {
+			return sample;
+		}
+		sample.prev = sample.next = begin - 1;
+		if (ufbx_fabs(prev->time - time) < eps) {
+			return sample;
+		}
+
+		double rcp_delta = 1.0 / (next->time - prev->time);
+		sample.next = begin;
+		sample.t = (time - prev->time) * rcp_delta;
+		return sample;
+	}
+
+	// Last frame
+	sample.prev = sample.next = end - 1;
+	return sample;
+}
+
+typedef struct {
+	ufbx_real *values;
+	size_t capacity;
+	size_t num_values;
+
+	// Index of the buffered frame or `SIZE_MAX` if the slot is empty
+	size_t frame_index;
+	const ufbx_cache_frame *frame;
+	const ufbx_geometry_cache_data_opts *read_opts;
+
+	// Being read by a task in prefetch batch `batch`
+	bool pending;
+	uint64_t batch;
+} ufbxi_cache_playback_slot;
+
+typedef struct {
+	ufbx_cache_playback playback;
+	uint32_t magic;
+
+	ufbx_error error;
+	ufbxi_allocator ator;
+	ufbxi_thread_pool thread_pool;
+	ufbx_geometry_cache_data_opts read_opts;
+	size_t prefetch_frames;
+
+	ufbxi_cache_playback_slot *slots;
+	size_t num_slots;
+	ufbx_real *values;
+	size_t num_values;
+
+	// Prefetch tasks are flushed in batches which must be waited for in
+	// order, the thread group used by each batch is stored here.
+	uint64_t num_batches;
+	uint64_t num_waited_batches;
+	uint32_t batch_groups[UFBX_THREAD_GROUP_COUNT];
+
+	bool has_time;
+	bool reverse;
+	double time;
+} ufbxi_cache_playback_imp;
+
+ufbx_static_assert(cache_playback_imp_offset, offsetof(ufbxi_cache_playback_imp, playback) == 0);
+
+static ufbxi_noinline void ufbxi_cache_playback_read(ufbxi_cache_playback_slot *slot)
+{
+	slot->num_values = ufbx_read_geometry_cache_real(slot->frame, slot->values, slot->capacity, slot->read_opts);
+}
+
+static bool ufbxi_cache_playback_task_fn(ufbxi_task *task)
+{
+	ufbxi_cache_playback_read((ufbxi_cache_playback_slot*)task->data);
+	return true;
+}
+
+static ufbxi_noinline void ufbxi_cache_playback_wait(ufbxi_cache_playback_imp *imp, uint64_t batch)
+{
+	while (imp->num_waited_batches <= batch && imp->num_waited_batches < imp->num_batches) {
+		uint64_t index = imp->num_waited_batches++;
+		uint32_t group = imp->batch_groups[index % UFBX_THREAD_GROUP_COUNT];
+		ufbxi_ignore(ufbxi_thread_pool_wait_imp(&imp->thread_pool, group, false));
+		for (size_t i = 0; i < imp->num_slots; i++) {
+			ufbxi_cache_playback_slot *slot = &imp->slots[i];
+			if (slot->pending && slot->batch == index) {
+				slot->pending = false;
+			}
+		}
+	}
+}
+
+// How far `frame` is from the current sample in the direction of playback,
+// frames behind the playback position are considered further than any ahead.
+static ufbxi_noinline size_t ufbxi_cache_playback_distance(const ufbxi_cache_playback_imp *imp, size_t frame, size_t prev, size_t next)
+{
+	if (frame == SIZE_MAX) return SIZE_MAX;
+	if (frame >= prev && frame <= next) return 0;
+	if (!imp->reverse) {
+		return frame > next ? frame - next : SIZE_MAX / 2 + (prev - frame);
+	} else {
+		return frame < prev ? prev - frame : SIZE_MAX / 2 + (frame - next);
+	}
+}
+
+// Find the furthest slot that is not pending with distance above `min_distance`.
+static ufbxi_noinline ufbxi_cache_playback_slot *ufbxi_cache_playback_evict(ufbxi_cache_playback_imp *imp, size_t prev, size_t next, size_t min_distance)
+{
+	ufbxi_cache_playback_slot *best = NULL;
+	size_t best_distance = min_distance;
+	for (size_t i = 0; i < imp->num_slots; i++) {
+		ufbxi_cache_playback_slot *slot = &imp->slots[i];
+		if (slot->pending) continue;
+		size_t distance = ufbxi_cache_playback_distance(imp, slot->frame_index, prev, next);
+		if (distance > best_distance) {
+			best = slot;
+			best_distance = distance;
+		}
+	}
+	return best;
+}
+
+static ufbxi_noinline ufbxi_cache_playback_slot *ufbxi_cache_playback_get(ufbxi_cache_playback_imp *imp, size_t frame_index, size_t prev, size_t next)
+{
+	for (size_t i = 0; i < imp->num_slots; i++) {
+		ufbxi_cache_playback_slot *slot = &imp->slots[i];
+		if (slot->frame_index == frame_index) {
+			if (slot->pending) {
+				ufbxi_cache_playback_wait(imp, slot->batch);
+			}
+			imp->playback.num_frame_hits++;
+			return slot;
+		}
+	}
+
+	// There are always at least two slots so after waiting for all
+	// prefetches there is a slot available outside `[prev, next]`.
+	ufbxi_cache_playback_slot *slot = ufbxi_cache_playback_evict(imp, prev, next, 0);
+	if (!slot) {
+		ufbxi_cache_playback_wait(imp, imp->num_batches);
+		slot = ufbxi_cache_playback_evict(imp, prev, next, 0);
+	}
+	ufbx_assert(slot);
+
+	imp->playback.num_frame_misses++;
+	slot->frame_index = frame_index;
+	slot->frame = &imp->playback.channel->frames.data[frame_index];
+	ufbxi_cache_playback_read(slot);
+	return slot;
+}
+
+static ufbxi_noinline void ufbxi_cache_playback_prefetch(ufbxi_cache_playback_imp *imp, size_t prev, size_t next)
+{
+	ufbxi_thread_pool *pool = &imp->thread_pool;
+	if (!pool->enabled) return;
+
+	size_t num_frames = imp->playback.channel->frames.count;
+	bool has_tasks = false;
+	for (size_t ahead = 1; ahead <= imp->prefetch_frames; ahead++) {
+		size_t frame_index = 0;
+		if (imp->reverse) {
+			if (prev < ahead) break;
+			frame_index = prev - ahead;
+		} else {
+			if (num_frames - next <= ahead) break;
+			frame_index = next + ahead;
+		}
+
+		bool found = false;
+		for (size_t i = 0; i < imp->num_slots; i++) {
+			if (imp->slots[i].frame_index == frame_index) {
+				found = true;
+				break;
+			}
+		}
+		if (found) continue;
+
+		// Only replace frames that are needed later than this one
+		ufbxi_cache_playback_slot *slot = ufbxi_cache_playback_evict(imp, prev, next, ahead);
+		if (!slot) break;
+
+		// Make sure the thread group of this batch is not in use
+		if (!has_tasks && imp->num_batches - imp->num_waited_batches >= UFBX_THREAD_GROUP_COUNT) {
+			ufbxi_cache_playback_wait(imp, imp->num_waited_batches);
+		}
+
+		ufbxi_task *task = ufbxi_thread_pool_create_task(pool, &ufbxi_cache_playback_task_fn);
+		if (!task) break;
+
+		slot->frame_index = frame_index;
+		slot->frame = &imp->playback.channel->frames.data[frame_index];
+		slot->num_values = 0;
+		slot->pending = true;
+		slot->batch = imp->num_batches;
+		task->data = slot;
+		ufbxi_thread_pool_run_task(pool, task);
+		has_tasks = true;
+	}
+
+	if (has_tasks) {
+		imp->batch_groups[imp->num_batches % UFBX_THREAD_GROUP_COUNT] = pool->group;
+		ufbxi_thread_pool_flush_group(pool);
+		imp->num_batches++;
+	}
+}
+
+static ufbxi_noinline void ufbxi_cache_playback_blend(ufbx_real *dst, const ufbx_real *src, size_t count, ufbx_real weight, bool additive)
+{
+	if (additive) {
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			dst[i] += src[i] * weight;
+		}
+	} else {
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			dst[i] = src[i] * weight;
+		}
+	}
+}
+
+static ufbxi_noinline size_t ufbxi_cache_playback_sample(ufbxi_cache_playback_imp *imp, double time, ufbx_real *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
+{
+	if (imp->playback.channel->frames.count == 0) return 0;
+
+	if (imp->has_time && time != imp->time) {
+		imp->reverse = time < imp->time;
+	}
+	imp->has_time = true;
+	imp->time = time;
+
+	ufbxi_cache_sample sample = ufbxi_find_cache_sample(imp->playback.channel, time);
+	ufbx_real weight = opts->use_weight ? opts->weight : 1.0f;
+
+	ufbxi_cache_playback_slot *prev = ufbxi_cache_playback_get(imp, sample.prev, sample.prev, sample.next);
+	size_t num_values = ufbxi_min_sz(count, prev->num_values);
+	if (sample.prev == sample.next) {
+		ufbxi_cache_playback_blend(data, prev->values, num_values, weight, opts->additive);
+	} else {
+		ufbxi_cache_playback_slot *next = ufbxi_cache_playback_get(imp, sample.next, sample.prev, sample.next);
+		ufbxi_cache_playback_blend(data, prev->values, num_values, (ufbx_real)(weight * (1.0 - sample.t)), opts->additive);
+		num_values = ufbxi_min_sz(num_values, next->num_values);
+		ufbxi_cache_playback_blend(data, next->values, num_values, (ufbx_real)(weight * sample.t), true);
+	}
+
+	ufbxi_cache_playback_prefetch(imp, sample.prev, sample.next);
+	return num_values;
+}
+
+static ufbxi_noinline void ufbxi_free_cache_playback_imp(ufbxi_cache_playback_imp *imp)
+{
+	// Waits for all pending prefetch tasks
+	ufbxi_thread_pool_free(&imp->thread_pool);
+
+	if (imp->slots) {
+		ufbxi_free(&imp->ator, ufbxi_cache_playback_slot, imp->slots, imp->num_slots);
+	}
+	if (imp->values) {
+		ufbxi_free(&imp->ator, ufbx_real, imp->values, imp->num_values);
+	}
+
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_free(&ator, ufbxi_cache_playback_imp, imp, 1);
+	ufbxi_free_ator(&ator);
+}
+
+#endif
+
 typedef struct {
 	union {
 		double f64[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
@@ -31983,39 +37443,55 @@ ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_fr
 		memcpy(buf, &val, 2);
 		dst_big_endian = buf[0] == 0xbb;
 	}
+	bool swap = src_big_endian != dst_big_endian;
 
 	if (src_count == 0) return 0;
 	src_count = ufbxi_min_sz(src_count, count);
 
+	size_t src_size = use_double ? sizeof(double) : sizeof(float);
 	ufbx_stream stream = { 0 };
-	if (!ufbxi_open_file(&opts.open_file_cb, &stream, frame->filename.data, frame->filename.length, NULL, NULL, UFBX_OPEN_FILE_GEOMETRY_CACHE)) {
-		return 0;
-	}
 
-	// Skip to the correct point in the file
-	uint64_t offset = frame->data_offset;
-	if (stream.skip_fn) {
-		while (offset > 0) {
-			size_t to_skip = (size_t)ufbxi_min64(offset, UFBXI_MAX_SKIP_SIZE);
-			if (!stream.skip_fn(stream.user, to_skip)) break;
-			offset -= to_skip;
-		}
+	// Readers return the whole frame in memory at once
+	const char *src_data = NULL;
+	if (opts.reader) {
+		ufbxi_cache_reader_imp *imp = (ufbxi_cache_reader_imp*)opts.reader;
+		ufbx_assert(imp->magic == UFBXI_CACHE_READER_IMP_MAGIC);
+		if (imp->magic != UFBXI_CACHE_READER_IMP_MAGIC) return 0;
+
+		size_t data_size = 0;
+		src_data = ufbxi_cache_reader_read_frame(imp, frame, src_count * src_size, &data_size);
+		if (!src_data) return 0;
+		src_count = data_size / src_size;
 	} else {
-		char buffer[4096]; // ufbxi_uninit
-		while (offset > 0) {
-			size_t to_skip = (size_t)ufbxi_min64(offset, sizeof(buffer));
-			size_t num_read = stream.read_fn(stream.user, buffer, to_skip);
-			if (num_read != to_skip) break;
-			offset -= to_skip;
+		if (!ufbxi_open_file(&opts.open_file_cb, &stream, frame->filename.data, frame->filename.length, NULL, NULL, UFBX_OPEN_FILE_GEOMETRY_CACHE)) {
+			return 0;
 		}
-	}
 
-	// Failed to skip all the way
-	if (offset > 0) {
-		if (stream.close_fn) {
-			stream.close_fn(stream.user);
+		// Skip to the correct point in the file
+		uint64_t offset = frame->data_offset;
+		if (stream.skip_fn) {
+			while (offset > 0) {
+				size_t to_skip = (size_t)ufbxi_min64(offset, UFBXI_MAX_SKIP_SIZE);
+				if (!stream.skip_fn(stream.user, to_skip)) break;
+				offset -= to_skip;
+			}
+		} else {
+			char buffer[4096]; // ufbxi_uninit
+			while (offset > 0) {
+				size_t to_skip = (size_t)ufbxi_min64(offset, sizeof(buffer));
+				size_t num_read = stream.read_fn(stream.user, buffer, to_skip);
+				if (num_read != to_skip) break;
+				offset -= to_skip;
+			}
+		}
+
+		// Failed to skip all the way
+		if (offset > 0) {
+			if (stream.close_fn) {
+				stream.close_fn(stream.user);
+			}
+			return 0;
 		}
-		return 0;
 	}
 
 	ufbx_real *dst = data;
@@ -32025,38 +37501,16 @@ ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_fr
 		size_t to_read = ufbxi_min_sz(src_count, UFBXI_GEOMETRY_CACHE_BUFFER_SIZE);
 		src_count -= to_read;
 		size_t num_read = 0;
-		if (use_double) {
-			size_t bytes_read = stream.read_fn(stream.user, buffer.src.f64, to_read * sizeof(double));
-			if (bytes_read == SIZE_MAX) bytes_read = 0;
-			num_read = bytes_read / sizeof(double);
-			if (src_big_endian != dst_big_endian) {
-				for (size_t i = 0; i < num_read; i++) {
-					char t, *v = (char*)&buffer.src.f64[i];
-					t = v[0]; v[0] = v[7]; v[7] = t;
-					t = v[1]; v[1] = v[6]; v[6] = t;
-					t = v[2]; v[2] = v[5]; v[5] = t;
-					t = v[3]; v[3] = v[4]; v[4] = t;
-				}
-			}
-			ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-				buffer.dst[i] = (ufbx_real)buffer.src.f64[i];
-			}
+		if (src_data) {
+			num_read = to_read;
+			ufbxi_decode_cache_values(buffer.dst, src_data, num_read, use_double, swap);
+			src_data += num_read * src_size;
 		} else {
-			size_t bytes_read = stream.read_fn(stream.user, buffer.src.f32, to_read * sizeof(float));
+			size_t bytes_read = stream.read_fn(stream.user, buffer.src.f64, to_read * src_size);
 			if (bytes_read == SIZE_MAX) bytes_read = 0;
-			num_read = bytes_read / sizeof(float);
-			if (src_big_endian != dst_big_endian) {
-				for (size_t i = 0; i < num_read; i++) {
-					char t, *v = (char*)&buffer.src.f32[i];
-					t = v[0]; v[0] = v[3]; v[3] = t;
-					t = v[1]; v[1] = v[2]; v[2] = t;
-				}
-			}
-			ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-				buffer.dst[i] = (ufbx_real)buffer.src.f32[i];
-			}
+			num_read = bytes_read / src_size;
+			ufbxi_decode_cache_values(buffer.dst, (const char*)buffer.src.f64, num_read, use_double, swap);
 		}
-
 		if (!opts.ignore_transform) {
 			ufbx_real scale = frame->scale_factor;
 			if (scale != 1.0f) {
@@ -32116,86 +37570,372 @@ ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_real(const ufbx_cache_
 		memset(&opts, 0, sizeof(opts));
 	}
 
-	size_t begin = 0;
-	size_t end = channel->frames.count;
+	ufbxi_cache_sample sample = ufbxi_find_cache_sample(channel, time);
 	const ufbx_cache_frame *frames = channel->frames.data;
-	while (end - begin >= 8) {
-		size_t mid = (begin + end) >> 1;
-		if (frames[mid].time < time) {
-			begin = mid + 1;
-		} else {
-			end = mid;
-		}
+	if (sample.prev == sample.next) {
+		return ufbx_read_geometry_cache_real(&frames[sample.prev], data, count, &opts);
 	}
 
-	const double eps = 0.00000001;
+	ufbx_real original_weight = opts.use_weight ? opts.weight : 1.0f;
 
-	end = channel->frames.count;
-	for (; begin < end; begin++) {
-		const ufbx_cache_frame *next = &frames[begin];
-		if (next->time < time) continue;
+	opts.use_weight = true;
+	opts.weight = (ufbx_real)(original_weight * (1.0 - sample.t));
+	size_t num_prev = ufbx_read_geometry_cache_real(&frames[sample.prev], data, count, &opts);
 
-		// First keyframe
-		if (begin == 0) {
-			return ufbx_read_geometry_cache_real(next, data, count, &opts);
-		}
+	opts.additive = true;
+	opts.weight = (ufbx_real)(original_weight * sample.t);
+	return ufbx_read_geometry_cache_real(&frames[sample.next], data, num_prev, &opts);
+#else
+	return 0;
+#endif
+}
 
-		const ufbx_cache_frame *prev = next - 1;
+ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_vec3(const ufbx_cache_frame *frame, ufbx_vec3 *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	if (!frame || count == 0) return 0;
+	ufbx_assert(data);
+	if (!data) return 0;
+	return ufbx_read_geometry_cache_real(frame, (ufbx_real*)data, count * 3, opts) / 3;
+#else
+	return 0;
+#endif
+}
 
-		// Snap to exact frames if near
-		if (ufbx_fabs(next->time - time) < eps) {
-			return ufbx_read_geometry_cache_real(next, data, count, &opts);
+ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_vec3(const ufbx_cache_channel *channel, double time, ufbx_vec3 *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	if (!channel || count == 0) return 0;
+	ufbx_assert(data);
+	if (!data) return 0;
+	return ufbx_sample_geometry_cache_real(channel, time, (ufbx_real*)data, count * 3, opts) / 3;
+#else
+	return 0;
+#endif
+}
+
+ufbx_abi ufbx_geometry_cache_reader *ufbx_create_geometry_cache_reader(const ufbx_geometry_cache_reader_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_geometry_cache_reader, opts, error);
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	ufbx_geometry_cache_reader_opts reader_opts; // ufbxi_uninit
+	if (opts) {
+		reader_opts = *opts;
+	} else {
+		memset(&reader_opts, 0, sizeof(reader_opts));
+	}
+	if (reader_opts.max_open_files == 0) {
+		reader_opts.max_open_files = 4;
+	}
+	if (reader_opts.max_buffered_file_size == 0) {
+		reader_opts.max_buffered_file_size = 64u * 1024u * 1024u;
+	}
+
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(&local_error, &ator, &reader_opts.allocator, "reader");
+
+	ufbxi_cache_reader_imp *imp = ufbxi_alloc(&ator, ufbxi_cache_reader_imp, 1);
+	ufbxi_cache_reader_file *files = imp ? ufbxi_alloc(&ator, ufbxi_cache_reader_file, reader_opts.max_open_files) : NULL;
+	if (!files) {
+		if (imp) {
+			ufbxi_free(&ator, ufbxi_cache_reader_imp, imp, 1);
 		}
-		if (ufbx_fabs(prev->time - time) < eps) {
-			return ufbx_read_geometry_cache_real(prev, data, count, &opts);
+		ufbxi_free_ator(&ator);
+		ufbxi_fix_error_type(&local_error, "Failed to create geometry cache reader", error);
+		return NULL;
+	}
+
+	memset(imp, 0, sizeof(ufbxi_cache_reader_imp));
+	memset(files, 0, reader_opts.max_open_files * sizeof(ufbxi_cache_reader_file));
+	imp->magic = UFBXI_CACHE_READER_IMP_MAGIC;
+	imp->opts = reader_opts;
+	imp->ator = ator;
+	imp->ator.error = &imp->error;
+	imp->files = files;
+	imp->num_files = reader_opts.max_open_files;
+
+	if (error) {
+		ufbxi_clear_error(error);
+	}
+	return &imp->reader;
+#else
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_GEOMETRY_CACHE");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_GEOMETRY_CACHE", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
+
+ufbx_abi void ufbx_free_geometry_cache_reader(ufbx_geometry_cache_reader *reader)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	if (!reader) return;
+
+	ufbxi_cache_reader_imp *imp = (ufbxi_cache_reader_imp*)reader;
+	ufbx_assert(imp->magic == UFBXI_CACHE_READER_IMP_MAGIC);
+	if (imp->magic != UFBXI_CACHE_READER_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	for (size_t i = 0; i < imp->num_files; i++) {
+		ufbxi_cache_reader_close(imp, &imp->files[i]);
+	}
+	ufbxi_free(&imp->ator, ufbxi_cache_reader_file, imp->files, imp->num_files);
+	if (imp->read_buf) {
+		ufbxi_free(&imp->ator, char, imp->read_buf, imp->read_buf_size);
+	}
+
+	// The allocator is stored in `imp` so copy it out before freeing
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_free(&ator, ufbxi_cache_reader_imp, imp, 1);
+	ufbxi_free_ator(&ator);
+#endif
+}
+
+ufbx_abi ufbx_cache_playback *ufbx_create_cache_playback(const ufbx_cache_channel *channel, const ufbx_cache_playback_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_cache_playback, opts, error);
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	ufbx_assert(channel);
+	ufbx_cache_playback_opts playback_opts; // ufbxi_uninit
+	if (opts) {
+		playback_opts = *opts;
+	} else {
+		memset(&playback_opts, 0, sizeof(playback_opts));
+	}
+	if (playback_opts.prefetch_frames == 0) {
+		playback_opts.prefetch_frames = 4;
+	}
+	if (playback_opts.memory_budget == 0) {
+		playback_opts.memory_budget = 256u * 1024u * 1024u;
+	}
+
+	size_t num_frame_values = 1;
+	ufbxi_for_list(ufbx_cache_frame, frame, channel->frames) {
+		size_t num_values = frame->data_count;
+		if (frame->data_format == UFBX_CACHE_DATA_FORMAT_VEC3_FLOAT || frame->data_format == UFBX_CACHE_DATA_FORMAT_VEC3_DOUBLE) {
+			num_values *= 3;
 		}
+		num_frame_values = ufbxi_max_sz(num_frame_values, num_values);
+	}
 
-		double rcp_delta = 1.0 / (next->time - prev->time);
-		double t = (time - prev->time) * rcp_delta;
+	// Buffer the frames being sampled and the prefetched ones within the budget
+	size_t num_slots = ufbxi_min_sz(playback_opts.prefetch_frames, SIZE_MAX - 2) + 2;
+	num_slots = ufbxi_min_sz(num_slots, playback_opts.memory_budget / (num_frame_values * sizeof(ufbx_real)));
+	num_slots = ufbxi_max_sz(num_slots, 2);
+
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(&local_error, &ator, &playback_opts.allocator, "playback");
 
-		ufbx_real original_weight = opts.use_weight ? opts.weight : 1.0f;
+	ufbxi_cache_playback_imp *imp = ufbxi_alloc(&ator, ufbxi_cache_playback_imp, 1);
+	if (!imp) {
+		ufbxi_free_ator(&ator);
+		ufbxi_fix_error_type(&local_error, "Failed to create cache playback", error);
+		return NULL;
+	}
 
-		opts.use_weight = true;
-		opts.weight = (ufbx_real)(original_weight * (1.0 - t));
-		size_t num_prev = ufbx_read_geometry_cache_real(prev, data, count, &opts);
+	memset(imp, 0, sizeof(ufbxi_cache_playback_imp));
+	imp->magic = UFBXI_CACHE_PLAYBACK_IMP_MAGIC;
+	imp->ator = ator;
+	imp->ator.error = &imp->error;
+	imp->playback.channel = (ufbx_cache_channel*)channel;
+	imp->playback.num_frame_values = num_frame_values;
+	imp->playback.num_buffered_frames = num_slots;
+	imp->prefetch_frames = playback_opts.prefetch_frames;
+	imp->read_opts.open_file_cb = playback_opts.open_file_cb;
+	imp->read_opts.ignore_transform = playback_opts.ignore_transform;
+
+	int ok = 1;
+	imp->slots = ufbxi_alloc(&imp->ator, ufbxi_cache_playback_slot, num_slots);
+	imp->values = imp->slots ? ufbxi_alloc(&imp->ator, ufbx_real, num_slots * num_frame_values) : NULL;
+	if (imp->values) {
+		imp->num_slots = num_slots;
+		imp->num_values = num_slots * num_frame_values;
+		for (size_t i = 0; i < num_slots; i++) {
+			ufbxi_cache_playback_slot *slot = &imp->slots[i];
+			memset(slot, 0, sizeof(ufbxi_cache_playback_slot));
+			slot->values = imp->values + i * num_frame_values;
+			slot->capacity = num_frame_values;
+			slot->frame_index = SIZE_MAX;
+			slot->read_opts = &imp->read_opts;
+		}
+		ok = ufbxi_thread_pool_init(&imp->thread_pool, &imp->error, &imp->ator, &playback_opts.thread_opts);
+	} else {
+		if (imp->slots) {
+			ufbxi_free(&imp->ator, ufbxi_cache_playback_slot, imp->slots, num_slots);
+			imp->slots = NULL;
+		}
+		ok = 0;
+	}
 
-		opts.additive = true;
-		opts.weight = (ufbx_real)(original_weight * t);
-		return ufbx_read_geometry_cache_real(next, data, num_prev, &opts);
+	if (!ok) {
+		ufbx_error imp_error = imp->error;
+		ufbxi_free_cache_playback_imp(imp);
+		ufbxi_fix_error_type(&imp_error, "Failed to create cache playback", error);
+		return NULL;
 	}
 
-	// Last frame
-	const ufbx_cache_frame *last = &frames[end - 1];
-	return ufbx_read_geometry_cache_real(last, data, count, &opts);
+	if (error) {
+		ufbxi_clear_error(error);
+	}
+	return &imp->playback;
 #else
-	return 0;
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_GEOMETRY_CACHE");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_GEOMETRY_CACHE", "Feature disabled");
+	}
+	return NULL;
 #endif
 }
 
-ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_vec3(const ufbx_cache_frame *frame, ufbx_vec3 *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
+ufbx_abi void ufbx_free_cache_playback(ufbx_cache_playback *playback)
 {
 #if UFBXI_FEATURE_GEOMETRY_CACHE
-	if (!frame || count == 0) return 0;
+	if (!playback) return;
+
+	ufbxi_cache_playback_imp *imp = (ufbxi_cache_playback_imp*)playback;
+	ufbx_assert(imp->magic == UFBXI_CACHE_PLAYBACK_IMP_MAGIC);
+	if (imp->magic != UFBXI_CACHE_PLAYBACK_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	ufbxi_free_cache_playback_imp(imp);
+#endif
+}
+
+ufbx_abi ufbxi_noinline size_t ufbx_cache_playback_sample_real(ufbx_cache_playback *playback, double time, ufbx_real *data, size_t count, const ufbx_geometry_cache_data_opts *user_opts)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	ufbxi_check_opts_return_no_error(0, user_opts);
+	if (!playback || count == 0) return 0;
 	ufbx_assert(data);
 	if (!data) return 0;
-	return ufbx_read_geometry_cache_real(frame, (ufbx_real*)data, count * 3, opts) / 3;
+
+	ufbxi_cache_playback_imp *imp = (ufbxi_cache_playback_imp*)playback;
+	ufbx_assert(imp->magic == UFBXI_CACHE_PLAYBACK_IMP_MAGIC);
+	if (imp->magic != UFBXI_CACHE_PLAYBACK_IMP_MAGIC) return 0;
+
+	ufbx_geometry_cache_data_opts opts; // ufbxi_uninit
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
+
+	return ufbxi_cache_playback_sample(imp, time, data, count, &opts);
 #else
 	return 0;
 #endif
 }
 
-ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_vec3(const ufbx_cache_channel *channel, double time, ufbx_vec3 *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
+ufbx_abi ufbxi_noinline size_t ufbx_cache_playback_sample_vec3(ufbx_cache_playback *playback, double time, ufbx_vec3 *data, size_t count, const ufbx_geometry_cache_data_opts *opts)
 {
 #if UFBXI_FEATURE_GEOMETRY_CACHE
-	if (!channel || count == 0) return 0;
+	if (!playback || count == 0) return 0;
 	ufbx_assert(data);
 	if (!data) return 0;
-	return ufbx_sample_geometry_cache_real(channel, time, (ufbx_real*)data, count * 3, opts) / 3;
+	return ufbx_cache_playback_sample_real(playback, time, (ufbx_real*)data, count * 3, opts) / 3;
 #else
 	return 0;
 #endif
 }
 
+ufbx_abi ufbxi_noinline size_t ufbx_read_embedded_file(const ufbx_embedded_location *location, const char *filename, void *data, size_t data_size, const ufbx_read_embedded_opts *opts)
+{
+	return ufbx_read_embedded_file_len(location, filename, strlen(filename), data, data_size, opts);
+}
+
+ufbx_abi ufbxi_noinline size_t ufbx_read_embedded_file_len(const ufbx_embedded_location *location, const char *filename, size_t filename_len, void *data, size_t data_size, const ufbx_read_embedded_opts *user_opts)
+{
+	if (!location || location->encoding == UFBX_EMBEDDED_ENCODING_NONE) return 0;
+	ufbxi_check_opts_return_no_error(0, user_opts);
+
+	ufbx_read_embedded_opts opts; // ufbxi_uninit
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
+	if (!opts.open_file_cb.fn) {
+		opts.open_file_cb.fn = ufbx_default_open_file;
+	}
+
+	ufbx_stream stream = { 0 };
+	if (!ufbxi_open_file(&opts.open_file_cb, &stream, filename, filename_len, NULL, NULL, UFBX_OPEN_FILE_MAIN_MODEL)) {
+		return 0;
+	}
+
+	size_t result = ufbx_read_embedded_stream(location, &stream, data, data_size);
+	if (stream.close_fn) {
+		stream.close_fn(stream.user);
+	}
+	return result;
+}
+
+ufbx_abi ufbxi_noinline size_t ufbx_read_embedded_memory(const ufbx_embedded_location *location, const void *file_data, size_t file_size, void *data, size_t data_size)
+{
+	if (!location || !file_data) return 0;
+	if (location->offset > file_size || location->encoded_size > file_size - location->offset) return 0;
+
+	const char *src = (const char*)file_data + location->offset;
+	size_t src_size = (size_t)location->encoded_size;
+	size_t size = ufbxi_min_sz(location->size, data_size);
+
+	switch (location->encoding) {
+	case UFBX_EMBEDDED_ENCODING_RAW: {
+		size = ufbxi_min_sz(size, src_size);
+		memcpy(data, src, size);
+		return size;
+	}
+	case UFBX_EMBEDDED_ENCODING_BASE64: {
+		ufbxi_base64_decoder dec; // ufbxi_uninit
+		ufbxi_base64_decoder_init(&dec, data, size);
+		ufbxi_base64_decode_chunk(&dec, src, src_size);
+		return dec.failed || dec.in_string ? 0 : ufbxi_min_sz(dec.pos, size);
+	}
+	default:
+		return 0;
+	}
+}
+
+ufbx_abi ufbxi_noinline size_t ufbx_read_embedded_stream(const ufbx_embedded_location *location, ufbx_stream *stream, void *data, size_t data_size)
+{
+	if (!location || !stream || !stream->read_fn) return 0;
+	if (location->encoding != UFBX_EMBEDDED_ENCODING_RAW && location->encoding != UFBX_EMBEDDED_ENCODING_BASE64) return 0;
+	if (!ufbxi_skip_stream(stream, location->offset)) return 0;
+
+	size_t size = ufbxi_min_sz(location->size, data_size);
+	if (location->encoding == UFBX_EMBEDDED_ENCODING_RAW) {
+		char *dst = (char*)data;
+		size = (size_t)ufbxi_min64(size, location->encoded_size);
+		size_t num_read = 0;
+		while (num_read < size) {
+			size_t to_read = size - num_read;
+			size_t result = stream->read_fn(stream->user, dst + num_read, to_read);
+			if (result == 0 || result > to_read) break;
+			num_read += result;
+		}
+		return num_read;
+	} else {
+		ufbxi_base64_decoder dec; // ufbxi_uninit
+		ufbxi_base64_decoder_init(&dec, data, size);
+
+		char buffer[4096]; // ufbxi_uninit
+		uint64_t left = location->encoded_size;
+		while (left > 0) {
+			size_t to_read = (size_t)ufbxi_min64(left, sizeof(buffer));
+			size_t result = stream->read_fn(stream->user, buffer, to_read);
+			if (result == 0 || result > to_read) break;
+			ufbxi_base64_decode_chunk(&dec, buffer, result);
+			left -= result;
+		}
+		return dec.failed || dec.in_string ? 0 : ufbxi_min_sz(dec.pos, size);
+	}
+}
+
 ufbx_abi ufbx_dom_node *ufbx_dom_find_len(const ufbx_dom_node *parent, const char *name, size_t name_len)
 {
 	ufbx_string ref = ufbxi_safe_string(name, name_len);
@@ -32207,12 +37947,17 @@ ufbx_abi ufbx_dom_node *ufbx_dom_find_len(const ufbx_dom_node *parent, const cha
 
 ufbx_abi size_t ufbx_generate_indices(const ufbx_vertex_stream *streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_allocator_opts *allocator, ufbx_error *error)
 {
-	ufbx_error local_error; // ufbxi_uninit
-	if (!error) {
-		error = &local_error;
+	ufbx_generate_indices_opts opts = { 0 };
+	if (allocator) {
+		opts.temp_allocator = *allocator;
 	}
-	memset(error, 0, sizeof(ufbx_error));
-	return ufbxi_generate_indices(streams, num_streams, indices, num_indices, allocator, error);
+	return ufbxi_generate_indices(streams, num_streams, indices, num_indices, &opts, error);
+}
+
+ufbx_abi size_t ufbx_generate_indices_ex(const ufbx_vertex_stream *streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_generate_indices_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_return(0, opts, error);
+	return ufbxi_generate_indices(streams, num_streams, indices, num_indices, opts, error);
 }
 
 ufbx_abi void ufbx_thread_pool_run_task(ufbx_thread_pool_context ctx, uint32_t index)
@@ -385,12 +385,15 @@ typedef struct ufbx_void_list {
 } ufbx_void_list;
 
 UFBX_LIST_TYPE(ufbx_bool_list, bool);
+UFBX_LIST_TYPE(ufbx_uint16_list, uint16_t);
 UFBX_LIST_TYPE(ufbx_uint32_list, uint32_t);
 UFBX_LIST_TYPE(ufbx_real_list, ufbx_real);
 UFBX_LIST_TYPE(ufbx_vec2_list, ufbx_vec2);
 UFBX_LIST_TYPE(ufbx_vec3_list, ufbx_vec3);
 UFBX_LIST_TYPE(ufbx_vec4_list, ufbx_vec4);
 UFBX_LIST_TYPE(ufbx_string_list, ufbx_string);
+UFBX_LIST_TYPE(ufbx_const_uint32_list, const uint32_t);
+UFBX_LIST_TYPE(ufbx_const_real_list, const ufbx_real);
 
 // Sentinel value used to represent a missing index.
 #define UFBX_NO_INDEX ((uint32_t)~0u)
@@ -2216,6 +2219,40 @@ typedef struct ufbx_geometry_cache {
 	ufbx_string_list extra_info;
 } ufbx_geometry_cache;
 
+// Persistent state for reading geometry cache frames, see `ufbx_create_geometry_cache_reader()`.
+// Keeps recently used cache files open or memory mapped between reads.
+// NOTE: A reader may only be used from one thread at a time.
+typedef struct ufbx_geometry_cache_reader {
+
+	// Number of times a cache file has been opened.
+	size_t num_files_opened;
+
+	// Number of frames read through the reader.
+	size_t num_frames_read;
+
+} ufbx_geometry_cache_reader;
+
+// Frame buffer for playing back a single geometry cache channel, see `ufbx_create_cache_playback()`.
+// NOTE: A playback object may only be used from one thread at a time.
+typedef struct ufbx_cache_playback {
+
+	// Channel that is played back, must be kept alive while using the playback.
+	ufbx_cache_channel *channel;
+
+	// Number of `ufbx_real` values buffered for each frame.
+	size_t num_frame_values;
+
+	// Number of frames that fit in the buffer.
+	size_t num_buffered_frames;
+
+	// Frames that were already buffered or prefetched when they were needed.
+	size_t num_frame_hits;
+
+	// Frames that had to be read synchronously when sampling.
+	size_t num_frame_misses;
+
+} ufbx_cache_playback;
+
 struct ufbx_cache_deformer {
 	union { ufbx_element element; struct {
 		ufbx_string name;
@@ -2830,6 +2867,25 @@ typedef struct ufbx_shader_texture {
 
 } ufbx_shader_texture;
 
+typedef enum ufbx_embedded_encoding UFBX_ENUM_REPR {
+	UFBX_EMBEDDED_ENCODING_NONE,   // < No deferred content
+	UFBX_EMBEDDED_ENCODING_RAW,    // < Raw bytes stored contiguously in the file
+	UFBX_EMBEDDED_ENCODING_BASE64, // < Quoted base64 strings separated by commas (ASCII)
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_EMBEDDED_ENCODING)
+} ufbx_embedded_encoding;
+
+UFBX_ENUM_TYPE(ufbx_embedded_encoding, UFBX_EMBEDDED_ENCODING, UFBX_EMBEDDED_ENCODING_BASE64);
+
+// Location of embedded content in the original file, see `ufbx_load_opts.defer_embedded`.
+// Use `ufbx_read_embedded_file/memory/stream()` to load the content.
+typedef struct ufbx_embedded_location {
+	ufbx_embedded_encoding encoding; // < Encoding of the data in the file
+	uint64_t offset;                 // < Byte offset into the file
+	uint64_t encoded_size;           // < Number of bytes in the file starting from `offset`
+	size_t size;                     // < Size of the decoded content in bytes
+} ufbx_embedded_location;
+
 // Unique texture within the file.
 typedef struct ufbx_texture_file {
 
@@ -2861,6 +2917,9 @@ typedef struct ufbx_texture_file {
 	// Optional embedded content blob, eg. raw .png format data
 	ufbx_blob content;
 
+	// Location of the embedded content if loaded with `ufbx_load_opts.defer_embedded`.
+	ufbx_embedded_location content_location;
+
 } ufbx_texture_file;
 
 UFBX_LIST_TYPE(ufbx_texture_file_list, ufbx_texture_file);
@@ -2902,6 +2961,9 @@ struct ufbx_texture {
 	// FILE: Optional embedded content blob, eg. raw .png format data
 	ufbx_blob content;
 
+	// FILE: Location of the embedded content if loaded with `ufbx_load_opts.defer_embedded`.
+	ufbx_embedded_location content_location;
+
 	// FILE: Optional video texture
 	ufbx_nullable ufbx_video *video;
 
@@ -2970,6 +3032,9 @@ struct ufbx_video {
 
 	// Optional embedded content blob
 	ufbx_blob content;
+
+	// Location of the embedded content if loaded with `ufbx_load_opts.defer_embedded`.
+	ufbx_embedded_location content_location;
 };
 
 // Shader specifies a shading model and contains `ufbx_shader_binding` elements
@@ -3034,6 +3099,8 @@ typedef struct ufbx_transform_override {
 
 UFBX_LIST_TYPE(ufbx_transform_override_list, ufbx_transform_override);
 
+typedef struct ufbx_anim_cursor ufbx_anim_cursor;
+
 // Animation descriptor used for evaluating animation.
 // Usually obtained from `ufbx_scene` via either global animation `ufbx_scene.anim`,
 // per-stack animation `ufbx_anim_stack.anim` or per-layer animation `ufbx_anim_layer.anim`.
@@ -3061,11 +3128,26 @@ typedef struct ufbx_anim {
 	// Evaluate connected properties as if they would not be connected.
 	bool ignore_connections;
 
-	// Custom `ufbx_anim` created by `ufbx_create_anim()`.
+	// Custom `ufbx_anim` created by `ufbx_create_anim()` or `ufbx_create_anim_cursor()`.
+	// NOTE: Custom animations must be passed by pointer, not as copies.
 	bool custom;
 
 } ufbx_anim;
 
+// Remembers the last evaluated keyframe of each curve for fast sequential playback.
+// Use `anim` with any animation evaluation function, eg. `ufbx_evaluate_transform()`.
+// NOTE: Evaluating `anim` modifies the cursor so it must not be used from multiple threads.
+struct ufbx_anim_cursor {
+
+	// Copy of the animation passed to `ufbx_create_anim_cursor()` that uses this cursor.
+	ufbx_anim *anim;
+
+	// Number of keyframe lookups that were resolved close to the previous keyframe
+	// and the ones that needed a full search, eg. due to seeking backwards.
+	uint64_t num_sequential_lookups;
+	uint64_t num_search_lookups;
+};
+
 struct ufbx_anim_stack {
 	union { ufbx_element element; struct {
 		ufbx_string name;
@@ -3385,6 +3467,9 @@ struct ufbx_audio_clip {
 
 	// Optional embedded content blob, eg. raw .png format data
 	ufbx_blob content;
+
+	// Location of the embedded content if loaded with `ufbx_load_opts.defer_embedded`.
+	ufbx_embedded_location content_location;
 };
 
 // -- Miscellaneous
@@ -4240,6 +4325,21 @@ typedef struct ufbx_progress_cb {
 		(progress))
 } ufbx_progress_cb;
 
+// -- Mesh streaming
+
+// Called with each mesh as soon as its geometry has been read, see `ufbx_load_opts.mesh_cb`.
+// Return `false` to cancel loading and fail with `UFBX_ERROR_CANCELLED`.
+typedef bool ufbx_mesh_fn(void *user, ufbx_mesh *mesh);
+
+typedef struct ufbx_mesh_cb {
+	ufbx_mesh_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_mesh_cb, ufbx_mesh_fn, bool,
+		(void *user, ufbx_mesh *mesh),
+		(mesh))
+} ufbx_mesh_cb;
+
 // -- Inflate
 
 typedef struct ufbx_inflate_input ufbx_inflate_input;
@@ -4530,6 +4630,77 @@ typedef struct ufbx_baked_anim {
 
 } ufbx_baked_anim;
 
+// Uniformly sampled vec3 track quantized to 16 bits per component.
+// Sample `i` is at time `ufbx_compact_anim.time_begin + i / ufbx_compact_anim.sample_rate`
+// and component `c` of it decodes to `min.c + scale.c * ufbx_compact_anim.data[data_offset + i*3 + c]`.
+typedef struct ufbx_compact_vec3_track {
+	uint32_t data_offset; // < Index of the first sample in `ufbx_compact_anim.data`
+	uint32_t num_samples; // < Number of samples, `1` for constant tracks
+	ufbx_vec3 min;        // < Value of quantized zero
+	ufbx_vec3 scale;      // < Value of a single quantization step
+} ufbx_compact_vec3_track;
+
+// Uniformly sampled rotation track using "smallest three" quaternion encoding.
+// Each sample is three 16-bit values, storing the three smallest components in the low 15 bits
+// and the index of the dropped largest (positive) component in the top bits of the first two.
+typedef struct ufbx_compact_quat_track {
+	uint32_t data_offset; // < Index of the first sample in `ufbx_compact_anim.data`
+	uint32_t num_samples; // < Number of samples, `1` for constant tracks
+} ufbx_compact_quat_track;
+
+// Compact transform animation for a single node, see `ufbx_baked_node`.
+typedef struct ufbx_compact_node {
+	uint32_t typed_id;
+	uint32_t element_id;
+	ufbx_compact_vec3_track translation;
+	ufbx_compact_quat_track rotation;
+	ufbx_compact_vec3_track scale;
+} ufbx_compact_node;
+
+UFBX_LIST_TYPE(ufbx_compact_node_list, ufbx_compact_node);
+
+// Compact property animation, see `ufbx_baked_prop`.
+typedef struct ufbx_compact_prop {
+	// Name of the property, eg. `"Visibility"`.
+	ufbx_string name;
+	// Property value track, `num_samples == 1` if the value is constant.
+	ufbx_compact_vec3_track value;
+} ufbx_compact_prop;
+
+UFBX_LIST_TYPE(ufbx_compact_prop_list, ufbx_compact_prop);
+
+// Compact property animation for a single element, see `ufbx_baked_element`.
+typedef struct ufbx_compact_element {
+	// Element ID of the element, maps to `ufbx_scene.elements[]`.
+	uint32_t element_id;
+	// List of properties the animation modifies.
+	ufbx_compact_prop_list props;
+} ufbx_compact_element;
+
+UFBX_LIST_TYPE(ufbx_compact_element_list, ufbx_compact_element);
+
+// Baked animation resampled at a uniform rate and quantized for a small memory footprint.
+// Tracks don't store key times and all quantized samples are in a single `data` array,
+// see `ufbx_compact_baked_anim()`.
+typedef struct ufbx_compact_anim {
+
+	// Sorted by `typed_id` and `element_id` like in `ufbx_baked_anim`.
+	ufbx_compact_node_list nodes;
+	ufbx_compact_element_list elements;
+
+	// Quantized samples of all tracks.
+	ufbx_uint16_list data;
+
+	// Time of the first and last sample and the number of samples per second.
+	double time_begin;
+	double time_end;
+	double sample_rate;
+
+	// Number of samples in non-constant tracks.
+	size_t num_samples;
+
+} ufbx_compact_anim;
+
 // -- Thread API
 
 // Internal thread pool handle.
@@ -4615,6 +4786,11 @@ typedef struct ufbx_load_opts {
 	bool ignore_embedded;    // < Do not load embedded content
 	bool ignore_all_content; // < Do not load any content (geometry, animation, embedded)
 
+	// Do not load embedded video and audio content, only record where it is in the file.
+	// See `ufbx_video.content_location` and `ufbx_read_embedded_file/memory/stream()`.
+	// NOTE: Ignored if `ignore_embedded` is set, retained DOM arrays are `UFBX_DOM_VALUE_ARRAY_IGNORED`.
+	bool defer_embedded;
+
 	bool evaluate_skinning; // < Evaluate skinning (see ufbx_mesh.skinned_vertices)
 	bool evaluate_caches;   // < Evaluate vertex caches (see ufbx_mesh.skinned_vertices)
 
@@ -4658,6 +4834,8 @@ typedef struct ufbx_load_opts {
 	// Force ASCII parsing to use a single thread.
 	// The multi-threaded ASCII parsing is slightly more lenient as it ignores
 	// the self-reported size of ASCII arrays, that threaded parsing depends on.
+	// NOTE: Files loaded from memory are indexed up front, arrays whose reported
+	// size doesn't match their contents fall back to single-threaded parsing.
 	bool force_single_thread_ascii_parsing;
 
 	// UNSAFE: If enabled allows using unsafe options that may fundamentally
@@ -4705,6 +4883,23 @@ typedef struct ufbx_load_opts {
 	// Buffer size in bytes to use for reading from files or IO callbacks
 	size_t read_buffer_size;
 
+	// Memory map the file opened by `ufbx_load_file()` and parse it in place like
+	// `ufbx_load_memory()` instead of reading it in `read_buffer_size` chunks.
+	// Only supported on Linux, falls back to regular reading if the file cannot be
+	// mapped or if `open_file_cb` is used for the main file.
+	// NOTE: The file must not be truncated by other processes during loading.
+	bool map_main_file;
+
+	// Don't verify the Adler-32 checksums of compressed binary FBX arrays.
+	// Saves some time when loading trusted files, but corrupted arrays may go undetected.
+	bool skip_deflate_checksum;
+
+	// Parse floating point numbers in ASCII FBX and OBJ files approximately.
+	// Numbers with more than 17 significant digits are truncated instead of being
+	// rounded using arbitrary precision arithmetic, which may be off by one unit in
+	// the last place. Useful for previews of files written with excessive precision.
+	bool approximate_float_parsing;
+
 	// Filename to use as a base for relative file paths if not specified using
 	// `ufbx_load_file()`. Use `length = SIZE_MAX` for NULL-terminated strings.
 	// `raw_filename` will be derived from this if empty.
@@ -4721,6 +4916,15 @@ typedef struct ufbx_load_opts {
 	// External file callbacks (defaults to stdio.h)
 	ufbx_open_file_cb open_file_cb;
 
+	// Stream meshes to a callback instead of keeping their geometry in the scene.
+	// Called for each mesh as soon as its geometry and vertex attributes have been read,
+	// other data such as materials, deformers and instances are not available yet.
+	// The geometry is released after the callback returns, the meshes in the resulting
+	// scene are empty as if `ignore_geometry` was set.
+	// NOTE: Only supported for FBX files. Memory is only saved for post-6000 files,
+	// legacy meshes are read in full.
+	ufbx_mesh_cb mesh_cb;
+
 	// How to handle geometry transforms in the nodes.
 	// See `ufbx_geometry_transform_handling` for an explanation.
 	ufbx_geometry_transform_handling geometry_transform_handling;
@@ -4849,6 +5053,31 @@ typedef struct ufbx_load_opts {
 	uint32_t _end_zero;
 } ufbx_load_opts;
 
+// Data reused between `ufbx_evaluate_scene()` calls, see `ufbx_create_evaluate_cache()`.
+// Contains the normal mapping of deformed meshes so that only the normal values
+// need to be recomputed when evaluating skinning.
+// NOTE: Evaluation does not modify the cache so it can be shared between threads.
+typedef struct ufbx_evaluate_cache {
+
+	// Scene the cache was created for.
+	ufbx_scene *scene;
+
+	// Number of meshes with a cached normal mapping.
+	size_t num_meshes;
+
+} ufbx_evaluate_cache;
+
+// Options for `ufbx_create_evaluate_cache()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_evaluate_cache_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during creation
+	ufbx_allocator_opts result_allocator; // < Allocator used for the cache
+
+	uint32_t _end_zero;
+} ufbx_evaluate_cache_opts;
+
 // Options for `ufbx_evaluate_scene()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_evaluate_opts {
@@ -4866,12 +5095,28 @@ typedef struct ufbx_evaluate_opts {
 	// External file callbacks (defaults to stdio.h)
 	ufbx_open_file_cb open_file_cb;
 
+	// Read geometry caches through a reader that keeps files open between evaluations.
+	// `open_file_cb` is not used for caches if this is specified.
+	ufbx_geometry_cache_reader *cache_reader;
+
+	// Skin the vertices of large meshes in parallel using a thread pool.
+	// Only used if `evaluate_skinning` is set.
+	ufbx_thread_opts thread_opts;
+
+	// Reuse normal mappings when evaluating skinning, must be created for the scene
+	// passed to `ufbx_evaluate_scene()`, see `ufbx_create_evaluate_cache()`.
+	ufbx_evaluate_cache *cache;
+
+	// Only evaluate the hierarchies under these nodes (`ufbx_node.typed_id`) along with
+	// their ancestors, attributes, materials, deformers, skinning bones and constraints.
+	// Meshes skinned to the selected nodes, or sharing deformers with included meshes,
+	// are evaluated as well. Other elements retain their values from the original scene, or the previous
+	// evaluation in `ufbx_evaluate_scene_in_place()`. Empty evaluates all elements.
+	ufbx_const_uint32_list root_node_ids;
+
 	uint32_t _end_zero;
 } ufbx_evaluate_opts;
 
-UFBX_LIST_TYPE(ufbx_const_uint32_list, const uint32_t);
-UFBX_LIST_TYPE(ufbx_const_real_list, const ufbx_real);
-
 typedef struct ufbx_prop_override_desc {
 	// Element (`ufbx_element.element_id`) to override the property from
 	uint32_t element_id;
@@ -4916,6 +5161,16 @@ typedef struct ufbx_anim_opts {
 	uint32_t _end_zero;
 } ufbx_anim_opts;
 
+// Options for `ufbx_create_anim_cursor()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_anim_cursor_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts allocator; // < Allocator used for the cursor
+
+	uint32_t _end_zero;
+} ufbx_anim_cursor_opts;
+
 // Specifies how to handle stepped tangents.
 typedef enum ufbx_bake_step_handling UFBX_ENUM_REPR {
 
@@ -4946,6 +5201,23 @@ typedef enum ufbx_bake_step_handling UFBX_ENUM_REPR {
 
 UFBX_ENUM_TYPE(ufbx_bake_step_handling, UFBX_BAKE_STEP_HANDLING, UFBX_BAKE_STEP_HANDLING_IGNORE);
 
+// Algorithm used to remove keys when `ufbx_bake_opts.key_reduction_enabled` is set.
+typedef enum ufbx_bake_key_reduction UFBX_ENUM_REPR {
+
+	// Remove keys that are redundant compared to their immediate neighbors.
+	// See `ufbx_bake_opts.key_reduction_threshold` and `ufbx_bake_opts.key_reduction_passes`.
+	UFBX_BAKE_KEY_REDUCTION_LOCAL,
+
+	// Remove as many keys as possible while interpolating the remaining keys stays
+	// within a per-channel tolerance of every sampled key.
+	// See `ufbx_bake_opts.key_reduction_translation_tolerance` and related options.
+	UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED,
+
+	UFBX_ENUM_FORCE_WIDTH(ufbx_bake_key_reduction)
+} ufbx_bake_key_reduction;
+
+UFBX_ENUM_TYPE(ufbx_bake_key_reduction, UFBX_BAKE_KEY_REDUCTION, UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED);
+
 typedef struct ufbx_bake_opts {
 	uint32_t _begin_zero;
 
@@ -5017,9 +5289,53 @@ typedef struct ufbx_bake_opts {
 	// Default: `4`
 	size_t key_reduction_passes;
 
+	// Algorithm to use for key reduction.
+	ufbx_bake_key_reduction key_reduction_mode;
+
+	// Maximum translation error in scene units for `UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED`.
+	// Default: `0.001`
+	double key_reduction_translation_tolerance;
+
+	// Maximum rotation error in degrees for `UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED`.
+	// Default: `0.01`
+	double key_reduction_rotation_tolerance;
+
+	// Maximum scale error for `UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED`.
+	// Default: `0.0001`
+	double key_reduction_scale_tolerance;
+
+	// Maximum error of baked properties for `UFBX_BAKE_KEY_REDUCTION_ERROR_BOUNDED`.
+	// Default: `0.0001`
+	double key_reduction_prop_tolerance;
+
+	// Tighten the rotation and scale tolerances of nodes based on the distance to their
+	// furthest descendant, so that the resulting error of descendant positions stays
+	// approximately within `key_reduction_translation_tolerance`.
+	bool key_reduction_hierarchy_error;
+
+	// Sample the animation of independent nodes and properties in parallel.
+	// The result is identical to baking without a thread pool.
+	ufbx_thread_opts thread_opts;
+
 	uint32_t _end_zero;
 } ufbx_bake_opts;
 
+// Options for `ufbx_compact_baked_anim()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_compact_anim_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during conversion
+	ufbx_allocator_opts result_allocator; // < Allocator used for the final compact animation
+
+	// Uniform sample rate for all the tracks in samples per second.
+	// NOTE: Steps and keyframes are not preserved exactly, use a rate high enough for the content.
+	// Default: 30
+	double sample_rate;
+
+	uint32_t _end_zero;
+} ufbx_compact_anim_opts;
+
 // Options for `ufbx_tessellate_nurbs_curve()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_tessellate_curve_opts {
@@ -5097,6 +5413,35 @@ typedef struct ufbx_subdivide_opts {
 	uint32_t _end_zero;
 } ufbx_subdivide_opts;
 
+// Options for `ufbx_triangulate_mesh()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_triangulate_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator; // < Allocator used for internal bookkeeping
+
+	// Triangulate large meshes in parallel using a thread pool.
+	// Each task processes a contiguous range of faces.
+	ufbx_thread_opts thread_opts;
+
+	uint32_t _end_zero;
+} ufbx_triangulate_opts;
+
+// Options for `ufbx_generate_indices_ex()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_generate_indices_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator; // < Allocator used during index generation
+
+	// Pack and hash the vertices of large inputs in parallel using a thread pool.
+	// The deduplication itself is serial, so the result is identical to the non-threaded one.
+	// Packed vertices waiting for deduplication are limited by `ufbx_thread_opts.memory_limit`.
+	ufbx_thread_opts thread_opts;
+
+	uint32_t _end_zero;
+} ufbx_generate_indices_opts;
+
 // Options for `ufbx_load_geometry_cache()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_geometry_cache_opts {
@@ -5138,9 +5483,75 @@ typedef struct ufbx_geometry_cache_data_opts {
 	// Ignore scene transform.
 	bool ignore_transform;
 
+	// Reuse open files between reads, see `ufbx_create_geometry_cache_reader()`.
+	// `open_file_cb` is ignored if this is specified.
+	ufbx_geometry_cache_reader *reader;
+
 	uint32_t _end_zero;
 } ufbx_geometry_cache_data_opts;
 
+// Options for `ufbx_read_embedded_file()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_read_embedded_opts {
+	uint32_t _begin_zero;
+
+	// External file callbacks (defaults to stdio.h)
+	ufbx_open_file_cb open_file_cb;
+
+	uint32_t _end_zero;
+} ufbx_read_embedded_opts;
+
+// Options for `ufbx_create_geometry_cache_reader()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_geometry_cache_reader_opts {
+	uint32_t _begin_zero;
+
+	// Allocator used for the reader and buffered files
+	ufbx_allocator_opts allocator;
+
+	// External file callbacks (defaults to stdio.h)
+	// Files are memory mapped instead where supported if this is not set.
+	ufbx_open_file_cb open_file_cb;
+
+	// Maximum number of files to keep open at once, defaults to 4.
+	size_t max_open_files;
+
+	// Files opened via `open_file_cb` up to this size are read fully into memory,
+	// larger files are streamed. Defaults to 64MB, set to `SIZE_MAX` to always stream.
+	size_t max_buffered_file_size;
+
+	uint32_t _end_zero;
+} ufbx_geometry_cache_reader_opts;
+
+// Options for `ufbx_create_cache_playback()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_cache_playback_opts {
+	uint32_t _begin_zero;
+
+	// Allocator used for the playback and the frame buffer
+	ufbx_allocator_opts allocator;
+
+	// Thread pool used to read upcoming frames in the background.
+	// Without a thread pool frames are still buffered but read only when needed.
+	ufbx_thread_opts thread_opts;
+
+	// External file callbacks (defaults to stdio.h)
+	// NOTE: Called from thread pool tasks if `thread_opts` is specified.
+	ufbx_open_file_cb open_file_cb;
+
+	// Number of frames to read ahead in the direction of playback, defaults to 4.
+	size_t prefetch_frames;
+
+	// Maximum memory used for buffered frames, defaults to 256MB.
+	// At least two frames are always buffered so that samples can be interpolated.
+	size_t memory_budget;
+
+	// Ignore scene transform.
+	bool ignore_transform;
+
+	uint32_t _end_zero;
+} ufbx_cache_playback_opts;
+
 typedef struct ufbx_panic {
 	bool did_panic;
 	size_t message_length;
@@ -5331,6 +5742,15 @@ ufbx_unsafe ufbx_abi bool ufbx_open_memory_ctx(ufbx_stream *stream, ufbx_open_fi
 // Returns `default_value` only if `curve == NULL` or it has no keyframes.
 ufbx_abi ufbx_real ufbx_evaluate_curve(const ufbx_anim_curve *curve, double time, ufbx_real default_value);
 
+// Evaluate `count` animation `curves` at a single `time` into `values`.
+// Equivalent to `values[i] = ufbx_evaluate_curve(curves[i], time, default_value)`.
+ufbx_abi void ufbx_evaluate_curves(const ufbx_anim_curve *const *curves, ufbx_real *values, size_t count, double time, ufbx_real default_value);
+
+// Evaluate a single animation `curve` at `count` different `times` into `values`.
+// Equivalent to `values[i] = ufbx_evaluate_curve(curve, times[i], default_value)`.
+// HINT: Fastest if `times` are sorted as keyframes are then searched incrementally.
+ufbx_abi void ufbx_evaluate_curve_times(const ufbx_anim_curve *curve, const double *times, ufbx_real *values, size_t count, ufbx_real default_value);
+
 // Evaluate a value from bundled animation curves.
 ufbx_abi ufbx_real ufbx_evaluate_anim_value_real(const ufbx_anim_value *anim_value, double time);
 ufbx_abi ufbx_vec3 ufbx_evaluate_anim_value_vec3(const ufbx_anim_value *anim_value, double time);
@@ -5388,6 +5808,21 @@ ufbx_abi ufbx_real ufbx_evaluate_blend_weight(const ufbx_anim *anim, const ufbx_
 // scene cannot be freed until all evaluated scenes are freed.
 ufbx_abi ufbx_scene *ufbx_evaluate_scene(const ufbx_scene *scene, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *opts, ufbx_error *error);
 
+// Re-evaluate `state` returned by `ufbx_evaluate_scene()` at a different `time`.
+// Updates animated properties, derived element values and deformed vertices
+// in place, reusing the memory of the previous evaluation where possible.
+// `anim` must belong to the original scene, `NULL` uses its default animation.
+// `opts.result_allocator` is ignored as the memory is owned by `state`.
+// Returns `false` on failure, leaving `state` partially updated.
+// NOTE: Pointers into `state` stay valid but their contents are overwritten.
+ufbx_abi bool ufbx_evaluate_scene_in_place(ufbx_scene *state, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *opts, ufbx_error *error);
+
+// Compute data that is reused by `ufbx_evaluate_scene()` calls on `scene`, see `ufbx_evaluate_opts.cache`.
+// The cache must be freed before `scene`.
+ufbx_abi ufbx_evaluate_cache *ufbx_create_evaluate_cache(const ufbx_scene *scene, const ufbx_evaluate_cache_opts *opts, ufbx_error *error);
+// Free a cache returned by `ufbx_create_evaluate_cache()`.
+ufbx_abi void ufbx_free_evaluate_cache(ufbx_evaluate_cache *cache);
+
 // Create a custom animation descriptor.
 // `ufbx_anim_opts` is used to specify animation layers and weights.
 // HINT: You can also leave `ufbx_anim_opts.layer_ids[]` empty and only specify
@@ -5400,6 +5835,19 @@ ufbx_abi void ufbx_free_anim(ufbx_anim *anim);
 // Increase the animation reference count.
 ufbx_abi void ufbx_retain_anim(ufbx_anim *anim);
 
+// Create a cursor for evaluating `anim` (or `scene->anim` if `NULL`) of `scene` sequentially.
+// Evaluating `ufbx_anim_cursor.anim` continues keyframe searches from the previously
+// evaluated keyframes, making monotonic playback amortized O(1) per curve.
+// The cursor keeps a reference to `scene` and `anim` until freed.
+ufbx_abi ufbx_anim_cursor *ufbx_create_anim_cursor(const ufbx_scene *scene, const ufbx_anim *anim, const ufbx_anim_cursor_opts *opts, ufbx_error *error);
+
+// Free a cursor returned by `ufbx_create_anim_cursor()`.
+ufbx_abi void ufbx_free_anim_cursor(ufbx_anim_cursor *cursor);
+
+// Evaluate a single animation `curve` at `time` using `cursor` for the keyframe search.
+// Returns the same value as `ufbx_evaluate_curve()`.
+ufbx_abi ufbx_real ufbx_evaluate_curve_cursor(ufbx_anim_cursor *cursor, const ufbx_anim_curve *curve, double time, ufbx_real default_value);
+
 // Animation baking
 
 // "Bake" an animation to linearly interpolated keyframes.
@@ -5425,6 +5873,24 @@ ufbx_abi ufbx_vec3 ufbx_evaluate_baked_vec3(ufbx_baked_vec3_list keyframes, doub
 // Handles stepped tangents cleanly, which is not strictly necessary for custom interpolation.
 ufbx_abi ufbx_quat ufbx_evaluate_baked_quat(ufbx_baked_quat_list keyframes, double time);
 
+// Resample and quantize `bake` into a compact representation, see `ufbx_compact_anim`.
+// Does not reference `bake` so it can be freed afterwards.
+ufbx_abi ufbx_compact_anim *ufbx_compact_baked_anim(const ufbx_baked_anim *bake, const ufbx_compact_anim_opts *opts, ufbx_error *error);
+
+// Increment or decrement the reference count of `anim`, freeing it when it reaches zero.
+ufbx_abi void ufbx_retain_compact_anim(ufbx_compact_anim *anim);
+ufbx_abi void ufbx_free_compact_anim(ufbx_compact_anim *anim);
+
+// Find the compact animation of `node` or `element`, returns `NULL` if it is not animated.
+ufbx_abi ufbx_compact_node *ufbx_find_compact_node(ufbx_compact_anim *anim, ufbx_node *node);
+ufbx_abi ufbx_compact_element *ufbx_find_compact_element(ufbx_compact_anim *anim, ufbx_element *element);
+
+// Evaluate compact animation tracks at `time`, linearly interpolating between adjacent samples.
+// Rotations are interpolated using normalized linear interpolation.
+ufbx_abi ufbx_vec3 ufbx_evaluate_compact_vec3(const ufbx_compact_anim *anim, const ufbx_compact_vec3_track *track, double time);
+ufbx_abi ufbx_quat ufbx_evaluate_compact_quat(const ufbx_compact_anim *anim, const ufbx_compact_quat_track *track, double time);
+ufbx_abi ufbx_transform ufbx_evaluate_compact_node(const ufbx_compact_anim *anim, const ufbx_compact_node *node, double time);
+
 // Poses
 
 // Retrieve the bone pose for `node`.
@@ -5549,6 +6015,15 @@ ufbx_abi uint32_t ufbx_find_face_index(ufbx_mesh *mesh, size_t index);
 ufbx_abi uint32_t ufbx_catch_triangulate_face(ufbx_panic *panic, uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, ufbx_face face);
 ufbx_abi uint32_t ufbx_triangulate_face(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, ufbx_face face);
 
+// Triangulate all faces of `mesh` into `indices`, returning the number of triangles.
+// Triangles are written in face order, identical to calling `ufbx_triangulate_face()` for each face.
+// NOTE: You need space for `mesh->num_triangles * 3` indices!
+ufbx_abi size_t ufbx_triangulate_mesh(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const ufbx_triangulate_opts *opts, ufbx_error *error);
+
+// Triangulate the faces of a mesh part, eg. `ufbx_mesh.material_parts[]`.
+// NOTE: You need space for `part->num_triangles * 3` indices!
+ufbx_abi size_t ufbx_triangulate_mesh_part(uint32_t *indices, size_t num_indices, const ufbx_mesh *mesh, const ufbx_mesh_part *part, const ufbx_triangulate_opts *opts, ufbx_error *error);
+
 // Generate the half-edge representation of `mesh` to `topo[mesh->num_indices]`
 ufbx_abi void ufbx_catch_compute_topology(ufbx_panic *panic, const ufbx_mesh *mesh, ufbx_topo_edge *topo, size_t num_topo);
 ufbx_abi void ufbx_compute_topology(const ufbx_mesh *mesh, ufbx_topo_edge *topo, size_t num_topo);
@@ -5620,6 +6095,36 @@ ufbx_abi size_t ufbx_read_geometry_cache_vec3(const ufbx_cache_frame *frame, ufb
 ufbx_abi size_t ufbx_sample_geometry_cache_real(const ufbx_cache_channel *channel, double time, ufbx_real *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
 ufbx_abi size_t ufbx_sample_geometry_cache_vec3(const ufbx_cache_channel *channel, double time, ufbx_vec3 *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
 
+// Create a reader for `ufbx_geometry_cache_data_opts.reader`.
+// Frames read through the reader keep their files open so subsequent reads
+// from the same file do not need to re-open or re-read it.
+ufbx_abi ufbx_geometry_cache_reader *ufbx_create_geometry_cache_reader(const ufbx_geometry_cache_reader_opts *opts, ufbx_error *error);
+// Free a reader returned by `ufbx_create_geometry_cache_reader()`, closing all files.
+ufbx_abi void ufbx_free_geometry_cache_reader(ufbx_geometry_cache_reader *reader);
+
+// Create a playback object for sampling `channel` at successive times.
+// Decoded frames are kept in a buffer and upcoming ones are read ahead of time
+// using `ufbx_cache_playback_opts.thread_opts` if specified.
+ufbx_abi ufbx_cache_playback *ufbx_create_cache_playback(const ufbx_cache_channel *channel, const ufbx_cache_playback_opts *opts, ufbx_error *error);
+// Free a playback returned by `ufbx_create_cache_playback()`, waits for pending reads.
+ufbx_abi void ufbx_free_cache_playback(ufbx_cache_playback *playback);
+// Sample the channel of `playback`, returns the same data as `ufbx_sample_geometry_cache_TYPE()`.
+// Only `additive`, `use_weight` and `weight` of `opts` are used.
+ufbx_abi size_t ufbx_cache_playback_sample_real(ufbx_cache_playback *playback, double time, ufbx_real *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
+ufbx_abi size_t ufbx_cache_playback_sample_vec3(ufbx_cache_playback *playback, double time, ufbx_vec3 *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
+
+// Embedded content
+
+// Read embedded content left in the file with `ufbx_load_opts.defer_embedded`.
+// `data` should have space for `location->size` bytes, returns the number of bytes written
+// which is less than `location->size` if the file could not be read.
+ufbx_abi size_t ufbx_read_embedded_file(const ufbx_embedded_location *location, const char *filename, void *data, size_t data_size, const ufbx_read_embedded_opts *opts);
+ufbx_abi size_t ufbx_read_embedded_file_len(const ufbx_embedded_location *location, const char *filename, size_t filename_len, void *data, size_t data_size, const ufbx_read_embedded_opts *opts);
+// Read from the file contents passed to `ufbx_load_memory()`.
+ufbx_abi size_t ufbx_read_embedded_memory(const ufbx_embedded_location *location, const void *file_data, size_t file_size, void *data, size_t data_size);
+// Read from `stream` positioned at the beginning of the file, the stream is not closed.
+ufbx_abi size_t ufbx_read_embedded_stream(const ufbx_embedded_location *location, ufbx_stream *stream, void *data, size_t data_size);
+
 // DOM
 
 // Find a DOM node given a name.
@@ -5633,6 +6138,9 @@ ufbx_abi ufbx_dom_node *ufbx_dom_find(const ufbx_dom_node *parent, const char *n
 // This function compacts the data within `streams` in-place, writing the deduplicated indices to `indices`.
 ufbx_abi size_t ufbx_generate_indices(const ufbx_vertex_stream *streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_allocator_opts *allocator, ufbx_error *error);
 
+// Version of `ufbx_generate_indices()` with additional options, see `ufbx_generate_indices_opts`.
+ufbx_abi size_t ufbx_generate_indices_ex(const ufbx_vertex_stream *streams, size_t num_streams, uint32_t *indices, size_t num_indices, const ufbx_generate_indices_opts *opts, ufbx_error *error);
+
 // Thread pool
 
 // Run a single thread pool task.
@@ -5788,6 +6296,12 @@ template<> struct ufbx_type_traits<ufbx_baked_anim> {
 	static void free(ufbx_baked_anim *ptr) { ufbx_free_baked_anim(ptr); }
 };
 
+template<> struct ufbx_type_traits<ufbx_compact_anim> {
+	enum { valid = 1 };
+	static void retain(ufbx_compact_anim *ptr) { ufbx_retain_compact_anim(ptr); }
+	static void free(ufbx_compact_anim *ptr) { ufbx_free_compact_anim(ptr); }
+};
+
 class ufbx_deleter {
 public:
 	template <typename T>